@@ -197,6 +197,7 @@ dnl If some extension uses mysql-xdevapi it will get compiled in PHP core
 if test "$PHP_MYSQL_XDEVAPI" != "no" || test "$PHP_MYSQL_XDEVAPI_ENABLED" == "yes"; then
 	mysqlx_devapi_sources=" \
 		mysqlx_base_result.cc \
+		mysqlx_benchmark.cc \
 		mysqlx_class_properties.cc \
 		mysqlx_client.cc \
 		mysqlx_collection.cc \
@@ -217,9 +218,11 @@ if test "$PHP_MYSQL_XDEVAPI" != "no" || test "$PHP_MYSQL_XDEVAPI_ENABLED" == "ye
 		mysqlx_executable.cc \
 		mysqlx_execution_status.cc \
 		mysqlx_expression.cc \
+		mysqlx_fake_server.cc \
 		mysqlx_object.cc \
 		mysqlx_result.cc \
 		mysqlx_result_iterator.cc \
+		mysqlx_row.cc \
 		mysqlx_row_result.cc \
 		mysqlx_row_result_iterator.cc \
 		mysqlx_schema.cc \
@@ -228,6 +231,7 @@ if test "$PHP_MYSQL_XDEVAPI" != "no" || test "$PHP_MYSQL_XDEVAPI_ENABLED" == "ye
 		mysqlx_sql_statement.cc \
 		mysqlx_sql_statement_result.cc \
 		mysqlx_sql_statement_result_iterator.cc \
+		mysqlx_statistics.cc \
 		mysqlx_table.cc \
 		mysqlx_table__delete.cc \
 		mysqlx_table__insert.cc \
@@ -240,6 +244,7 @@ if test "$PHP_MYSQL_XDEVAPI" != "no" || test "$PHP_MYSQL_XDEVAPI_ENABLED" == "ye
 
 	mysqlx_util=" \
 		util/allocator.cc \
+		util/arena.cc \
 		util/arguments.cc \
 		util/exceptions.cc \
 		util/functions.cc \
@@ -255,6 +260,7 @@ if test "$PHP_MYSQL_XDEVAPI" != "no" || test "$PHP_MYSQL_XDEVAPI_ENABLED" == "ye
 
 	xmysqlnd_sources=" \
 		xmysqlnd/xmysqlnd_any2expr.cc \
+		xmysqlnd/xmysqlnd_capture.cc \
 		xmysqlnd/xmysqlnd_collection.cc \
 		xmysqlnd/xmysqlnd_compression.cc \
 		xmysqlnd/xmysqlnd_compression_setup.cc \
@@ -268,14 +274,18 @@ if test "$PHP_MYSQL_XDEVAPI" != "no" || test "$PHP_MYSQL_XDEVAPI_ENABLED" == "ye
 		xmysqlnd/xmysqlnd_driver.cc \
 		xmysqlnd/xmysqlnd_environment.cc \
 		xmysqlnd/xmysqlnd_extension_plugin.cc \
+		xmysqlnd/xmysqlnd_fake_server.cc \
 		xmysqlnd/xmysqlnd_index_collection_commands.cc \
 		xmysqlnd/xmysqlnd_object_factory.cc \
+		xmysqlnd/xmysqlnd_perf_statistics.cc \
 		xmysqlnd/xmysqlnd_protocol_dumper.cc \
 		xmysqlnd/xmysqlnd_protocol_frame_codec.cc \
 		xmysqlnd/xmysqlnd_rowset.cc \
 		xmysqlnd/xmysqlnd_rowset_buffered.cc \
 		xmysqlnd/xmysqlnd_rowset_fwd.cc \
 		xmysqlnd/xmysqlnd_schema.cc \
+		xmysqlnd/xmysqlnd_schema_cache.cc \
+		xmysqlnd/xmysqlnd_server_info_cache.cc \
 		xmysqlnd/xmysqlnd_session.cc \
 		xmysqlnd/xmysqlnd_statistics.cc \
 		xmysqlnd/xmysqlnd_stmt.cc \
@@ -283,11 +293,14 @@ if test "$PHP_MYSQL_XDEVAPI" != "no" || test "$PHP_MYSQL_XDEVAPI_ENABLED" == "ye
 		xmysqlnd/xmysqlnd_stmt_result.cc \
 		xmysqlnd/xmysqlnd_stmt_result_meta.cc \
 		xmysqlnd/xmysqlnd_table.cc \
+		xmysqlnd/xmysqlnd_trace.cc \
 		xmysqlnd/xmysqlnd_utils.cc \
 		xmysqlnd/xmysqlnd_warning_list.cc \
 		xmysqlnd/xmysqlnd_wireprotocol.cc \
 		xmysqlnd/xmysqlnd_wireprotocol_types.cc \
+		xmysqlnd/xmysqlnd_write_batch.cc \
 		xmysqlnd/xmysqlnd_zval2any.cc \
+		xmysqlnd/xmysqlnd_zval2expr.cc \
 		"
 
 	xmysqlnd_cdkbase_parser=" \
@@ -30,7 +30,9 @@
 #include "mysqlx_class_properties.h"
 #include "mysqlx_warning.h"
 #include "mysqlx_base_result.h"
+#include "util/exceptions.h"
 #include "util/object.h"
+#include "util/value.h"
 
 namespace mysqlx {
 
@@ -52,6 +54,111 @@ static const zend_function_entry mysqlx_base_result_methods[] = {
 	{nullptr, nullptr, nullptr}
 };
 
+void
+fetch_one_num(drv::st_xmysqlnd_stmt_result* result, zval* return_value)
+{
+	DBG_ENTER("fetch_one_num");
+	RETVAL_NULL();
+	if (result && (FALSE == result->m.eof(result))) {
+		if (PASS == result->m.fetch_current_list(result, return_value, nullptr, nullptr)) {
+			result->m.next(result, nullptr, nullptr);
+		}
+	}
+	DBG_VOID_RETURN;
+}
+
+void
+fetch_all_num(drv::st_xmysqlnd_stmt_result* result, zval* return_value)
+{
+	DBG_ENTER("fetch_all_num");
+	if (result) {
+		result->m.fetch_all_lists(result, return_value, nullptr, nullptr);
+	}
+	util::zvalue::ensure_is_array(return_value);
+	DBG_VOID_RETURN;
+}
+
+namespace {
+
+unsigned int get_column_index(const drv::st_xmysqlnd_stmt_result_meta* meta, const zval* column)
+{
+	const unsigned int field_count{meta->m->get_field_count(meta)};
+	if (!column || (Z_TYPE_P(column) == IS_NULL)) {
+		return 0;
+	}
+	if (Z_TYPE_P(column) == IS_LONG) {
+		const zend_long index{Z_LVAL_P(column)};
+		if ((index < 0) || (static_cast<zend_ulong>(index) >= field_count)) {
+			throw util::xdevapi_exception(util::xdevapi_exception::Code::invalid_argument, "column index out of range");
+		}
+		return static_cast<unsigned int>(index);
+	}
+	if (Z_TYPE_P(column) == IS_STRING) {
+		const util::string_view name{Z_STRVAL_P(column), Z_STRLEN_P(column)};
+		for (unsigned int i{0}; i < field_count; ++i) {
+			if (meta->m->get_field(meta, i)->name == name) {
+				return i;
+			}
+		}
+		throw util::xdevapi_exception(util::xdevapi_exception::Code::invalid_argument, "unknown column name");
+	}
+	throw util::xdevapi_exception(util::xdevapi_exception::Code::invalid_argument, "column has to be an index or a name");
+}
+
+} // anonymous namespace
+
+void
+fetch_all_column(drv::st_xmysqlnd_stmt_result* result, const zval* column, zval* return_value)
+{
+	DBG_ENTER("fetch_all_column");
+	if (result && result->meta) {
+		const unsigned int field{ get_column_index(result->meta, column) };
+		result->m.fetch_all_field(result, field, return_value, nullptr, nullptr);
+	}
+	util::zvalue::ensure_is_array(return_value);
+	DBG_VOID_RETURN;
+}
+
+/*
+  Assigns the current row to the properties of an existing object, the column
+  names are the keys already interned in the result metadata.
+*/
+void
+fetch_one_into(drv::st_xmysqlnd_stmt_result* result, zval* object, zval* return_value)
+{
+	DBG_ENTER("fetch_one_into");
+	RETVAL_NULL();
+	if (!result || !result->meta || (TRUE == result->m.eof(result))) {
+		DBG_VOID_RETURN;
+	}
+
+	util::zvalue row;
+	if (PASS != result->m.fetch_current_list(result, row.ptr(), nullptr, nullptr)) {
+		DBG_VOID_RETURN;
+	}
+	result->m.next(result, nullptr, nullptr);
+
+	const drv::st_xmysqlnd_stmt_result_meta* meta{ result->meta };
+	const unsigned int field_count{meta->m->get_field_count(meta)};
+	zend_class_entry* const scope{ Z_OBJCE_P(object) };
+	for (unsigned int i{0}; i < field_count; ++i) {
+		zval* const value{ zend_hash_index_find(Z_ARRVAL_P(row.ptr()), i) };
+		if (!value) {
+			continue;
+		}
+#if PHP_VERSION_ID >= 80000 // PHP 8.0 or newer
+		zend_update_property_ex(scope, Z_OBJ_P(object), meta->m->get_field(meta, i)->zend_hash_key.sname, value);
+#else
+		zend_update_property_ex(scope, object, meta->m->get_field(meta, i)->zend_hash_key.sname, value);
+#endif
+		if (EG(exception)) {
+			break;
+		}
+	}
+	ZVAL_COPY(return_value, object);
+	DBG_VOID_RETURN;
+}
+
 void
 mysqlx_register_base_result_interface(UNUSED_INIT_FUNC_ARGS, zend_object_handlers* /*mysqlx_std_object_handlers*/)
 {
@@ -35,6 +35,15 @@ struct st_mysqlx_base_result : public util::custom_allocable
 	drv::st_xmysqlnd_stmt_result* result;
 };
 
+/*
+  Fetch modes shared by RowResult and SqlStatementResult, none of them builds
+  a hash keyed by column names per row.
+*/
+void fetch_one_num(drv::st_xmysqlnd_stmt_result* result, zval* return_value);
+void fetch_all_num(drv::st_xmysqlnd_stmt_result* result, zval* return_value);
+void fetch_all_column(drv::st_xmysqlnd_stmt_result* result, const zval* column, zval* return_value);
+void fetch_one_into(drv::st_xmysqlnd_stmt_result* result, zval* object, zval* return_value);
+
 void mysqlx_register_base_result_interface(INIT_FUNC_ARGS, zend_object_handlers* mysqlx_std_object_handlers);
 void mysqlx_unregister_base_result_interface(SHUTDOWN_FUNC_ARGS);
 
@@ -0,0 +1,874 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Filip Janiszewski <fjanisze@php.net>                        |
+  |          Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#include "php_api.h"
+#include "mysqlnd_api.h"
+#include "xmysqlnd/xmysqlnd.h"
+#include "xmysqlnd/xmysqlnd_capture.h"
+#include "xmysqlnd/xmysqlnd_compression.h"
+#include "xmysqlnd/xmysqlnd_compression_types.h"
+#include "xmysqlnd/xmysqlnd_compressor_lz4.h"
+#include "xmysqlnd/xmysqlnd_compressor_zlib.h"
+#include "xmysqlnd/xmysqlnd_compressor_zstd.h"
+#include "xmysqlnd/xmysqlnd_crud_collection_commands.h"
+#include "xmysqlnd/xmysqlnd_session.h"
+#include "xmysqlnd/xmysqlnd_stmt.h"
+#include "xmysqlnd/xmysqlnd_stmt_result.h"
+#include "xmysqlnd/xmysqlnd_stmt_result_meta.h"
+#include "xmysqlnd/xmysqlnd_utils.h"
+#include "xmysqlnd/xmysqlnd_wireprotocol.h"
+#include "xmysqlnd/crud_parsers/mysqlx_crud_parser.h"
+#include "xmysqlnd/proto_gen/mysqlx_connection.pb.h"
+#include "xmysqlnd/proto_gen/mysqlx_crud.pb.h"
+#include "xmysqlnd/proto_gen/mysqlx_resultset.pb.h"
+#include "xmysqlnd/proto_gen/mysqlx_sql.pb.h"
+#include "mysqlx_benchmark.h"
+#include "util/arguments.h"
+#include "util/exceptions.h"
+#include "util/functions.h"
+#include "util/strings.h"
+#include "util/types.h"
+#include "util/value.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace mysqlx {
+
+namespace devapi {
+
+#ifdef MYSQL_XDEVAPI_DEV_MODE
+
+using namespace drv;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Benchmark_result
+{
+	std::size_t operations;
+	Clock::duration elapsed;
+	std::size_t allocations;
+};
+
+// ----------------------------------------------------------------------------
+
+#if PHP_VERSION_ID >= 80400 // PHP 8.4 or newer - custom handlers get the file and line
+#define BENCHMARK_ALLOC_DC ZEND_FILE_LINE_DC ZEND_FILE_LINE_ORIG_DC
+#define BENCHMARK_ALLOC_RELAY_CC ZEND_FILE_LINE_RELAY_CC ZEND_FILE_LINE_ORIG_RELAY_CC
+#define BENCHMARK_HEAP_RELAY_CC ZEND_FILE_LINE_RELAY_CC ZEND_FILE_LINE_ORIG_RELAY_CC
+#else
+#define BENCHMARK_ALLOC_DC
+#define BENCHMARK_ALLOC_RELAY_CC
+#define BENCHMARK_HEAP_RELAY_CC ZEND_FILE_LINE_CC ZEND_FILE_LINE_EMPTY_CC
+#endif
+
+/*
+	Counts the request heap allocations (emalloc & co., so also mnd_emalloc and
+	util::custom_allocable objects) while it exists, by hooking the zend_mm custom
+	handlers. Allocations made straight with malloc/new, e.g. by protobuf, are not
+	seen. Hooking slows down emalloc, so the allocations are counted in a separate
+	run of a case, not in the timed ones. If zend_mm was built without custom heap
+	support it counts nothing.
+*/
+class Allocation_counter
+{
+public:
+	Allocation_counter();
+	Allocation_counter(const Allocation_counter&) = delete;
+	Allocation_counter& operator=(const Allocation_counter&) = delete;
+	~Allocation_counter();
+
+	// allocations counted so far by the active counter, 0 if there is none
+	static std::size_t get_count();
+
+private:
+	static void* count_malloc(std::size_t size BENCHMARK_ALLOC_DC);
+	static void count_free(void* ptr BENCHMARK_ALLOC_DC);
+	static void* count_realloc(void* ptr, std::size_t size BENCHMARK_ALLOC_DC);
+
+	static thread_local Allocation_counter* active;
+
+	zend_mm_heap* heap;
+	void* (*prev_malloc)(std::size_t BENCHMARK_ALLOC_DC);
+	void (*prev_free)(void* BENCHMARK_ALLOC_DC);
+	void* (*prev_realloc)(void*, std::size_t BENCHMARK_ALLOC_DC);
+	std::size_t count{0};
+};
+
+thread_local Allocation_counter* Allocation_counter::active{nullptr};
+
+Allocation_counter::Allocation_counter()
+	: heap{ zend_mm_get_heap() }
+{
+	zend_mm_get_custom_handlers(heap, &prev_malloc, &prev_free, &prev_realloc);
+	zend_mm_set_custom_handlers(heap, count_malloc, count_free, count_realloc);
+	active = this;
+}
+
+Allocation_counter::~Allocation_counter()
+{
+	active = nullptr;
+	zend_mm_set_custom_handlers(heap, prev_malloc, prev_free, prev_realloc);
+}
+
+std::size_t Allocation_counter::get_count()
+{
+	return active ? active->count : 0;
+}
+
+void* Allocation_counter::count_malloc(std::size_t size BENCHMARK_ALLOC_DC)
+{
+	++active->count;
+	if (active->prev_malloc) return active->prev_malloc(size BENCHMARK_ALLOC_RELAY_CC);
+	return _zend_mm_alloc(active->heap, size BENCHMARK_HEAP_RELAY_CC);
+}
+
+void Allocation_counter::count_free(void* ptr BENCHMARK_ALLOC_DC)
+{
+	if (active->prev_free) {
+		active->prev_free(ptr BENCHMARK_ALLOC_RELAY_CC);
+		return;
+	}
+	_zend_mm_free(active->heap, ptr BENCHMARK_HEAP_RELAY_CC);
+}
+
+void* Allocation_counter::count_realloc(void* ptr, std::size_t size BENCHMARK_ALLOC_DC)
+{
+	++active->count;
+	if (active->prev_realloc) return active->prev_realloc(ptr, size BENCHMARK_ALLOC_RELAY_CC);
+	return _zend_mm_realloc(active->heap, ptr, size BENCHMARK_HEAP_RELAY_CC);
+}
+
+/*
+	times the measured section of a case, the setup and cleanup around it are not
+	taken into account
+*/
+template<typename Operation>
+Benchmark_result measure(std::size_t operations, Operation operation)
+{
+	const std::size_t allocations_before{ Allocation_counter::get_count() };
+	const Clock::time_point start{ Clock::now() };
+	operation();
+	const Clock::duration elapsed{ Clock::now() - start };
+	return { operations, elapsed, Allocation_counter::get_count() - allocations_before };
+}
+
+// ----------------------------------------------------------------------------
+
+std::string encode_varints(std::initializer_list<uint64_t> values)
+{
+	std::string buffer;
+	for (uint64_t value : values) {
+		do {
+			uint8_t byte{static_cast<uint8_t>(value & 0x7F)};
+			value >>= 7;
+			if (value) byte |= 0x80;
+			buffer += static_cast<char>(byte);
+		} while (value);
+	}
+	return buffer;
+}
+
+/*
+	scale byte, then packed BCD digits closed with the sign nibble (0xC or 0xD)
+*/
+std::string encode_decimal(const util::string_view& value)
+{
+	std::string digits;
+	uint8_t scale{0};
+	bool negative{false};
+	bool fractional{false};
+	for (char c : value) {
+		if (c == '-') {
+			negative = true;
+		} else if (c == '.') {
+			fractional = true;
+		} else {
+			digits += c;
+			if (fractional) ++scale;
+		}
+	}
+
+	const uint8_t sign{static_cast<uint8_t>(negative ? 0xD : 0xC)};
+	std::string buffer(1, static_cast<char>(scale));
+	for (std::size_t i{0}; i < digits.length(); i += 2) {
+		const uint8_t high = static_cast<uint8_t>(digits[i] - '0');
+		const uint8_t low = static_cast<uint8_t>(i + 1 < digits.length() ? digits[i + 1] - '0' : sign);
+		buffer += static_cast<char>((high << 4) | low);
+	}
+	if (!(digits.length() & 0x01)) {
+		buffer += static_cast<char>(sign << 4);
+	}
+	return buffer;
+}
+
+std::string encode_set(std::initializer_list<util::string_view> values)
+{
+	std::string buffer;
+	for (const util::string_view& value : values) {
+		buffer += encode_varints({value.length()});
+		buffer.append(value.data(), value.length());
+	}
+	return buffer;
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+	Row of cells encoded the way they come in Mysqlx::Resultset::Row, decoded
+	through a per-column decode plan just like the rows read from the wire.
+*/
+class Synthetic_row
+{
+public:
+	Synthetic_row& add(enum xmysqlnd_field_type type, std::string&& buffer);
+	Synthetic_row& add_date(std::string&& buffer);
+
+	Benchmark_result decode(std::size_t iterations) const;
+
+private:
+	struct Column
+	{
+		XMYSQLND_RESULT_FIELD_META meta;
+		std::string buffer;
+	};
+
+	util::vector<Column> columns;
+};
+
+Synthetic_row& Synthetic_row::add(enum xmysqlnd_field_type type, std::string&& buffer)
+{
+	Column column{};
+	column.meta.type = type;
+	column.meta.type_set = TRUE;
+	column.buffer = std::move(buffer);
+	columns.push_back(std::move(column));
+	return *this;
+}
+
+Synthetic_row& Synthetic_row::add_date(std::string&& buffer)
+{
+	add(XMYSQLND_TYPE_DATETIME, std::move(buffer));
+	XMYSQLND_RESULT_FIELD_META& meta{ columns.back().meta };
+	meta.content_type = Mysqlx::Resultset::DATE;
+	meta.content_type_set = TRUE;
+	return *this;
+}
+
+Benchmark_result Synthetic_row::decode(std::size_t iterations) const
+{
+	util::vector<st_xmysqlnd_row_field_decode_step> decode_plan;
+	for (const Column& column : columns) {
+		decode_plan.push_back({xmysqlnd_row_field_decoder(&column.meta), &column.meta});
+	}
+
+	return measure(iterations * columns.size(), [&] {
+		for (std::size_t i{0}; i < iterations; ++i) {
+			const st_xmysqlnd_row_field_decode_step* step = decode_plan.data();
+			for (const Column& column : columns) {
+				zval zv;
+				ZVAL_NULL(&zv);
+				if (!column.buffer.empty()) {
+					step->decoder(&zv, reinterpret_cast<const uint8_t*>(column.buffer.data()), column.buffer.size(), step->field_meta);
+				}
+				zval_ptr_dtor(&zv);
+				++step;
+			}
+		}
+	});
+}
+
+// ----------------------------------------------------------------------------
+
+Benchmark_result row_field_decimal(std::size_t iterations)
+{
+	Synthetic_row row;
+	row.add(XMYSQLND_TYPE_DECIMAL, encode_decimal("-12345678901234.5678"));
+	return row.decode(iterations);
+}
+
+/*
+	financial report - 20 x DECIMAL(15,2) per row
+*/
+Benchmark_result row_report(std::size_t iterations)
+{
+	Synthetic_row row;
+	const char* values[]{
+		"0.00", "1.05", "-17.40", "250.99", "1999.00",
+		"-42000.10", "100000.00", "3.14", "-0.99", "75432.18",
+		"1234567890123.45", "-9876543210.00", "12.34", "56.78", "-90.12",
+		"345.60", "7890.12", "-34567.89", "0.01", "999999999999.99"
+	};
+	for (const char* value : values) {
+		row.add(XMYSQLND_TYPE_DECIMAL, encode_decimal(value));
+	}
+	return row.decode(iterations);
+}
+
+Benchmark_result row_field_datetime(std::size_t iterations)
+{
+	Synthetic_row row;
+	row.add(XMYSQLND_TYPE_DATETIME, encode_varints({2020, 11, 27, 13, 45, 59, 123456}));
+	return row.decode(iterations);
+}
+
+Benchmark_result row_field_date(std::size_t iterations)
+{
+	Synthetic_row row;
+	row.add_date(encode_varints({2020, 11, 27}));
+	return row.decode(iterations);
+}
+
+Benchmark_result row_field_time(std::size_t iterations)
+{
+	Synthetic_row row;
+	row.add(XMYSQLND_TYPE_TIME, encode_varints({1, 838, 59, 59, 999}));
+	return row.decode(iterations);
+}
+
+Benchmark_result row_field_set(std::size_t iterations)
+{
+	Synthetic_row row;
+	row.add(XMYSQLND_TYPE_SET, encode_set({"red", "green", "blue", "cyan", "magenta"}));
+	return row.decode(iterations);
+}
+
+std::string encode_sint(int64_t value)
+{
+	return encode_varints({(static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63)});
+}
+
+std::string encode_double(double value)
+{
+	uint64_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	char buffer[sizeof(bits)];
+	int8store(buffer, bits);
+	return std::string(buffer, sizeof(buffer));
+}
+
+std::string encode_float(float value)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	char buffer[sizeof(bits)];
+	int4store(buffer, bits);
+	return std::string(buffer, sizeof(buffer));
+}
+
+// BYTES cells come with a trailing '\0'
+std::string encode_bytes(const util::string_view& value)
+{
+	std::string buffer(value.data(), value.length());
+	buffer += '\0';
+	return buffer;
+}
+
+Benchmark_result row_field_sint(std::size_t iterations)
+{
+	Synthetic_row row;
+	row.add(XMYSQLND_TYPE_SIGNED_INT, encode_sint(-1234567890123LL));
+	return row.decode(iterations);
+}
+
+Benchmark_result row_field_uint(std::size_t iterations)
+{
+	Synthetic_row row;
+	row.add(XMYSQLND_TYPE_UNSIGNED_INT, encode_varints({18446744073709ULL}));
+	return row.decode(iterations);
+}
+
+Benchmark_result row_field_double(std::size_t iterations)
+{
+	Synthetic_row row;
+	row.add(XMYSQLND_TYPE_DOUBLE, encode_double(2718.281828459045));
+	return row.decode(iterations);
+}
+
+Benchmark_result row_field_float(std::size_t iterations)
+{
+	Synthetic_row row;
+	row.add(XMYSQLND_TYPE_FLOAT, encode_float(3.1415f));
+	return row.decode(iterations);
+}
+
+Benchmark_result row_field_bytes(std::size_t iterations)
+{
+	Synthetic_row row;
+	row.add(XMYSQLND_TYPE_BYTES, encode_bytes("The quick brown fox jumps over the lazy dog"));
+	return row.decode(iterations);
+}
+
+// ----------------------------------------------------------------------------
+
+const std::size_t Frame_header_size{5}; /* payload length + message type */
+
+void append_frame(std::string& frames, xmysqlnd_server_message_type packet_type, const google::protobuf::Message& message)
+{
+	const std::string payload{ message.SerializeAsString() };
+	char header[Frame_header_size];
+	int4store(header, static_cast<uint32_t>(payload.length() + 1));
+	header[Frame_header_size - 1] = static_cast<char>(packet_type);
+	frames.append(header, sizeof(header));
+	frames += payload;
+}
+
+Mysqlx::Sql::StmtExecute create_stmt_execute()
+{
+	Mysqlx::Sql::StmtExecute stmt_execute;
+	stmt_execute.set_namespace_(namespace_sql.data(), namespace_sql.length());
+	stmt_execute.set_stmt("SELECT id, name, price, amount FROM bench.products WHERE category = ? LIMIT 100");
+	Mysqlx::Datatypes::Any* arg{ stmt_execute.add_args() };
+	arg->set_type(Mysqlx::Datatypes::Any::SCALAR);
+	Mysqlx::Datatypes::Scalar* scalar{ arg->mutable_scalar() };
+	scalar->set_type(Mysqlx::Datatypes::Scalar::V_SINT);
+	scalar->set_v_signed_int(42);
+	return stmt_execute;
+}
+
+Benchmark_result frame_encode(std::size_t iterations)
+{
+	const Mysqlx::Sql::StmtExecute stmt_execute{ create_stmt_execute() };
+	util::bytes frame;
+	return measure(iterations, [&] {
+		for (std::size_t i{0}; i < iterations; ++i) {
+			const std::size_t payload_size{ stmt_execute.ByteSizeLong() };
+			frame.resize(Frame_header_size + payload_size);
+			int4store(frame.data(), static_cast<uint32_t>(payload_size + 1));
+			frame[Frame_header_size - 1] = static_cast<util::byte>(COM_SQL_STMT_EXECUTE);
+			stmt_execute.SerializeToArray(frame.data() + Frame_header_size, static_cast<int>(payload_size));
+		}
+	});
+}
+
+Mysqlx::Resultset::Row create_row(int64_t id)
+{
+	Mysqlx::Resultset::Row row;
+	row.add_field(encode_sint(id));
+	row.add_field(encode_bytes("product name of moderate length"));
+	row.add_field(encode_double(19.99 + static_cast<double>(id)));
+	row.add_field(encode_decimal("12345.67"));
+	return row;
+}
+
+Benchmark_result frame_decode(std::size_t iterations)
+{
+	const std::string payload{ create_row(1000).SerializeAsString() };
+	Mysqlx::Resultset::Row row;
+	return measure(iterations, [&] {
+		for (std::size_t i{0}; i < iterations; ++i) {
+			row.ParseFromArray(payload.data(), static_cast<int>(payload.length()));
+		}
+	});
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+	Session whose vio is served by an in-process server - the responses to a query
+	returning the given number of rows, looped, so that every statement sent gets
+	the same result. No request is interpreted, the session never leaves the
+	allocated state and closing it just closes the stream.
+*/
+class Synthetic_server_session
+{
+public:
+	explicit Synthetic_server_session(std::size_t row_count);
+	~Synthetic_server_session();
+
+	// sends the query and reads all its rows, returns the number of rows
+	std::size_t query(bool buffered);
+	// the next query builds its result meta from scratch
+	void clear_meta_cache();
+
+private:
+	XMYSQLND_SESSION session;
+	XMYSQLND_STMT_OP__EXECUTE* stmt_execute{nullptr};
+};
+
+Synthetic_server_session::Synthetic_server_session(std::size_t row_count)
+	: session{ create_session(false) }
+{
+	std::string frames;
+	const std::pair<const char*, Mysqlx::Resultset::ColumnMetaData::FieldType> columns[]{
+		{ "id", Mysqlx::Resultset::ColumnMetaData::SINT },
+		{ "name", Mysqlx::Resultset::ColumnMetaData::BYTES },
+		{ "price", Mysqlx::Resultset::ColumnMetaData::DOUBLE },
+		{ "amount", Mysqlx::Resultset::ColumnMetaData::DECIMAL },
+	};
+	for (const auto& column : columns) {
+		Mysqlx::Resultset::ColumnMetaData meta;
+		meta.set_type(column.second);
+		meta.set_name(column.first);
+		meta.set_original_name(column.first);
+		meta.set_table("products");
+		meta.set_original_table("products");
+		meta.set_schema("bench");
+		meta.set_catalog("def");
+		if (column.second == Mysqlx::Resultset::ColumnMetaData::BYTES) {
+			meta.set_collation(255);
+		}
+		append_frame(frames, XMSG_COLUMN_METADATA, meta);
+	}
+	for (std::size_t i{0}; i < row_count; ++i) {
+		append_frame(frames, XMSG_RSET_ROW, create_row(static_cast<int64_t>(i)));
+	}
+	append_frame(frames, XMSG_RSET_FETCH_DONE, Mysqlx::Resultset::FetchDone());
+	append_frame(frames, XMSG_STMT_EXECUTE_OK, Mysqlx::Sql::StmtExecuteOk());
+
+	if (!session
+		|| (FAIL == xmysqlnd_replay_attach(session->get_data()->io.vio, FALSE, frames)))
+	{
+		throw util::xdevapi_exception(util::xdevapi_exception::Code::runtime_error, "cannot set up the synthetic server");
+	}
+
+	stmt_execute = xmysqlnd_stmt_execute__create(namespace_sql, "SELECT id, name, price, amount FROM bench.products");
+	xmysqlnd_stmt_execute__finalize_bind(stmt_execute);
+}
+
+Synthetic_server_session::~Synthetic_server_session()
+{
+	if (stmt_execute) {
+		xmysqlnd_stmt_execute__destroy(stmt_execute);
+	}
+}
+
+std::size_t Synthetic_server_session::query(bool buffered)
+{
+	const st_xmysqlnd_stmt_on_warning_bind on_warning{ nullptr, nullptr };
+	const st_xmysqlnd_stmt_on_error_bind on_error{ nullptr, nullptr };
+	const std::size_t Fwd_prefetch_rows{100};
+
+	xmysqlnd_stmt* stmt{ session->create_statement_object(session) };
+	std::size_t row_count{0};
+	bool failed{true};
+	if (stmt && (PASS == stmt->send_raw_message(stmt, xmysqlnd_stmt_execute__get_protobuf_message(stmt_execute), nullptr, nullptr))) {
+		zend_bool has_more_rows{FALSE};
+		zend_bool has_more_results{FALSE};
+		XMYSQLND_STMT_RESULT* result{ buffered
+			? stmt->get_buffered_result(stmt, &has_more_results, on_warning, on_error, nullptr, nullptr)
+			: stmt->get_fwd_result(stmt, Fwd_prefetch_rows, &has_more_rows, &has_more_results, on_warning, on_error, nullptr, nullptr) };
+		if (result) {
+			zval rows;
+			ZVAL_UNDEF(&rows);
+			if (PASS == result->m.fetch_all(result, &rows, nullptr, nullptr)) {
+				row_count = zend_hash_num_elements(Z_ARRVAL(rows));
+				failed = false;
+			}
+			zval_ptr_dtor(&rows);
+			xmysqlnd_stmt_result_free(result, nullptr, nullptr);
+		}
+	}
+	if (stmt) {
+		xmysqlnd_stmt_free(stmt, nullptr, nullptr);
+	}
+
+	if (failed) {
+		throw util::xdevapi_exception(util::xdevapi_exception::Code::runtime_error, "synthetic query failed");
+	}
+	return row_count;
+}
+
+void Synthetic_server_session::clear_meta_cache()
+{
+	session->get_data()->result_meta_cache.clear();
+}
+
+const std::size_t Synthetic_result_rows{100};
+
+Benchmark_result rowset_buffered(std::size_t iterations)
+{
+	Synthetic_server_session session(Synthetic_result_rows);
+	return measure(iterations * Synthetic_result_rows, [&] {
+		for (std::size_t i{0}; i < iterations; ++i) {
+			session.query(true);
+		}
+	});
+}
+
+Benchmark_result rowset_fwd(std::size_t iterations)
+{
+	Synthetic_server_session session(Synthetic_result_rows);
+	return measure(iterations * Synthetic_result_rows, [&] {
+		for (std::size_t i{0}; i < iterations; ++i) {
+			session.query(false);
+		}
+	});
+}
+
+// per statement allocations, with a result meta (4 columns) built for every query
+Benchmark_result query_meta_build(std::size_t iterations)
+{
+	Synthetic_server_session session(1);
+	return measure(iterations, [&] {
+		for (std::size_t i{0}; i < iterations; ++i) {
+			session.clear_meta_cache();
+			session.query(true);
+		}
+	});
+}
+
+// ----------------------------------------------------------------------------
+
+Benchmark_result expr_parse(std::size_t iterations)
+{
+	const std::string criteria{
+		"age > :min_age AND name LIKE 'J%' AND address.city IN ('Paris', 'Berlin', 'Oslo')"
+		" AND (score + bonus) * 2 >= 100" };
+	return measure(iterations, [&] {
+		for (std::size_t i{0}; i < iterations; ++i) {
+			std::unique_ptr<Mysqlx::Expr::Expr> expr{ parser::parse(criteria, true) };
+		}
+	});
+}
+
+Benchmark_result doc_decode(std::size_t iterations)
+{
+	const util::zvalue raw_doc(
+		"{\"_id\": \"00005f3a2b4c0000000000000001\", \"name\": \"Jane Doe\", \"age\": 37,"
+		" \"active\": true, \"score\": 97.25, \"tags\": [\"admin\", \"dev\", \"ops\"],"
+		" \"address\": {\"street\": \"Main St 12\", \"city\": \"Paris\", \"zip\": \"75001\"}}");
+	return measure(iterations, [&] {
+		for (std::size_t i{0}; i < iterations; ++i) {
+			util::zvalue doc(xmysqlnd_utils_decode_doc(raw_doc));
+		}
+	});
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+	compresses a batch of inserts the way the frame codec does and decompresses
+	them back, i.e. both directions of a compressed exchange
+*/
+Benchmark_result compress(compression::Algorithm algorithm, std::size_t iterations)
+{
+	Mysqlx::Sql::StmtExecute stmt_execute{ create_stmt_execute() };
+	std::string stmt{ "INSERT INTO bench.products VALUES " };
+	for (int i{0}; i < 50; ++i) {
+		stmt += (i ? ", " : "");
+		stmt += "(" + std::to_string(i) + ", 'product name of moderate length', 19.99, 12345.67)";
+	}
+	stmt_execute.set_stmt(stmt);
+	std::string payload{ stmt_execute.SerializeAsString() };
+
+	compression::Executor compression_executor;
+	compression_executor.reset(compression::Configuration(algorithm));
+	Mysqlx::Connection::Compression compression_msg;
+	Messages messages;
+	return measure(iterations, [&] {
+		for (std::size_t i{0}; i < iterations; ++i) {
+			const compression::Compress_result compress_result{ compression_executor.compress_message(
+				COM_SQL_STMT_EXECUTE,
+				payload.length(),
+				reinterpret_cast<util::byte*>(&payload[0])) };
+			compression_msg.set_client_messages(static_cast<Mysqlx::ClientMessages_Type>(COM_SQL_STMT_EXECUTE));
+			compression_msg.set_uncompressed_size(compress_result.uncompressed_size);
+			compression_msg.set_payload(compress_result.compressed_payload);
+			messages.clear();
+			compression_executor.decompress_messages(compression_msg, messages);
+		}
+	});
+}
+
+Benchmark_result compress_zstd(std::size_t iterations)
+{
+	return compress(compression::Algorithm::zstd_stream, iterations);
+}
+
+Benchmark_result compress_lz4(std::size_t iterations)
+{
+	return compress(compression::Algorithm::lz4_message, iterations);
+}
+
+Benchmark_result compress_zlib(std::size_t iterations)
+{
+	return compress(compression::Algorithm::zlib_deflate_stream, iterations);
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+	lookup of an already prepared find among a few other prepared statements, as
+	done on every execute() of a statement with the prepared statements support on
+*/
+Benchmark_result ps_cache_lookup(std::size_t iterations)
+{
+	Prepare_stmt_data ps_data;
+	ps_data.set_supported_ps(true);
+
+	auto create_find{ [](const char* collection_name) {
+		Mysqlx::Crud::Find find;
+		find.mutable_collection()->set_schema("bench");
+		find.mutable_collection()->set_name(collection_name);
+		find.set_data_model(Mysqlx::Crud::DOCUMENT);
+		find.set_allocated_criteria(parser::parse("_id = :id", true));
+		return find;
+	} };
+
+	const char* collection_names[]{ "customers", "orders", "products", "invoices", "shipments" };
+	for (const char* collection_name : collection_names) {
+		Mysqlx::Crud::Find find{ create_find(collection_name) };
+		ps_data.add_message(find, 1);
+	}
+
+	Mysqlx::Crud::Find find{ create_find("products") };
+	return measure(iterations, [&] {
+		for (std::size_t i{0}; i < iterations; ++i) {
+			ps_data.add_message(find, 1);
+		}
+	});
+}
+
+// ----------------------------------------------------------------------------
+
+struct Benchmark_case
+{
+	util::string_view name;
+	Benchmark_result (*run)(std::size_t iterations);
+	bool (*is_available)();
+};
+
+const Benchmark_case benchmark_cases[]{
+	{ "frame_encode", frame_encode, nullptr },
+	{ "frame_decode", frame_decode, nullptr },
+	{ "row_field_sint", row_field_sint, nullptr },
+	{ "row_field_uint", row_field_uint, nullptr },
+	{ "row_field_double", row_field_double, nullptr },
+	{ "row_field_float", row_field_float, nullptr },
+	{ "row_field_bytes", row_field_bytes, nullptr },
+	{ "row_field_decimal", row_field_decimal, nullptr },
+	{ "row_report", row_report, nullptr },
+	{ "row_field_datetime", row_field_datetime, nullptr },
+	{ "row_field_date", row_field_date, nullptr },
+	{ "row_field_time", row_field_time, nullptr },
+	{ "row_field_set", row_field_set, nullptr },
+	{ "rowset_buffered", rowset_buffered, nullptr },
+	{ "rowset_fwd", rowset_fwd, nullptr },
+	{ "query_meta_build", query_meta_build, nullptr },
+	{ "expr_parse", expr_parse, nullptr },
+	{ "doc_decode", doc_decode, nullptr },
+	{ "compress_zstd", compress_zstd, compression::is_compressor_zstd_available },
+	{ "compress_lz4", compress_lz4, compression::is_compressor_lz4_available },
+	{ "compress_zlib", compress_zlib, compression::is_compressor_zlib_available },
+	{ "ps_cache_lookup", ps_cache_lookup, nullptr },
+};
+
+double get_ns_per_op(const Benchmark_result& result)
+{
+	const auto elapsed_ns{ std::chrono::duration_cast<std::chrono::nanoseconds>(result.elapsed).count() };
+	return result.operations ? static_cast<double>(elapsed_ns) / result.operations : 0.0;
+}
+
+/*
+	A warm-up run, then the timed runs - the median of them is reported as the
+	result, as it is much less noisy than the mean. The allocations are counted in
+	one more run at the end.
+*/
+util::zvalue run_case(const Benchmark_case& benchmark_case, std::size_t iterations, std::size_t repeats)
+{
+	benchmark_case.run(std::max<std::size_t>(iterations / 10, 1));
+
+	util::vector<Benchmark_result> results;
+	for (std::size_t i{0}; i < repeats; ++i) {
+		results.push_back(benchmark_case.run(iterations));
+	}
+	std::sort(results.begin(), results.end(),
+		[](const Benchmark_result& lhs, const Benchmark_result& rhs) { return lhs.elapsed < rhs.elapsed; });
+	const Benchmark_result& median{ results[results.size() / 2] };
+
+	Benchmark_result counted_result{};
+	{
+		Allocation_counter allocation_counter;
+		counted_result = benchmark_case.run(iterations);
+	}
+
+	const uint64_t total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(median.elapsed).count();
+	return {
+		{ "case", benchmark_case.name },
+		{ "iterations", static_cast<uint64_t>(iterations) },
+		{ "repeats", static_cast<uint64_t>(repeats) },
+		{ "operations", static_cast<uint64_t>(median.operations) },
+		{ "total_ns", total_ns },
+		{ "ns_per_op", get_ns_per_op(median) },
+		{ "min_ns_per_op", get_ns_per_op(results.front()) },
+		{ "allocations_per_op", counted_result.operations
+			? static_cast<double>(counted_result.allocations) / counted_result.operations
+			: 0.0 }
+	};
+}
+
+} // anonymous namespace
+
+MYSQL_XDEVAPI_PHP_FUNCTION(mysql_xdevapi__benchmark)
+{
+	util::arg_string case_name;
+	zend_long iterations{100000};
+	zend_long repeats{5};
+
+	DBG_ENTER("mysql_xdevapi__benchmark");
+	if (FAILURE == util::get_function_arguments(execute_data, "s|ll",
+		&case_name.str, &case_name.len,
+		&iterations,
+		&repeats))
+	{
+		DBG_VOID_RETURN;
+	}
+
+	if (iterations <= 0) {
+		throw util::xdevapi_exception(util::xdevapi_exception::Code::invalid_argument, "iterations must be positive");
+	}
+
+	if (repeats <= 0) {
+		throw util::xdevapi_exception(util::xdevapi_exception::Code::invalid_argument, "repeats must be positive");
+	}
+
+	if (case_name.to_view() == "all") {
+		util::zvalue reports(util::zvalue::create_array());
+		for (const Benchmark_case& benchmark_case : benchmark_cases) {
+			if (benchmark_case.is_available && !benchmark_case.is_available()) continue;
+			reports.push_back(run_case(benchmark_case, static_cast<std::size_t>(iterations), static_cast<std::size_t>(repeats)));
+		}
+		reports.move_to(return_value);
+		DBG_VOID_RETURN;
+	}
+
+	for (const Benchmark_case& benchmark_case : benchmark_cases) {
+		if (benchmark_case.name != case_name.to_view()) continue;
+
+		if (benchmark_case.is_available && !benchmark_case.is_available()) {
+			throw util::xdevapi_exception(util::xdevapi_exception::Code::runtime_error, "benchmark case not available in this build");
+		}
+
+		util::zvalue report(run_case(benchmark_case, static_cast<std::size_t>(iterations), static_cast<std::size_t>(repeats)));
+		report.move_to(return_value);
+		DBG_VOID_RETURN;
+	}
+
+	throw util::xdevapi_exception(util::xdevapi_exception::Code::invalid_argument, "unknown benchmark case");
+}
+
+#endif // MYSQL_XDEVAPI_DEV_MODE
+
+} // namespace devapi
+
+} // namespace mysqlx
@@ -0,0 +1,41 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Filip Janiszewski <fjanisze@php.net>                        |
+  |          Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#ifndef MYSQLX_BENCHMARK_H
+#define MYSQLX_BENCHMARK_H
+
+namespace mysqlx {
+
+namespace devapi {
+
+#ifdef MYSQL_XDEVAPI_DEV_MODE
+
+/*
+	Developer mode only - runs one of the built-in benchmarks of the driver hot
+	paths (or "all" of them) and returns its report, which json_encode turns into
+	something a CI job can track. Rowsets are fetched from an in-process server.
+*/
+PHP_FUNCTION(mysql_xdevapi__benchmark);
+
+#endif
+
+} // namespace devapi
+
+} // namespace mysqlx
+
+#endif /* MYSQLX_BENCHMARK_H */
@@ -19,17 +19,21 @@
 #include "mysqlnd_api.h"
 #include "xmysqlnd/xmysqlnd_session.h"
 #include "mysqlx_class_properties.h"
+#include "mysqlx_object.h"
 #include "mysqlx_session.h"
+#include "mysqlx_sql_statement.h"
 #include "util/allocator.h"
 #include "util/exceptions.h"
 #include "util/functions.h"
 #include "util/json_utils.h"
 #include "util/object.h"
 #include "util/string_utils.h"
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 namespace mysqlx {
 
@@ -53,6 +57,8 @@ struct Connection_pool_options {
 struct Client_options
 {
 	Connection_pool_options conn_pool_options;
+	// ms, 0 disables the metadata cache
+	int metadata_cache_ttl{ 0 };
 }; // Client_options
 
 //------------------------------------------------------------------------------
@@ -121,7 +127,8 @@ void Client_options_parser::verify_option(const std::string& option_name)
 		"enabled",
   		"maxSize",
   		"maxIdleTime",
-  		"queueTimeOut"
+  		"queueTimeOut",
+		"metadataCacheTtl"
 	};
 
 	if (!allowed_options.count(option_name)) {
@@ -140,6 +147,7 @@ void Client_options_parser::assign_options()
 	assign_option("maxSize", pool_options.max_size, [](int val){ return 0 < val; });
 	assign_option("maxIdleTime", pool_options.max_idle_time, [](int val){ return 0 <= val; });
 	assign_option("queueTimeOut", pool_options.queue_timeout, [](int val){ return 0 <= val; });
+	assign_option("metadataCacheTtl", client_options.metadata_cache_ttl, [](int val){ return 0 <= val; });
 }
 
 template<typename T, typename Value_checker>
@@ -216,7 +224,8 @@ class Connection_pool
 public:
 	Connection_pool(
 		const std::string& uri,
-		const Connection_pool_options& options);
+		const Connection_pool_options& options,
+		std::shared_ptr<drv::Schema_cache> schema_cache);
 	~Connection_pool();
 
 public:
@@ -224,6 +233,9 @@ public:
 
 	void prune_expired_connections();
 	void close();
+	void invalidate_metadata_cache();
+	// 0 if the number of connections isn't limited
+	std::size_t get_max_size() const;
 
 private:
 	bool is_full() const;
@@ -255,6 +267,8 @@ private:
 	const std::size_t max_size;
 	const std::chrono::milliseconds max_idle_time;
 	const std::chrono::milliseconds queue_timeout;
+	// shared by all the connections, nullptr if disabled
+	const std::shared_ptr<drv::Schema_cache> schema_cache;
 
 	using Active_connections = std::set<drv::XMYSQLND_SESSION>;
 	Active_connections active_connections;
@@ -269,12 +283,14 @@ private:
 
 Connection_pool::Connection_pool(
 	const std::string& uri,
-	const Connection_pool_options& options)
+	const Connection_pool_options& options,
+	std::shared_ptr<drv::Schema_cache> schema_cache)
 	: connection_uri(uri)
 	, pooling_disabled(!options.enabled)
 	, max_size(static_cast<std::size_t>(options.max_size))
 	, max_idle_time(options.max_idle_time)
 	, queue_timeout(options.queue_timeout)
+	, schema_cache(schema_cache)
 {
 }
 
@@ -327,8 +343,20 @@ void Connection_pool::close()
 	close_idle_connections();
 }
 
+void Connection_pool::invalidate_metadata_cache()
+{
+	if (schema_cache) {
+		schema_cache->invalidate();
+	}
+}
+
 // ---------
 
+std::size_t Connection_pool::get_max_size() const
+{
+	return pooling_disabled ? 0 : max_size;
+}
+
 bool Connection_pool::is_full() const
 {
 	const std::size_t connections_count{ active_connections.size() + idle_connections.size() };
@@ -353,6 +381,7 @@ drv::XMYSQLND_SESSION Connection_pool::create_new_connection(const bool persiste
 	if (drv::connect_session(connection_uri.c_str(), connection) == FAIL) {
 		throw util::xdevapi_exception(util::xdevapi_exception::Code::connection_failure);
 	}
+	connection->get_data()->schema_cache = schema_cache;
 	return connection;
 }
 
@@ -398,7 +427,11 @@ drv::XMYSQLND_SESSION Connection_pool::pop_idle_connection()
 
 drv::XMYSQLND_SESSION Connection_pool::try_pop_idle_connection(std::unique_lock<std::mutex>& lck)
 {
-	if (wait_for_idle_connection(lck)) return pop_idle_connection();
+	const drv::Perf_clock::time_point wait_started{
+		drv::xmysqlnd_get_perf_statistics() ? drv::Perf_clock::now() : drv::Perf_clock::time_point() };
+	const bool got_idle_connection{ wait_for_idle_connection(lck) };
+	drv::xmysqlnd_perf_record_latency(drv::XMYSQLND_PERF_OP_POOL_WAIT, wait_started);
+	if (got_idle_connection) return pop_idle_connection();
 
 	util::ostringstream os;
 	os << "Couldn't get connection from pool - queue timeout elapsed " << connection_uri.c_str();
@@ -461,7 +494,12 @@ struct Client_state : public util::permanent_allocable
 Client_state::Client_state(
 	const std::string& uri,
 	const Client_options& client_options)
-	: conn_pool(uri, client_options.conn_pool_options)
+	: conn_pool(
+		uri,
+		client_options.conn_pool_options,
+		client_options.metadata_cache_ttl
+			? std::make_shared<drv::Schema_cache>(std::chrono::milliseconds(client_options.metadata_cache_ttl))
+			: nullptr)
 {
 }
 
@@ -558,6 +596,117 @@ Connection_pool& fetch_connection_pool(util::raw_zval* from)
 
 //------------------------------------------------------------------------------
 
+// statements sent on a session before the response to the first of them is read
+const std::size_t Parallel_statements_per_session{ 2 };
+
+util::zvalue prepare_parallel_statement(
+	drv::XMYSQLND_SESSION& session,
+	const util::zvalue& statement)
+{
+	util::zvalue query;
+	util::zvalue params;
+	if (statement.is_string()) {
+		query = statement;
+	} else if (statement.is_array() && (statement.size() <= 2)) {
+		query = statement.find(std::size_t{0});
+		params = statement.find(std::size_t{1});
+	}
+	if (!query.is_string() || (query.to_string_view().empty())
+		|| !(params.is_undef() || params.is_array()))
+	{
+		throw util::xdevapi_exception(
+			util::xdevapi_exception::Code::invalid_argument,
+			"statement must be a query string or an array [query, params]");
+	}
+
+	drv::xmysqlnd_stmt* stmt{ session->create_statement_object(session) };
+	if (!stmt) {
+		throw util::xdevapi_exception(util::xdevapi_exception::Code::runtime_error, "cannot create statement");
+	}
+	util::zvalue sql_stmt{ create_sql_stmt(stmt, drv::namespace_sql, query.to_string_view()) };
+	if (params.is_array()) {
+		for (const auto& param : params.values()) {
+			if (!mysqlx_sql_statement_bind_one_param(sql_stmt.ptr(), param)) {
+				throw util::xdevapi_exception(util::xdevapi_exception::Code::invalid_argument, "cannot bind statement param");
+			}
+		}
+	}
+	return sql_stmt;
+}
+
+void read_parallel_result(util::zvalue& sql_stmt, util::zvalue& results)
+{
+	util::zvalue result{ mysqlx_sql_statement_read_pipelined_result(sql_stmt.ptr()) };
+	if (result.is_undef()) {
+		result = nullptr;
+	}
+	results.push_back(std::move(result));
+}
+
+/*
+	The statements are spread round-robin over sessions taken from the pool, and
+	each session gets the next statement as soon as a response to one of its
+	former ones is read, so there are up to Parallel_statements_per_session in
+	flight on every session, and the server executes them concurrently. The
+	responses are read in the order of the statements.
+*/
+util::zvalue execute_parallel(
+	Connection_pool& conn_pool,
+	const util::zvalue& statements,
+	const std::size_t concurrency)
+{
+	DBG_ENTER("execute_parallel");
+	const std::size_t statements_count{ statements.size() };
+	util::zvalue results{ util::zvalue::create_array(statements_count) };
+	if (statements_count == 0) {
+		DBG_RETURN(results);
+	}
+
+	std::size_t sessions_count{ std::min(concurrency, statements_count) };
+	const std::size_t pool_max_size{ conn_pool.get_max_size() };
+	if (pool_max_size) {
+		sessions_count = std::min(sessions_count, pool_max_size);
+	}
+
+	// the session objects give the connections back to the pool when destroyed
+	std::vector<util::zvalue> session_objects;
+	std::vector<drv::XMYSQLND_SESSION> sessions;
+	for (std::size_t i{0}; i < sessions_count; ++i) {
+		drv::XMYSQLND_SESSION session{ conn_pool.get_connection() };
+		session_objects.push_back(create_session(session));
+		sessions.push_back(session);
+	}
+
+	// everything is checked before the first statement goes out
+	std::vector<util::zvalue> sql_stmts;
+	sql_stmts.reserve(statements_count);
+	for (const auto& statement : statements.values()) {
+		sql_stmts.push_back(prepare_parallel_statement(sessions[sql_stmts.size() % sessions_count], statement));
+	}
+
+	const std::size_t window{ sessions_count * Parallel_statements_per_session };
+	const zend_long flags{ MYSQLX_EXECUTE_FLAG_ASYNC | MYSQLX_EXECUTE_FLAG_BUFFERED };
+	std::size_t next_to_read{0};
+	for (std::size_t i{0}; i < statements_count; ++i) {
+		if (i >= window) {
+			// the response that frees a slot on the session of statement i
+			read_parallel_result(sql_stmts[next_to_read++], results);
+		}
+		mysqlx_sql_statement_execute(Z_MYSQLX_P(sql_stmts[i].ptr()), flags);
+	}
+	/*
+		after a failure the rest is read too, so that no response is left
+		behind on the sessions returned to the pool
+	*/
+	while (next_to_read < statements_count) {
+		read_parallel_result(sql_stmts[next_to_read++], results);
+	}
+
+	DBG_RETURN(results);
+}
+
+//------------------------------------------------------------------------------
+
 zend_class_entry* client_class_entry;
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_client__construct, 0, ZEND_RETURN_VALUE, 0)
@@ -569,6 +718,14 @@ ZEND_END_ARG_INFO()
 ZEND_BEGIN_ARG_INFO_EX(arginfo_client__close, 0, ZEND_RETURN_VALUE, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_client__invalidate_metadata_cache, 0, ZEND_RETURN_VALUE, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_client__execute_parallel, 0, ZEND_RETURN_VALUE, 1)
+	ZEND_ARG_TYPE_INFO(no_pass_by_ref, statements, IS_ARRAY, dont_allow_null)
+	ZEND_ARG_TYPE_INFO(no_pass_by_ref, concurrency, IS_LONG, dont_allow_null)
+ZEND_END_ARG_INFO()
+
 
 MYSQL_XDEVAPI_PHP_METHOD(mysqlx_client, __construct)
 {
@@ -610,10 +767,58 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_client, close)
 	DBG_VOID_RETURN;
 }
 
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_client, invalidateMetadataCache)
+{
+	DBG_ENTER("mysqlx_client::invalidateMetadataCache");
+
+	util::raw_zval* object_zv{nullptr};
+	if (util::get_method_arguments(
+		execute_data, getThis(),
+		"O", &object_zv, client_class_entry) == FAILURE) {
+		DBG_VOID_RETURN;
+	}
+
+	auto& conn_pool{ fetch_connection_pool(object_zv) };
+	conn_pool.invalidate_metadata_cache();
+
+	DBG_VOID_RETURN;
+}
+
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_client, executeParallel)
+{
+	DBG_ENTER("mysqlx_client::executeParallel");
+
+	util::raw_zval* object_zv{nullptr};
+	util::raw_zval* statements{nullptr};
+	zend_long concurrency{4};
+	if (util::get_method_arguments(
+		execute_data, getThis(),
+		"Oa|l", &object_zv, client_class_entry,
+		&statements, &concurrency) == FAILURE) {
+		DBG_VOID_RETURN;
+	}
+
+	if (concurrency <= 0) {
+		throw util::xdevapi_exception(
+			util::xdevapi_exception::Code::invalid_argument,
+			"concurrency must be a positive number");
+	}
+
+	auto& conn_pool{ fetch_connection_pool(object_zv) };
+	util::zvalue results{ execute_parallel(conn_pool, util::zvalue(statements), static_cast<std::size_t>(concurrency)) };
+	if (!EG(exception)) {
+		results.move_to(return_value);
+	}
+
+	DBG_VOID_RETURN;
+}
+
 const zend_function_entry client_methods[] = {
 	PHP_ME(mysqlx_client, __construct, arginfo_client__construct, ZEND_ACC_PRIVATE)
 	PHP_ME(mysqlx_client, getSession, arginfo_client__get_session, ZEND_ACC_PUBLIC)
 	PHP_ME(mysqlx_client, close, arginfo_client__close, ZEND_ACC_PUBLIC)
+	PHP_ME(mysqlx_client, invalidateMetadataCache, arginfo_client__invalidate_metadata_cache, ZEND_ACC_PUBLIC)
+	PHP_ME(mysqlx_client, executeParallel, arginfo_client__execute_parallel, ZEND_ACC_PUBLIC)
 	{nullptr, nullptr, nullptr}
 };
 
@@ -22,6 +22,8 @@
 #include "xmysqlnd/xmysqlnd_collection.h"
 #include "xmysqlnd/xmysqlnd_schema.h"
 #include "xmysqlnd/xmysqlnd_session.h"
+#include "xmysqlnd/xmysqlnd_stmt_execution_state.h"
+#include "xmysqlnd/xmysqlnd_stmt_result.h"
 #include "php_mysqlx.h"
 #include "mysqlx_class_properties.h"
 #include "mysqlx_exception.h"
@@ -33,12 +35,14 @@
 #include "mysqlx_collection_index.h"
 #include "mysqlx_collection.h"
 #include "mysqlx_doc_result.h"
+#include "mysqlx_result.h"
 #include "mysqlx_schema.h"
 #include "mysqlx_session.h"
+#include "mysqlx_sql_statement.h"
 #include "util/allocator.h"
 #include "util/functions.h"
-#include "util/json_utils.h"
 #include "util/object.h"
+#include "util/strings.h"
 #include <vector>
 
 namespace mysqlx {
@@ -118,6 +122,20 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_collection_remove_one, 0, ZEND_RETURN_VALU
 ZEND_END_ARG_INFO()
 
 
+// multi doc ops
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_collection_get_many, 0, ZEND_RETURN_VALUE, 1)
+	ZEND_ARG_TYPE_INFO(no_pass_by_ref, ids, IS_ARRAY, dont_allow_null)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_collection_remove_many, 0, ZEND_RETURN_VALUE, 1)
+	ZEND_ARG_TYPE_INFO(no_pass_by_ref, ids, IS_ARRAY, dont_allow_null)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_collection_add_or_replace_many, 0, ZEND_RETURN_VALUE, 1)
+	ZEND_ARG_TYPE_INFO(no_pass_by_ref, docs, IS_ITERABLE, dont_allow_null)
+ZEND_END_ARG_INFO()
+
+
 // index ops
 ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_collection__create_index, 0, ZEND_RETURN_VALUE, 2)
 	ZEND_ARG_TYPE_INFO(no_pass_by_ref, index_name, IS_STRING, dont_allow_null)
@@ -368,6 +386,18 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_collection, remove)
 	DBG_VOID_RETURN;
 }
 
+/*
+	getOne, replaceOne and removeOne don't build the regular CRUD operations, the
+	driver sends prebuilt messages with the id and document put straight into them
+*/
+static util::zvalue
+execute_key_statement(xmysqlnd_stmt* stmt, const zend_long flags, const mysqlx_result_type result_type)
+{
+	DBG_ENTER("execute_key_statement");
+	util::zvalue stmt_obj = create_stmt(stmt);
+	DBG_RETURN(mysqlx_statement_execute_read_response(Z_MYSQLX_P(stmt_obj.ptr()), flags, result_type));
+}
+
 MYSQL_XDEVAPI_PHP_METHOD(mysqlx_collection, getOne)
 {
 	DBG_ENTER("mysqlx_collection::getOne");
@@ -384,16 +414,10 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_collection, getOne)
 	}
 
 	auto& data_object = util::fetch_data_object<st_mysqlx_collection>(object_zv);
-
-	Collection_find coll_find;
-	const char* Get_one_search_expression = "_id = :id";
-	if (!coll_find.init(data_object.collection, Get_one_search_expression)) {
-		DBG_VOID_RETURN;
-	}
-
-	util::zvalue bind_variables{{"id", id.to_view()}};
-	if (coll_find.bind(bind_variables)) {
-		const util::zvalue resultset = coll_find.execute();
+	xmysqlnd_stmt* stmt{ data_object.collection->get_one(id.to_view()) };
+	if (stmt) {
+		const util::zvalue resultset = execute_key_statement(
+			stmt, MYSQLX_EXECUTE_FLAG_BUFFERED, MYSQLX_RESULT_DOC);
 		fetch_one_from_doc_result(resultset).move_to(return_value);
 	}
 
@@ -418,22 +442,9 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_collection, replaceOne)
 	}
 
 	auto& data_object = util::fetch_data_object<st_mysqlx_collection>(object_zv);
-
-	Collection_modify coll_modify;
-	const char* Replace_one_search_expression = "$._id = :id";
-	if (!coll_modify.init(data_object.collection, Replace_one_search_expression)) {
-		DBG_VOID_RETURN;
-	}
-
-	util::zvalue bind_variables{{"id", id.to_view()}};
-	if (!coll_modify.bind(bind_variables)) {
-		DBG_VOID_RETURN;
-	}
-
-	const util::string_view Doc_root_path("$");
-	util::zvalue doc_with_id(util::json::ensure_doc_id(doc, id.to_view()));
-	if (coll_modify.set(Doc_root_path, doc_with_id)) {
-		coll_modify.execute().move_to(return_value);
+	xmysqlnd_stmt* stmt{ data_object.collection->replace_one(id.to_view(), util::zvalue(doc)) };
+	if (stmt) {
+		execute_key_statement(stmt, 0, MYSQLX_RESULT).move_to(return_value);
 	}
 
 	DBG_VOID_RETURN;
@@ -459,8 +470,7 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_collection, addOrReplaceOne)
 	auto& data_object = util::fetch_data_object<st_mysqlx_collection>(object_zv);
 
 	Collection_add coll_add;
-	util::zvalue doc_with_id(util::json::ensure_doc_id(doc, id.to_view()));
-	if (coll_add.add_docs(data_object.collection, id.to_view(), doc_with_id)) {
+	if (coll_add.add_docs(data_object.collection, id.to_view(), doc)) {
 		coll_add.execute().move_to(return_value);
 	}
 
@@ -483,17 +493,178 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_collection, removeOne)
 	}
 
 	auto& data_object = util::fetch_data_object<st_mysqlx_collection>(object_zv);
-	Collection_remove coll_remove;
-	const char* Remove_one_search_expression = "_id = :id";
-	if (!coll_remove.init(data_object.collection, Remove_one_search_expression)) {
+	xmysqlnd_stmt* stmt{ data_object.collection->remove_one(id.to_view()) };
+	if (stmt) {
+		execute_key_statement(stmt, 0, MYSQLX_RESULT).move_to(return_value);
+	}
+
+	DBG_VOID_RETURN;
+}
+
+namespace {
+
+/*
+	ids of getMany / removeMany without duplicates - they are sent as string
+	literals, so a number would never match a document, even the one with that
+	number as its id, and is rejected
+*/
+util::strings to_doc_ids(const util::zvalue& raw_ids)
+{
+	util::strings ids;
+	ids.reserve(raw_ids.size());
+	util::stringset known_ids;
+	for (const auto& raw_id : raw_ids.values()) {
+		if (!raw_id.is_string()) {
+			throw util::xdevapi_exception(util::xdevapi_exception::Code::invalid_argument, "document id must be a string");
+		}
+		util::string id{ raw_id.to_string() };
+		if (known_ids.insert(id).second) {
+			ids.push_back(std::move(id));
+		}
+	}
+	return ids;
+}
+
+void fetch_docs_by_id(const util::zvalue& resultset, util::map<util::string, util::zvalue>& docs)
+{
+	st_mysqlx_doc_result& doc_result = util::fetch_data_object<st_mysqlx_doc_result>(resultset);
+	while (FALSE == doc_result.result->m.eof(doc_result.result)) {
+		util::zvalue doc;
+		if (!fetch_current_doc(doc_result.result, doc)) break;
+		const util::zvalue doc_id(doc.find("_id"));
+		if (doc_id.is_string()) {
+			docs[doc_id.to_string()] = doc;
+		}
+		doc_result.result->m.next(doc_result.result, nullptr, nullptr);
+	}
+}
+
+} // anonymous namespace
+
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_collection, getMany)
+{
+	DBG_ENTER("mysqlx_collection::getMany");
+
+	util::raw_zval* object_zv{nullptr};
+	util::raw_zval* raw_ids{nullptr};
+
+	if (FAILURE == util::get_method_arguments(
+		execute_data, getThis(), "Oa",
+		&object_zv, mysqlx_collection_class_entry,
+		&raw_ids))
+	{
+		DBG_VOID_RETURN;
+	}
+
+	auto& data_object = util::fetch_data_object<st_mysqlx_collection>(object_zv);
+	const util::strings ids(to_doc_ids(util::zvalue(raw_ids)));
+
+	util::map<util::string, util::zvalue> found_docs;
+	std::size_t next_id{0};
+	while (next_id < ids.size()) {
+		xmysqlnd_stmt* stmt{ data_object.collection->get_many(ids, next_id) };
+		if (!stmt) {
+			DBG_VOID_RETURN;
+		}
+		const util::zvalue resultset = execute_key_statement(
+			stmt, MYSQLX_EXECUTE_FLAG_BUFFERED, MYSQLX_RESULT_DOC);
+		if (!resultset.is_object()) {
+			DBG_VOID_RETURN;
+		}
+		fetch_docs_by_id(resultset, found_docs);
+	}
+
+	// keyed by id in the order of the ids requested, the ones not found are skipped
+	util::zvalue docs(util::zvalue::create_array(found_docs.size()));
+	for (const auto& id : ids) {
+		auto found_doc{ found_docs.find(id) };
+		if (found_doc == found_docs.end()) continue;
+		util::raw_zval* doc{ found_doc->second.ptr() };
+		Z_TRY_ADDREF_P(doc);
+		zend_symtable_str_update(Z_ARRVAL_P(docs.ptr()), id.data(), id.length(), doc);
+	}
+	docs.move_to(return_value);
+
+	DBG_VOID_RETURN;
+}
+
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_collection, removeMany)
+{
+	DBG_ENTER("mysqlx_collection::removeMany");
+
+	util::raw_zval* object_zv{nullptr};
+	util::raw_zval* raw_ids{nullptr};
+
+	if (FAILURE == util::get_method_arguments(
+		execute_data, getThis(), "Oa",
+		&object_zv, mysqlx_collection_class_entry,
+		&raw_ids))
+	{
+		DBG_VOID_RETURN;
+	}
+
+	auto& data_object = util::fetch_data_object<st_mysqlx_collection>(object_zv);
+	const util::strings ids(to_doc_ids(util::zvalue(raw_ids)));
+
+	// nothing to remove, the server isn't asked at all
+	if (ids.empty()) {
+		XMYSQLND_SESSION session{ data_object.collection->get_schema()->get_session() };
+		st_xmysqlnd_stmt_result* stmt_result{ xmysqlnd_stmt_result_create_empty(
+			session->data->persistent, session->data->object_factory, session->data->stats, session->data->error_info) };
+		if (stmt_result) {
+			create_result(stmt_result).move_to(return_value);
+		}
 		DBG_VOID_RETURN;
 	}
 
-	util::zvalue bind_variables{{"id", id.to_view()}};
-	if (coll_remove.bind(bind_variables)) {
-		coll_remove.execute().move_to(return_value);
+	// the result of the last chunk reports the documents removed by all of them
+	util::zvalue result;
+	st_xmysqlnd_stmt_execution_state* exec_state{nullptr};
+	uint64_t removed_count{0};
+	std::size_t next_id{0};
+	do {
+		xmysqlnd_stmt* stmt{ data_object.collection->remove_many(ids, next_id) };
+		if (!stmt) {
+			DBG_VOID_RETURN;
+		}
+		result = execute_key_statement(stmt, 0, MYSQLX_RESULT);
+		if (!result.is_object()) {
+			DBG_VOID_RETURN;
+		}
+		auto& data_result{ util::fetch_data_object<st_mysqlx_result>(result.ptr()) };
+		st_xmysqlnd_stmt_result* stmt_result{ data_result.get_result() };
+		exec_state = stmt_result ? stmt_result->exec_state : nullptr;
+		if (exec_state) {
+			removed_count += exec_state->m->get_affected_items_count(exec_state);
+		}
+	} while (next_id < ids.size());
+
+	if (exec_state) {
+		exec_state->m->set_affected_items_count(exec_state, removed_count);
+	}
+	result.move_to(return_value);
+
+	DBG_VOID_RETURN;
+}
+
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_collection, addOrReplaceMany)
+{
+	DBG_ENTER("mysqlx_collection::addOrReplaceMany");
+
+	util::raw_zval* object_zv{nullptr};
+	util::raw_zval* docs{nullptr};
+
+	if (FAILURE == util::get_method_arguments(
+		execute_data, getThis(), "Oz",
+		&object_zv, mysqlx_collection_class_entry,
+		&docs))
+	{
+		DBG_VOID_RETURN;
 	}
 
+	auto& data_object = util::fetch_data_object<st_mysqlx_collection>(object_zv);
+	add_or_replace_docs(data_object.collection, util::zvalue(docs)).move_to(return_value);
+
 	DBG_VOID_RETURN;
 }
 
@@ -564,6 +735,10 @@ static const zend_function_entry mysqlx_collection_methods[] = {
 	PHP_ME(mysqlx_collection, addOrReplaceOne, arginfo_mysqlx_collection_add_or_replace_one, ZEND_ACC_PUBLIC)
 	PHP_ME(mysqlx_collection, removeOne, arginfo_mysqlx_collection_remove_one, ZEND_ACC_PUBLIC)
 
+	PHP_ME(mysqlx_collection, getMany, arginfo_mysqlx_collection_get_many, ZEND_ACC_PUBLIC)
+	PHP_ME(mysqlx_collection, removeMany, arginfo_mysqlx_collection_remove_many, ZEND_ACC_PUBLIC)
+	PHP_ME(mysqlx_collection, addOrReplaceMany, arginfo_mysqlx_collection_add_or_replace_many, ZEND_ACC_PUBLIC)
+
 	PHP_ME(mysqlx_collection, createIndex,	arginfo_mysqlx_collection__create_index,	ZEND_ACC_PUBLIC)
 	PHP_ME(mysqlx_collection, dropIndex,	arginfo_mysqlx_collection__drop_index,		ZEND_ACC_PUBLIC)
 
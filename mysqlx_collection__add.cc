@@ -20,26 +20,34 @@
 #include "php_api.h"
 #include "mysqlnd_api.h"
 #include "json_api.h"
+extern "C" {
+#include <zend_interfaces.h>
+}
 #include "xmysqlnd/xmysqlnd.h"
 #include "xmysqlnd/xmysqlnd_session.h"
 #include "xmysqlnd/xmysqlnd_schema.h"
 #include "xmysqlnd/xmysqlnd_stmt.h"
+#include "xmysqlnd/xmysqlnd_stmt_execution_state.h"
+#include "xmysqlnd/xmysqlnd_stmt_result.h"
 #include "xmysqlnd/xmysqlnd_collection.h"
 #include "xmysqlnd/xmysqlnd_crud_collection_commands.h"
 #include "php_mysqlx.h"
 #include "mysqlx_exception.h"
 #include "mysqlx_class_properties.h"
 #include "mysqlx_executable.h"
+#include "mysqlx_result.h"
 #include "mysqlx_sql_statement.h"
 #include "mysqlx_collection__add.h"
 #include "mysqlx_exception.h"
 #include "util/allocator.h"
+#include "util/exceptions.h"
 #include "util/arguments.h"
 #include "util/functions.h"
 #include "util/json_utils.h"
 #include "util/object.h"
 #include "util/strings.h"
 #include "util/string_utils.h"
+#include <memory>
 
 namespace mysqlx {
 
@@ -82,42 +90,27 @@ enum class Add_op_status
 	noop
 };
 
+/*
+	documents are not encoded here, they are serialized straight into
+	the rows of the Insert message while binding, see st_xmysqlnd_crud_collection_op__add::bind_docs
+*/
 Add_op_status
-collection_add_string(
+collection_add_doc(
 	st_xmysqlnd_crud_collection_op__add* add_op,
-	util::zvalue& doc)
+	const util::zvalue& doc,
+	const std::optional<util::string>& doc_id)
 {
-	if( PASS == xmysqlnd_crud_collection_add__add_doc(add_op, doc) ) {
-		return Add_op_status::success;
+	if (doc.is_array() && doc.empty()) {
+		if (doc_id) {
+			throw util::xdevapi_exception(util::xdevapi_exception::Code::json_fail);
+		}
+		return Add_op_status::noop;
 	}
-	return Add_op_status::fail;
-}
 
-Add_op_status
-collection_add_object(
-	st_xmysqlnd_crud_collection_op__add* add_op,
-	util::zvalue& doc)
-{
-	Add_op_status ret = Add_op_status::fail;
-	util::zvalue new_doc(util::json::encode_document(doc));
-	if( PASS == xmysqlnd_crud_collection_add__add_doc(add_op, new_doc) ) {
-		ret = Add_op_status::success;
-	}
-	return ret;
-}
-
-Add_op_status
-collection_add_array(
-	st_xmysqlnd_crud_collection_op__add* add_op,
-	util::zvalue& doc)
-{
-	Add_op_status ret = Add_op_status::fail;
-	if( doc.empty() ) {
-		ret = Add_op_status::noop;
-	} else {
-		ret = collection_add_object(add_op, doc);
-	}
-	return ret;
+	const enum_func_status ret = doc_id
+		? xmysqlnd_crud_collection_add__add_doc(add_op, doc, *doc_id)
+		: xmysqlnd_crud_collection_add__add_doc(add_op, doc);
+	return ret == PASS ? Add_op_status::success : Add_op_status::fail;
 }
 
 } // anonymous namespace
@@ -165,12 +158,17 @@ bool Collection_add::add_docs(
 
 bool Collection_add::add_docs(
 	xmysqlnd_collection* coll,
-	const util::string_view& /*doc_id*/,
+	const util::string_view& doc_id,
 	const util::zvalue& doc)
 {
+	if (!doc.is_string() && !doc.is_array() && !doc.is_object()) {
+		throw util::xdevapi_exception(util::xdevapi_exception::Code::json_fail);
+	}
+
 	const int num_of_documents = 1;
 	util::arg_zvals docs{doc.ptr(), num_of_documents};
 	if (!add_docs(coll, docs)) return false;
+	single_doc_id = util::string(doc_id);
 	return xmysqlnd_crud_collection_add__set_upsert(add_op) == PASS;
 }
 
@@ -192,22 +190,7 @@ util::zvalue Collection_add::execute()
 	size_t noop_cnt{0};
 	Add_op_status ret = Add_op_status::success;
 	for (auto it{docs.begin()}; it != docs.end() && ret != Add_op_status::fail ; ++it) {
-		ret = Add_op_status::fail;
-		util::zvalue doc(*it);
-		switch(doc.type()) {
-		case util::zvalue::Type::String:
-			ret = collection_add_string(add_op, doc);
-			break;
-		case util::zvalue::Type::Array:
-			ret = collection_add_array(add_op, doc);
-			break;
-		case util::zvalue::Type::Object:
-			ret = collection_add_object(add_op, doc);
-			break;
-		default:
-			assert(!"should not happen!");
-			ret = Add_op_status::fail;
-		}
+		ret = collection_add_doc(add_op, *it, single_doc_id);
 		if( ret == Add_op_status::noop ) {
 			++noop_cnt;
 		}
@@ -232,6 +215,178 @@ util::zvalue Collection_add::execute()
 
 //------------------------------------------------------------------------------
 
+namespace {
+
+// ids are keys, so numeric ones come as integers
+util::string to_doc_id(const util::zvalue& key)
+{
+	if (key.is_string()) return key.to_string();
+	if (key.is_long()) {
+		const std::string number{ std::to_string(key.to_long()) };
+		return util::string(number.data(), number.length());
+	}
+	throw util::xdevapi_exception(util::xdevapi_exception::Code::invalid_argument, "document id must be a string");
+}
+
+/*
+	calls add(id, doc) for each [id => doc] of an array or a Traversable (e.g. a
+	generator), stops when add returns false or the Traversable has thrown
+*/
+template<typename Add_doc>
+bool traverse_docs_by_id(const util::zvalue& docs, Add_doc add)
+{
+	if (docs.is_array()) {
+		for (const auto& [key, doc] : docs) {
+			if (!add(to_doc_id(key), doc)) return false;
+		}
+		return true;
+	}
+
+	zend_class_entry* ce{ Z_OBJCE_P(docs.ptr()) };
+	std::unique_ptr<zend_object_iterator, decltype(&zend_iterator_dtor)> iterator(
+		ce->get_iterator(ce, docs.ptr(), 0),
+		&zend_iterator_dtor);
+	if (!iterator) return false;
+
+	if (iterator->funcs->rewind) {
+		iterator->funcs->rewind(iterator.get());
+	}
+	while (!EG(exception) && (iterator->funcs->valid(iterator.get()) == SUCCESS)) {
+		const zval* doc_zv{ iterator->funcs->get_current_data(iterator.get()) };
+		if (!doc_zv || EG(exception)) break;
+
+		util::zvalue key;
+		if (iterator->funcs->get_current_key) {
+			iterator->funcs->get_current_key(iterator.get(), key.ptr());
+			if (EG(exception)) break;
+		} else {
+			key = static_cast<int64_t>(iterator->index);
+		}
+		if (!add(to_doc_id(key), util::zvalue(doc_zv))) return false;
+
+		++iterator->index;
+		iterator->funcs->move_forward(iterator.get());
+	}
+	return !EG(exception);
+}
+
+/*
+	documents of addOrReplaceMany are encoded straight into an upsert Insert, which
+	is sent whenever it gets xmysqlnd.insert_batch_size bytes long, so only one
+	chunk of them exists at a time
+*/
+class Docs_upsert
+{
+public:
+	explicit Docs_upsert(xmysqlnd_collection* coll);
+	Docs_upsert(const Docs_upsert&) = delete;
+	Docs_upsert& operator=(const Docs_upsert&) = delete;
+	~Docs_upsert();
+
+	bool add(const util::string& id, const util::zvalue& doc);
+	bool flush();
+
+	// result of the last chunk, reporting the documents affected by all of them
+	util::zvalue get_result();
+
+private:
+	xmysqlnd_collection* collection;
+	st_xmysqlnd_crud_collection_op__add* add_op{nullptr};
+	std::size_t max_chunk_size{0};
+	std::size_t chunk_size{0};
+	std::size_t chunk_docs_count{0};
+
+	util::zvalue result;
+	uint64_t affected_items_count{0};
+};
+
+Docs_upsert::Docs_upsert(xmysqlnd_collection* coll)
+	: collection(coll)
+{
+	add_op = xmysqlnd_crud_collection_add__create(
+		collection->get_schema()->get_name(),
+		collection->get_name());
+	xmysqlnd_crud_collection_add__set_upsert(add_op);
+
+	const zend_long chunk_size_setting{ MYSQL_XDEVAPI_G(insert_batch_size) };
+	max_chunk_size = chunk_size_setting > 0 ? static_cast<std::size_t>(chunk_size_setting) : 0;
+}
+
+Docs_upsert::~Docs_upsert()
+{
+	xmysqlnd_crud_collection_add__destroy(add_op);
+}
+
+bool Docs_upsert::add(const util::string& id, const util::zvalue& doc)
+{
+	chunk_size += xmysqlnd_crud_collection_add__bind_doc(add_op, doc, id);
+	++chunk_docs_count;
+	if (max_chunk_size && (chunk_size >= max_chunk_size)) {
+		return flush();
+	}
+	return true;
+}
+
+bool Docs_upsert::flush()
+{
+	if (chunk_docs_count == 0) return true;
+
+	xmysqlnd_stmt* stmt = collection->add(add_op);
+	if (!stmt) return false;
+	result = execute_statement(*stmt);
+	if (!result.is_object()) return false;
+
+	auto& data_result{ util::fetch_data_object<st_mysqlx_result>(result.ptr()) };
+	st_xmysqlnd_stmt_result* stmt_result{ data_result.get_result() };
+	st_xmysqlnd_stmt_execution_state* exec_state{ stmt_result ? stmt_result->exec_state : nullptr };
+	if (exec_state) {
+		affected_items_count += exec_state->m->get_affected_items_count(exec_state);
+	}
+
+	xmysqlnd_crud_collection_add__clear_docs(add_op);
+	chunk_size = 0;
+	chunk_docs_count = 0;
+	return true;
+}
+
+util::zvalue Docs_upsert::get_result()
+{
+	if (result.is_object()) {
+		auto& data_result{ util::fetch_data_object<st_mysqlx_result>(result.ptr()) };
+		st_xmysqlnd_stmt_result* stmt_result{ data_result.get_result() };
+		st_xmysqlnd_stmt_execution_state* exec_state{ stmt_result ? stmt_result->exec_state : nullptr };
+		if (exec_state) {
+			exec_state->m->set_affected_items_count(exec_state, affected_items_count);
+		}
+	}
+	return result;
+}
+
+} // anonymous namespace
+
+util::zvalue add_or_replace_docs(
+	drv::xmysqlnd_collection* collection,
+	const util::zvalue& docs)
+{
+	DBG_ENTER("add_or_replace_docs");
+	if (!docs.is_array() && !(docs.is_object() && docs.is_instance_of(zend_ce_traversable))) {
+		throw util::xdevapi_exception(
+			util::xdevapi_exception::Code::invalid_argument,
+			"documents must be an array or a Traversable of id => document");
+	}
+
+	Docs_upsert upsert(collection);
+	const bool all_docs_added{ traverse_docs_by_id(
+		docs,
+		[&upsert](const util::string& id, const util::zvalue& doc) { return upsert.add(id, doc); }) };
+	if (!all_docs_added || !upsert.flush()) {
+		DBG_RETURN(util::zvalue());
+	}
+	DBG_RETURN(upsert.get_result());
+}
+
+//------------------------------------------------------------------------------
+
 
 MYSQL_XDEVAPI_PHP_METHOD(mysqlx_collection__add, __construct)
 {
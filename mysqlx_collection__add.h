@@ -60,11 +60,21 @@ private:
 	drv::xmysqlnd_collection* collection{nullptr};
 	drv::st_xmysqlnd_crud_collection_op__add* add_op{nullptr};
 	util::zvalues docs;
+	// set for upsert of single doc (addOrReplaceOne), injected while encoding
+	std::optional<util::string> single_doc_id;
 };
 
 util::zvalue create_collection_add(
 	drv::xmysqlnd_collection* schema,
 	const util::arg_zvals& docs);
+
+/*
+	upserts [id => doc] pairs of an array or a Traversable in chunks, returns the
+	result of the last chunk with the count of documents affected by all of them
+*/
+util::zvalue add_or_replace_docs(
+	drv::xmysqlnd_collection* collection,
+	const util::zvalue& docs);
 void mysqlx_register_collection__add_class(INIT_FUNC_ARGS, zend_object_handlers* mysqlx_std_object_handlers);
 void mysqlx_unregister_collection__add_class(SHUTDOWN_FUNC_ARGS);
 
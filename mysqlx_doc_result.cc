@@ -35,6 +35,7 @@
 #include "mysqlx_base_result.h"
 #include "util/allocator.h"
 #include "util/arguments.h"
+#include "util/exceptions.h"
 #include "util/functions.h"
 #include "util/object.h"
 #include "util/string_utils.h"
@@ -62,6 +63,30 @@ ZEND_END_ARG_INFO()
 ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_doc_result__get_warnings, 0, ZEND_RETURN_VALUE, 0)
 ZEND_END_ARG_INFO()
 
+namespace {
+
+/*
+	Collection.find() returns the documents in the `doc` column, they are decoded
+	straight from the cell, without building the whole row first. The meta looks the
+	column up once, a result set without it is not one of documents. No meta means
+	no result set, so there is nothing to fetch either.
+*/
+bool get_doc_field(drv::st_xmysqlnd_stmt_result* result, unsigned int* doc_field)
+{
+	drv::st_xmysqlnd_stmt_result_meta* meta{ result->meta };
+	if (!meta) {
+		return false;
+	}
+	if (!meta->m->find_doc_field(meta, doc_field)) {
+		util::raise_xdevapi_exception(util::xdevapi_exception(
+			util::xdevapi_exception::Code::fetch_fail, "result has no doc column"));
+		return false;
+	}
+	return true;
+}
+
+} // anonymous namespace
+
 st_mysqlx_doc_result::~st_mysqlx_doc_result()
 {
 	xmysqlnd_stmt_result_free(result, nullptr, nullptr);
@@ -87,9 +112,9 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_doc_result, fetchOne)
 	auto& data_object{ util::fetch_data_object<st_mysqlx_doc_result>(object_zv) };
 	drv::st_xmysqlnd_stmt_result* result{ data_object.result};
 	if (FALSE == data_object.result->m.eof(result)) {
-		util::zvalue row;
-		if (PASS == data_object.result->m.fetch_current(result, row.ptr(), nullptr, nullptr)) {
-			xmysqlnd_utils_decode_doc_row(row).move_to(return_value);
+		util::zvalue doc;
+		if (fetch_current_doc(result, doc)) {
+			doc.move_to(return_value);
 			data_object.result->m.next(result, nullptr, nullptr);
 		}
 	}
@@ -110,9 +135,12 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_doc_result, fetchAll)
 
 	auto& data_object{ util::fetch_data_object<st_mysqlx_doc_result>(object_zv) };
 	if (data_object.result) {
-		util::zvalue set;
-		if (PASS == data_object.result->m.fetch_all(data_object.result, set.ptr(), nullptr, nullptr)) {
-			xmysqlnd_utils_decode_doc_rows(set).move_to(return_value);
+		util::zvalue raw_docs;
+		unsigned int doc_field{0};
+		if (get_doc_field(data_object.result, &doc_field)
+			&& (PASS == data_object.result->m.fetch_all_field(data_object.result, doc_field, raw_docs.ptr(), nullptr, nullptr)))
+		{
+			xmysqlnd_utils_decode_docs(raw_docs).move_to(return_value);
 		}
 	}
 	util::zvalue::ensure_is_array(return_value);
@@ -266,15 +294,28 @@ util::zvalue fetch_one_from_doc_result(const util::zvalue& resultset) {
 		DBG_RETURN(row);
 	}
 
-	util::zvalue encoded_row;
-	if (PASS == doc_result.result->m.fetch_current(doc_result.result, encoded_row.ptr(), nullptr, nullptr)) {
-		row = xmysqlnd_utils_decode_doc_row(encoded_row);
+	if (fetch_current_doc(doc_result.result, row)) {
 		doc_result.result->m.next(doc_result.result, nullptr, nullptr);
 	}
 
 	DBG_RETURN(row);
 }
 
+bool fetch_current_doc(drv::st_xmysqlnd_stmt_result* result, util::zvalue& doc)
+{
+	DBG_ENTER("fetch_current_doc");
+	unsigned int doc_field{0};
+	if (!get_doc_field(result, &doc_field)) {
+		DBG_RETURN(false);
+	}
+	util::zvalue raw_doc;
+	if (PASS != result->m.fetch_current_field(result, doc_field, raw_doc.ptr(), nullptr, nullptr)) {
+		DBG_RETURN(false);
+	}
+	doc = xmysqlnd_utils_decode_doc(raw_doc);
+	DBG_RETURN(true);
+}
+
 } // namespace devapi
 
 } // namespace mysqlx
@@ -41,6 +41,7 @@ void mysqlx_register_doc_result_class(INIT_FUNC_ARGS, zend_object_handlers* mysq
 void mysqlx_unregister_doc_result_class(SHUTDOWN_FUNC_ARGS);
 
 util::zvalue fetch_one_from_doc_result(const util::zvalue& resultset);
+bool fetch_current_doc(drv::st_xmysqlnd_stmt_result* result, util::zvalue& doc);
 
 } // namespace devapi
 
@@ -22,7 +22,6 @@ extern "C" {
 }
 #include "xmysqlnd/xmysqlnd.h"
 #include "xmysqlnd/xmysqlnd_stmt_result.h"
-#include "xmysqlnd/xmysqlnd_utils.h"
 #include "mysqlx_doc_result.h"
 #include "mysqlx_object.h"
 #include "mysqlx_class_properties.h"
@@ -88,11 +87,7 @@ XMYSQLND_METHOD(mysqlx_doc_result_iterator, fetch_current_data)(zend_object_iter
 	if (iterator->result && iterator->usable) {
 		iterator->current_row.reset();
 
-		util::zvalue current_row;
-		if (PASS == iterator->result->m.fetch_current(iterator->result, current_row.ptr(), nullptr, nullptr) &&
-			 current_row.is_array())
-		{
-			iterator->current_row = xmysqlnd_utils_decode_doc_row(current_row);
+		if (fetch_current_doc(iterator->result, iterator->current_row)) {
 			DBG_RETURN(PASS);
 		} else {
 			DBG_RETURN(FAIL);
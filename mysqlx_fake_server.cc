@@ -0,0 +1,249 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#include "php_api.h"
+#include "mysqlnd_api.h"
+#include "php_mysqlx.h"
+#include "xmysqlnd/xmysqlnd_fake_server.h"
+#include "mysqlx_fake_server.h"
+#include "util/arguments.h"
+#include "util/exceptions.h"
+#include "util/functions.h"
+#include "util/json_utils.h"
+#include "util/value.h"
+#include <memory>
+#include <string>
+
+namespace mysqlx {
+
+namespace devapi {
+
+#ifdef MYSQL_XDEVAPI_DEV_MODE
+
+using namespace drv;
+
+namespace {
+
+[[noreturn]] void throw_invalid_option(const std::string& msg)
+{
+	throw util::xdevapi_exception(util::xdevapi_exception::Code::invalid_argument, msg);
+}
+
+Fake_column_type infer_column_type(const util::zvalue& value)
+{
+	if (value.is_long()) return Fake_column_type::sint;
+	if (value.is_double()) return Fake_column_type::real;
+	if (value.is_bool()) return Fake_column_type::uint;
+	if (value.is_array() || value.is_object()) return Fake_column_type::json;
+	return Fake_column_type::bytes;
+}
+
+Fake_value to_fake_value(const util::zvalue& value, Fake_column_type column_type)
+{
+	if (value.is_null()) return Fake_value();
+
+	switch (column_type) {
+		case Fake_column_type::sint:
+			return Fake_value(value.to_int64());
+
+		case Fake_column_type::uint:
+			return Fake_value(value.to_uint64());
+
+		case Fake_column_type::real:
+			return Fake_value(value.to_double());
+
+		case Fake_column_type::json: {
+			std::string json;
+			util::json::encode_document(value, json);
+			return Fake_value(json);
+		}
+
+		case Fake_column_type::bytes:
+			return Fake_value(value.to_std_string());
+	}
+	return Fake_value();
+}
+
+/*
+	[ 'columns' => [names], 'rows' => [[values]], 'rows_affected' => n,
+	  'error' => [code, message], 'latency_us' => n ]
+	column types follow the first non-null value in the column
+*/
+Fake_response to_fake_response(const util::zvalue& options)
+{
+	if (!options.is_array()) throw_invalid_option("fake server response must be an array");
+
+	Fake_response response;
+
+	const util::zvalue columns(options.find("columns"));
+	if (columns.is_array()) {
+		for (const auto& column_name : columns.values()) {
+			response.columns.push_back({ column_name.to_std_string(), Fake_column_type::bytes });
+		}
+	}
+
+	const util::zvalue rows(options.find("rows"));
+	if (rows.is_array()) {
+		std::vector<bool> type_known(response.columns.size(), false);
+		for (const auto& row : rows.values()) {
+			if (!row.is_array() || (row.size() != response.columns.size())) {
+				throw_invalid_option("fake server row must be an array with a value per column");
+			}
+			std::size_t i{0};
+			for (const auto& value : row.values()) {
+				if (!type_known[i] && !value.is_null()) {
+					response.columns[i].type = infer_column_type(value);
+					type_known[i] = true;
+				}
+				++i;
+			}
+		}
+
+		for (const auto& row : rows.values()) {
+			std::vector<Fake_value> fake_row;
+			std::size_t i{0};
+			for (const auto& value : row.values()) {
+				fake_row.push_back(to_fake_value(value, response.columns[i++].type));
+			}
+			response.rows.push_back(std::move(fake_row));
+		}
+	}
+
+	const util::zvalue rows_affected(options.find("rows_affected"));
+	if (!rows_affected.is_undef()) {
+		response.rows_affected = rows_affected.to_uint64();
+	}
+
+	const util::zvalue error(options.find("error"));
+	if (!error.is_undef()) {
+		if (!error.is_array() || (error.size() != 2)) {
+			throw_invalid_option("fake server error must be an array [code, message]");
+		}
+		response.error_code = error.find(std::size_t{0}).to_uint();
+		response.error_message = error.find(std::size_t{1}).to_std_string();
+		if (response.error_code == 0) throw_invalid_option("fake server error code must be non-zero");
+	}
+
+	const util::zvalue latency_us(options.find("latency_us"));
+	if (!latency_us.is_undef()) {
+		response.latency_us = latency_us.to_int64();
+	}
+
+	return response;
+}
+
+Fake_server_config to_fake_server_config(const util::zvalue& options)
+{
+	Fake_server_config config;
+	if (options.is_undef() || options.is_null()) return config;
+
+	const util::zvalue host(options.find("host"));
+	if (!host.is_undef()) config.host = host.to_std_string();
+
+	const util::zvalue port(options.find("port"));
+	if (!port.is_undef()) {
+		const int64_t port_value{ port.to_int64() };
+		if ((port_value < 0) || (port_value > 65535)) throw_invalid_option("fake server port out of range");
+		config.port = static_cast<unsigned int>(port_value);
+	}
+
+	const util::zvalue socket(options.find("socket"));
+	if (!socket.is_undef()) config.socket = socket.to_std_string();
+
+	const util::zvalue latency_us(options.find("latency_us"));
+	if (!latency_us.is_undef()) {
+		const int64_t latency_value{ latency_us.to_int64() };
+		if (latency_value < 0) throw_invalid_option("fake server latency must not be negative");
+		config.latency_us = static_cast<uint64_t>(latency_value);
+	}
+
+	const util::zvalue server_version(options.find("server_version"));
+	if (!server_version.is_undef()) config.server_version = server_version.to_std_string();
+
+	const util::zvalue node_type(options.find("node_type"));
+	if (!node_type.is_undef()) config.node_type = node_type.to_std_string();
+
+	const util::zvalue responses(options.find("responses"));
+	if (!responses.is_undef()) {
+		if (!responses.is_array()) throw_invalid_option("fake server responses must be an array");
+		for (const auto& [key, response] : responses) {
+			config.responses[key.to_std_string()] = to_fake_response(response);
+		}
+	}
+
+	return config;
+}
+
+} // anonymous namespace
+
+MYSQL_XDEVAPI_PHP_FUNCTION(mysql_xdevapi__startFakeServer)
+{
+	zval* options{nullptr};
+
+	DBG_ENTER("mysql_xdevapi__startFakeServer");
+	if (FAILURE == util::get_function_arguments(execute_data, "|a", &options)) {
+		DBG_VOID_RETURN;
+	}
+
+	const Fake_server_config config(to_fake_server_config(util::zvalue(options)));
+
+	mysqlx_release_fake_server(MYSQL_XDEVAPI_G(fake_server));
+	std::unique_ptr<Fake_server> fake_server(new Fake_server(config));
+	if (!fake_server->start()) {
+		throw util::xdevapi_exception(
+			util::xdevapi_exception::Code::runtime_error,
+			"cannot start fake server: " + fake_server->get_error());
+	}
+
+	util::zvalue address(config.socket.empty()
+		? util::zvalue{
+			{ "host", config.host },
+			{ "port", static_cast<zend_long>(fake_server->get_port()) } }
+		: util::zvalue{
+			{ "socket", config.socket } });
+	MYSQL_XDEVAPI_G(fake_server) = fake_server.release();
+
+	address.move_to(return_value);
+	DBG_VOID_RETURN;
+}
+
+MYSQL_XDEVAPI_PHP_FUNCTION(mysql_xdevapi__stopFakeServer)
+{
+	DBG_ENTER("mysql_xdevapi__stopFakeServer");
+	if (FAILURE == util::get_function_arguments(execute_data, "")) {
+		DBG_VOID_RETURN;
+	}
+
+	const bool was_running{ MYSQL_XDEVAPI_G(fake_server) != nullptr };
+	mysqlx_release_fake_server(MYSQL_XDEVAPI_G(fake_server));
+	RETVAL_BOOL(was_running);
+	DBG_VOID_RETURN;
+}
+
+void mysqlx_release_fake_server(drv::Fake_server*& fake_server)
+{
+	if (!fake_server) return;
+	fake_server->stop();
+	delete fake_server;
+	fake_server = nullptr;
+}
+
+#endif // MYSQL_XDEVAPI_DEV_MODE
+
+} // namespace devapi
+
+} // namespace mysqlx
@@ -0,0 +1,52 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#ifndef MYSQLX_FAKE_SERVER_H
+#define MYSQLX_FAKE_SERVER_H
+
+namespace mysqlx {
+
+namespace drv { class Fake_server; }
+
+namespace devapi {
+
+#ifdef MYSQL_XDEVAPI_DEV_MODE
+
+/*
+	Developer mode only - starts the fake X Protocol server of the current thread
+	(or process) with the given listening address, latency and scripted responses,
+	replacing the one started before. Returns the address it listens on, so that
+	getSession can target it.
+*/
+PHP_FUNCTION(mysql_xdevapi__startFakeServer);
+
+/*
+	Developer mode only - stops the fake X Protocol server, returns false if there
+	was none running
+*/
+PHP_FUNCTION(mysql_xdevapi__stopFakeServer);
+
+// called when the module globals are destroyed
+void mysqlx_release_fake_server(drv::Fake_server*& fake_server);
+
+#endif
+
+} // namespace devapi
+
+} // namespace mysqlx
+
+#endif /* MYSQLX_FAKE_SERVER_H */
@@ -26,12 +26,14 @@
 #include "xmysqlnd/xmysqlnd_rowset_fwd.h"
 #include "xmysqlnd/xmysqlnd_warning_list.h"
 #include "xmysqlnd/xmysqlnd_stmt_execution_state.h"
+#include "xmysqlnd/xmysqlnd_write_batch.h"
 #include "php_mysqlx.h"
 #include "mysqlx_class_properties.h"
 #include "mysqlx_warning.h"
 #include "mysqlx_result_iterator.h"
 #include "mysqlx_result.h"
 #include "mysqlx_base_result.h"
+#include "util/exceptions.h"
 #include "util/object.h"
 #include "util/string_utils.h"
 #include "util/functions.h"
@@ -67,6 +69,23 @@ st_mysqlx_result::~st_mysqlx_result()
 	xmysqlnd_stmt_result_free(result, nullptr, nullptr);
 }
 
+st_xmysqlnd_stmt_result*
+st_mysqlx_result::get_result()
+{
+	if (batched_write) {
+		batched_write->wait();
+		result = batched_write->release_result();
+		if (!result) {
+			throw util::xdevapi_exception(
+				batched_write->get_error_code(),
+				batched_write->get_sql_state(),
+				batched_write->get_error_message());
+		}
+		batched_write.reset();
+	}
+	return result;
+}
+
 MYSQL_XDEVAPI_PHP_METHOD(mysqlx_result, __construct)
 {
 	UNUSED_INTERNAL_FUNCTION_PARAMETERS();
@@ -86,7 +105,7 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_result, getAffectedItemsCount)
 
 	auto& data_object{ util::fetch_data_object<st_mysqlx_result>(object_zv) };
 
-	const XMYSQLND_STMT_EXECUTION_STATE* exec_state = data_object.result->exec_state;
+	const XMYSQLND_STMT_EXECUTION_STATE* exec_state = data_object.get_result()->exec_state;
 	/* Maybe check here if there was an error and throw an Exception or return a warning */
 	if (exec_state) {
 		const uint64_t value = exec_state->m->get_affected_items_count(exec_state);
@@ -115,7 +134,7 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_result, getAutoIncrementValue)
 
 	auto& data_object{ util::fetch_data_object<st_mysqlx_result>(object_zv) };
 
-	const XMYSQLND_STMT_EXECUTION_STATE* const exec_state = data_object.result->exec_state;
+	const XMYSQLND_STMT_EXECUTION_STATE* const exec_state = data_object.get_result()->exec_state;
 	/* Maybe check here if there was an error and throw an Exception or return a warning */
 	if (exec_state) {
 		const uint64_t value = exec_state->m->get_last_insert_id(exec_state);
@@ -142,7 +161,7 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_result, getGeneratedIds)
 	}
 
 	auto& data_object{ util::fetch_data_object<st_mysqlx_result>(object_zv) };
-	const XMYSQLND_STMT_EXECUTION_STATE* const exec_state = data_object.result->exec_state;
+	const XMYSQLND_STMT_EXECUTION_STATE* const exec_state = data_object.get_result()->exec_state;
 	if ( exec_state == nullptr ) {
 		php_error_docref(nullptr, E_WARNING, "Unable to get the correct exec_state");
 		DBG_VOID_RETURN;
@@ -170,7 +189,7 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_result, getWarningsCount)
 	RETVAL_LONG(0);
 
 	auto& data_object{ util::fetch_data_object<st_mysqlx_result>(object_zv) };
-	const XMYSQLND_WARNING_LIST* const warnings = data_object.result->warnings;
+	const XMYSQLND_WARNING_LIST* const warnings = data_object.get_result()->warnings;
 	/* Maybe check here if there was an error and throw an Exception or return a warning */
 	if (warnings) {
 		const std::size_t value = warnings->count();
@@ -196,7 +215,7 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_result, getWarnings)
 	}
 
 	auto& data_object{ util::fetch_data_object<st_mysqlx_result>(object_zv) };
-	const XMYSQLND_WARNING_LIST* const warnings = data_object.result->warnings;
+	const XMYSQLND_WARNING_LIST* const warnings = data_object.get_result()->warnings;
 	/* Maybe check here if there was an error and throw an Exception or return a warning */
 	if (warnings) {
 		const std::size_t count{warnings->count()};
@@ -289,6 +308,19 @@ create_result(XMYSQLND_STMT_RESULT* result)
 	DBG_RETURN(result_obj);
 }
 
+util::zvalue
+create_deferred_result(const Batched_write_ptr& batched_write)
+{
+	DBG_ENTER("create_deferred_result");
+
+	util::zvalue result_obj;
+	st_mysqlx_result& data_object{
+		util::init_object<st_mysqlx_result>(mysqlx_result_class_entry, result_obj) };
+	data_object.batched_write = batched_write;
+
+	DBG_RETURN(result_obj);
+}
+
 } // namespace devapi
 
 } // namespace mysqlx
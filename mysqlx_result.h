@@ -20,11 +20,13 @@
 
 #include "util/allocator.h"
 #include "util/value.h"
+#include <memory>
 
 namespace mysqlx {
 
 namespace drv {
 struct st_xmysqlnd_stmt_result;
+class Batched_write;
 }
 
 namespace devapi {
@@ -32,10 +34,20 @@ namespace devapi {
 struct st_mysqlx_result : public util::custom_allocable
 {
 	~st_mysqlx_result();
-	drv::st_xmysqlnd_stmt_result* result;
+
+	/*
+		the result of a write executed during a batch is read on first use, throws
+		if the server returned an error for it - see Session::beginBatch
+	*/
+	drv::st_xmysqlnd_stmt_result* get_result();
+	bool is_deferred() const { return batched_write != nullptr; }
+
+	drv::st_xmysqlnd_stmt_result* result{nullptr};
+	std::shared_ptr<drv::Batched_write> batched_write;
 };
 
 util::zvalue create_result(drv::st_xmysqlnd_stmt_result* result);
+util::zvalue create_deferred_result(const std::shared_ptr<drv::Batched_write>& batched_write);
 void mysqlx_register_result_class(INIT_FUNC_ARGS, zend_object_handlers* mysqlx_std_object_handlers);
 void mysqlx_unregister_result_class(SHUTDOWN_FUNC_ARGS);
 
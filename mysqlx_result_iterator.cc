@@ -25,6 +25,7 @@ extern "C" {
 #include "mysqlx_result.h"
 #include "mysqlx_object.h"
 #include "mysqlx_class_properties.h"
+#include "util/exceptions.h"
 #include "util/object.h"
 
 namespace mysqlx {
@@ -152,6 +153,16 @@ static zend_object_iterator*
 mysqlx__result_create_iterator(zend_class_entry* ce, util::raw_zval* object, int by_ref)
 {
 	DBG_ENTER("mysqlx_result_create_iterator");
+	// a deferred result of a batched write has to be read first
+	MYSQL_XDEVAPI_TRY {
+		st_mysqlx_object* mysqlx_object = Z_MYSQLX_P(object);
+		if (mysqlx_object->ptr) {
+			static_cast<st_mysqlx_result*>(mysqlx_object->ptr)->get_result();
+		}
+	} MYSQL_XDEVAPI_CATCH
+	if (EG(exception)) {
+		DBG_RETURN(nullptr);
+	}
 	auto iterator = util::create_result_iterator<st_mysqlx_result, st_mysqlx__result_iterator>(
 		ce,
 		&mysqlx__result_iterator_funcs,
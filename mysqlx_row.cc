@@ -0,0 +1,422 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Andrey Hristov <andrey@php.net>                             |
+  +----------------------------------------------------------------------+
+*/
+#include "php_api.h"
+#include "mysqlnd_api.h"
+extern "C" {
+#include <zend_interfaces.h>
+}
+#include "xmysqlnd/xmysqlnd.h"
+#include "xmysqlnd/xmysqlnd_rowset.h"
+#include "xmysqlnd/xmysqlnd_stmt_result.h"
+#include "xmysqlnd/xmysqlnd_stmt_result_meta.h"
+#include "php_mysqlx.h"
+#include "mysqlx_class_properties.h"
+#include "mysqlx_object.h"
+#include "mysqlx_row.h"
+#include "util/exceptions.h"
+#include "util/functions.h"
+#include "util/object.h"
+
+namespace mysqlx {
+
+namespace devapi {
+
+using namespace drv;
+
+static zend_class_entry* mysqlx_row_class_entry;
+
+/*
+	The cells are the ones of the rowset, decoded when the row was read, nothing is
+	copied until a column is accessed. Rows of buffered results point into the
+	rowset and keep the result alive, rows of forward-only results have to copy
+	the cells, as the rowset drops them with the next prefetch.
+*/
+struct st_mysqlx_row : public util::custom_allocable
+{
+	~st_mysqlx_row();
+
+	const zval* find_cell(const zval* column) const;
+	util::zvalue to_array() const;
+	unsigned int get_field_count() const;
+
+	XMYSQLND_STMT_RESULT* result{nullptr};
+	XMYSQLND_STMT_RESULT_META* meta{nullptr};
+	const zval* cells{nullptr};
+	zval* own_cells{nullptr};
+};
+
+st_mysqlx_row::~st_mysqlx_row()
+{
+	if (own_cells) {
+		const unsigned int field_count{ get_field_count() };
+		for (unsigned int i{0}; i < field_count; ++i) {
+			zval_ptr_dtor(&own_cells[i]);
+		}
+		mnd_efree(own_cells);
+	}
+	if (meta) {
+		xmysqlnd_stmt_result_meta_free(meta, nullptr, nullptr);
+	}
+	if (result) {
+		result->m.free_reference(result, nullptr, nullptr);
+	}
+}
+
+const zval* st_mysqlx_row::find_cell(const zval* column) const
+{
+	unsigned int field{0};
+	if (!meta->m->find_field(meta, column, &field)) {
+		return nullptr;
+	}
+	return &cells[field];
+}
+
+util::zvalue st_mysqlx_row::to_array() const
+{
+	util::zvalue row;
+	HashTable* const row_template{ meta->m->get_row_template(meta) };
+	if (row_template) {
+		const zval* cell{ cells };
+		zval* zv;
+		ZVAL_ARR(row.ptr(), zend_array_dup(row_template));
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(row.ptr()), zv) {
+			ZVAL_COPY(zv, cell++);
+		} ZEND_HASH_FOREACH_END();
+	} else {
+		const unsigned int field_count{ get_field_count() };
+		array_init_size(row.ptr(), field_count);
+		for (unsigned int col{0}; col < field_count; ++col) {
+			const XMYSQLND_RESULT_FIELD_META* field_meta{ meta->m->get_field(meta, col) };
+			zval cell;
+			ZVAL_COPY(&cell, &cells[col]);
+			if (field_meta->zend_hash_key.is_numeric == FALSE) {
+				zend_hash_update(Z_ARRVAL_P(row.ptr()), field_meta->zend_hash_key.sname, &cell);
+			} else {
+				zend_hash_index_update(Z_ARRVAL_P(row.ptr()), field_meta->zend_hash_key.key, &cell);
+			}
+		}
+	}
+	return row;
+}
+
+unsigned int st_mysqlx_row::get_field_count() const
+{
+	return meta->m->get_field_count(meta);
+}
+
+#if PHP_VERSION_ID >= 80100 // PHP 8.1 or newer
+ZEND_BEGIN_ARG_WITH_TENTATIVE_RETURN_TYPE_INFO_EX(arginfo_mysqlx_row__offset_exists, 0, 1, _IS_BOOL, 0)
+#else
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_row__offset_exists, 0, ZEND_RETURN_VALUE, 1)
+#endif
+	ZEND_ARG_INFO(no_pass_by_ref, column)
+ZEND_END_ARG_INFO()
+
+#if PHP_VERSION_ID >= 80100 // PHP 8.1 or newer
+ZEND_BEGIN_ARG_WITH_TENTATIVE_RETURN_TYPE_INFO_EX(arginfo_mysqlx_row__offset_get, 0, 1, IS_MIXED, 0)
+#else
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_row__offset_get, 0, ZEND_RETURN_VALUE, 1)
+#endif
+	ZEND_ARG_INFO(no_pass_by_ref, column)
+ZEND_END_ARG_INFO()
+
+#if PHP_VERSION_ID >= 80100 // PHP 8.1 or newer
+ZEND_BEGIN_ARG_WITH_TENTATIVE_RETURN_TYPE_INFO_EX(arginfo_mysqlx_row__offset_set, 0, 2, IS_VOID, 0)
+#else
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_row__offset_set, 0, ZEND_RETURN_VALUE, 2)
+#endif
+	ZEND_ARG_INFO(no_pass_by_ref, column)
+	ZEND_ARG_INFO(no_pass_by_ref, value)
+ZEND_END_ARG_INFO()
+
+#if PHP_VERSION_ID >= 80100 // PHP 8.1 or newer
+ZEND_BEGIN_ARG_WITH_TENTATIVE_RETURN_TYPE_INFO_EX(arginfo_mysqlx_row__offset_unset, 0, 1, IS_VOID, 0)
+#else
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_row__offset_unset, 0, ZEND_RETURN_VALUE, 1)
+#endif
+	ZEND_ARG_INFO(no_pass_by_ref, column)
+ZEND_END_ARG_INFO()
+
+#if PHP_VERSION_ID >= 80100 // PHP 8.1 or newer
+ZEND_BEGIN_ARG_WITH_TENTATIVE_RETURN_TYPE_INFO_EX(arginfo_mysqlx_row__count, 0, 0, IS_LONG, 0)
+#else
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_row__count, 0, ZEND_RETURN_VALUE, 0)
+#endif
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_row__get, 0, ZEND_RETURN_VALUE, 1)
+	ZEND_ARG_TYPE_INFO(no_pass_by_ref, name, IS_STRING, dont_allow_null)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_row__isset, 0, ZEND_RETURN_VALUE, 1)
+	ZEND_ARG_TYPE_INFO(no_pass_by_ref, name, IS_STRING, dont_allow_null)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_row__to_array, 0, ZEND_RETURN_VALUE, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_row__construct, 0, ZEND_RETURN_VALUE, 0)
+ZEND_END_ARG_INFO()
+
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_row, __construct)
+{
+	UNUSED_INTERNAL_FUNCTION_PARAMETERS();
+}
+
+// the same as isset() on the row array - the column is there and isn't null
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_row, offsetExists)
+{
+	DBG_ENTER("mysqlx_row::offsetExists");
+
+	util::raw_zval* object_zv{nullptr};
+	util::raw_zval* column{nullptr};
+	if (FAILURE == util::get_method_arguments(execute_data, getThis(), "Oz",
+												&object_zv, mysqlx_row_class_entry,
+												&column))
+	{
+		DBG_VOID_RETURN;
+	}
+
+	const auto& data_object{ util::fetch_data_object<st_mysqlx_row>(object_zv) };
+	const zval* cell{ data_object.find_cell(column) };
+	RETVAL_BOOL(cell && (Z_TYPE_P(cell) != IS_NULL));
+	DBG_VOID_RETURN;
+}
+
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_row, offsetGet)
+{
+	DBG_ENTER("mysqlx_row::offsetGet");
+
+	util::raw_zval* object_zv{nullptr};
+	util::raw_zval* column{nullptr};
+	if (FAILURE == util::get_method_arguments(execute_data, getThis(), "Oz",
+												&object_zv, mysqlx_row_class_entry,
+												&column))
+	{
+		DBG_VOID_RETURN;
+	}
+
+	RETVAL_NULL();
+
+	const auto& data_object{ util::fetch_data_object<st_mysqlx_row>(object_zv) };
+	if (const zval* cell = data_object.find_cell(column)) {
+		ZVAL_COPY(return_value, cell);
+	}
+	DBG_VOID_RETURN;
+}
+
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_row, offsetSet)
+{
+	UNUSED_INTERNAL_FUNCTION_PARAMETERS();
+	throw util::xdevapi_exception(util::xdevapi_exception::Code::runtime_error, "row is read-only");
+}
+
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_row, offsetUnset)
+{
+	UNUSED_INTERNAL_FUNCTION_PARAMETERS();
+	throw util::xdevapi_exception(util::xdevapi_exception::Code::runtime_error, "row is read-only");
+}
+
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_row, count)
+{
+	DBG_ENTER("mysqlx_row::count");
+
+	util::raw_zval* object_zv{nullptr};
+	if (FAILURE == util::get_method_arguments(execute_data, getThis(), "O",
+												&object_zv, mysqlx_row_class_entry))
+	{
+		DBG_VOID_RETURN;
+	}
+
+	const auto& data_object{ util::fetch_data_object<st_mysqlx_row>(object_zv) };
+	RETVAL_LONG(data_object.get_field_count());
+	DBG_VOID_RETURN;
+}
+
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_row, __get)
+{
+	DBG_ENTER("mysqlx_row::__get");
+
+	util::raw_zval* object_zv{nullptr};
+	util::raw_zval* name{nullptr};
+	if (FAILURE == util::get_method_arguments(execute_data, getThis(), "Oz",
+												&object_zv, mysqlx_row_class_entry,
+												&name))
+	{
+		DBG_VOID_RETURN;
+	}
+
+	RETVAL_NULL();
+
+	const auto& data_object{ util::fetch_data_object<st_mysqlx_row>(object_zv) };
+	if (const zval* cell = data_object.find_cell(name)) {
+		ZVAL_COPY(return_value, cell);
+	}
+	DBG_VOID_RETURN;
+}
+
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_row, __isset)
+{
+	DBG_ENTER("mysqlx_row::__isset");
+
+	util::raw_zval* object_zv{nullptr};
+	util::raw_zval* name{nullptr};
+	if (FAILURE == util::get_method_arguments(execute_data, getThis(), "Oz",
+												&object_zv, mysqlx_row_class_entry,
+												&name))
+	{
+		DBG_VOID_RETURN;
+	}
+
+	const auto& data_object{ util::fetch_data_object<st_mysqlx_row>(object_zv) };
+	const zval* cell{ data_object.find_cell(name) };
+	RETVAL_BOOL(cell && (Z_TYPE_P(cell) != IS_NULL));
+	DBG_VOID_RETURN;
+}
+
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_row, toArray)
+{
+	DBG_ENTER("mysqlx_row::toArray");
+
+	util::raw_zval* object_zv{nullptr};
+	if (FAILURE == util::get_method_arguments(execute_data, getThis(), "O",
+												&object_zv, mysqlx_row_class_entry))
+	{
+		DBG_VOID_RETURN;
+	}
+
+	const auto& data_object{ util::fetch_data_object<st_mysqlx_row>(object_zv) };
+	data_object.to_array().move_to(return_value);
+	DBG_VOID_RETURN;
+}
+
+static const zend_function_entry mysqlx_row_methods[] = {
+	PHP_ME(mysqlx_row, __construct, arginfo_mysqlx_row__construct, ZEND_ACC_PRIVATE)
+
+	PHP_ME(mysqlx_row, offsetExists, arginfo_mysqlx_row__offset_exists, ZEND_ACC_PUBLIC)
+	PHP_ME(mysqlx_row, offsetGet, arginfo_mysqlx_row__offset_get, ZEND_ACC_PUBLIC)
+	PHP_ME(mysqlx_row, offsetSet, arginfo_mysqlx_row__offset_set, ZEND_ACC_PUBLIC)
+	PHP_ME(mysqlx_row, offsetUnset, arginfo_mysqlx_row__offset_unset, ZEND_ACC_PUBLIC)
+	PHP_ME(mysqlx_row, count, arginfo_mysqlx_row__count, ZEND_ACC_PUBLIC)
+	PHP_ME(mysqlx_row, __get, arginfo_mysqlx_row__get, ZEND_ACC_PUBLIC)
+	PHP_ME(mysqlx_row, __isset, arginfo_mysqlx_row__isset, ZEND_ACC_PUBLIC)
+	PHP_ME(mysqlx_row, toArray, arginfo_mysqlx_row__to_array, ZEND_ACC_PUBLIC)
+
+	{nullptr, nullptr, nullptr}
+};
+
+static zend_object_handlers mysqlx_object_row_handlers;
+static HashTable mysqlx_row_properties;
+
+const st_mysqlx_property_entry mysqlx_row_property_entries[] =
+{
+	{std::string_view{}, nullptr, nullptr}
+};
+
+// var_dump() and print_r() show the columns, as they would for the row array
+static HashTable*
+mysqlx_row_get_debug_info(
+#if PHP_VERSION_ID >= 80000 // PHP 8.0 or newer
+	zend_object* object,
+#else
+	util::raw_zval* object,
+#endif
+	int* is_temp)
+{
+	const auto& data_object{ util::fetch_data_object<st_mysqlx_row>(object) };
+	util::zvalue row{ data_object.to_array() };
+	HashTable* retval{ Z_ARRVAL_P(row.ptr()) };
+	GC_ADDREF(retval);
+	*is_temp = 1;
+	return retval;
+}
+
+static void
+mysqlx_row_free_storage(zend_object* object)
+{
+	util::free_object<st_mysqlx_row>(object);
+}
+
+static zend_object *
+php_mysqlx_row_object_allocator(zend_class_entry* class_type)
+{
+	DBG_ENTER("php_mysqlx_row_object_allocator");
+	st_mysqlx_object* mysqlx_object = util::alloc_object<st_mysqlx_row>(
+		class_type,
+		&mysqlx_object_row_handlers,
+		&mysqlx_row_properties);
+	DBG_RETURN(&mysqlx_object->zo);
+}
+
+void
+mysqlx_register_row_class(UNUSED_INIT_FUNC_ARGS, zend_object_handlers* mysqlx_std_object_handlers)
+{
+	MYSQL_XDEVAPI_REGISTER_CLASS(
+		mysqlx_row_class_entry,
+		"Row",
+		mysqlx_std_object_handlers,
+		mysqlx_object_row_handlers,
+		php_mysqlx_row_object_allocator,
+		mysqlx_row_free_storage,
+		mysqlx_row_methods,
+		mysqlx_row_properties,
+		mysqlx_row_property_entries,
+		zend_ce_arrayaccess,
+		zend_ce_countable);
+
+	mysqlx_object_row_handlers.get_debug_info = mysqlx_row_get_debug_info;
+}
+
+void
+mysqlx_unregister_row_class(UNUSED_SHUTDOWN_FUNC_ARGS)
+{
+	zend_hash_destroy(&mysqlx_row_properties);
+}
+
+util::zvalue
+create_row(XMYSQLND_STMT_RESULT* result)
+{
+	DBG_ENTER("create_row");
+	XMYSQLND_STMT_RESULT_META* meta{nullptr};
+	const zval* cells{ result->m.get_current_cells(result, &meta) };
+	if (!cells) {
+		DBG_RETURN(util::zvalue());
+	}
+
+	util::zvalue row_obj;
+	st_mysqlx_row& data_object{ util::init_object<st_mysqlx_row>(mysqlx_row_class_entry, row_obj) };
+	data_object.meta = xmysqlnd_stmt_result_meta_get_reference(meta);
+	if (result->rowset->type == XMYSQLND_TYPE_ROWSET_BUFFERED) {
+		data_object.result = result->m.get_reference(result);
+		data_object.cells = cells;
+	} else {
+		const unsigned int field_count{ data_object.get_field_count() };
+		if (field_count) {
+			data_object.own_cells = static_cast<zval*>(mnd_ecalloc(field_count, sizeof(zval)));
+			for (unsigned int i{0}; i < field_count; ++i) {
+				ZVAL_COPY(&data_object.own_cells[i], &cells[i]);
+			}
+		}
+		data_object.cells = data_object.own_cells;
+	}
+	DBG_RETURN(row_obj);
+}
+
+} // namespace devapi
+
+} // namespace mysqlx
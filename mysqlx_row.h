@@ -0,0 +1,47 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Andrey Hristov <andrey@php.net>                             |
+  +----------------------------------------------------------------------+
+*/
+#ifndef MYSQLX_ROW_H
+#define MYSQLX_ROW_H
+
+#include "util/value.h"
+
+namespace mysqlx {
+
+namespace drv {
+
+struct st_xmysqlnd_stmt_result;
+
+} // namespace drv
+
+namespace devapi {
+
+void mysqlx_register_row_class(INIT_FUNC_ARGS, zend_object_handlers* mysqlx_std_object_handlers);
+void mysqlx_unregister_row_class(SHUTDOWN_FUNC_ARGS);
+
+/*
+	Row object over the current row of the result, the columns are copied into zvals
+	only when read, see xmysqlnd.lazy_rows. Returns an undef zvalue if there is no
+	current row.
+*/
+util::zvalue create_row(drv::st_xmysqlnd_stmt_result* result);
+
+} // namespace devapi
+
+} // namespace mysqlx
+
+#endif /* MYSQLX_ROW_H */
@@ -22,7 +22,9 @@ extern "C" {
 }
 #include "xmysqlnd/xmysqlnd.h"
 #include "xmysqlnd/xmysqlnd_stmt_result.h"
+#include "php_mysqlx.h"
 #include "mysqlx_row_result.h"
+#include "mysqlx_row.h"
 #include "mysqlx_object.h"
 #include "mysqlx_class_properties.h"
 #include "util/object.h"
@@ -87,6 +89,11 @@ XMYSQLND_METHOD(mysqlx_row_result_iterator, fetch_current_data)(zend_object_iter
 	if (iterator->result && iterator->usable) {
 		iterator->current_row.reset();
 
+		if (MYSQL_XDEVAPI_G(lazy_rows)) {
+			iterator->current_row = create_row(iterator->result);
+			DBG_RETURN(iterator->current_row.is_object() ? PASS : FAIL);
+		}
+
 		if (PASS == iterator->result->m.fetch_current(iterator->result, iterator->current_row.ptr(), nullptr, nullptr) &&
 			iterator->current_row.is_array())
 		{
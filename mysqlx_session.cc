@@ -105,6 +105,12 @@ ZEND_END_ARG_INFO()
 ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_session__close, 0, ZEND_RETURN_VALUE, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_session__begin_batch, 0, ZEND_RETURN_VALUE, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_session__flush, 0, ZEND_RETURN_VALUE, 0)
+ZEND_END_ARG_INFO()
+
 bool Session_data::close_connection()
 {
 	if (!session) return false;
@@ -187,8 +193,20 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_session, generateUUID)
 struct st_mysqlx_get_schemas_ctx
 {
 	util::zvalue* list;
+	// collected for the metadata cache, if the session has one
+	drv::Schema_names* names;
 };
 
+static void
+add_schema_to_list(XMYSQLND_SESSION session, const util::string_view& schema_name, util::zvalue& list)
+{
+	xmysqlnd_schema * schema = session->create_schema_object(schema_name);
+	if (schema) {
+		util::zvalue schema_obj = create_schema(schema);
+		list.push_back(schema_obj);
+	}
+}
+
 static const enum_hnd_func_status
 get_schemas_handler_on_row(void * context,
 						   XMYSQLND_SESSION const session,
@@ -203,10 +221,9 @@ get_schemas_handler_on_row(void * context,
 	if (ctx && ctx->list && row) {
 		assert(ctx->list->is_array());
 		const util::string_view schema_name{ Z_STRVAL(row[0]), Z_STRLEN(row[0]) };
-		xmysqlnd_schema * schema = session->create_schema_object(schema_name);
-		if (schema) {
-			util::zvalue schema_obj = create_schema(schema);
-			ctx->list->push_back(schema_obj);
+		add_schema_to_list(session, schema_name, *ctx->list);
+		if (ctx->names) {
+			ctx->names->emplace(schema_name);
 		}
 	}
 	DBG_RETURN(HND_AGAIN);
@@ -240,9 +257,21 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_session, getSchemas)
 	auto& data_object{ fetch_session_data(object_zv) };
 	util::zvalue schemas = util::zvalue::create_array();
 	if (XMYSQLND_SESSION session = data_object.session) {
+		std::shared_ptr<drv::Schema_cache> schema_cache{ session->get_data()->schema_cache };
+		if (schema_cache) {
+			if (auto schema_names = schema_cache->find_schema_names()) {
+				for (const auto& schema_name : *schema_names) {
+					add_schema_to_list(session, schema_name, schemas);
+				}
+				schemas.move_to(return_value);
+				DBG_VOID_RETURN;
+			}
+		}
+
 		const st_xmysqlnd_session_query_bind_variable_bind var_binder{ nullptr, nullptr };
 		constexpr util::string_view list_query("SHOW DATABASES");
-		st_mysqlx_get_schemas_ctx ctx{ &schemas };
+		drv::Schema_names schema_names;
+		st_mysqlx_get_schemas_ctx ctx{ &schemas, schema_cache ? &schema_names : nullptr };
 		const st_xmysqlnd_session_on_result_start_bind on_result_start{ nullptr, nullptr };
 		const st_xmysqlnd_session_on_row_bind on_row{ get_schemas_handler_on_row, &ctx };
 		const st_xmysqlnd_session_on_warning_bind on_warning{ nullptr, nullptr };
@@ -253,6 +282,8 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_session, getSchemas)
 		if (PASS != session->query_cb(namespace_sql, list_query, var_binder, on_result_start, on_row, on_warning, on_error, on_result_end, on_statement_ok)) {
 			schemas.clear();
 			mysqlx_throw_exception_from_session_if_needed(session->data);
+		} else if (schema_cache) {
+			schema_cache->store_schema_names(std::move(schema_names));
 		}
 	}
 	schemas.move_to(return_value);
@@ -469,22 +500,20 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_session, startTransaction)
 	DBG_ENTER("mysqlx_session::startTransaction");
 
 	util::raw_zval* object_zv{nullptr};
-	constexpr util::string_view query{"START TRANSACTION"};
 	if (util::get_method_arguments(execute_data, getThis(), "O", &object_zv, mysqlx_session_class_entry) == FAILURE)
 	{
 		DBG_VOID_RETURN;
 	}
 
-	RETVAL_NULL();
+	RETVAL_FALSE;
 
 	auto& data_object{ fetch_session_data(object_zv) };
 	if (data_object.session) {
-		mysqlx_execute_session_query(
-			data_object.session,
-			namespace_sql, query,
-			MYSQLX_EXECUTE_FLAG_BUFFERED,
-			util::zvalues()
-			).move_to(return_value);
+		if (PASS == data_object.session->data->start_transaction()) {
+			RETVAL_TRUE;
+		} else {
+			mysqlx_throw_exception_from_session_if_needed(data_object.session->data);
+		}
 	}
 
 	DBG_VOID_RETURN;
@@ -495,23 +524,20 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_session, commit)
 	DBG_ENTER("mysqlx_session::commit");
 
 	util::raw_zval* object_zv{nullptr};
-	constexpr util::string_view query{"COMMIT"};
 	if (util::get_method_arguments(execute_data, getThis(), "O", &object_zv, mysqlx_session_class_entry) == FAILURE)
 	{
 		DBG_VOID_RETURN;
 	}
 
-	RETVAL_NULL();
+	RETVAL_FALSE;
 
 	auto& data_object{ fetch_session_data(object_zv) };
 	if (data_object.session) {
-		mysqlx_execute_session_query(
-			data_object.session,
-			namespace_sql,
-			query,
-			MYSQLX_EXECUTE_FLAG_BUFFERED,
-			util::zvalues()
-			).move_to(return_value);
+		if (PASS == data_object.session->data->commit()) {
+			RETVAL_TRUE;
+		} else {
+			mysqlx_throw_exception_from_session_if_needed(data_object.session->data);
+		}
 	}
 
 	DBG_VOID_RETURN;
@@ -522,23 +548,20 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_session, rollback)
 	DBG_ENTER("mysqlx_session::rollback");
 
 	util::raw_zval* object_zv{nullptr};
-	constexpr util::string_view query{"ROLLBACK"};
 	if (util::get_method_arguments(execute_data, getThis(), "O", &object_zv, mysqlx_session_class_entry) == FAILURE)
 	{
 		DBG_VOID_RETURN;
 	}
 
-	RETVAL_NULL();
+	RETVAL_FALSE;
 
 	auto& data_object{ fetch_session_data(object_zv) };
 	if (data_object.session) {
-		mysqlx_execute_session_query(
-			data_object.session,
-			namespace_sql,
-			query,
-			MYSQLX_EXECUTE_FLAG_BUFFERED,
-			util::zvalues()
-			).move_to(return_value);
+		if (PASS == data_object.session->data->rollback()) {
+			RETVAL_TRUE;
+		} else {
+			mysqlx_throw_exception_from_session_if_needed(data_object.session->data);
+		}
 	}
 
 	DBG_VOID_RETURN;
@@ -547,10 +570,17 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_session, rollback)
 static util::string
 generate_savepoint_name( const unsigned int name_seed )
 {
-	static const std::string SAVEPOINT_NAME_PREFIX{ "SAVEPOINT" };
-	std::stringstream output;
-	output << SAVEPOINT_NAME_PREFIX << name_seed;
-	return output.str().c_str();
+	return "SAVEPOINT" + util::to_string(name_seed);
+}
+
+static zend_bool
+execute_savepoint_query(XMYSQLND_SESSION& session, const util::string& query)
+{
+	if (PASS == session->data->execute_trx_control(query)) {
+		return TRUE;
+	}
+	mysqlx_throw_exception_from_session_if_needed(session->data);
+	return FALSE;
 }
 
 MYSQL_XDEVAPI_PHP_METHOD(mysqlx_session, setSavepoint)
@@ -569,6 +599,10 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_session, setSavepoint)
 	RETVAL_FALSE;
 
 	auto& data_object = fetch_session_data(object_zv);
+	if (!data_object.session) {
+		DBG_VOID_RETURN;
+	}
+
 	util::string query{ "SAVEPOINT " };
 	util::zvalue name;
 	if( savepoint_name.empty() ) {
@@ -580,15 +614,9 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_session, setSavepoint)
 
 	query += util::escape_identifier( name.to_string_view() );
 
-	if (data_object.session) {
-		mysqlx_execute_session_query(
-			data_object.session,
-			namespace_sql,
-			{query.c_str(), query.size()} ,
-			MYSQLX_EXECUTE_FLAG_BUFFERED,
-			util::zvalues());
+	if (execute_savepoint_query(data_object.session, query)) {
+		name.move_to(return_value);
 	}
-	name.move_to(return_value);
 
 	DBG_VOID_RETURN;
 }
@@ -613,13 +641,7 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_session, rollbackTo)
 	const util::string query{ "ROLLBACK TO " + name };
 
 	if (data_object.session) {
-		mysqlx_execute_session_query(
-			data_object.session,
-			namespace_sql,
-			{query.c_str(), query.size()} ,
-			MYSQLX_EXECUTE_FLAG_BUFFERED,
-			util::zvalues()
-			).move_to(return_value);
+		RETVAL_BOOL(execute_savepoint_query(data_object.session, query));
 	}
 
 	DBG_VOID_RETURN;
@@ -645,13 +667,47 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_session, releaseSavepoint)
 	const util::string query{ "RELEASE SAVEPOINT " + name };
 
 	if (data_object.session) {
-		mysqlx_execute_session_query(
-			data_object.session,
-			namespace_sql,
-			{query.c_str(), query.size()} ,
-			MYSQLX_EXECUTE_FLAG_BUFFERED,
-			util::zvalues()
-			).move_to(return_value);
+		RETVAL_BOOL(execute_savepoint_query(data_object.session, query));
+	}
+
+	DBG_VOID_RETURN;
+}
+
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_session, beginBatch)
+{
+	DBG_ENTER("mysqlx_session::beginBatch");
+
+	util::raw_zval* object_zv{nullptr};
+	if (util::get_method_arguments(execute_data, getThis(), "O", &object_zv, mysqlx_session_class_entry) == FAILURE) {
+		DBG_VOID_RETURN;
+	}
+
+	RETVAL_FALSE;
+
+	auto& data_object{ fetch_session_data(object_zv) };
+	if (data_object.session) {
+		data_object.session->data->begin_write_batch();
+		RETVAL_TRUE;
+	}
+
+	DBG_VOID_RETURN;
+}
+
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_session, flush)
+{
+	DBG_ENTER("mysqlx_session::flush");
+
+	util::raw_zval* object_zv{nullptr};
+	if (util::get_method_arguments(execute_data, getThis(), "O", &object_zv, mysqlx_session_class_entry) == FAILURE) {
+		DBG_VOID_RETURN;
+	}
+
+	RETVAL_FALSE;
+
+	auto& data_object{ fetch_session_data(object_zv) };
+	if (data_object.session) {
+		// errors of the single writes are thrown by their results
+		RETVAL_BOOL(data_object.session->data->end_write_batch() == 0);
 	}
 
 	DBG_VOID_RETURN;
@@ -698,6 +754,8 @@ static const zend_function_entry mysqlx_session_methods[] = {
 	PHP_ME(mysqlx_session, setSavepoint, arginfo_mysqlx_session__set_savepoint, ZEND_ACC_PUBLIC)
 	PHP_ME(mysqlx_session, rollbackTo, arginfo_mysqlx_session__rollback_to, ZEND_ACC_PUBLIC)
 	PHP_ME(mysqlx_session, releaseSavepoint, arginfo_mysqlx_session__release_savepoint, ZEND_ACC_PUBLIC)
+	PHP_ME(mysqlx_session, beginBatch, arginfo_mysqlx_session__begin_batch, ZEND_ACC_PUBLIC)
+	PHP_ME(mysqlx_session, flush, arginfo_mysqlx_session__flush, ZEND_ACC_PUBLIC)
 	PHP_ME(mysqlx_session, close, arginfo_mysqlx_session__close, ZEND_ACC_PUBLIC)
 	{nullptr, nullptr, nullptr}
 };
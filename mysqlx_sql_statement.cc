@@ -23,6 +23,8 @@
 #include "xmysqlnd/xmysqlnd_stmt_result.h"
 #include "xmysqlnd/xmysqlnd_stmt_result_meta.h"
 #include "xmysqlnd/xmysqlnd_stmt_execution_state.h"
+#include "xmysqlnd/xmysqlnd_session.h"
+#include "xmysqlnd/xmysqlnd_write_batch.h"
 #include "php_mysqlx.h"
 #include "mysqlx_class_properties.h"
 #include "mysqlx_execution_status.h"
@@ -538,6 +540,46 @@ mysqlx_sql_statement_execute(
 	DBG_RETURN(result);
 }
 
+util::zvalue
+mysqlx_sql_statement_read_pipelined_result(util::raw_zval* object_zv)
+{
+	DBG_ENTER("mysqlx_sql_statement_read_pipelined_result");
+	util::zvalue result;
+	auto& data_object{ util::fetch_data_object<st_mysqlx_statement>(object_zv) };
+	if (PASS != data_object.send_query_status) {
+		DBG_RETURN(result);
+	}
+
+	xmysqlnd_stmt* stmt = data_object.stmt;
+	const st_xmysqlnd_stmt_on_warning_bind on_warning = { mysqlx_sql_stmt_on_warning, nullptr };
+	const st_xmysqlnd_stmt_on_error_bind on_error = { mysqlx_sql_stmt_on_error, nullptr };
+	data_object.execute_flags = MYSQLX_EXECUTE_FLAG_BUFFERED;
+	XMYSQLND_STMT_RESULT* stmt_result = stmt->get_buffered_result(stmt, &data_object.has_more_results, on_warning, on_error, nullptr, nullptr);
+
+	/*
+		the response to the next statement sent on the session follows, so any
+		further result sets have to be consumed right now
+	*/
+	while (stmt_result && data_object.has_more_results) {
+		XMYSQLND_STMT_RESULT* next_result = stmt->get_buffered_result(stmt, &data_object.has_more_results, on_warning, on_error, nullptr, nullptr);
+		if (!next_result) {
+			break;
+		}
+		xmysqlnd_stmt_result_free(next_result, nullptr, nullptr);
+	}
+	data_object.has_more_results = FALSE;
+
+	if (stmt_result) {
+		result = create_sql_stmt_result(stmt_result, &data_object);
+	} else {
+		if (!EG(exception)) {
+			RAISE_EXCEPTION_FETCH_FAIL();
+		}
+		data_object.send_query_status = FAIL;
+	}
+	DBG_RETURN(result);
+}
+
 MYSQL_XDEVAPI_PHP_METHOD(mysqlx_sql_statement, execute)
 {
 	zend_long flags{MYSQLX_EXECUTE_FLAG_BUFFERED};
@@ -766,9 +808,16 @@ mysqlx_statement_execute_read_response(const st_mysqlx_object* const mysqlx_obje
 		object->has_more_results = FALSE;
 		object->send_query_status = PASS;
 
+		Write_batch& write_batch{ stmt->get_session()->get_data()->write_batch };
 		if (object->execute_flags & MYSQLX_EXECUTE_FLAG_ASYNC) {
 			DBG_INF("ASYNC");
 			return_value = (PASS == object->send_query_status);
+		} else if ((result_type == MYSQLX_RESULT) && write_batch.is_active()) {
+			// the response is left unread until the batch is drained, see Write_batch
+			DBG_INF("BATCHED");
+			Batched_write_ptr batched_write{ std::make_shared<Batched_write>(stmt) };
+			write_batch.add(batched_write);
+			return_value = create_deferred_result(batched_write);
 		} else {
 				const st_xmysqlnd_stmt_on_warning_bind on_warning = { mysqlx_sql_stmt_on_warning, nullptr };
 				const st_xmysqlnd_stmt_on_error_bind on_error = { mysqlx_sql_stmt_on_error, nullptr };
@@ -79,6 +79,13 @@ util::zvalue create_sql_stmt(drv::xmysqlnd_stmt* stmt, const std::string_view& n
 bool mysqlx_sql_statement_bind_one_param(util::raw_zval* object_zv, const util::zvalue& param);
 util::zvalue mysqlx_sql_statement_execute(const st_mysqlx_object* const mysqlx_object, const zend_long flags);
 
+/*
+	Reads the buffered result of a statement executed with MYSQLX_EXECUTE_FLAG_ASYNC
+	while other statements are pipelined behind it on the same session. Only the
+	first result set is kept, so that the session is ready for the next response.
+*/
+util::zvalue mysqlx_sql_statement_read_pipelined_result(util::raw_zval* object_zv);
+
 } // namespace devapi
 
 } // namespace mysqlx
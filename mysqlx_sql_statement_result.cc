@@ -60,6 +60,20 @@ ZEND_END_ARG_INFO()
 ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_sql_statement_result__fetch_all, 0, ZEND_RETURN_VALUE, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_sql_statement_result__fetch_one_num, 0, ZEND_RETURN_VALUE, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_sql_statement_result__fetch_all_num, 0, ZEND_RETURN_VALUE, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_sql_statement_result__fetch_all_column, 0, ZEND_RETURN_VALUE, 0)
+	ZEND_ARG_INFO(no_pass_by_ref, column)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_sql_statement_result__fetch_one_into, 0, ZEND_RETURN_VALUE, 1)
+	ZEND_ARG_TYPE_INFO(no_pass_by_ref, object, IS_OBJECT, dont_allow_null)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_sql_statement_result__get_affected_items_count, 0, ZEND_RETURN_VALUE, 0)
 ZEND_END_ARG_INFO()
 
@@ -216,6 +230,78 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_sql_statement_result, fetchAll)
 	DBG_VOID_RETURN;
 }
 
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_sql_statement_result, fetchOneNum)
+{
+	DBG_ENTER("mysqlx_sql_statement_result::fetchOneNum");
+
+	util::raw_zval* object_zv{nullptr};
+	if (FAILURE == util::get_method_arguments(execute_data, getThis(), "O",
+												&object_zv, mysqlx_sql_statement_result_class_entry))
+	{
+		DBG_VOID_RETURN;
+	}
+
+	auto& data_object{ util::fetch_data_object<st_mysqlx_sql_statement_result>(object_zv) };
+	fetch_one_num(data_object.result, return_value);
+
+	DBG_VOID_RETURN;
+}
+
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_sql_statement_result, fetchAllNum)
+{
+	DBG_ENTER("mysqlx_sql_statement_result::fetchAllNum");
+
+	util::raw_zval* object_zv{nullptr};
+	if (FAILURE == util::get_method_arguments(execute_data, getThis(), "O",
+												&object_zv, mysqlx_sql_statement_result_class_entry))
+	{
+		DBG_VOID_RETURN;
+	}
+
+	auto& data_object{ util::fetch_data_object<st_mysqlx_sql_statement_result>(object_zv) };
+	fetch_all_num(data_object.result, return_value);
+
+	DBG_VOID_RETURN;
+}
+
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_sql_statement_result, fetchAllColumn)
+{
+	DBG_ENTER("mysqlx_sql_statement_result::fetchAllColumn");
+
+	util::raw_zval* object_zv{nullptr};
+	util::raw_zval* column{nullptr};
+	if (FAILURE == util::get_method_arguments(execute_data, getThis(), "O|z",
+												&object_zv, mysqlx_sql_statement_result_class_entry,
+												&column))
+	{
+		DBG_VOID_RETURN;
+	}
+
+	auto& data_object{ util::fetch_data_object<st_mysqlx_sql_statement_result>(object_zv) };
+	fetch_all_column(data_object.result, column, return_value);
+
+	DBG_VOID_RETURN;
+}
+
+MYSQL_XDEVAPI_PHP_METHOD(mysqlx_sql_statement_result, fetchOneInto)
+{
+	DBG_ENTER("mysqlx_sql_statement_result::fetchOneInto");
+
+	util::raw_zval* object_zv{nullptr};
+	util::raw_zval* target{nullptr};
+	if (FAILURE == util::get_method_arguments(execute_data, getThis(), "Oo",
+												&object_zv, mysqlx_sql_statement_result_class_entry,
+												&target))
+	{
+		DBG_VOID_RETURN;
+	}
+
+	auto& data_object{ util::fetch_data_object<st_mysqlx_sql_statement_result>(object_zv) };
+	fetch_one_into(data_object.result, target, return_value);
+
+	DBG_VOID_RETURN;
+}
+
 MYSQL_XDEVAPI_PHP_METHOD(mysqlx_sql_statement_result, getAffectedItemsCount)
 {
 	DBG_ENTER("mysqlx_sql_statement_result::getAffectedItemsCount");
@@ -495,6 +581,10 @@ static const zend_function_entry mysqlx_sql_statement_result_methods[] = {
 	PHP_ME(mysqlx_sql_statement_result, hasData,				arginfo_mysqlx_sql_statement_result__has_data,					ZEND_ACC_PUBLIC)
 	PHP_ME(mysqlx_sql_statement_result, fetchOne,				arginfo_mysqlx_sql_statement_result__fetch_one,				ZEND_ACC_PUBLIC)
 	PHP_ME(mysqlx_sql_statement_result, fetchAll,				arginfo_mysqlx_sql_statement_result__fetch_all,				ZEND_ACC_PUBLIC)
+	PHP_ME(mysqlx_sql_statement_result, fetchOneNum,			arginfo_mysqlx_sql_statement_result__fetch_one_num,			ZEND_ACC_PUBLIC)
+	PHP_ME(mysqlx_sql_statement_result, fetchAllNum,			arginfo_mysqlx_sql_statement_result__fetch_all_num,			ZEND_ACC_PUBLIC)
+	PHP_ME(mysqlx_sql_statement_result, fetchAllColumn,		arginfo_mysqlx_sql_statement_result__fetch_all_column,		ZEND_ACC_PUBLIC)
+	PHP_ME(mysqlx_sql_statement_result, fetchOneInto,			arginfo_mysqlx_sql_statement_result__fetch_one_into,			ZEND_ACC_PUBLIC)
 
 	PHP_ME(mysqlx_sql_statement_result, getAffectedItemsCount,	arginfo_mysqlx_sql_statement_result__get_affected_items_count,	ZEND_ACC_PUBLIC)
 	PHP_ME(mysqlx_sql_statement_result, getLastInsertId,		arginfo_mysqlx_sql_statement_result__get_last_insert_id,		ZEND_ACC_PUBLIC)
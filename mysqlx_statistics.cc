@@ -0,0 +1,183 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#include "php_api.h"
+#include "mysqlnd_api.h"
+#include <ext/standard/info.h>
+#include "php_mysqlx.h"
+#include "xmysqlnd/xmysqlnd_perf_statistics.h"
+#include "xmysqlnd/xmysqlnd_trace.h"
+#include "mysqlx_statistics.h"
+#include "util/arguments.h"
+#include "util/functions.h"
+#include "util/value.h"
+#include <cinttypes>
+#include <cstdio>
+#include <string>
+
+namespace mysqlx {
+
+namespace devapi {
+
+using namespace drv;
+
+namespace {
+
+util::zvalue get_latency_summary(const Latency_histogram& histogram)
+{
+	return util::zvalue{
+		{ "count", histogram.get_count() },
+		{ "sum_us", histogram.get_sum() },
+		{ "min_us", histogram.get_min() },
+		{ "max_us", histogram.get_max() },
+		{ "p50_us", histogram.get_percentile(50.0) },
+		{ "p90_us", histogram.get_percentile(90.0) },
+		{ "p99_us", histogram.get_percentile(99.0) },
+		{ "p999_us", histogram.get_percentile(99.9) }
+	};
+}
+
+double get_ratio(uint64_t numerator, uint64_t denominator)
+{
+	return denominator ? static_cast<double>(numerator) / static_cast<double>(denominator) : 0.0;
+}
+
+/*
+	OpenTelemetry-like span, so it can be forwarded to an exporter as it is
+*/
+util::zvalue get_trace_span_info(const Trace_span& span)
+{
+	char span_id[17];
+	std::snprintf(span_id, sizeof(span_id), "%016" PRIx64, span.span_id);
+	const util::zvalue attributes{
+		{ "db.system", "mysql" },
+		{ "mysqlx.message_type", static_cast<uint64_t>(span.command) },
+		{ "mysqlx.rows", span.rows },
+		{ "mysqlx.bytes_sent", span.bytes_sent },
+		{ "mysqlx.bytes_received", span.bytes_received },
+		{ "mysqlx.first_byte_time_unix_nano", xmysqlnd_trace_to_unix_ns(span.first_byte_ns) },
+		{ "mysqlx.wait_ns", span.first_byte_ns - span.send_ns },
+		{ "mysqlx.transfer_ns", span.last_byte_ns - span.first_byte_ns },
+		{ "mysqlx.decode_ns", span.decode_ns }
+	};
+	return util::zvalue{
+		{ "name", std::string("mysqlx.") + xmysqlnd_perf_op_names[span.op] },
+		{ "span_id", span_id },
+		{ "kind", "client" },
+		{ "start_time_unix_nano", xmysqlnd_trace_to_unix_ns(span.send_ns) },
+		{ "end_time_unix_nano", xmysqlnd_trace_to_unix_ns(span.last_byte_ns) },
+		{ "attributes", attributes }
+	};
+}
+
+} // anonymous namespace
+
+void mysqlx_minfo_statistics()
+{
+	const Perf_statistics& perf_stats{ MYSQL_XDEVAPI_G(perf_statistics) };
+
+	php_info_print_table_start();
+	php_info_print_table_header(5, "Operation", "Count", "p50 (us)", "p99 (us)", "Max (us)");
+	for (int op{0}; op < XMYSQLND_PERF_OP_LAST; ++op) {
+		const Latency_histogram& histogram{ perf_stats.latency[op] };
+		php_info_print_table_row(5,
+			xmysqlnd_perf_op_names[op],
+			std::to_string(histogram.get_count()).c_str(),
+			std::to_string(histogram.get_percentile(50.0)).c_str(),
+			std::to_string(histogram.get_percentile(99.0)).c_str(),
+			std::to_string(histogram.get_max()).c_str());
+	}
+	php_info_print_table_end();
+
+	php_info_print_table_start();
+	php_info_print_table_header(2, "Counter", "Value");
+	for (int counter{0}; counter < XMYSQLND_PERF_LAST; ++counter) {
+		php_info_print_table_row(2,
+			xmysqlnd_perf_counter_names[counter],
+			std::to_string(perf_stats.counters[counter]).c_str());
+	}
+	php_info_print_table_end();
+}
+
+MYSQL_XDEVAPI_PHP_FUNCTION(mysql_xdevapi_getStatistics)
+{
+	zend_bool reset{FALSE};
+
+	DBG_ENTER("mysql_xdevapi_getStatistics");
+	if (FAILURE == util::get_function_arguments(execute_data, "|b", &reset)) {
+		DBG_VOID_RETURN;
+	}
+
+	Perf_statistics& perf_stats{ MYSQL_XDEVAPI_G(perf_statistics) };
+
+	util::zvalue latency(util::zvalue::create_array(XMYSQLND_PERF_OP_LAST));
+	for (int op{0}; op < XMYSQLND_PERF_OP_LAST; ++op) {
+		latency.insert(xmysqlnd_perf_op_names[op], get_latency_summary(perf_stats.latency[op]));
+	}
+
+	const uint64_t* counters{ perf_stats.counters };
+	util::zvalue counters_info(util::zvalue::create_array(XMYSQLND_PERF_LAST + 3));
+	for (int counter{0}; counter < XMYSQLND_PERF_LAST; ++counter) {
+		counters_info.insert(xmysqlnd_perf_counter_names[counter], counters[counter]);
+	}
+	counters_info.insert("row_decode_avg_ns", get_ratio(
+		counters[XMYSQLND_PERF_ROWS_DECODE_SAMPLED_NS], counters[XMYSQLND_PERF_ROWS_DECODE_SAMPLED]));
+	counters_info.insert("compression_ratio", get_ratio(
+		counters[XMYSQLND_PERF_COMPRESS_BYTES_IN], counters[XMYSQLND_PERF_COMPRESS_BYTES_OUT]));
+	counters_info.insert("decompression_ratio", get_ratio(
+		counters[XMYSQLND_PERF_DECOMPRESS_BYTES_OUT], counters[XMYSQLND_PERF_DECOMPRESS_BYTES_IN]));
+
+	util::zvalue statistics{
+		{ "latency", std::move(latency) },
+		{ "counters", std::move(counters_info) }
+	};
+
+	if (reset) {
+		perf_stats.reset();
+	}
+
+	statistics.move_to(return_value);
+	DBG_VOID_RETURN;
+}
+
+MYSQL_XDEVAPI_PHP_FUNCTION(mysql_xdevapi_drainTraceSpans)
+{
+	DBG_ENTER("mysql_xdevapi_drainTraceSpans");
+	if (FAILURE == util::get_function_arguments(execute_data, "")) {
+		DBG_VOID_RETURN;
+	}
+
+	Trace_buffer& trace_buffer{ xmysqlnd_get_trace_buffer() };
+	const std::size_t spans_count{ trace_buffer.size() };
+	util::zvalue spans(util::zvalue::create_array(spans_count));
+	for (std::size_t i{0}; i < spans_count; ++i) {
+		spans.push_back(get_trace_span_info(trace_buffer.get(i)));
+	}
+
+	util::zvalue trace{
+		{ "spans", std::move(spans) },
+		{ "dropped", trace_buffer.get_dropped() }
+	};
+	trace_buffer.clear();
+
+	trace.move_to(return_value);
+	DBG_VOID_RETURN;
+}
+
+} // namespace devapi
+
+} // namespace mysqlx
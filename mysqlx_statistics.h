@@ -0,0 +1,43 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#ifndef MYSQLX_STATISTICS_H
+#define MYSQLX_STATISTICS_H
+
+namespace mysqlx {
+
+namespace devapi {
+
+void mysqlx_minfo_statistics();
+
+/*
+	returns latency histograms summary per operation and the throughput counters
+	collected by the current thread (or process), optionally resetting them
+*/
+PHP_FUNCTION(mysql_xdevapi_getStatistics);
+
+/*
+	returns the wire-level spans traced (see xmysqlnd.trace_sample_rate) by the
+	current thread (or process) since the previous call, oldest first
+*/
+PHP_FUNCTION(mysql_xdevapi_drainTraceSpans);
+
+} // namespace devapi
+
+} // namespace mysqlx
+
+#endif /* MYSQLX_STATISTICS_H */
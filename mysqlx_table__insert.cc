@@ -22,11 +22,13 @@
 #include "xmysqlnd/xmysqlnd_session.h"
 #include "xmysqlnd/xmysqlnd_schema.h"
 #include "xmysqlnd/xmysqlnd_stmt.h"
+#include "xmysqlnd/xmysqlnd_stmt_result.h"
 #include "xmysqlnd/xmysqlnd_table.h"
 #include "php_mysqlx.h"
 #include "mysqlx_exception.h"
 #include "mysqlx_class_properties.h"
 #include "mysqlx_executable.h"
+#include "mysqlx_result.h"
 #include "mysqlx_sql_statement.h"
 #include "mysqlx_table__insert.h"
 #include "util/allocator.h"
@@ -46,7 +48,7 @@ ZEND_END_ARG_INFO()
 
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_mysqlx_table__insert__values, 0, ZEND_RETURN_VALUE, 1)
-	MYSQL_XDEVAPI_ARG_VARIADIC_TYPE_INFO(no_pass_by_ref, row_values, IS_ARRAY, dont_allow_null)
+	MYSQL_XDEVAPI_ARG_VARIADIC_TYPE_INFO(no_pass_by_ref, row_values, IS_ITERABLE, dont_allow_null)
 ZEND_END_ARG_INFO()
 
 
@@ -68,6 +70,19 @@ st_mysqlx_table__insert::~st_mysqlx_table__insert()
 }
 
 
+static const enum_hnd_func_status
+mysqlx_table__insert_on_error(
+	void* /*context*/,
+	xmysqlnd_stmt* const /*stmt*/,
+	const unsigned int code,
+	const util::string_view& sql_state,
+	const util::string_view& message)
+{
+	DBG_ENTER("mysqlx_table__insert_on_error");
+	create_exception(code, sql_state, message);
+	DBG_RETURN(HND_PASS_RETURN_FAIL);
+}
+
 MYSQL_XDEVAPI_PHP_METHOD(mysqlx_table__insert, __construct)
 {
 	UNUSED_INTERNAL_FUNCTION_PARAMETERS();
@@ -133,11 +148,32 @@ MYSQL_XDEVAPI_PHP_METHOD(mysqlx_table__insert, execute)
 		if (FALSE == xmysqlnd_crud_table_insert__is_initialized(data_object.crud_op)) {
 			RAISE_EXCEPTION(err_msg_insert_fail);
 		} else {
-			xmysqlnd_stmt* stmt = data_object.table->insert(data_object.crud_op);
+			const st_xmysqlnd_stmt_on_error_bind on_error{ mysqlx_table__insert_on_error, nullptr };
+			xmysqlnd_stmt* stmt = data_object.table->insert(data_object.crud_op, on_error);
+			const uint64_t rows_inserted_before_failure{ data_object.crud_op->items_affected };
 			if (stmt) {
 				util::zvalue stmt_obj = create_stmt(stmt);
 				zend_long flags{0};
-				mysqlx_statement_execute_read_response(Z_MYSQLX_P(stmt_obj.ptr()), flags, MYSQLX_RESULT).move_to(return_value);
+				util::zvalue result{ mysqlx_statement_execute_read_response(Z_MYSQLX_P(stmt_obj.ptr()), flags, MYSQLX_RESULT) };
+				if (result.is_object()) {
+					auto& data_result{ util::fetch_data_object<st_mysqlx_result>(result.ptr()) };
+					// a deferred result needs no merge unless the rows went in several messages
+					const bool split_insert{ data_object.crud_op->items_affected || data_object.crud_op->last_insert_id };
+					if (!data_result.is_deferred() || split_insert) {
+						st_xmysqlnd_stmt_result* stmt_result{ data_result.get_result() };
+						if (stmt_result && stmt_result->exec_state) {
+							xmysqlnd_crud_table_insert__merge_batch_states(data_object.crud_op, stmt_result->exec_state);
+						}
+					}
+				}
+				result.move_to(return_value);
+			}
+			// batches which went through are not undone when a later one fails
+			if (Z_TYPE_P(return_value) != IS_OBJECT && rows_inserted_before_failure) {
+				php_error_docref(
+					nullptr, E_WARNING,
+					"Insert failed, but %llu row(s) sent in other batches were inserted",
+					static_cast<unsigned long long>(rows_inserted_before_failure));
 			}
 		}
 	}
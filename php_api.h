@@ -63,11 +63,23 @@ extern "C" {
 	ZEND_HASH_FOREACH_STR_KEY_VAL(ht, _key, _val) \
 	MYSQLX_RESTORE_WARNINGS()
 
+#define MYSQLX_HASH_FOREACH_KEY(ht, _h, _key) \
+	MYSQLX_SUPPRESS_MSVC_WARNINGS(4127) \
+	ZEND_HASH_FOREACH_KEY(ht, _h, _key) \
+	MYSQLX_RESTORE_WARNINGS()
+
+#define MYSQLX_HASH_FOREACH_KEY_VAL_IND(ht, _h, _key, _val) \
+	MYSQLX_SUPPRESS_MSVC_WARNINGS(4127) \
+	ZEND_HASH_FOREACH_KEY_VAL_IND(ht, _h, _key, _val) \
+	MYSQLX_RESTORE_WARNINGS()
+
 #else // UNIX OSes
 
 #define MYSQLX_HASH_FOREACH_VAL ZEND_HASH_FOREACH_VAL
 #define MYSQLX_HASH_FOREACH_PTR	ZEND_HASH_FOREACH_PTR
 #define MYSQLX_HASH_FOREACH_STR_KEY_VAL ZEND_HASH_FOREACH_STR_KEY_VAL
+#define MYSQLX_HASH_FOREACH_KEY ZEND_HASH_FOREACH_KEY
+#define MYSQLX_HASH_FOREACH_KEY_VAL_IND ZEND_HASH_FOREACH_KEY_VAL_IND
 
 #endif
 
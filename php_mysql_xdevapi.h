@@ -18,7 +18,7 @@
 #ifndef PHP_MYSQL_XDEVAPI_H
 #define PHP_MYSQL_XDEVAPI_H
 
-#define PHP_MYSQL_XDEVAPI_VERSION "8.0.27"
+#define PHP_MYSQL_XDEVAPI_VERSION "8.0.28"
 #define MYSQL_XDEVAPI_VERSION_ID 80027
 #define PHP_MYSQL_XDEVAPI_LICENSE "PHP License, version 3.01"
 #define PHP_MYSQL_XDEVAPI_NAME   "mysql-connector-php"
@@ -30,9 +30,12 @@ extern "C" {
 #include "xmysqlnd/xmysqlnd_priv.h"
 #include "php_mysqlx.h"
 #include "php_mysqlx_ex.h"
+#include "mysqlx_benchmark.h"
 #include "mysqlx_client.h"
 #include "mysqlx_expression.h"
+#include "mysqlx_fake_server.h"
 #include "mysqlx_session.h"
+#include "mysqlx_statistics.h"
 #include <string>
 
 extern "C" {
@@ -50,10 +53,16 @@ PHP_MINFO_FUNCTION(mysql_xdevapi)
 
 	php_info_print_table_row(2, "Collecting statistics", MYSQL_XDEVAPI_G(collect_statistics)? "Yes":"No");
 	php_info_print_table_row(2, "Collecting memory statistics", MYSQL_XDEVAPI_G(collect_memory_statistics)? "Yes":"No");
+	php_info_print_table_row(2, "Collecting performance statistics", MYSQL_XDEVAPI_G(collect_perf_statistics)? "Yes":"No");
 
 	php_info_print_table_row(2, "Tracing", MYSQL_XDEVAPI_G(debug)? MYSQL_XDEVAPI_G(debug):"n/a");
+	php_info_print_table_row(2, "Wire tracing sample rate", std::to_string(MYSQL_XDEVAPI_G(trace_sample_rate)).c_str());
 
 	php_info_print_table_end();
+
+	if (MYSQL_XDEVAPI_G(collect_perf_statistics)) {
+		mysqlx::devapi::mysqlx_minfo_statistics();
+	}
 }
 
 PHP_MYSQL_XDEVAPI_API ZEND_DECLARE_MODULE_GLOBALS(mysql_xdevapi)
@@ -68,6 +77,7 @@ static PHP_GINIT_FUNCTION(mysql_xdevapi)
 
 	mysql_xdevapi_globals->collect_statistics = TRUE;
 	mysql_xdevapi_globals->collect_memory_statistics = FALSE;
+	mysql_xdevapi_globals->collect_perf_statistics = FALSE;
 	mysql_xdevapi_globals->debug = nullptr;	/* The actual string */
 	mysql_xdevapi_globals->dbg = nullptr;	/* The DBG object*/
 	mysql_xdevapi_globals->trace_alloc_settings = nullptr;
@@ -80,15 +90,48 @@ static PHP_GINIT_FUNCTION(mysql_xdevapi)
 	mysql_xdevapi_globals->debug_malloc_fail_threshold = -1;
 	mysql_xdevapi_globals->debug_calloc_fail_threshold = -1;
 	mysql_xdevapi_globals->debug_realloc_fail_threshold = -1;
+	mysql_xdevapi_globals->trace_sample_rate = 0;
+	mysql_xdevapi_globals->trace_buffer_size = 1024;
+	mysql_xdevapi_globals->capture_dir = nullptr;
+	mysql_xdevapi_globals->capture_sequence = 0;
+	mysql_xdevapi_globals->replay_file = nullptr;
+	mysql_xdevapi_globals->replay_pacing = FALSE;
+	mysql_xdevapi_globals->insert_batch_size = 0;
+	mysql_xdevapi_globals->insert_pipelining = FALSE;
+	mysql_xdevapi_globals->lookup_batch_size = 1048576;
+	mysql_xdevapi_globals->lazy_rows = FALSE;
+	mysql_xdevapi_globals->server_info_ttl = 60;
+	mysql_xdevapi_globals->perf_statistics.reset();
+	mysql_xdevapi_globals->trace_buffer.init();
+	mysql_xdevapi_globals->fake_server = nullptr;
+}
+
+static PHP_GSHUTDOWN_FUNCTION(mysql_xdevapi)
+{
+	mysql_xdevapi_globals->trace_buffer.release();
+#ifdef MYSQL_XDEVAPI_DEV_MODE
+	mysqlx::devapi::mysqlx_release_fake_server(mysql_xdevapi_globals->fake_server);
+#endif
 }
 
 PHP_INI_BEGIN()
 	STD_PHP_INI_BOOLEAN("xmysqlnd.collect_statistics",	"1", 	PHP_INI_ALL,	OnUpdateBool,	collect_statistics, 		zend_mysql_xdevapi_globals, mysql_xdevapi_globals)
 	STD_PHP_INI_BOOLEAN("xmysqlnd.collect_memory_statistics","0",PHP_INI_SYSTEM,OnUpdateBool,	collect_memory_statistics,	zend_mysql_xdevapi_globals, mysql_xdevapi_globals)
+	STD_PHP_INI_BOOLEAN("xmysqlnd.collect_perf_statistics","0",	PHP_INI_ALL,	OnUpdateBool,	collect_perf_statistics,	zend_mysql_xdevapi_globals, mysql_xdevapi_globals)
 	STD_PHP_INI_ENTRY("xmysqlnd.debug",					nullptr, 	PHP_INI_SYSTEM, OnUpdateString,	debug,						zend_mysql_xdevapi_globals, mysql_xdevapi_globals)
 	STD_PHP_INI_ENTRY("xmysqlnd.trace_alloc",			nullptr, 	PHP_INI_SYSTEM, OnUpdateString,	trace_alloc_settings,		zend_mysql_xdevapi_globals, mysql_xdevapi_globals)
 	STD_PHP_INI_ENTRY("xmysqlnd.net_read_timeout",	"31536000",	PHP_INI_SYSTEM, OnUpdateLong,	net_read_timeout,			zend_mysql_xdevapi_globals, mysql_xdevapi_globals)
 	STD_PHP_INI_ENTRY("xmysqlnd.mempool_default_size","16000",   PHP_INI_ALL,	OnUpdateLong,	mempool_default_size,		zend_mysql_xdevapi_globals, mysql_xdevapi_globals)
+	STD_PHP_INI_ENTRY("xmysqlnd.trace_sample_rate",	"0",		PHP_INI_ALL,	OnUpdateLong,	trace_sample_rate,			zend_mysql_xdevapi_globals, mysql_xdevapi_globals)
+	STD_PHP_INI_ENTRY("xmysqlnd.trace_buffer_size",	"1024",		PHP_INI_SYSTEM, OnUpdateLong,	trace_buffer_size,			zend_mysql_xdevapi_globals, mysql_xdevapi_globals)
+	STD_PHP_INI_ENTRY("xmysqlnd.capture_dir",		nullptr,	PHP_INI_SYSTEM,	OnUpdateString,	capture_dir,				zend_mysql_xdevapi_globals, mysql_xdevapi_globals)
+	STD_PHP_INI_ENTRY("xmysqlnd.replay_file",		nullptr,	PHP_INI_SYSTEM,	OnUpdateString,	replay_file,				zend_mysql_xdevapi_globals, mysql_xdevapi_globals)
+	STD_PHP_INI_BOOLEAN("xmysqlnd.replay_pacing",	"0",		PHP_INI_ALL,	OnUpdateBool,	replay_pacing,				zend_mysql_xdevapi_globals, mysql_xdevapi_globals)
+	STD_PHP_INI_ENTRY("xmysqlnd.insert_batch_size",	"0",		PHP_INI_ALL,	OnUpdateLong,	insert_batch_size,			zend_mysql_xdevapi_globals, mysql_xdevapi_globals)
+	STD_PHP_INI_BOOLEAN("xmysqlnd.insert_pipelining",	"0",		PHP_INI_ALL,	OnUpdateBool,	insert_pipelining,			zend_mysql_xdevapi_globals, mysql_xdevapi_globals)
+	STD_PHP_INI_ENTRY("xmysqlnd.lookup_batch_size",	"1048576",	PHP_INI_ALL,	OnUpdateLong,	lookup_batch_size,			zend_mysql_xdevapi_globals, mysql_xdevapi_globals)
+	STD_PHP_INI_BOOLEAN("xmysqlnd.lazy_rows",	"0",		PHP_INI_ALL,	OnUpdateBool,	lazy_rows,					zend_mysql_xdevapi_globals, mysql_xdevapi_globals)
+	STD_PHP_INI_ENTRY("xmysqlnd.server_info_ttl",	"60",		PHP_INI_ALL,	OnUpdateLong,	server_info_ttl,			zend_mysql_xdevapi_globals, mysql_xdevapi_globals)
 #if PHP_DEBUG
 	STD_PHP_INI_ENTRY("xmysqlnd.debug_emalloc_fail_threshold","-1",   PHP_INI_SYSTEM,	OnUpdateLong,	debug_emalloc_fail_threshold,	zend_mysql_xdevapi_globals,		mysql_xdevapi_globals)
 	STD_PHP_INI_ENTRY("xmysqlnd.debug_ecalloc_fail_threshold","-1",   PHP_INI_SYSTEM,	OnUpdateLong,	debug_ecalloc_fail_threshold,	zend_mysql_xdevapi_globals,		mysql_xdevapi_globals)
@@ -190,6 +233,28 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_mysql_xdevapi__expression, 0, ZEND_RETURN_VALUE,
 	ZEND_ARG_TYPE_INFO(0, expression, IS_STRING, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysql_xdevapi__get_statistics, 0, ZEND_RETURN_VALUE, 0)
+	ZEND_ARG_TYPE_INFO(0, reset, _IS_BOOL, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysql_xdevapi__drain_trace_spans, 0, ZEND_RETURN_VALUE, 0)
+ZEND_END_ARG_INFO()
+
+#ifdef MYSQL_XDEVAPI_DEV_MODE
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysql_xdevapi__benchmark, 0, ZEND_RETURN_VALUE, 1)
+	ZEND_ARG_TYPE_INFO(0, case_name, IS_STRING, 0)
+	ZEND_ARG_TYPE_INFO(0, iterations, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO(0, repeats, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysql_xdevapi__start_fake_server, 0, ZEND_RETURN_VALUE, 0)
+	ZEND_ARG_TYPE_INFO(0, options, IS_ARRAY, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_mysql_xdevapi__stop_fake_server, 0, ZEND_RETURN_VALUE, 0)
+ZEND_END_ARG_INFO()
+#endif
+
 /*
   We need a proper macro, that is included in all mysqlx_ files which register classes by using INIT_NS_CLASS_ENTRY.
   For now we use in these files const string "Mysqlx".
@@ -200,6 +265,13 @@ static const zend_function_entry mysqlx_functions[] = {
 	ZEND_NS_NAMED_FE(MYSQL_XDEVAPI_NAMESPACE, getSession, mysqlx::devapi::ZEND_FN(mysql_xdevapi_getSession), arginfo_mysql_xdevapi__get_session)
 	ZEND_NS_NAMED_FE(MYSQL_XDEVAPI_NAMESPACE, getClient, mysqlx::devapi::ZEND_FN(mysql_xdevapi_getClient), arginfo_mysql_xdevapi__get_client)
 	ZEND_NS_NAMED_FE(MYSQL_XDEVAPI_NAMESPACE, expression, mysqlx::devapi::ZEND_FN(mysql_xdevapi__expression), arginfo_mysql_xdevapi__expression)
+	ZEND_NS_NAMED_FE(MYSQL_XDEVAPI_NAMESPACE, getStatistics, mysqlx::devapi::ZEND_FN(mysql_xdevapi_getStatistics), arginfo_mysql_xdevapi__get_statistics)
+	ZEND_NS_NAMED_FE(MYSQL_XDEVAPI_NAMESPACE, drainTraceSpans, mysqlx::devapi::ZEND_FN(mysql_xdevapi_drainTraceSpans), arginfo_mysql_xdevapi__drain_trace_spans)
+#ifdef MYSQL_XDEVAPI_DEV_MODE
+	ZEND_NS_NAMED_FE(MYSQL_XDEVAPI_NAMESPACE, benchmark, mysqlx::devapi::ZEND_FN(mysql_xdevapi__benchmark), arginfo_mysql_xdevapi__benchmark)
+	ZEND_NS_NAMED_FE(MYSQL_XDEVAPI_NAMESPACE, startFakeServer, mysqlx::devapi::ZEND_FN(mysql_xdevapi__startFakeServer), arginfo_mysql_xdevapi__start_fake_server)
+	ZEND_NS_NAMED_FE(MYSQL_XDEVAPI_NAMESPACE, stopFakeServer, mysqlx::devapi::ZEND_FN(mysql_xdevapi__stopFakeServer), arginfo_mysql_xdevapi__stop_fake_server)
+#endif
 	PHP_FE_END
 };
 
@@ -233,7 +305,7 @@ zend_module_entry mysql_xdevapi_module_entry = {
 	PHP_MYSQL_XDEVAPI_VERSION,
 	PHP_MODULE_GLOBALS(mysql_xdevapi),
 	PHP_GINIT(mysql_xdevapi),
-	nullptr,
+	PHP_GSHUTDOWN(mysql_xdevapi),
 	nullptr,
 	STANDARD_MODULE_PROPERTIES_EX
 };
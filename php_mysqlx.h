@@ -19,6 +19,10 @@
 #define PHP_MYSQLX_H
 
 #include "php_mysql_xdevapi.h"
+#include "xmysqlnd/xmysqlnd_perf_statistics.h"
+#include "xmysqlnd/xmysqlnd_trace.h"
+
+namespace mysqlx { namespace drv { class Fake_server; } }
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,6 +40,7 @@ extern zend_module_entry mysql_xdevapi_module_entry;
 ZEND_BEGIN_MODULE_GLOBALS(mysql_xdevapi)
 	zend_bool		collect_statistics;
 	zend_bool		collect_memory_statistics;
+	zend_bool		collect_perf_statistics;
 	char *			debug;					/* The actual string */
 	MYSQLND_DEBUG *	dbg;					/* The DBG object for standard tracing */
 	char *			trace_alloc_settings;	/* The actual string */
@@ -48,6 +53,20 @@ ZEND_BEGIN_MODULE_GLOBALS(mysql_xdevapi)
 	zend_long		debug_malloc_fail_threshold;
 	zend_long		debug_calloc_fail_threshold;
 	zend_long		debug_realloc_fail_threshold;
+	zend_long		trace_sample_rate;
+	zend_long		trace_buffer_size;
+	char *			capture_dir;
+	zend_ulong		capture_sequence;
+	char *			replay_file;
+	zend_bool		replay_pacing;
+	zend_long		insert_batch_size;
+	zend_bool		insert_pipelining;
+	zend_long		lookup_batch_size;
+	zend_bool		lazy_rows;
+	zend_long		server_info_ttl;
+	mysqlx::drv::Perf_statistics	perf_statistics;
+	mysqlx::drv::Trace_buffer		trace_buffer;
+	mysqlx::drv::Fake_server*		fake_server;
 ZEND_END_MODULE_GLOBALS(mysql_xdevapi)
 
 
@@ -42,6 +42,7 @@
 #include "mysqlx_base_result.h"
 #include "mysqlx_doc_result.h"
 #include "mysqlx_result.h"
+#include "mysqlx_row.h"
 #include "mysqlx_row_result.h"
 #include "mysqlx_sql_statement_result.h"
 #include "mysqlx_column_result.h"
@@ -105,6 +106,7 @@ mysqlx_minit_classes(INIT_FUNC_ARGS)
 	mysqlx_register_base_result_interface(INIT_FUNC_ARGS_PASSTHRU, &mysqlx_std_object_handlers);
 	mysqlx_register_doc_result_class(INIT_FUNC_ARGS_PASSTHRU, &mysqlx_std_object_handlers);
 	mysqlx_register_result_class(INIT_FUNC_ARGS_PASSTHRU, &mysqlx_std_object_handlers);
+	mysqlx_register_row_class(INIT_FUNC_ARGS_PASSTHRU, &mysqlx_std_object_handlers);
 	mysqlx_register_row_result_class(INIT_FUNC_ARGS_PASSTHRU, &mysqlx_std_object_handlers);
 	mysqlx_register_sql_statement_result_class(INIT_FUNC_ARGS_PASSTHRU, &mysqlx_std_object_handlers);
 	mysqlx_register_column_result_class(INIT_FUNC_ARGS_PASSTHRU, &mysqlx_std_object_handlers);
@@ -176,6 +178,7 @@ mysqlx_mshutdown_classes(SHUTDOWN_FUNC_ARGS)
 	mysqlx_unregister_table_class(SHUTDOWN_FUNC_ARGS_PASSTHRU);
 	mysqlx_unregister_sql_statement_result_class(SHUTDOWN_FUNC_ARGS_PASSTHRU);
 	mysqlx_unregister_row_result_class(SHUTDOWN_FUNC_ARGS_PASSTHRU);
+	mysqlx_unregister_row_class(SHUTDOWN_FUNC_ARGS_PASSTHRU);
 	mysqlx_unregister_result_class(SHUTDOWN_FUNC_ARGS_PASSTHRU);
 	mysqlx_unregister_doc_result_class(SHUTDOWN_FUNC_ARGS_PASSTHRU);
 	mysqlx_unregister_base_result_interface(SHUTDOWN_FUNC_ARGS_PASSTHRU);
@@ -0,0 +1,89 @@
+--TEST--
+mysqlx client execute sql statements in parallel on pooled sessions
+--SKIPIF--
+--INI--
+error_reporting=E_ALL
+default_socket_timeout=4
+--FILE--
+<?php
+require_once(__DIR__."/../connect.inc");
+require_once(__DIR__."/client_utils.inc");
+
+$pooling_options = '{
+	"enabled": true,
+	"maxSize": 3,
+	"queueTimeOut": 1000
+}';
+
+$session = create_test_db();
+fill_db_table();
+
+$client = mysql_xdevapi\getClient($connection_uri, $pooling_options);
+
+// results come back in the order of the statements
+$statements = [];
+for ($i = 0; $i < 20; ++$i) {
+	$statements[] = "SELECT $i AS n, CONNECTION_ID() AS conn";
+}
+$results = $client->executeParallel($statements, 4);
+expect_eq(count($results), 20);
+$connections = [];
+foreach ($results as $i => $res) {
+	$row = $res->fetchOne();
+	expect_eq($row['n'], $i);
+	$connections[$row['conn']] = true;
+}
+// no more sessions than the pool allows
+expect_eq(count($connections), 3);
+
+// bound params
+$results = $client->executeParallel([
+	"SELECT COUNT(*) AS c FROM $db.$test_table_name",
+	["SELECT name FROM $db.$test_table_name WHERE age = ? ORDER BY name", [11]],
+	["SELECT name FROM $db.$test_table_name WHERE age > ? AND job = ? ORDER BY name", [16, 'teacher']],
+]);
+expect_eq($results[0]->fetchOne()['c'], 12);
+expect_eq($results[1]->fetchAll(), [['name' => 'Eulalia'], ['name' => 'Mamie']]);
+expect_eq($results[2]->fetchAll(), [['name' => 'Romy']]);
+
+expect_eq($client->executeParallel([]), []);
+
+// a failing statement is reported, the sessions go back to the pool usable
+try {
+	$client->executeParallel([
+		"SELECT 1",
+		"SELECT * FROM $db.no_such_table",
+		"SELECT 3",
+		"SELECT 4",
+	], 2);
+	test_step_failed();
+} catch(Exception $e) {
+	test_step_ok();
+}
+$results = $client->executeParallel(["SELECT 1 AS n", "SELECT 2 AS n", "SELECT 3 AS n"], 3);
+expect_eq($results[2]->fetchOne()['n'], 3);
+
+try {
+	$client->executeParallel(["SELECT 1"], 0);
+	test_step_failed();
+} catch(Exception $e) {
+	test_step_ok();
+}
+
+try {
+	$client->executeParallel([42]);
+	test_step_failed();
+} catch(Exception $e) {
+	test_step_ok();
+}
+
+verify_expectations();
+print "done!\n";
+?>
+--CLEAN--
+<?php
+	require_once(__DIR__."/../connect.inc");
+	clean_test_db();
+?>
+--EXPECTF--
+done!%A
@@ -0,0 +1,63 @@
+--TEST--
+mysqlx client metadata cache
+--SKIPIF--
+--FILE--
+<?php
+	require("connect.inc");
+
+	create_test_db();
+
+	$client = mysql_xdevapi\getClient($connection_uri, '{"metadataCacheTtl": 600000}');
+	$session = $client->getSession();
+	$schema = $session->getSchema($db);
+
+	expect_true($schema->existsInDatabase());
+	expect_true($schema->getCollection($test_collection_name)->existsInDatabase());
+	expect_true($schema->getTable($test_table_name)->existsInDatabase());
+	expect_false($schema->getTable($test_table_name)->isView());
+	expect_false($schema->getCollection("cached_coll")->existsInDatabase());
+
+	// DDL through the client updates the cache
+	$schema->createCollection("cached_coll");
+	expect_true($schema->getCollection("cached_coll")->existsInDatabase());
+	$collections_count = count($schema->getCollections());
+	$schema->dropCollection("cached_coll");
+	expect_false($schema->getCollection("cached_coll")->existsInDatabase());
+	expect_eq(count($schema->getCollections()), $collections_count - 1);
+
+	// ...and is shared by the sessions of the client
+	$session2 = $client->getSession();
+	$session2->getSchema($db)->createCollection("shared_coll");
+	expect_true($schema->getCollection("shared_coll")->existsInDatabase());
+
+	// plain SQL DDL is seen only after invalidation
+	$session->sql("CREATE TABLE $db.cached_tab(id INT)")->execute();
+	expect_false($schema->getTable("cached_tab")->existsInDatabase());
+	$client->invalidateMetadataCache();
+	expect_true($schema->getTable("cached_tab")->existsInDatabase());
+
+	$session->createSchema("cached_schema");
+	expect_true($session->getSchema("cached_schema")->existsInDatabase());
+	$session->dropSchema("cached_schema");
+	expect_false($session->getSchema("cached_schema")->existsInDatabase());
+
+	try {
+		mysql_xdevapi\getClient($base_uri, '{"metadataCacheTtl": -1}');
+		test_step_failed();
+	} catch (Exception $e) {
+		test_step_ok();
+	}
+
+	$client->close();
+
+	verify_expectations();
+	print "done!".PHP_EOL;
+?>
+--CLEAN--
+<?php
+	require("connect.inc");
+	clean_test_db();
+	clean_test_db("cached_schema");
+?>
+--EXPECTF--
+done!%A
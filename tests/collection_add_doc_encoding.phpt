@@ -0,0 +1,114 @@
+--TEST--
+mysqlx collection add - documents serialization
+--SKIPIF--
+--INI--
+error_reporting=0
+--FILE--
+<?php
+require_once("connect.inc");
+
+class Serializable_doc implements JsonSerializable {
+	public function jsonSerialize() {
+		return ["_id" => "serializable", "kind" => "serializable"];
+	}
+}
+
+$session = create_test_db();
+$schema = $session->getSchema($db);
+$coll = $schema->getCollection($test_collection_name);
+
+$nested = new stdClass();
+$nested->list = [1, 2, 3];
+$nested->map = [5 => "five", "six" => 6];
+
+$coll->add(
+	["_id" => "1", "name" => "Zażółć gęślą jaźń", "price" => 1.25, "tags" => ["a", "b"], "empty" => []],
+	["_id" => "2", "nested" => $nested, "flag" => true, "none" => null, "path" => "a/b\"c"],
+	'{"_id": "3", "big": 12345678901234567890, "nested": {"x": [1, {"y": 2}]}}',
+	new Serializable_doc())->execute();
+
+$doc = $coll->getOne("1");
+expect_eq($doc["name"], "Zażółć gęślą jaźń");
+expect_eq($doc["price"], 1.25);
+expect_eq($doc["tags"], ["a", "b"]);
+expect_eq($doc["empty"], []);
+
+$doc = $coll->getOne("2");
+expect_eq($doc["nested"]["list"], [1, 2, 3]);
+expect_eq($doc["nested"]["map"]["5"], "five");
+expect_eq($doc["nested"]["map"]["six"], 6);
+expect_true($doc["flag"]);
+expect_null($doc["none"]);
+expect_eq($doc["path"], "a/b\"c");
+
+$doc = $coll->getOne("3");
+expect_eq($doc["nested"]["x"][1]["y"], 2);
+
+$doc = $coll->getOne("serializable");
+expect_eq($doc["kind"], "serializable");
+
+// _id injected while serializing, the one from document is overwritten
+$coll->addOrReplaceOne("10", ["_id" => "other", "list" => [1, 2]]);
+$doc = $coll->getOne("10");
+expect_eq($doc["_id"], "10");
+expect_eq($doc["list"], [1, 2]);
+expect_null($coll->getOne("other"));
+
+$coll->addOrReplaceOne("11", '{"a": {"_id": "inner"}, "_id": "outer"}');
+$doc = $coll->getOne("11");
+expect_eq($doc["_id"], "11");
+expect_eq($doc["a"]["_id"], "inner");
+
+$coll->addOrReplaceOne("12", new Serializable_doc());
+$doc = $coll->getOne("12");
+expect_eq($doc["_id"], "12");
+expect_eq($doc["kind"], "serializable");
+
+// lengths of the rows take from one to four bytes on the wire
+$sizes = [0, 100, 20000, 3000000];
+foreach ($sizes as $i => $size) {
+	$coll->add(["_id" => "size" . $i, "data" => str_repeat("x", $size)])->execute();
+}
+foreach ($sizes as $i => $size) {
+	expect_eq(strlen($coll->getOne("size" . $i)["data"]), $size);
+}
+$res = $coll->add(
+	["_id" => "many1", "data" => str_repeat("y", 300)],
+	["_id" => "many2", "data" => "z"],
+	["_id" => "many3", "data" => str_repeat("w", 70000)])->execute();
+expect_eq($res->getAffectedItemsCount(), 3);
+expect_eq(strlen($coll->getOne("many3")["data"]), 70000);
+
+// invalid documents
+try {
+	$coll->add(["value" => NAN])->execute();
+	test_step_failed();
+} catch(Exception $e) {
+	test_step_ok();
+}
+
+try {
+	$coll->add(["value" => "\xff\xfe"])->execute();
+	test_step_failed();
+} catch(Exception $e) {
+	test_step_ok();
+}
+
+try {
+	$coll->addOrReplaceOne("13", '{"broken": ');
+	test_step_failed();
+} catch(Exception $e) {
+	test_step_ok();
+}
+expect_null($coll->getOne("13"));
+
+verify_expectations();
+print "done!\n";
+?>
+--CLEAN--
+<?php
+	require_once("connect.inc");
+	clean_test_db();
+?>
+--EXPECTF--
+done!%A
@@ -0,0 +1,101 @@
+--TEST--
+mysqlx collection addOrReplaceMany
+--SKIPIF--
+--INI--
+error_reporting=0
+xmysqlnd.insert_batch_size=256
+--FILE--
+<?php
+	require("connect.inc");
+
+	function generate_docs($count, $base = 0) {
+		for ($i = 0; $i < $count; ++$i) {
+			yield sprintf("gen-%05d", $i) => [ "ordinal" => $base + $i, "payload" => str_repeat("p", 40) ];
+		}
+	}
+
+	function throwing_docs() {
+		yield "before-throw" => [ "ordinal" => 1 ];
+		throw new Exception("doc source failed");
+	}
+
+	$session = create_test_db();
+	$coll = fill_test_collection(true);
+
+	// added ones count once, replaced ones twice, numeric keys are ids as well
+	$res = $coll->addOrReplaceMany([
+		1 => [ "name" => "Marco", "age" => 20, "job" => "Cantante" ],
+		"2" => '{"name": "Lonardo", "age": 36, "job": "Paninaro"}',
+		"1000" => [ "name" => "Nuovo", "age" => 1, "job" => "Neonato" ],
+	]);
+	expect_eq($res->getAffectedItemsCount(), 5);
+	expect_eq($coll->getOne(1)["age"], 20);
+	expect_eq($coll->getOne(2)["age"], 36);
+	expect_eq($coll->getOne("1000")["name"], "Nuovo");
+	expect_eq($coll->getOne("1000")["_id"], "1000");
+	expect_eq($coll->getOne(3)["name"], "Riccardo");
+
+	// the key wins over the _id of the document
+	$coll->addOrReplaceMany([ "1001" => [ "_id" => "other", "name" => "Altro" ] ]);
+	expect_eq($coll->getOne("1001")["name"], "Altro");
+	expect_null($coll->getOne("other"));
+
+	// documents of about 80 bytes each, streamed from a generator in many messages
+	$res = $coll->addOrReplaceMany(generate_docs(500));
+	expect_eq($res->getAffectedItemsCount(), 500);
+	expect_eq($coll->getOne("gen-00321")["ordinal"], 321);
+
+	$res = $coll->addOrReplaceMany(generate_docs(600, 1000));
+	expect_eq($res->getAffectedItemsCount(), 1100);
+	expect_eq($coll->getOne("gen-00321")["ordinal"], 1321);
+	expect_eq(count($coll->getMany(["gen-00000", "gen-00499", "gen-00599"])), 3);
+
+	ini_set('xmysqlnd.insert_batch_size', 0);
+	$docs = [];
+	foreach (generate_docs(100) as $id => $doc) {
+		$doc["ordinal"] += 10000;
+		$docs[$id] = $doc;
+	}
+	$res = $coll->addOrReplaceMany($docs);
+	expect_eq($res->getAffectedItemsCount(), 200);
+	expect_eq($coll->getOne("gen-00042")["ordinal"], 10042);
+	ini_set('xmysqlnd.insert_batch_size', 256);
+
+	expect_null($coll->addOrReplaceMany([]));
+
+	// invalid documents and ids
+	try {
+		$coll->addOrReplaceMany([ "bad-doc" => 42 ]);
+		test_step_failed();
+	} catch(Exception $e) {
+		test_step_ok();
+	}
+	expect_null($coll->getOne("bad-doc"));
+
+	try {
+		$coll->addOrReplaceMany("not iterable");
+		test_step_failed();
+	} catch(Throwable $e) {
+		test_step_ok();
+	}
+
+	// an exception thrown by the document source goes through
+	try {
+		$coll->addOrReplaceMany(throwing_docs());
+		test_step_failed();
+	} catch(Exception $e) {
+		expect_eq($e->getMessage(), "doc source failed");
+	}
+	expect_null($coll->getOne("before-throw"));
+	expect_eq($session->sql("SELECT 1")->execute()->fetchOne()["1"], 1);
+
+	verify_expectations();
+	print "done!\n";
+?>
+--CLEAN--
+<?php
+	require("connect.inc");
+	clean_test_db();
+?>
+--EXPECTF--
+done!%A
@@ -0,0 +1,64 @@
+--TEST--
+mysqlx collection find - documents decoding
+--SKIPIF--
+--INI--
+error_reporting=0
+--FILE--
+<?php
+require_once("connect.inc");
+
+$session = create_test_db();
+$schema = $session->getSchema($db);
+$coll = $schema->getCollection($test_collection_name);
+
+$coll->add(
+	'{"_id": "1", "name": "Zażółć gęślą jaźń", "price": 1.25, "exp": 1e3, "neg": -0, "tags": ["a", "b"], "empty": {}, "list": []}',
+	'{"_id": "2", "map": {"5": "five", "six": 6, "": "empty"}, "flag": true, "none": null, "esc": "a\"b\\cé😀"}',
+	'{"_id": "3", "big": 12345678901234567890, "min": -9223372036854775808, "nested": {"x": [1, {"y": [[], [2.5]]}]}}')->execute();
+
+// documents decoded by DocResult match the ones decoded by ext/json
+$raw_docs = $session->sql("SELECT doc FROM $db.$test_collection_name ORDER BY _id")->execute()->fetchAll();
+$expected_docs = [];
+foreach ($raw_docs as $raw_doc) {
+	$expected_docs[] = json_decode($raw_doc["doc"], true);
+}
+expect_eq(count($expected_docs), 3);
+
+$docs = $coll->find()->sort("_id")->execute()->fetchAll();
+expect_eq($docs, $expected_docs);
+
+$res = $coll->find()->sort("_id")->execute();
+foreach ($expected_docs as $expected_doc) {
+	expect_eq($res->fetchOne(), $expected_doc);
+}
+expect_null($res->fetchOne());
+
+$i = 0;
+foreach ($coll->find()->sort("_id")->execute() as $doc) {
+	expect_eq($doc, $expected_docs[$i++]);
+}
+expect_eq($i, 3);
+
+expect_eq($coll->getOne("2"), $expected_docs[1]);
+
+$doc = $docs[2];
+expect_true(is_float($doc["big"]));
+expect_true(is_int($doc["min"]));
+expect_eq($doc["nested"]["x"][1]["y"][1][0], 2.5);
+expect_eq($docs[1]["map"][5], "five");
+expect_eq($docs[1]["map"][""], "empty");
+
+// projection
+$docs = $coll->find("_id = '1'")->fields(["name", "tags"])->execute()->fetchAll();
+expect_eq($docs, [["name" => "Zażółć gęślą jaźń", "tags" => ["a", "b"]]]);
+
+verify_expectations();
+print "done!\n";
+?>
+--CLEAN--
+<?php
+	require_once("connect.inc");
+	clean_test_db();
+?>
+--EXPECTF--
+done!%A
@@ -0,0 +1,99 @@
+--TEST--
+mysqlx collection getMany / removeMany
+--SKIPIF--
+--INI--
+error_reporting=0
+xmysqlnd.lookup_batch_size=64
+--FILE--
+<?php
+	require("connect.inc");
+
+	$session = create_test_db();
+	$coll = fill_test_collection(true);
+
+	// keyed by id in the order of the ids requested, missing and repeated ids are skipped
+	$docs = $coll->getMany(["3", "1", "1000", "2", "3"]);
+	expect_eq(count($docs), 3);
+	expect_eq(array_keys($docs), [3, 1, 2]);
+	expect_eq($docs[3]["name"], "Riccardo");
+	expect_eq($docs[1]["name"], "Marco");
+	expect_eq($docs["2"]["name"], "Lonardo");
+
+	expect_eq($coll->getMany([]), []);
+	expect_eq($coll->getMany(["1000", "1001"]), []);
+
+	// ids of about 20 bytes each, split into many messages
+	$ids = [];
+	for ($i = 0; $i < 200; ++$i) {
+		$id = sprintf("many-%015d", $i);
+		$coll->add(["_id" => $id, "ordinal" => 1000 + $i])->execute();
+		$ids[] = $id;
+	}
+	$docs = $coll->getMany($ids);
+	expect_eq(count($docs), 200);
+	expect_eq(array_keys($docs), $ids);
+	expect_eq($docs["many-000000000123"]["ordinal"], 1123);
+
+	ini_set('xmysqlnd.lookup_batch_size', 0);
+	expect_eq(count($coll->getMany($ids)), 200);
+	ini_set('xmysqlnd.lookup_batch_size', 64);
+
+	$res = $coll->removeMany(array_slice($ids, 0, 150));
+	expect_eq($res->getAffectedItemsCount(), 150);
+	expect_eq(count($coll->getMany($ids)), 50);
+
+	$res = $coll->removeMany(array_merge($ids, ["4", "5", "1000"]));
+	expect_eq($res->getAffectedItemsCount(), 52);
+	expect_eq($coll->getMany($ids), []);
+	expect_null($coll->getOne("4"));
+	expect_eq($coll->getOne("6")["name"], "Mariangela");
+
+	// no ids, no Delete is sent
+	$count_session = mysql_xdevapi\getSession($connection_uri);
+	$count_coll = $count_session->getSchema($db)->getCollection($test_collection_name);
+	$deletes_sent = function() use ($count_session) {
+		return $count_session->sql("show session status like 'Mysqlx_crud_delete'")->execute()->fetchOne()['Value'];
+	};
+	$deletes_before = $deletes_sent();
+	$res = $count_coll->removeMany([]);
+	expect_eq($res->getAffectedItemsCount(), 0);
+	expect_eq($res->getWarningsCount(), 0);
+	expect_eq($res->getGeneratedIds(), []);
+	expect_eq($deletes_sent(), $deletes_before);
+	$res = $count_coll->removeMany(["1000"]);
+	expect_eq($res->getAffectedItemsCount(), 0);
+	expect_eq($deletes_sent(), strval($deletes_before + 1));
+	$count_session->close();
+
+	try {
+		$coll->getMany([["1"]]);
+		test_step_failed();
+	} catch(Exception $e) {
+		test_step_ok();
+	}
+
+	// ids are strings, a number is not converted
+	try {
+		$coll->getMany(["6", 7]);
+		test_step_failed();
+	} catch(Exception $e) {
+		test_step_ok();
+	}
+	try {
+		$coll->removeMany([6]);
+		test_step_failed();
+	} catch(Exception $e) {
+		test_step_ok();
+	}
+	expect_eq($coll->getOne("6")["name"], "Mariangela");
+
+	verify_expectations();
+	print "done!\n";
+?>
+--CLEAN--
+<?php
+	require("connect.inc");
+	clean_test_db();
+?>
+--EXPECTF--
+done!%A
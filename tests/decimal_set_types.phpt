@@ -0,0 +1,43 @@
+--TEST--
+mysqlx Decimal, Set types
+--SKIPIF--
+--INI--
+error_reporting=E_ALL
+--FILE--
+<?php
+
+	require("connect.inc");
+	$session = mysql_xdevapi\getSession($connection_uri);
+	create_test_db();
+	$test_table = 'test_decimal_set_table';
+
+	$session->sql("create table $db.$test_table ("
+		."id int, d0 decimal(10,0), d2 decimal(15,2), d5 decimal(30,5), s set('red','green','blue'))")->execute();
+
+	$schema = $session->getSchema($db);
+	$table = $schema->getTable($test_table);
+
+	$table->insert('id', 'd0', 'd2', 'd5', 's')->values(
+		[1, 0, 0, 0, ''],
+		[2, 7, 0.05, -0.00001, 'red'],
+		[3, -1234567890, -1234567890123.45, '1234567890123456789012345.67891', 'red,blue'],
+		[4, 1000, 99.9, -12.5, 'red,green,blue']
+		)->execute();
+
+	$rows = $table->select('d0', 'd2', 'd5', 's')->orderBy('id')->execute()->fetchAll();
+
+	expect_eq($rows[0], ['d0' => '0', 'd2' => '0.00', 'd5' => '0.00000', 's' => []]);
+	expect_eq($rows[1], ['d0' => '7', 'd2' => '0.05', 'd5' => '-0.00001', 's' => ['red']]);
+	expect_eq($rows[2], ['d0' => '-1234567890', 'd2' => '-1234567890123.45', 'd5' => '1234567890123456789012345.67891', 's' => ['red', 'blue']]);
+	expect_eq($rows[3], ['d0' => '1000', 'd2' => '99.90', 'd5' => '-12.50000', 's' => ['red', 'green', 'blue']]);
+
+	verify_expectations();
+	print "done!".PHP_EOL;
+?>
+--CLEAN--
+<?php
+	require("connect.inc");
+	clean_test_db();
+?>
+--EXPECTF--
+done!%A
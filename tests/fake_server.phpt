@@ -0,0 +1,64 @@
+--TEST--
+mysqlx fake server
+--SKIPIF--
+<?php
+	if (!function_exists('mysql_xdevapi\startFakeServer')) die('skip dev mode only');
+?>
+--FILE--
+<?php
+	require("connect.inc");
+
+	$address = mysql_xdevapi\startFakeServer([
+		'latency_us' => 1000,
+		'responses' => [
+			'SELECT name, age FROM test.people' => [
+				'columns' => ['name', 'age'],
+				'rows' => [['alice', 31], ['bob', null]]
+			],
+			'DELETE FROM test.people' => [
+				'rows_affected' => 2
+			],
+			'SELECT fail' => [
+				'error' => [1146, "Table 'test.fail' doesn't exist"]
+			],
+			'find test.docs' => [
+				'columns' => ['doc'],
+				'rows' => [[['_id' => '1', 'name' => 'alice']]]
+			]
+		]
+	]);
+	expect_eq($address['host'], '127.0.0.1');
+	expect_true($address['port'] > 0);
+
+	$session = mysql_xdevapi\getSession(
+		"mysqlx://anyone:anything@{$address['host']}:{$address['port']}/?ssl-mode=disabled");
+
+	$rows = $session->sql('SELECT name, age FROM test.people')->execute()->fetchAll();
+	expect_eq($rows, [['name' => 'alice', 'age' => 31], ['name' => 'bob', 'age' => null]]);
+
+	$res = $session->sql('DELETE FROM test.people')->execute();
+	expect_eq($res->getAffectedItemsCount(), 2);
+
+	try {
+		$session->sql('SELECT fail')->execute();
+		test_step_failed();
+	} catch(Exception $e) {
+		expect_eq($e->getCode(), 1146);
+	}
+
+	$docs = $session->getSchema('test')->getCollection('docs')->find()->execute()->fetchAll();
+	expect_eq(count($docs), 1);
+	expect_eq($docs[0]['name'], 'alice');
+
+	// no scripted response
+	expect_eq($session->sql('SELECT 1')->execute()->fetchAll(), []);
+
+	$session->close();
+	expect_true(mysql_xdevapi\stopFakeServer());
+	expect_false(mysql_xdevapi\stopFakeServer());
+
+	verify_expectations();
+	print "done!\n";
+?>
+--EXPECTF--
+done!%A
@@ -0,0 +1,90 @@
+--TEST--
+mysqlx select / sql fetch modes - packed lists, single column, into object
+--SKIPIF--
+--FILE--
+<?php
+	require("connect.inc");
+
+	class Worker {
+		public $name;
+		public $age;
+		public $job;
+	}
+
+	$session = create_test_db();
+	fill_db_table();
+
+	$schema = $session->getSchema($db);
+	$table = $schema->getTable($test_table_name);
+
+	// RowResult
+	$res = $table->select('name', 'age')->where('age < 13')->orderBy(['age asc', 'name asc'])->execute();
+	expect_eq($res->fetchOneNum(), ['Eulalia', 11]);
+	expect_eq($res->fetchOneNum(), ['Mamie', 11]);
+
+	$res = $table->select('name', 'age')->where('age < 13')->orderBy(['age asc', 'name asc'])->execute();
+	expect_eq($res->fetchAllNum(), [['Eulalia', 11], ['Mamie', 11], ['Polly', 12], ['Rufus', 12]]);
+
+	$res = $table->select('name', 'age')->where('age < 13')->orderBy(['age asc', 'name asc'])->execute();
+	expect_eq($res->fetchAllColumn(), ['Eulalia', 'Mamie', 'Polly', 'Rufus']);
+
+	$res = $table->select('name', 'age')->where('age < 13')->orderBy(['age asc', 'name asc'])->execute();
+	expect_eq($res->fetchAllColumn('age'), [11, 11, 12, 12]);
+
+	$res = $table->select('name', 'age')->where('age < 13')->orderBy(['age asc', 'name asc'])->execute();
+	expect_eq($res->fetchAllColumn(1), [11, 11, 12, 12]);
+
+	$res = $table->select('name', 'age', 'job')->where('age > 16')->orderBy('name asc')->execute();
+	$worker = new Worker();
+	expect_true($res->fetchOneInto($worker) === $worker);
+	expect_eq($worker->name, 'Caspian');
+	expect_eq($worker->age, 17);
+	expect_eq($worker->job, 'tailor');
+	$row = new stdClass();
+	$res->fetchOneInto($row);
+	expect_eq($row->name, 'Romy');
+	expect_eq($row->job, 'teacher');
+	expect_null($res->fetchOneInto($row));
+	expect_null($res->fetchOneNum());
+
+	$res = $table->select('name', 'age')->execute();
+	try {
+		$res->fetchAllColumn('salary');
+		test_step_failed();
+	} catch(Exception $e) {
+		test_step_ok();
+	}
+	try {
+		$res->fetchAllColumn(2);
+		test_step_failed();
+	} catch(Exception $e) {
+		test_step_ok();
+	}
+
+	// SqlStatementResult
+	$res = $session->sql("select name, age from $db.$test_table_name where age > 15 order by name")->execute();
+	expect_eq($res->fetchOneNum(), ['Caspian', 17]);
+
+	$res = $session->sql("select name, age from $db.$test_table_name where age > 15 order by name")->execute();
+	expect_eq($res->fetchAllNum(), [['Caspian', 17], ['Romy', 17], ['Vesper', 16]]);
+
+	$res = $session->sql("select name, age from $db.$test_table_name where age > 15 order by name")->execute();
+	expect_eq($res->fetchAllColumn('name'), ['Caspian', 'Romy', 'Vesper']);
+
+	$res = $session->sql("select name, age, job from $db.$test_table_name where age = 16")->execute();
+	$worker = new Worker();
+	$res->fetchOneInto($worker);
+	expect_eq($worker->name, 'Vesper');
+	expect_eq($worker->job, 'builder');
+	expect_null($res->fetchOneInto($worker));
+
+	verify_expectations();
+	print "done!\n";
+?>
+--CLEAN--
+<?php
+	require("connect.inc");
+	clean_test_db();
+?>
+--EXPECTF--
+done!%A
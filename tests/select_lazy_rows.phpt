@@ -0,0 +1,79 @@
+--TEST--
+mysqlx select / sql iterated as lazy Row objects
+--SKIPIF--
+--INI--
+xmysqlnd.lazy_rows=1
+--FILE--
+<?php
+	require("connect.inc");
+
+	$session = create_test_db();
+	fill_db_table();
+
+	$schema = $session->getSchema($db);
+	$table = $schema->getTable($test_table_name);
+
+	// RowResult
+	$res = $table->select('name', 'age')->where('age < 13')->orderBy(['age asc', 'name asc'])->execute();
+	$names = [];
+	$kept = null;
+	foreach ($res as $row) {
+		expect_true($row instanceof mysql_xdevapi\Row);
+		expect_eq(count($row), 2);
+		expect_eq($row['name'], $row->name);
+		expect_true(isset($row['age']));
+		expect_false(isset($row['job']));
+		expect_null($row['job']);
+		$names[] = $row['name'];
+		if ($kept === null) $kept = $row;
+	}
+	expect_eq($names, ['Eulalia', 'Mamie', 'Polly', 'Rufus']);
+	// a row stays valid after the iteration went on
+	expect_eq($kept->toArray(), ['name' => 'Eulalia', 'age' => 11]);
+
+	try {
+		$kept['name'] = 'Foo';
+		test_step_failed();
+	} catch(Exception $e) {
+		test_step_ok();
+	}
+
+	try {
+		unset($kept['name']);
+		test_step_failed();
+	} catch(Exception $e) {
+		test_step_ok();
+	}
+
+	// SqlStatementResult
+	$res = $session->sql("SELECT name, age, NULL AS job FROM $db.$test_table_name WHERE age > 16 ORDER BY name")->execute();
+	$rows = [];
+	foreach ($res as $row) {
+		expect_true($row->job === null);
+		expect_false(isset($row->job));
+		$rows[] = $row;
+	}
+	expect_eq(count($rows), 2);
+	expect_eq($rows[0]->toArray(), ['name' => 'Caspian', 'age' => 17, 'job' => null]);
+	expect_eq($rows[1]['name'], 'Romy');
+
+	// the fetch methods still return arrays
+	$res = $table->select('name', 'age')->where('age = 11')->orderBy('name asc')->execute();
+	expect_eq($res->fetchOne(), ['name' => 'Eulalia', 'age' => 11]);
+
+	ini_set('xmysqlnd.lazy_rows', 0);
+	$res = $table->select('name', 'age')->where('age = 11')->orderBy('name asc')->execute();
+	foreach ($res as $row) {
+		expect_true(is_array($row));
+	}
+
+	verify_expectations();
+	print "done!\n";
+?>
+--CLEAN--
+<?php
+	require("connect.inc");
+	clean_test_db();
+?>
+--EXPECTF--
+done!%A
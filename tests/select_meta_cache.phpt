@@ -0,0 +1,63 @@
+--TEST--
+mysqlx select - result metadata reused across result sets
+--SKIPIF--
+--FILE--
+<?php
+	require("connect.inc");
+
+	$session = create_test_db();
+	fill_db_table();
+
+	$schema = $session->getSchema($db);
+	$table = $schema->getTable($test_table_name);
+
+	// the same columns over and over, earlier results stay valid while new ones arrive
+	$results = [];
+	for ($i = 0; $i < 5; ++$i) {
+		$results[] = $table->select('name', 'age')->where('age > 16')->orderBy('name asc')->execute();
+	}
+	foreach ($results as $res) {
+		expect_eq($res->getColumnNames(), ['name', 'age']);
+		expect_eq($res->fetchAll(), [['name' => 'Caspian', 'age' => 17], ['name' => 'Romy', 'age' => 17]]);
+	}
+	unset($results);
+
+	// rows fetched one by one
+	$res = $session->sql("select name, age from $db.$test_table_name where age > 16 order by name")->execute();
+	expect_eq($res->fetchOne(), ['name' => 'Caspian', 'age' => 17]);
+	expect_eq($res->fetchOne(), ['name' => 'Romy', 'age' => 17]);
+	expect_null($res->fetchOne());
+
+	// different columns, different metadata
+	$res = $table->select('job', 'name')->where('age = 16')->execute();
+	expect_eq($res->fetchAll(), [['job' => 'builder', 'name' => 'Vesper']]);
+	$res = $table->select('name as job', 'job as name')->where('age = 16')->execute();
+	expect_eq($res->fetchAll(), [['job' => 'Vesper', 'name' => 'builder']]);
+
+	// duplicated names, the last column wins
+	for ($i = 0; $i < 2; ++$i) {
+		$res = $session->sql("select name, job as name from $db.$test_table_name where age = 16")->execute();
+		expect_eq($res->fetchOne(), ['name' => 'builder']);
+	}
+
+	// same columns, other rows
+	$res = $session->sql("select name from $db.$test_table_name where age = 16")->execute();
+	expect_eq($res->fetchAll(), [['name' => 'Vesper']]);
+	$res = $session->sql("select name from $db.$test_table_name where age = 15 order by name")->execute();
+	expect_eq($res->fetchAll(), [['name' => 'Octavia'], ['name' => 'Tierney']]);
+
+	// another session builds its own metadata
+	$other_session = mysql_xdevapi\getSession($connection_uri);
+	$res = $other_session->sql("select name, age from $db.$test_table_name where age > 16 order by name")->execute();
+	expect_eq($res->fetchAll(), [['name' => 'Caspian', 'age' => 17], ['name' => 'Romy', 'age' => 17]]);
+
+	verify_expectations();
+	print "done!\n";
+?>
+--CLEAN--
+<?php
+	require("connect.inc");
+	clean_test_db();
+?>
+--EXPECTF--
+done!%A
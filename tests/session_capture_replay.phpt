@@ -0,0 +1,55 @@
+--TEST--
+mysqlx session capture and replay
+--SKIPIF--
+--FILE--
+<?php
+	require_once("worker_utils.inc");
+
+	// both settings are for php.ini only, so each session runs in a worker process
+	function run_worker_session($ini_settings) {
+		$worker_cmd = prepare_worker_cmdline(resolve_worker_path(__FILE__), $ini_settings);
+		return trim(shell_exec($worker_cmd));
+	}
+
+	expect_false(ini_set('xmysqlnd.capture_dir', sys_get_temp_dir()));
+	expect_false(ini_set('xmysqlnd.replay_file', __FILE__));
+
+	$session = create_test_db();
+	fill_db_table();
+
+	$capture_dir = sys_get_temp_dir().DIRECTORY_SEPARATOR.'xmysqlnd_capture_'.getmypid();
+	@mkdir($capture_dir);
+
+	$live_rows = run_worker_session(['xmysqlnd.capture_dir' => $capture_dir]);
+	expect_true(strlen($live_rows) > 2);
+
+	$captures = glob($capture_dir.DIRECTORY_SEPARATOR.'*.xcap');
+	expect_eq(count($captures), 1);
+	expect_true(filesize($captures[0]) > 8);
+
+	// full speed
+	expect_eq(run_worker_session(['xmysqlnd.replay_file' => $captures[0]]), $live_rows);
+
+	// recorded pacing
+	expect_eq(
+		run_worker_session(['xmysqlnd.replay_file' => $captures[0], 'xmysqlnd.replay_pacing' => 1]),
+		$live_rows);
+
+	// not a capture
+	expect_eq(run_worker_session(['xmysqlnd.replay_file' => __FILE__]), "exception");
+
+	foreach ($captures as $capture) {
+		unlink($capture);
+	}
+	rmdir($capture_dir);
+
+	verify_expectations();
+	print "done!\n";
+?>
+--CLEAN--
+<?php
+	require("connect.inc");
+	clean_test_db();
+?>
+--EXPECTF--
+done!%A
@@ -0,0 +1,11 @@
+<?php
+	require_once(__DIR__.DIRECTORY_SEPARATOR."connect.inc");
+
+	try {
+		$session = mysql_xdevapi\getSession($connection_uri.'?'.$disable_ssl_opt);
+		$res = $session->sql("select name, age from $db.$test_table_name order by name")->execute();
+		echo json_encode($res->fetchAll()), "\n";
+	} catch(Exception $e) {
+		echo "exception\n";
+	}
+?>
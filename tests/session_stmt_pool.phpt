@@ -0,0 +1,94 @@
+--TEST--
+mysqlx statements reused within a session
+--SKIPIF--
+--FILE--
+<?php
+	require("connect.inc");
+
+	$session = create_test_db();
+	fill_db_table();
+	$schema = $session->getSchema($db);
+	$table = $schema->getTable($test_table_name);
+	$coll = $schema->getCollection($test_collection_name);
+	$coll->add('{"_id": "1", "name": "Sakila", "age": 17}')->execute();
+	$coll->add('{"_id": "2", "name": "Sakila", "age": 18}')->execute();
+
+	function names($rows) {
+		return implode(',', array_map(function ($row) { return $row['name']; }, $rows));
+	}
+
+	function run_statements($session, $table, $coll) {
+		global $db;
+		global $test_table_name;
+		$res = $session->sql("select name from $db.$test_table_name where age = ? order by name")->bind(11)->execute();
+		expect_eq(names($res->fetchAll()), 'Eulalia,Mamie');
+		$res = $table->select('name')->where('age = :age')->orderBy('name')->bind(['age' => 12])->execute();
+		expect_eq(names($res->fetchAll()), 'Polly,Rufus');
+		$res = $coll->find('age > :age')->bind(['age' => 17])->execute();
+		expect_eq(count($res->fetchAll()), 1);
+		$res = $table->delete()->where("name = 'Nobody'")->execute();
+		expect_eq($res->getAffectedItemsCount(), 0);
+	}
+
+	// warm up, the pool fills and the meta cache learns the results
+	for ($i = 0; $i < 10; ++$i) {
+		run_statements($session, $table, $coll);
+	}
+
+	// many statements on one session run on reused statement objects, nothing piles up
+	$memory_before = memory_get_usage();
+	for ($i = 0; $i < 500; ++$i) {
+		run_statements($session, $table, $coll);
+	}
+	$memory_growth = memory_get_usage() - $memory_before;
+	if ($memory_growth > 64 * 1024) {
+		test_step_failed("memory grew by $memory_growth bytes over 2000 statements");
+	}
+
+	// results kept alive past the next execute(), more of them than the pool holds
+	$kept = [];
+	for ($age = 11; $age <= 17; ++$age) {
+		$kept[$age] = $session->sql("select name from $db.$test_table_name where age = $age order by name")->execute();
+		run_statements($session, $table, $coll);
+	}
+	$kept_doc = $coll->find("_id = '2'")->execute();
+	run_statements($session, $table, $coll);
+	expect_eq(names($kept[11]->fetchAll()), 'Eulalia,Mamie');
+	expect_eq(names($kept[13]->fetchAll()), 'Cassidy');
+	expect_eq(names($kept[17]->fetchAll()), 'Caspian,Romy');
+	expect_eq($kept_doc->fetchOne()['age'], 18);
+	unset($kept[12]);
+	run_statements($session, $table, $coll);
+	expect_eq(names($kept[14]->fetchAll()), 'Lev,Olympia');
+
+	// session closed while the pool has statements and a result still holds one
+	$kept_row = $table->select('name')->where("age = 16")->execute();
+	$session->close();
+	expect_eq(names($kept_row->fetchAll()), 'Vesper');
+	expect_eq(names($kept[15]->fetchAll()), 'Octavia,Tierney');
+	unset($kept_row);
+	unset($kept);
+	unset($kept_doc);
+	try {
+		$session->sql("select 1")->execute();
+		test_step_failed("statement executed on a closed session");
+	} catch(Exception $e) {
+		test_step_ok();
+	}
+
+	// a new session starts with an empty pool of its own
+	$session = mysql_xdevapi\getSession($connection_uri);
+	$schema = $session->getSchema($db);
+	run_statements($session, $schema->getTable($test_table_name), $schema->getCollection($test_collection_name));
+	$session->close();
+
+	verify_expectations();
+	print "done!\n";
+?>
+--CLEAN--
+<?php
+	require("connect.inc");
+	clean_test_db();
+?>
+--EXPECTF--
+done!%A
@@ -0,0 +1,112 @@
+--TEST--
+mysqlx transaction control, START TRANSACTION sent with the first statement
+--SKIPIF--
+--INI--
+error_reporting=0
+--FILE--
+<?php
+	require("connect.inc");
+
+	$session = create_test_db();
+	$schema = $session->getSchema($db);
+	$coll = $schema->getCollection($test_collection_name);
+
+	$observer = mysql_xdevapi\getSession($connection_uri);
+	$observer_coll = $observer->getSchema($db)->getCollection($test_collection_name);
+
+	// empty transactions, transaction control returns true rather than a result
+	expect_true($session->startTransaction());
+	expect_true($session->commit());
+	expect_true($session->startTransaction());
+	expect_true($session->rollback());
+
+	// the deferred begin still makes the writes transactional
+	$session->startTransaction();
+	$coll->add('{"_id":"1", "name":"Marco"}')->execute();
+	expect_eq($observer_coll->count(), 0);
+	expect_true($session->rollback());
+	expect_eq($coll->count(), 0);
+
+	$session->startTransaction();
+	$coll->add('{"_id":"2", "name":"Lonardo"}')->execute();
+	expect_eq($session->sql("SELECT 1")->execute()->fetchOne()["1"], 1);
+	expect_true($session->commit());
+	expect_eq($observer_coll->count(), 1);
+
+	// a transaction started with plain SQL is committed by startTransaction, as before
+	$session->sql("START TRANSACTION")->execute();
+	$coll->add('{"_id":"3", "name":"Riccardo"}')->execute();
+	$session->startTransaction();
+	$session->rollback();
+	expect_eq($observer_coll->count(), 2);
+
+	// savepoints ride on the deferred begin too
+	$session->startTransaction();
+	$sp = $session->setSavepoint();
+	expect_eq($sp, "SAVEPOINT1");
+	$coll->add('{"_id":"4", "name":"Alfredo"}')->execute();
+	expect_true($session->rollbackTo($sp));
+	expect_true($session->releaseSavepoint($sp));
+	try {
+		$session->rollbackTo($sp);
+		test_step_failed();
+	} catch(Exception $e) {
+		test_step_ok();
+	}
+	expect_true($session->commit());
+	expect_eq($observer_coll->count(), 2);
+
+	// a failed statement doesn't leave the begin pending
+	$session->startTransaction();
+	try {
+		$session->sql("SELECT * FROM no_such_table")->execute();
+		test_step_failed();
+	} catch(Exception $e) {
+		test_step_ok();
+	}
+	$coll->add('{"_id":"5", "name":"Carlo"}')->execute();
+	expect_true($session->rollback());
+	expect_eq($observer_coll->count(), 2);
+
+	// if START TRANSACTION fails, the statement sent with it is not executed at all
+	$session->sql("XA START 'deferred_begin'")->execute();
+	$session->startTransaction();
+	try {
+		$coll->add('{"_id":"6", "name":"Sergio"}')->execute();
+		test_step_failed();
+	} catch(Exception $e) {
+		test_step_ok();
+	}
+	$session->sql("XA END 'deferred_begin'")->execute();
+	$session->sql("XA COMMIT 'deferred_begin' ONE PHASE")->execute();
+	expect_eq($observer_coll->count(), 2);
+	expect_eq($session->sql("SELECT 1")->execute()->fetchOne()["1"], 1);
+
+	// a begin pending on close still commits the transaction opened before it
+	$session->startTransaction();
+	$coll->add('{"_id":"7", "name":"Mariangela"}')->execute();
+	$session->startTransaction();
+	$session->close();
+	expect_eq($observer_coll->count(), 3);
+
+	// and so it does when a pooled session is reset
+	$client = mysql_xdevapi\getClient($connection_uri);
+	$pooled = $client->getSession();
+	$pooled_coll = $pooled->getSchema($db)->getCollection($test_collection_name);
+	$pooled->startTransaction();
+	$pooled_coll->add('{"_id":"8", "name":"Carlotta"}')->execute();
+	$pooled->startTransaction();
+	$pooled->close();
+	expect_eq($observer_coll->count(), 4);
+	$client->close();
+
+	verify_expectations();
+	print "done!\n";
+?>
+--CLEAN--
+<?php
+	require("connect.inc");
+	clean_test_db();
+?>
+--EXPECTF--
+done!%A
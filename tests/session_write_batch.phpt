@@ -0,0 +1,89 @@
+--TEST--
+mysqlx session write batch, writes sent together and their results read on flush
+--SKIPIF--
+--INI--
+error_reporting=0
+--FILE--
+<?php
+	require("connect.inc");
+
+	$session = create_test_db();
+	$schema = $session->getSchema($db);
+	$coll = $schema->getCollection($test_collection_name);
+	$table = $schema->getTable($test_table_name);
+
+	fill_db_table();
+	$coll->add('{"_id":"1", "name":"Marco", "age":19}')->execute();
+	$coll->add('{"_id":"2", "name":"Lonardo", "age":59}')->execute();
+
+	expect_true($session->beginBatch());
+	$results = [];
+	for ($i = 1; $i <= 10; ++$i) {
+		$results[] = $table->update()->set('age', mysql_xdevapi\expression('age + 1'))->where("name = 'Mamie'")->execute();
+	}
+	$results[] = $coll->modify('_id = "1"')->set('age', 20)->execute();
+	$results[] = $coll->remove('_id = "2"')->execute();
+	$results[] = $table->delete()->where("name = 'Olympia'")->execute();
+	$results[] = $table->insert("name", "age")->values(["Cassandra", 33])->execute();
+	$results[] = $coll->add('{"_id":"3", "name":"Riccardo"}')->execute();
+	expect_true($session->flush());
+
+	for ($i = 0; $i < 10; ++$i) {
+		expect_eq($results[$i]->getAffectedItemsCount(), 1);
+	}
+	expect_eq($table->select('age')->where("name = 'Mamie'")->execute()->fetchOne()['age'], 21);
+	expect_eq($results[10]->getAffectedItemsCount(), 1);
+	expect_eq($results[11]->getAffectedItemsCount(), 1);
+	expect_eq($results[12]->getAffectedItemsCount(), 1);
+	expect_eq($results[13]->getAffectedItemsCount(), 1);
+	expect_eq($results[14]->getGeneratedIds(), []);
+	expect_eq($coll->count(), 2);
+	expect_eq($coll->getOne("1")["age"], 20);
+
+	// a read in the middle of a batch gets the results of the writes before it
+	$session->beginBatch();
+	$res = $coll->modify('_id = "3"')->set('age', 42)->execute();
+	expect_eq($coll->getOne("3")["age"], 42);
+	expect_eq($res->getAffectedItemsCount(), 1);
+	expect_true($session->flush());
+
+	// the error of a write is thrown by its result, the others go through
+	$session->beginBatch();
+	$ok_before = $coll->modify('_id = "1"')->set('age', 21)->execute();
+	$failed = $coll->add('{"_id":"1", "name":"Duplicate"}')->execute();
+	$ok_after = $coll->modify('_id = "3"')->set('age', 43)->execute();
+	expect_false($session->flush());
+	expect_eq($ok_before->getAffectedItemsCount(), 1);
+	try {
+		$failed->getAffectedItemsCount();
+		test_step_failed();
+	} catch(Exception $e) {
+		expect_eq($e->getCode(), 5116);
+	}
+	expect_eq($ok_after->getAffectedItemsCount(), 1);
+
+	// the results may be read before flush, and flush with nothing queued is fine
+	$session->beginBatch();
+	$res = $table->update()->set('age', 100)->where("name = 'Cassandra'")->execute();
+	expect_eq($res->getAffectedItemsCount(), 1);
+	expect_true($session->flush());
+	expect_true($session->flush());
+
+	// unflushed writes are sent when the session closes
+	$session->beginBatch();
+	$coll->modify('_id = "3"')->set('age', 44)->execute();
+	$session->close();
+	$session = mysql_xdevapi\getSession($connection_uri);
+	$coll = $session->getSchema($db)->getCollection($test_collection_name);
+	expect_eq($coll->getOne("3")["age"], 44);
+
+	verify_expectations();
+	print "done!\n";
+?>
+--CLEAN--
+<?php
+	require("connect.inc");
+	clean_test_db();
+?>
+--EXPECTF--
+done!%A
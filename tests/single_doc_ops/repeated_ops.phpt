@@ -0,0 +1,73 @@
+--TEST--
+mysqlx collection single doc ops - repeated calls, statements prepared on the server
+--SKIPIF--
+--INI--
+error_reporting=0
+--FILE--
+<?php
+require_once(__DIR__."/../connect.inc");
+require_once(__DIR__."/single_doc_utils.inc");
+
+$session = create_test_db();
+$coll = fill_test_collection(true);
+
+// the first call sends the statement as is, the next ones execute it prepared
+for ($i = 0; $i < 3; ++$i) {
+	expect_doc(1, "Marco", 19, "Programmatore");
+	expect_doc(13, "Alessandra", 15, "Barista");
+	expect_null_doc(1000 + $i);
+}
+
+for ($i = 0; $i < 3; ++$i) {
+	$res = $coll->replaceOne(2, ["name" => "Lonardo" . $i, "age" => 23 + $i, "job" => "Paninaro"]);
+	verify_result($res, 2, 1);
+	expect_doc(2, "Lonardo" . $i, 23 + $i, "Paninaro");
+}
+
+// replaced by contents of another doc, its _id doesn't leak
+$doc = $coll->getOne(4);
+$res = $coll->replaceOne(3, $doc);
+verify_result($res, 3, 1);
+expect_doc(3, "Carlotta", 23, "Programmatrice");
+expect_doc(4, "Carlotta", 23, "Programmatrice");
+
+for ($i = 5; $i < 8; ++$i) {
+	$res = $coll->removeOne($i);
+	verify_result($res, $i, 1);
+	expect_null_doc($i);
+}
+$res = $coll->removeOne(5);
+verify_result($res, 5, 0);
+
+// a regular find of the same shape keeps working next to the prepared getOne
+$res = $coll->find("_id = :id")->bind(["id" => 8])->execute();
+verify_doc($res->fetchOne(), 8, "Antonella", 42, "Studente");
+expect_doc(8, "Antonella", 42, "Studente");
+
+// invalid documents are rejected before anything is sent
+try {
+	$coll->replaceOne(9, []);
+	test_step_failed();
+} catch(Exception $e) {
+	test_step_ok();
+}
+expect_non_empty_doc(9);
+
+// another collection object gets statements of its own
+$coll2 = $session->getSchema($db)->getCollection($test_collection_name);
+expect_doc(9, "Monica", 35, "Ballerino");
+$doc = $coll2->getOne(9);
+verify_doc($doc, 9, "Monica", 35, "Ballerino");
+$doc = $coll2->getOne(9);
+verify_doc($doc, 9, "Monica", 35, "Ballerino");
+
+verify_expectations();
+print "done!\n";
+?>
+--CLEAN--
+<?php
+	require_once(__DIR__."/../connect.inc");
+	clean_test_db();
+?>
+--EXPECTF--
+done!%A
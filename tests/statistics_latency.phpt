@@ -0,0 +1,70 @@
+--TEST--
+mysqlx latency histograms and throughput counters
+--SKIPIF--
+--INI--
+xmysqlnd.collect_perf_statistics=1
+--FILE--
+<?php
+	require("connect.inc");
+
+	mysql_xdevapi\getStatistics(true);
+
+	$session = create_test_db();
+	fill_db_table();
+
+	$schema = $session->getSchema($db);
+	$table = $schema->getTable($test_table_name);
+	$rows = $table->select('name', 'age')->execute()->fetchAll();
+	$table->update()->set('age', 20)->where('age = 17')->execute();
+	$session->sql("select 1")->execute()->fetchAll();
+
+	$coll = $schema->getCollection($test_collection_name);
+	$coll->add('{"_id": "1", "name": "Mamie"}')->execute();
+	$coll->find()->execute()->fetchAll();
+	$coll->remove("_id = '1'")->execute();
+
+	$stats = mysql_xdevapi\getStatistics();
+	expect_eq(array_keys($stats), ['latency', 'counters']);
+	foreach ($stats['latency'] as $op => $op_latency) {
+		if ($op_latency['count'] == 0) continue;
+		expect_true($op_latency['min_us'] <= $op_latency['p50_us']);
+		expect_true($op_latency['p50_us'] <= $op_latency['p99_us']);
+		expect_true($op_latency['p99_us'] <= $op_latency['max_us']);
+		expect_true($op_latency['sum_us'] >= $op_latency['max_us']);
+	}
+	foreach (['connect', 'auth', 'insert', 'sql'] as $op) {
+		expect_true($stats['latency'][$op]['count'] > 0);
+	}
+	// find / update / remove may be sent as prepared statements
+	$crud_count = 0;
+	foreach (['find', 'update', 'delete', 'execute'] as $op) {
+		$crud_count += $stats['latency'][$op]['count'];
+	}
+	expect_true($crud_count >= 4);
+	expect_eq($stats['latency']['pool_wait']['count'], 0);
+	expect_true($stats['counters']['rows_decoded'] >= count($rows) + 2);
+	expect_true($stats['counters']['rows_decode_sampled'] > 0);
+
+	// statistics were reset after being returned
+	mysql_xdevapi\getStatistics(true);
+	$stats = mysql_xdevapi\getStatistics();
+	expect_eq($stats['latency']['sql']['count'], 0);
+	expect_eq($stats['counters']['rows_decoded'], 0);
+
+	// nothing is timed nor counted while disabled
+	ini_set('xmysqlnd.collect_perf_statistics', 0);
+	$session->sql("select 1")->execute()->fetchAll();
+	$stats = mysql_xdevapi\getStatistics();
+	expect_eq($stats['latency']['sql']['count'], 0);
+	expect_eq($stats['counters']['rows_decoded'], 0);
+
+	verify_expectations();
+	print "done!\n";
+?>
+--CLEAN--
+<?php
+	require("connect.inc");
+	clean_test_db();
+?>
+--EXPECTF--
+done!%A
@@ -0,0 +1,77 @@
+--TEST--
+mysqlx table insert, update and bind of values of all types
+--SKIPIF--
+--INI--
+error_reporting=0
+--FILE--
+<?php
+	require("connect.inc");
+
+	$session = create_test_db(null, "id int primary key, name varchar(64), score double, active bool, info json");
+	$schema = $session->getSchema($db);
+	$table = $schema->getTable($test_table_name);
+
+	$table->insert("id", "name", "score", "active", "info")
+		->values([1, "Marco", 1.5, true, null])
+		->values([2, "Lonardo", -7.25, false, null])
+		->execute();
+
+	$row = $table->select("name", "score", "active")->where("id = :id")->bind(["id" => 1])->execute()->fetchOne();
+	expect_eq($row["name"], "Marco");
+	expect_eq($row["score"], 1.5);
+	expect_eq($row["active"], 1);
+
+	$res = $table->update()->set("name", "Riccardo")->set("score", 3.0)->where("id = :id")->bind(["id" => 2])->execute();
+	expect_eq($res->getAffectedItemsCount(), 1);
+	$row = $table->select("name", "score", "info")->where("name = :name")->bind(["name" => "Riccardo"])->execute()->fetchOne();
+	expect_eq($row["score"], 3.0);
+	expect_null($row["info"]);
+
+	expect_eq($table->select("id")->where("active = :flag")->bind(["flag" => false])->execute()->fetchOne()["id"], 2);
+	expect_eq($table->count(), 2);
+
+	// arrays and objects go into a json column as json arrays and objects
+	function fetch_info($table, $id) {
+		$row = $table->select("info")->where("id = :id")->bind(["id" => $id])->execute()->fetchOne();
+		return json_decode($row["info"], true);
+	}
+
+	$table->insert("id", "name", "info")
+		->values([3, "Array", [1, "two", [3, 4]]])
+		->values([4, "Object", (object)["city" => "Rome", "tags" => ["a", "b"], "geo" => (object)["zip" => 100]]])
+		->execute();
+	expect_eq(fetch_info($table, 3), [1, "two", [3, 4]]);
+	expect_eq(fetch_info($table, 4), ["city" => "Rome", "tags" => ["a", "b"], "geo" => ["zip" => 100]]);
+
+	$res = $table->update()->set("info", ["x", [true, null]])->where("id = :id")->bind(["id" => 1])->execute();
+	expect_eq($res->getAffectedItemsCount(), 1);
+	expect_eq(fetch_info($table, 1), ["x", [true, null]]);
+	$res = $table->update()->set("info", (object)["nested" => (object)["list" => [5, 6]]])->where("id = 2")->execute();
+	expect_eq($res->getAffectedItemsCount(), 1);
+	expect_eq(fetch_info($table, 2), ["nested" => ["list" => [5, 6]]]);
+
+	// and into a document, with set and patch
+	$coll = $schema->getCollection($test_collection_name);
+	$coll->add('{"_id": "1", "name": "Marco"}')->execute();
+	$coll->modify("_id = '1'")->set('$.x', [1, ["a" => 2, "b" => [3]]])->execute();
+	$coll->modify("_id = '1'")->set('$.y', (object)["inner" => (object)["z" => "deep"]])->execute();
+	$doc = $coll->getOne("1");
+	expect_eq($doc["x"], [1, ["a" => 2, "b" => [3]]]);
+	expect_eq($doc["y"], ["inner" => ["z" => "deep"]]);
+
+	$coll->modify("_id = '1'")->patch(json_encode(["y" => ["inner" => ["z" => null, "w" => [7, 8]]], "n" => ["m" => 9]]))->execute();
+	$doc = $coll->getOne("1");
+	expect_eq($doc["y"], ["inner" => ["w" => [7, 8]]]);
+	expect_eq($doc["n"], ["m" => 9]);
+	expect_eq($doc["x"], [1, ["a" => 2, "b" => [3]]]);
+
+	verify_expectations();
+	print "done!\n";
+?>
+--CLEAN--
+<?php
+	require("connect.inc");
+	clean_test_db();
+?>
+--EXPECTF--
+done!%A
@@ -0,0 +1,132 @@
+--TEST--
+mysqlx table insert split into batches, rows from generators
+--SKIPIF--
+--INI--
+xmysqlnd.insert_batch_size=512
+xmysqlnd.insert_pipelining=1
+--FILE--
+<?php
+	require("connect.inc");
+
+	function generate_rows($count) {
+		for ($i = 1; $i <= $count; ++$i) {
+			yield [ "name" . $i, $i, str_repeat("j", 32) ];
+		}
+	}
+
+	function throwing_rows() {
+		yield [ "before", 1, "job" ];
+		throw new Exception("row source failed");
+	}
+
+	$session = create_test_db(null, "id int auto_increment primary key, name varchar(64), age int, job varchar(64)");
+	$schema = $session->getSchema($db);
+	$table = $schema->getTable($test_table_name);
+
+	// 1000 rows of about 50 bytes each make many batches
+	$res = $table->insert("name", "age", "job")->values(generate_rows(1000))->execute();
+	expect_eq($res->getAffectedItemsCount(), 1000);
+	expect_eq($res->getAutoIncrementValue(), 1);
+	expect_eq($table->count(), 1000);
+
+	// plain rows and generators in one insert keep their order
+	$res = $table->insert("name", "age", "job")
+		->values(["first", 1001, "a"], generate_rows(100), ["last", 1102, "b"])
+		->execute();
+	expect_eq($res->getAffectedItemsCount(), 102);
+	expect_eq($res->getAutoIncrementValue(), 1001);
+	$row = $table->select("name")->where("id = 1102")->execute()->fetchOne();
+	expect_eq($row["name"], "last");
+
+	ini_set('xmysqlnd.insert_pipelining', 0);
+	$res = $table->insert("name", "age", "job")->values(generate_rows(200))->execute();
+	expect_eq($res->getAffectedItemsCount(), 200);
+	ini_set('xmysqlnd.insert_pipelining', 1);
+
+	// the rows of batches which went through are reported in a warning
+	$inserted_rows_warning = null;
+	set_error_handler(function($errno, $errstr) use (&$inserted_rows_warning) {
+		$inserted_rows_warning = $errstr;
+		return true;
+	}, E_WARNING);
+
+	function insert_with_duplicate($table, $first_id, $name, $dup_pos, $count) {
+		$rows = [];
+		for ($i = 0; $i < $count; ++$i) {
+			$rows[] = [ $first_id + $i, $name, 1, "job" ];
+			if ($i == $dup_pos) {
+				$rows[] = [ $first_id, $name, 1, "job" ];
+			}
+		}
+		$table->insert("id", "name", "age", "job")->values(...$rows)->execute();
+	}
+
+	function reported_rows($warning) {
+		return preg_match('/(\d+) row\(s\)/', (string)$warning, $matches) ? (int)$matches[1] : 0;
+	}
+
+	function dup_count($table) {
+		return $table->select("count(*) as c")->where("name = 'dup'")->execute()->fetchOne()["c"];
+	}
+
+	// a failing batch is reported, the session stays usable
+	try {
+		insert_with_duplicate($table, 3000, "dup", 49, 50);
+		test_step_failed();
+	} catch(Exception $e) {
+		test_step_ok();
+	}
+	expect_eq($session->sql("SELECT 1")->execute()->fetchOne()["1"], 1);
+	expect_eq(reported_rows($inserted_rows_warning), dup_count($table));
+	$table->delete()->where("name = 'dup'")->execute();
+
+	// pipelined, the batch sent behind the failing one is inserted and counted too
+	$inserted_rows_warning = null;
+	try {
+		insert_with_duplicate($table, 4000, "dup", 60, 120);
+		test_step_failed();
+	} catch(Exception $e) {
+		test_step_ok();
+	}
+	expect_true($table->select("id")->where("id > 4060")->execute()->fetchOne() !== null);
+	expect_eq(reported_rows($inserted_rows_warning), dup_count($table));
+	$table->delete()->where("name = 'dup'")->execute();
+
+	// not pipelined, nothing after the failing batch is inserted
+	ini_set('xmysqlnd.insert_pipelining', 0);
+	$inserted_rows_warning = null;
+	try {
+		insert_with_duplicate($table, 5000, "dup", 60, 120);
+		test_step_failed();
+	} catch(Exception $e) {
+		test_step_ok();
+	}
+	expect_eq(reported_rows($inserted_rows_warning), dup_count($table));
+	expect_eq($table->select("id")->where("id > 5060")->execute()->fetchOne(), null);
+	ini_set('xmysqlnd.insert_pipelining', 1);
+	restore_error_handler();
+
+	// an exception thrown by the row source goes through
+	try {
+		$table->insert("name", "age", "job")->values(throwing_rows())->execute();
+		test_step_failed();
+	} catch(Exception $e) {
+		expect_eq($e->getMessage(), "row source failed");
+	}
+	expect_eq($session->sql("SELECT 1")->execute()->fetchOne()["1"], 1);
+
+	// 0 - no limit, everything in one message
+	ini_set('xmysqlnd.insert_batch_size', 0);
+	$res = $table->insert("name", "age", "job")->values(generate_rows(300))->execute();
+	expect_eq($res->getAffectedItemsCount(), 300);
+
+	verify_expectations();
+	print "done!\n";
+?>
+--CLEAN--
+<?php
+	require("connect.inc");
+	clean_test_db();
+?>
+--EXPECTF--
+done!%A
@@ -0,0 +1,53 @@
+--TEST--
+mysqlx wire-level trace spans
+--SKIPIF--
+--INI--
+xmysqlnd.trace_sample_rate=1
+--FILE--
+<?php
+	require("connect.inc");
+
+	$session = create_test_db();
+	fill_db_table();
+	mysql_xdevapi\drainTraceSpans();
+
+	$rows = $session->sql("select name, age from $db.$test_table_name")->execute()->fetchAll();
+
+	$trace = mysql_xdevapi\drainTraceSpans();
+	expect_eq($trace['dropped'], 0);
+	expect_eq(count($trace['spans']), 1);
+	$span = $trace['spans'][0];
+	expect_eq($span['name'], 'mysqlx.sql');
+	expect_eq($span['kind'], 'client');
+	expect_eq(strlen($span['span_id']), 16);
+	expect_true($span['start_time_unix_nano'] <= $span['attributes']['mysqlx.first_byte_time_unix_nano']);
+	expect_true($span['attributes']['mysqlx.first_byte_time_unix_nano'] <= $span['end_time_unix_nano']);
+	expect_eq($span['attributes']['mysqlx.rows'], count($rows));
+	expect_true($span['attributes']['mysqlx.bytes_sent'] > 0);
+	expect_true($span['attributes']['mysqlx.bytes_received'] > 0);
+
+	// drained spans are gone
+	expect_eq(count(mysql_xdevapi\drainTraceSpans()['spans']), 0);
+
+	// sampling - only every 2nd statement is traced
+	ini_set('xmysqlnd.trace_sample_rate', 2);
+	for ($i = 0; $i < 4; ++$i) {
+		$session->sql("select $i")->execute();
+	}
+	expect_eq(count(mysql_xdevapi\drainTraceSpans()['spans']), 2);
+
+	// disabled
+	ini_set('xmysqlnd.trace_sample_rate', 0);
+	$session->sql("select 1")->execute();
+	expect_eq(count(mysql_xdevapi\drainTraceSpans()['spans']), 0);
+
+	verify_expectations();
+	print "done!\n";
+?>
+--CLEAN--
+<?php
+	require("connect.inc");
+	clean_test_db();
+?>
+--EXPECTF--
+done!%A
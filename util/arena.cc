@@ -0,0 +1,83 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#include "php_api.h"
+#include "mysqlnd_api.h"
+#include "arena.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace mysqlx {
+
+namespace util {
+
+Arena::~Arena()
+{
+	release();
+}
+
+void* Arena::allocate(std::size_t bytes_count, std::size_t alignment)
+{
+	const std::uintptr_t address{ reinterpret_cast<std::uintptr_t>(cursor) };
+	std::size_t padding{ (alignment - (address % alignment)) % alignment };
+	if (!cursor || (static_cast<std::size_t>(end - cursor) < padding + bytes_count)) {
+		add_block(bytes_count + alignment);
+		padding = (alignment - (reinterpret_cast<std::uintptr_t>(cursor) % alignment)) % alignment;
+	}
+	void* ptr{ cursor + padding };
+	cursor += padding + bytes_count;
+	return ptr;
+}
+
+std::string_view Arena::copy(const std::string_view& str)
+{
+	if (str.empty()) return std::string_view();
+	char* data{ static_cast<char*>(allocate(str.length(), 1)) };
+	std::memcpy(data, str.data(), str.length());
+	return std::string_view(data, str.length());
+}
+
+void Arena::release()
+{
+	while (last_block) {
+		Block* prev{ last_block->prev };
+		mnd_efree(last_block);
+		last_block = prev;
+	}
+	cursor = end = nullptr;
+	block_count = 0;
+}
+
+void Arena::add_block(std::size_t min_bytes_count)
+{
+	const std::size_t block_size{ sizeof(Block) + std::max(min_bytes_count, Default_block_size) };
+	Block* block{ static_cast<Block*>(mnd_emalloc(block_size)) };
+	if (!block) {
+		throw std::bad_alloc();
+	}
+	block->prev = last_block;
+	last_block = block;
+	cursor = reinterpret_cast<char*>(block) + sizeof(Block);
+	end = reinterpret_cast<char*>(block) + block_size;
+	++block_count;
+}
+
+} // namespace util
+
+} // namespace mysqlx
@@ -0,0 +1,82 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#ifndef MYSQL_XDEVAPI_PHP_UTIL_ARENA_H
+#define MYSQL_XDEVAPI_PHP_UTIL_ARENA_H
+
+#include <cstddef>
+#include <string_view>
+
+namespace mysqlx {
+
+namespace util {
+
+/*
+	Bump-pointer allocator for objects which live and die together, e.g. the
+	columns of one result. Memory comes in blocks from the request heap, is not
+	zeroed, and there is no per-object free - all the blocks go at once when the
+	arena is released. Destructors of the objects are not called, so they have to
+	be trivially destructible or cleaned up by their owner beforehand.
+*/
+class Arena
+{
+public:
+	Arena() = default;
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+	~Arena();
+
+	void* allocate(std::size_t bytes_count, std::size_t alignment = alignof(std::max_align_t));
+
+	// copy kept in the arena, not null-terminated
+	std::string_view copy(const std::string_view& str);
+
+	void release();
+
+	std::size_t get_block_count() const { return block_count; }
+
+private:
+	struct Block
+	{
+		Block* prev;
+	};
+
+	void add_block(std::size_t min_bytes_count);
+
+	static constexpr std::size_t Default_block_size{2048};
+
+	Block* last_block{nullptr};
+	char* cursor{nullptr};
+	char* end{nullptr};
+	std::size_t block_count{0};
+};
+
+} // namespace util
+
+} // namespace mysqlx
+
+inline void* operator new(std::size_t bytes_count, mysqlx::util::Arena& arena)
+{
+	return arena.allocate(bytes_count);
+}
+
+// only called if a constructor throws, the memory goes with the arena
+inline void operator delete(void* /*ptr*/, mysqlx::util::Arena& /*arena*/)
+{
+}
+
+#endif // MYSQL_XDEVAPI_PHP_UTIL_ARENA_H
@@ -25,193 +25,625 @@ extern "C" {
 #include "json_utils.h"
 #include "exceptions.h"
 #include "value.h"
+#include "rapidjson/memorystream.h"
+#include "rapidjson/reader.h"
+#include "rapidjson/writer.h"
+#include <cstring>
 
 namespace mysqlx::util::json {
 
-zvalue encode_document(const zvalue& src)
+namespace {
+
+const char* Id_column_name = "_id";
+const std::size_t Id_column_name_length = 3;
+
+/*
+	rapidjson output stream which appends straight to the target buffer, usually
+	string field of protobuf message, so there is no intermediate copy
+*/
+class Buffer_stream
 {
-	smart_str buf = { 0 };
-	JSON_G(error_code) = PHP_JSON_ERROR_NONE;
-	JSON_G(encode_max_depth) = PHP_JSON_PARSER_DEFAULT_DEPTH;
-	const int encode_flag = src.is_object() ? PHP_JSON_FORCE_OBJECT : 0;
-	php_json_encode(&buf, src.ptr(), encode_flag);
+	public:
+		using Ch = char;
 
-	if (JSON_G(error_code) != PHP_JSON_ERROR_NONE) {
-		smart_str_free(&buf);
-		throw xdevapi_exception(
-			xdevapi_exception::Code::json_fail,
-			static_cast<int>(JSON_G(error_code)));
+	public:
+		Buffer_stream(std::string& buffer) : buffer(buffer) {}
+
+		void Put(Ch c) { buffer.push_back(c); }
+		void Flush() {}
+
+	private:
+		std::string& buffer;
+};
+
+using Doc_id = std::optional<string_view>;
+
+using Writer = rapidjson::Writer<
+	Buffer_stream,
+	rapidjson::UTF8<>,
+	rapidjson::UTF8<>,
+	rapidjson::CrtAllocator,
+	rapidjson::kWriteValidateEncodingFlag>;
+
+[[noreturn]] void throw_encode_error(int php_json_error_code)
+{
+	throw xdevapi_exception(xdevapi_exception::Code::json_fail, php_json_error_code);
+}
+
+bool is_doc_id_key(const char* key, std::size_t key_length)
+{
+	return (key_length == Id_column_name_length)
+		&& !std::memcmp(key, Id_column_name, Id_column_name_length);
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+	SAX handler which rewrites JSON document passed as string and injects "_id"
+	on the fly, i.e. it is written as the very first member of the root object,
+	while "_id" member from source (if any) is skipped. Root array is rewritten
+	as object with members keyed by indexes, the same as PHP does in case
+	of inserting string key into list.
+*/
+class Doc_id_injector
+{
+	public:
+		Doc_id_injector(Writer& writer, const string_view& doc_id);
+
+	public:
+		bool Null();
+		bool Bool(bool value);
+		bool Int(int value);
+		bool Uint(unsigned value);
+		bool Int64(int64_t value);
+		bool Uint64(uint64_t value);
+		bool Double(double value);
+		bool RawNumber(const char* str, rapidjson::SizeType length, bool copy);
+		bool String(const char* str, rapidjson::SizeType length, bool copy);
+		bool StartObject();
+		bool Key(const char* str, rapidjson::SizeType length, bool copy);
+		bool EndObject(rapidjson::SizeType member_count);
+		bool StartArray();
+		bool EndArray(rapidjson::SizeType element_count);
+
+	private:
+		// returns false if scalar value should not be written
+		bool begin_scalar();
+		// returns false if container should not be written
+		bool begin_container();
+		// returns false if end of container should not be written
+		bool end_container();
+		void write_root_array_key();
+
+	private:
+		Writer& writer;
+		const string_view doc_id;
+		int depth{0};
+		bool skip_next_value{false};
+		int skip_nesting{0};
+		bool root_is_array{false};
+		std::size_t root_array_index{0};
+};
+
+Doc_id_injector::Doc_id_injector(Writer& writer, const string_view& doc_id)
+	: writer(writer)
+	, doc_id(doc_id)
+{
+}
+
+bool Doc_id_injector::begin_scalar()
+{
+	if (skip_nesting) return false;
+
+	if (skip_next_value) {
+		skip_next_value = false;
+		return false;
 	}
 
-	//TODO marines: there is fockup with lack of terminating zero, which makes troubles in
-	// xmysqlnd_json_string_find_id, i.e. php_json_yyparse returns result != 0
-	if (buf.s->len < buf.a)
-	{
-		buf.s->val[buf.s->len] = '\0';
+	if (depth == 0) {
+		// document has to be an object or array
+		throw_encode_error(PHP_JSON_ERROR_SYNTAX);
 	}
 
-	zvalue dest(buf.s->val, buf.s->len);
-	smart_str_free(&buf);
-	return dest;
+	write_root_array_key();
+	return true;
 }
 
-zvalue parse_document(const string_view& doc)
+bool Doc_id_injector::begin_container()
 {
-	zvalue dest;
-	if (php_json_decode(
-		dest.ptr(),
-		const_cast<char*>(doc.data()),
-		static_cast<int>(doc.length()),
-		false,
-		PHP_JSON_PARSER_DEFAULT_DEPTH) != SUCCESS)
-	{
-		throw xdevapi_exception(
-			xdevapi_exception::Code::json_parse_error,
-			static_cast<int>(JSON_G(error_code)));
+	if (skip_nesting) {
+		++skip_nesting;
+		return false;
 	}
-	return dest;
+
+	if (skip_next_value) {
+		skip_next_value = false;
+		skip_nesting = 1;
+		return false;
+	}
+
+	write_root_array_key();
+	++depth;
+	return true;
 }
 
-namespace {
+bool Doc_id_injector::end_container()
+{
+	if (skip_nesting) {
+		--skip_nesting;
+		return false;
+	}
 
-bool is_first_char(const zvalue& value, const char chr)
+	--depth;
+	return true;
+}
+
+void Doc_id_injector::write_root_array_key()
 {
-	assert(value.is_string());
-	if (value.empty()) return false;
-	const char* value_str = value.c_str();
-	return *value_str == chr;
+	if ((depth != 1) || !root_is_array) return;
+
+	char index_buf[MAX_LENGTH_OF_LONG];
+	const int index_length = snprintf(index_buf, sizeof(index_buf), "%zu", root_array_index++);
+	writer.Key(index_buf, static_cast<rapidjson::SizeType>(index_length));
 }
 
-} // anonymous namespace
+bool Doc_id_injector::Null()
+{
+	return !begin_scalar() || writer.Null();
+}
 
-bool can_be_document(const zvalue& value)
+bool Doc_id_injector::Bool(bool value)
 {
-	return is_first_char(value, '{');
+	return !begin_scalar() || writer.Bool(value);
 }
 
-bool can_be_array(const zvalue& value)
+bool Doc_id_injector::Int(int value)
 {
-	return is_first_char(value, '[');
+	return !begin_scalar() || writer.Int(value);
 }
 
-bool can_be_binding(const zvalue& value)
+bool Doc_id_injector::Uint(unsigned value)
 {
-	return is_first_char(value, ':');
+	return !begin_scalar() || writer.Uint(value);
 }
 
-namespace {
+bool Doc_id_injector::Int64(int64_t value)
+{
+	return !begin_scalar() || writer.Int64(value);
+}
+
+bool Doc_id_injector::Uint64(uint64_t value)
+{
+	return !begin_scalar() || writer.Uint64(value);
+}
+
+bool Doc_id_injector::Double(double value)
+{
+	return !begin_scalar() || writer.Double(value);
+}
+
+bool Doc_id_injector::RawNumber(const char* str, rapidjson::SizeType length, bool /*copy*/)
+{
+	// numbers are passed through as they are, so there is no loss of precision
+	return !begin_scalar() || writer.RawValue(str, length, rapidjson::kNumberType);
+}
+
+bool Doc_id_injector::String(const char* str, rapidjson::SizeType length, bool /*copy*/)
+{
+	return !begin_scalar() || writer.String(str, length);
+}
+
+bool Doc_id_injector::StartObject()
+{
+	if (!begin_container()) return true;
+	if (!writer.StartObject()) return false;
+	if (depth == 1) {
+		writer.Key(Id_column_name, Id_column_name_length);
+		return writer.String(doc_id.data(), static_cast<rapidjson::SizeType>(doc_id.length()));
+	}
+	return true;
+}
+
+bool Doc_id_injector::Key(const char* str, rapidjson::SizeType length, bool /*copy*/)
+{
+	if (skip_nesting) return true;
+
+	if ((depth == 1) && is_doc_id_key(str, length)) {
+		skip_next_value = true;
+		return true;
+	}
+
+	return writer.Key(str, length);
+}
 
-class Ensure_doc_id
+bool Doc_id_injector::EndObject(rapidjson::SizeType /*member_count*/)
+{
+	return !end_container() || writer.EndObject();
+}
+
+bool Doc_id_injector::StartArray()
+{
+	if (!begin_container()) return true;
+	if (depth == 1) {
+		root_is_array = true;
+		if (!writer.StartObject()) return false;
+		writer.Key(Id_column_name, Id_column_name_length);
+		return writer.String(doc_id.data(), static_cast<rapidjson::SizeType>(doc_id.length()));
+	}
+	return writer.StartArray();
+}
+
+bool Doc_id_injector::EndArray(rapidjson::SizeType /*element_count*/)
+{
+	if (!end_container()) return true;
+	return (depth == 0) ? writer.EndObject() : writer.EndArray();
+}
+
+void inject_doc_id(const string_view& doc, const string_view& doc_id, Writer& writer)
+{
+	Doc_id_injector injector(writer, doc_id);
+	rapidjson::MemoryStream doc_stream(doc.data(), doc.length());
+	rapidjson::Reader reader;
+	if (!reader.Parse<rapidjson::kParseNumbersAsStringsFlag>(doc_stream, injector)) {
+		const int error_code = reader.GetParseErrorCode() == rapidjson::kParseErrorTermination
+			? PHP_JSON_ERROR_UTF8 : PHP_JSON_ERROR_SYNTAX;
+		throw_encode_error(error_code);
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+	native zval => JSON serializer, produces output compatible with php_json_encode
+	(but without escaping of slashes and unicode chars), except of objects other
+	than stdClass (they may be JsonSerializable, enums, etc.) - for them we fall
+	back to php_json_encode
+*/
+class Document_encoder
 {
 	public:
-		Ensure_doc_id(
-			const zvalue& raw_doc,
-			const string_view& doc_id);
+		Document_encoder(std::string& dest, bool force_object);
 
 	public:
-		zvalue run();
+		void encode(const zval* doc, const Doc_id& doc_id);
 
 	private:
-		void process_string();
-		void process_array();
-		void process_object();
-
-		void decode_json(const zvalue& doc_as_str);
-		void store_id();
+		void write_value(const zval* value, int depth);
+		void write_string(const char* str, std::size_t length);
+		void write_key(zend_ulong index, const zend_string* key);
+		void write_doc_id(const string_view& doc_id);
+
+		void write_array(const HashTable* ht, int depth, const Doc_id& doc_id);
+		void write_object(const zval* obj, int depth);
+		void write_members(
+			const HashTable* members,
+			bool are_properties,
+			int depth,
+			const Doc_id& doc_id);
+		void write_foreign_object(const zval* obj, int depth, const Doc_id& doc_id);
+
+		static bool is_list(const HashTable* ht);
+		static bool is_std_object(const zval* obj);
 
 	private:
-		const zvalue& raw_doc;
-		const string_view& doc_id;
-		zvalue doc_with_id;
+		std::string& dest;
+		Buffer_stream stream;
+		Writer writer;
+		const bool force_object;
 
+		static constexpr int Max_depth{PHP_JSON_PARSER_DEFAULT_DEPTH};
 };
 
-//------------------------------------------------------------------------------
-
-Ensure_doc_id::Ensure_doc_id(const zvalue& src, const string_view& id)
-	: raw_doc(src)
-	, doc_id(id)
+Document_encoder::Document_encoder(std::string& dest, bool force_object)
+	: dest(dest)
+	, stream(dest)
+	, writer(stream)
+	, force_object(force_object)
 {
 }
 
-zvalue Ensure_doc_id::run()
+void Document_encoder::encode(const zval* doc, const Doc_id& doc_id)
 {
-	switch(raw_doc.type()) {
-		case zvalue::Type::String:
-			process_string();
+	ZVAL_DEREF(doc);
+	switch (Z_TYPE_P(doc)) {
+		case IS_STRING:
+			// string is supposed to be already encoded document
+			if (doc_id) {
+				inject_doc_id(string_view(Z_STRVAL_P(doc), Z_STRLEN_P(doc)), *doc_id, writer);
+			} else {
+				dest.append(Z_STRVAL_P(doc), Z_STRLEN_P(doc));
+			}
 			break;
 
-		case zvalue::Type::Array:
-			process_array();
+		case IS_ARRAY:
+			write_array(Z_ARRVAL_P(doc), 1, doc_id);
 			break;
 
-		case zvalue::Type::Object:
-			process_object();
+		case IS_OBJECT:
+			if (is_std_object(doc)) {
+				write_members(Z_OBJPROP_P(doc), true, 1, doc_id);
+			} else {
+				write_foreign_object(doc, 1, doc_id);
+			}
 			break;
 
 		default:
 			throw xdevapi_exception(xdevapi_exception::Code::json_fail);
 	}
-	return doc_with_id;
 }
 
-void Ensure_doc_id::process_string()
+void Document_encoder::write_value(const zval* value, int depth)
+{
+	ZVAL_DEREF(value);
+	switch (Z_TYPE_P(value)) {
+		case IS_UNDEF:
+		case IS_NULL:
+			writer.Null();
+			break;
+
+		case IS_FALSE:
+			writer.Bool(false);
+			break;
+
+		case IS_TRUE:
+			writer.Bool(true);
+			break;
+
+		case IS_LONG:
+			writer.Int64(Z_LVAL_P(value));
+			break;
+
+		case IS_DOUBLE:
+			if (!writer.Double(Z_DVAL_P(value))) {
+				throw_encode_error(PHP_JSON_ERROR_INF_OR_NAN);
+			}
+			break;
+
+		case IS_STRING:
+			write_string(Z_STRVAL_P(value), Z_STRLEN_P(value));
+			break;
+
+		case IS_ARRAY:
+			write_array(Z_ARRVAL_P(value), depth + 1, std::nullopt);
+			break;
+
+		case IS_OBJECT:
+			write_object(value, depth + 1);
+			break;
+
+		default:
+			throw_encode_error(PHP_JSON_ERROR_UNSUPPORTED_TYPE);
+	}
+}
+
+void Document_encoder::write_string(const char* str, std::size_t length)
+{
+	if (!writer.String(str, static_cast<rapidjson::SizeType>(length))) {
+		throw_encode_error(PHP_JSON_ERROR_UTF8);
+	}
+}
+
+void Document_encoder::write_key(zend_ulong index, const zend_string* key)
 {
-	decode_json(raw_doc);
-	store_id();
+	bool result{false};
+	if (key) {
+		result = writer.Key(ZSTR_VAL(key), static_cast<rapidjson::SizeType>(ZSTR_LEN(key)));
+	} else {
+		char index_buf[MAX_LENGTH_OF_LONG];
+		const int index_length = snprintf(index_buf, sizeof(index_buf), ZEND_ULONG_FMT, index);
+		result = writer.Key(index_buf, static_cast<rapidjson::SizeType>(index_length));
+	}
+
+	if (!result) {
+		throw_encode_error(PHP_JSON_ERROR_UTF8);
+	}
+}
+
+void Document_encoder::write_doc_id(const string_view& doc_id)
+{
+	writer.Key(Id_column_name, Id_column_name_length);
+	write_string(doc_id.data(), doc_id.length());
 }
 
-void Ensure_doc_id::process_array()
+void Document_encoder::write_array(const HashTable* ht, int depth, const Doc_id& doc_id)
 {
-	if (raw_doc.size() <= 0) {
-		throw xdevapi_exception(xdevapi_exception::Code::json_fail);
+	if (depth > Max_depth) {
+		throw_encode_error(PHP_JSON_ERROR_DEPTH);
 	}
 
-	doc_with_id = raw_doc.clone();
-	store_id();
+	if (!doc_id && !force_object && is_list(ht)) {
+		writer.StartArray();
+		const zval* value{nullptr};
+		MYSQLX_HASH_FOREACH_VAL(const_cast<HashTable*>(ht), value) {
+			write_value(value, depth);
+		} ZEND_HASH_FOREACH_END();
+		writer.EndArray();
+	} else {
+		write_members(ht, false, depth, doc_id);
+	}
 }
 
-void Ensure_doc_id::process_object()
+void Document_encoder::write_object(const zval* obj, int depth)
 {
-	const zvalue doc_as_str = encode_document(raw_doc);
-	decode_json(doc_as_str);
-	store_id();
+	if (depth > Max_depth) {
+		throw_encode_error(PHP_JSON_ERROR_DEPTH);
+	}
+
+	if (is_std_object(obj)) {
+		write_members(Z_OBJPROP_P(obj), true, depth, std::nullopt);
+	} else {
+		write_foreign_object(obj, depth, std::nullopt);
+	}
 }
 
-void Ensure_doc_id::decode_json(const zvalue& doc_as_str)
+void Document_encoder::write_members(
+	const HashTable* members,
+	bool are_properties,
+	int depth,
+	const Doc_id& doc_id)
 {
-	assert(doc_as_str.is_string());
-	doc_with_id = parse_document(doc_as_str.to_string_view());
-	if (!doc_with_id.is_array() && !doc_with_id.is_object()) {
-		throw xdevapi_exception(xdevapi_exception::Code::json_fail);
+	writer.StartObject();
+	if (doc_id) {
+		write_doc_id(*doc_id);
 	}
+
+	zend_ulong index{0};
+	zend_string* key{nullptr};
+	zval* value{nullptr};
+	MYSQLX_HASH_FOREACH_KEY_VAL_IND(const_cast<HashTable*>(members), index, key, value) {
+		if (key) {
+			// skip protected and private members (mangled names)
+			if (are_properties && ZSTR_LEN(key) && (ZSTR_VAL(key)[0] == '\0')) continue;
+			if (doc_id && is_doc_id_key(ZSTR_VAL(key), ZSTR_LEN(key))) continue;
+		}
+		write_key(index, key);
+		write_value(value, depth);
+	} ZEND_HASH_FOREACH_END();
+
+	writer.EndObject();
+}
+
+void Document_encoder::write_foreign_object(const zval* obj, int depth, const Doc_id& doc_id)
+{
+	smart_str buf = { 0 };
+	JSON_G(error_code) = PHP_JSON_ERROR_NONE;
+	JSON_G(encode_max_depth) = Max_depth - depth + 1;
+	const int encode_flag = force_object ? PHP_JSON_FORCE_OBJECT : 0;
+	php_json_encode(&buf, const_cast<zval*>(obj), encode_flag);
+
+	if (JSON_G(error_code) != PHP_JSON_ERROR_NONE) {
+		smart_str_free(&buf);
+		throw_encode_error(static_cast<int>(JSON_G(error_code)));
+	}
+
+	const string_view json(ZSTR_VAL(buf.s), ZSTR_LEN(buf.s));
+	try {
+		if (doc_id) {
+			inject_doc_id(json, *doc_id, writer);
+		} else {
+			writer.RawValue(json.data(), json.length(), rapidjson::kObjectType);
+		}
+	} catch (...) {
+		smart_str_free(&buf);
+		throw;
+	}
+	smart_str_free(&buf);
+}
+
+bool Document_encoder::is_list(const HashTable* ht)
+{
+	if (HT_IS_PACKED(ht) && HT_IS_WITHOUT_HOLES(ht)) return true;
+
+	zend_ulong expected_index{0};
+	zend_ulong index{0};
+	zend_string* key{nullptr};
+	MYSQLX_HASH_FOREACH_KEY(const_cast<HashTable*>(ht), index, key) {
+		if (key || (index != expected_index)) return false;
+		++expected_index;
+	} ZEND_HASH_FOREACH_END();
+	return true;
+}
+
+bool Document_encoder::is_std_object(const zval* obj)
+{
+	return Z_OBJCE_P(obj) == zend_standard_class_def;
+}
+
+} // anonymous namespace
+
+void encode_document(const zvalue& src, std::string& dest)
+{
+	Document_encoder encoder(dest, src.is_object());
+	encoder.encode(src.ptr(), std::nullopt);
 }
 
-void Ensure_doc_id::store_id()
+void encode_document(const zvalue& src, const string_view& doc_id, std::string& dest)
 {
-	const char* Id_column_name = "_id";
-	switch (doc_with_id.type()) {
-	case zvalue::Type::Array:
-		doc_with_id.insert(Id_column_name, doc_id);
-		break;
+	Document_encoder encoder(dest, src.is_object());
+	encoder.encode(src.ptr(), doc_id);
+}
 
-	case zvalue::Type::Object:
-		doc_with_id.set_property(Id_column_name, doc_id);
-		break;
+zvalue encode_document(const zvalue& src)
+{
+	std::string doc;
+	encode_document(src, doc);
+	return zvalue(doc);
+}
 
-	default:
-		assert(!"unexpected doc type!");
+zvalue parse_document(const string_view& doc)
+{
+	zvalue dest;
+	if (php_json_decode(
+		dest.ptr(),
+		const_cast<char*>(doc.data()),
+		static_cast<int>(doc.length()),
+		false,
+		PHP_JSON_PARSER_DEFAULT_DEPTH) != SUCCESS)
+	{
+		throw xdevapi_exception(
+			xdevapi_exception::Code::json_parse_error,
+			static_cast<int>(JSON_G(error_code)));
 	}
+	return dest;
+}
+
+namespace {
+
+bool is_first_char(const zvalue& value, const char chr)
+{
+	assert(value.is_string());
+	if (value.empty()) return false;
+	const char* value_str = value.c_str();
+	return *value_str == chr;
 }
 
 } // anonymous namespace
 
+bool can_be_document(const zvalue& value)
+{
+	return is_first_char(value, '{');
+}
+
+bool can_be_array(const zvalue& value)
+{
+	return is_first_char(value, '[');
+}
+
+bool can_be_binding(const zvalue& value)
+{
+	return is_first_char(value, ':');
+}
+
+void ensure_doc_id(
+	const zvalue& raw_doc,
+	const string_view& id,
+	std::string& dest)
+{
+	switch (raw_doc.type()) {
+		case zvalue::Type::String:
+		case zvalue::Type::Object:
+			break;
+
+		case zvalue::Type::Array:
+			if (raw_doc.empty()) {
+				throw xdevapi_exception(xdevapi_exception::Code::json_fail);
+			}
+			break;
+
+		default:
+			throw xdevapi_exception(xdevapi_exception::Code::json_fail);
+	}
+
+	encode_document(raw_doc, id, dest);
+}
+
 zvalue ensure_doc_id(
 	const zvalue& raw_doc,
 	const string_view& id)
 {
-	Ensure_doc_id edi(raw_doc, id);
-	return edi.run();
+	std::string doc_with_id;
+	ensure_doc_id(raw_doc, id, doc_with_id);
+	return zvalue(doc_with_id);
 }
 
 } // namespace mysqlx::util::json
@@ -30,6 +30,15 @@ namespace json {
 
 zvalue encode_document(const zvalue& src);
 
+/*
+	serializes document (array or object) straight into dest, e.g. into string
+	field of protobuf message; string is supposed to be already encoded document,
+	so it is just appended - the second overload injects "_id" member into
+	the root object during the same pass
+*/
+void encode_document(const zvalue& src, std::string& dest);
+void encode_document(const zvalue& src, const string_view& doc_id, std::string& dest);
+
 zvalue parse_document(const string_view& doc);
 
 bool can_be_document(const zvalue& value);
@@ -40,6 +49,12 @@ zvalue ensure_doc_id(
 	const zvalue& raw_doc,
 	const string_view& id);
 
+// as above, but serializes the document straight into dest
+void ensure_doc_id(
+	const zvalue& raw_doc,
+	const string_view& id,
+	std::string& dest);
+
 } // namespace json
 
 } // namespace mysqlx::util
@@ -18,7 +18,7 @@
 #ifndef XMYSQLND_H
 #define XMYSQLND_H
 
-#define PHP_XMYSQLND_VERSION "mysql_xdevapi 8.0.27"
+#define PHP_XMYSQLND_VERSION "mysql_xdevapi 8.0.28"
 #define XMYSQLND_VERSION_ID 80027
 
 #if PHP_DEBUG
@@ -0,0 +1,417 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#include "php_api.h"
+#include "mysqlnd_api.h"
+#include "php_mysqlx.h"
+#include "xmysqlnd_capture.h"
+#include "xmysqlnd_trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+#ifdef PHP_WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace mysqlx {
+
+namespace drv {
+
+namespace {
+
+const char Capture_magic[] = { 'X', 'C', 'A', 'P' };
+const zend_uchar Capture_version{1};
+
+const std::size_t Capture_header_size{8};
+const std::size_t Capture_record_header_size{14};
+
+// the frame header as it is sent on the wire - payload length (with the type) and type
+const std::size_t Frame_header_size{5};
+
+const std::size_t Capture_file_buffer_size{64 * 1024};
+
+long get_process_id()
+{
+#ifdef PHP_WIN32
+	return static_cast<long>(_getpid());
+#else
+	return static_cast<long>(getpid());
+#endif
+}
+
+} // anonymous namespace
+
+void Capture_writer::open()
+{
+	DBG_ENTER("Capture_writer::open");
+	close();
+
+	const char* capture_dir{ MYSQL_XDEVAPI_G(capture_dir) };
+	if (!capture_dir || !*capture_dir) {
+		DBG_VOID_RETURN;
+	}
+
+	char file_path[MAXPATHLEN];
+	snprintf(file_path, sizeof(file_path), "%s%cxmysqlnd-%ld-" ZEND_ULONG_FMT ".xcap",
+		capture_dir, DEFAULT_SLASH, get_process_id(), ++MYSQL_XDEVAPI_G(capture_sequence));
+	DBG_INF_FMT("path=%s", file_path);
+	path = file_path;
+
+	file = std::fopen(file_path, "wb");
+	if (!file) {
+		php_error_docref(nullptr, E_WARNING, "Cannot open the capture file %s", file_path);
+		DBG_VOID_RETURN;
+	}
+	std::setvbuf(file, nullptr, _IOFBF, Capture_file_buffer_size);
+
+	zend_uchar header[Capture_header_size]{};
+	std::memcpy(header, Capture_magic, sizeof(Capture_magic));
+	header[sizeof(Capture_magic)] = Capture_version;
+	if (std::fwrite(header, 1, sizeof(header), file) != sizeof(header)) {
+		on_write_error();
+		DBG_VOID_RETURN;
+	}
+	last_record_ns = xmysqlnd_trace_now_ns();
+	DBG_VOID_RETURN;
+}
+
+void Capture_writer::write(
+	Capture_direction direction,
+	zend_uchar packet_type,
+	const zend_uchar* payload,
+	std::size_t payload_size)
+{
+	const uint64_t now_ns{ xmysqlnd_trace_now_ns() };
+	zend_uchar header[Capture_record_header_size];
+	header[0] = static_cast<zend_uchar>(direction);
+	header[1] = packet_type;
+	int4store(header + 2, static_cast<uint32_t>(payload_size));
+	int8store(header + 6, now_ns - last_record_ns);
+	last_record_ns = now_ns;
+
+	const bool written{
+		(std::fwrite(header, 1, sizeof(header), file) == sizeof(header))
+		&& (!payload_size || (std::fwrite(payload, 1, payload_size, file) == payload_size)) };
+	if (!written) {
+		on_write_error();
+	}
+}
+
+void Capture_writer::close()
+{
+	if (!file) return;
+	// the buffered tail is written only here
+	if (std::fclose(file)) {
+		php_error_docref(nullptr, E_WARNING, "Cannot write the capture file %s", path.c_str());
+	}
+	file = nullptr;
+}
+
+// a capture with a gap cannot be replayed, so capturing stops at the first failed write
+void Capture_writer::on_write_error()
+{
+	php_error_docref(nullptr, E_WARNING, "Cannot write the capture file %s, capturing stopped", path.c_str());
+	std::fclose(file);
+	file = nullptr;
+}
+
+// ----------------------------------------------------------------------------
+
+namespace {
+
+/*
+	Server frames of a capture, laid out exactly as they came from the network, so
+	the frame codec reads them through the regular mysqlnd vio code.
+*/
+class Replay_stream
+{
+public:
+	Replay_stream(bool pacing, bool looped) : pacing{pacing}, looped{looped} {}
+
+	bool load(const char* path);
+	bool assign(const util::string_view& wire_frames);
+
+	std::size_t read(zend_uchar* buffer, std::size_t count);
+	void on_request_sent();
+
+private:
+	void wait_for_frame(const uint64_t delay_ns);
+
+	struct Frame
+	{
+		std::size_t end;
+		uint64_t delay_ns;
+	};
+
+	std::vector<zend_uchar> data;
+	std::vector<Frame> frames;
+	std::size_t pos{0};
+	std::size_t frame_index{0};
+	uint64_t last_event_ns{0};
+	const bool pacing;
+	const bool looped;
+};
+
+bool Replay_stream::load(const char* path)
+{
+	DBG_ENTER("Replay_stream::load");
+	DBG_INF_FMT("path=%s", path);
+	std::unique_ptr<std::FILE, decltype(&std::fclose)> file{ std::fopen(path, "rb"), &std::fclose };
+	if (!file) {
+		DBG_RETURN(false);
+	}
+
+	zend_uchar header[Capture_header_size];
+	if ((std::fread(header, 1, sizeof(header), file.get()) != sizeof(header))
+		|| std::memcmp(header, Capture_magic, sizeof(Capture_magic))
+		|| (header[sizeof(Capture_magic)] != Capture_version)) {
+		DBG_ERR("not a capture file");
+		DBG_RETURN(false);
+	}
+
+	zend_uchar record_header[Capture_record_header_size];
+	while (std::fread(record_header, 1, sizeof(record_header), file.get()) == sizeof(record_header)) {
+		const auto direction{ static_cast<Capture_direction>(record_header[0]) };
+		const zend_uchar packet_type{ record_header[1] };
+		const std::size_t payload_size{ uint4korr(record_header + 2) };
+		// the delay counts from the previous record, whatever its direction
+		const uint64_t delay_ns{ uint8korr(record_header + 6) };
+
+		if (direction == Capture_direction::client) {
+			if (std::fseek(file.get(), static_cast<long>(payload_size), SEEK_CUR)) break;
+			continue;
+		}
+
+		const std::size_t frame_begin{ data.size() };
+		data.resize(frame_begin + Frame_header_size + payload_size);
+		int4store(&data[frame_begin], static_cast<uint32_t>(payload_size + 1));
+		data[frame_begin + Frame_header_size - 1] = packet_type;
+		if (payload_size
+			&& (std::fread(&data[frame_begin + Frame_header_size], 1, payload_size, file.get()) != payload_size)) {
+			DBG_ERR("truncated capture file");
+			DBG_RETURN(false);
+		}
+		frames.push_back({data.size(), delay_ns});
+	}
+	DBG_INF_FMT("frames=" MYSQLND_SZ_T_SPEC " bytes=" MYSQLND_SZ_T_SPEC, frames.size(), data.size());
+	last_event_ns = xmysqlnd_trace_now_ns();
+	DBG_RETURN(true);
+}
+
+bool Replay_stream::assign(const util::string_view& wire_frames)
+{
+	data.assign(wire_frames.begin(), wire_frames.end());
+	std::size_t frame_begin{0};
+	while (frame_begin + Frame_header_size <= data.size()) {
+		const std::size_t frame_end{ frame_begin + Frame_header_size - 1 + uint4korr(&data[frame_begin]) };
+		if (frame_end > data.size()) break;
+		frames.push_back({frame_end, 0});
+		frame_begin = frame_end;
+	}
+	last_event_ns = xmysqlnd_trace_now_ns();
+	return frame_begin == data.size();
+}
+
+std::size_t Replay_stream::read(zend_uchar* buffer, std::size_t count)
+{
+	if (frame_index == frames.size()) {
+		if (!looped || frames.empty()) return 0;
+		frame_index = 0;
+		pos = 0;
+	}
+
+	const Frame& frame{ frames[frame_index] };
+	const bool frame_begins{ (frame_index == 0) ? (pos == 0) : (pos == frames[frame_index - 1].end) };
+	if (frame_begins && pacing) {
+		wait_for_frame(frame.delay_ns);
+	}
+
+	// never crosses a frame boundary, so the pacing of every frame is kept
+	const std::size_t to_copy{ std::min(count, frame.end - pos) };
+	std::memcpy(buffer, &data[pos], to_copy);
+	pos += to_copy;
+	if (pos == frame.end) {
+		++frame_index;
+		last_event_ns = xmysqlnd_trace_now_ns();
+	}
+	return to_copy;
+}
+
+void Replay_stream::on_request_sent()
+{
+	last_event_ns = xmysqlnd_trace_now_ns();
+}
+
+void Replay_stream::wait_for_frame(const uint64_t delay_ns)
+{
+	const uint64_t elapsed_ns{ xmysqlnd_trace_now_ns() - last_event_ns };
+	if (elapsed_ns < delay_ns) {
+		std::this_thread::sleep_for(std::chrono::nanoseconds(delay_ns - elapsed_ns));
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+template<typename Func>
+struct Func_result;
+
+template<typename Result, typename... Args>
+struct Func_result<Result(*)(Args...)>
+{
+	using type = Result;
+};
+
+// size_t up to PHP 7.3, ssize_t since PHP 7.4
+using Stream_io_result = Func_result<decltype(php_stream_ops::read)>::type;
+
+Stream_io_result replay_stream_write(php_stream* stream, const char* /*buffer*/, size_t count)
+{
+	static_cast<Replay_stream*>(stream->abstract)->on_request_sent();
+	return static_cast<Stream_io_result>(count);
+}
+
+Stream_io_result replay_stream_read(php_stream* stream, char* buffer, size_t count)
+{
+	Replay_stream* replay{ static_cast<Replay_stream*>(stream->abstract) };
+	const std::size_t bytes_read{ replay->read(reinterpret_cast<zend_uchar*>(buffer), count) };
+	if (!bytes_read) {
+		stream->eof = 1;
+	}
+	return static_cast<Stream_io_result>(bytes_read);
+}
+
+int replay_stream_close(php_stream* stream, int /*close_handle*/)
+{
+	delete static_cast<Replay_stream*>(stream->abstract);
+	stream->abstract = nullptr;
+	return 0;
+}
+
+int replay_stream_flush(php_stream* /*stream*/)
+{
+	return 0;
+}
+
+int replay_stream_set_option(php_stream* /*stream*/, int /*option*/, int /*value*/, void* /*ptrparam*/)
+{
+	return PHP_STREAM_OPTION_RETURN_NOTIMPL;
+}
+
+const php_stream_ops replay_stream_ops = {
+	replay_stream_write,
+	replay_stream_read,
+	replay_stream_close,
+	replay_stream_flush,
+	"xmysqlnd-replay",
+	nullptr, // seek
+	nullptr, // cast
+	nullptr, // stat
+	replay_stream_set_option
+};
+
+/*
+	the vio owns its stream, so like mysqlnd does for the network streams, take it
+	off the resource lists - otherwise it would be closed at the end of the request
+*/
+php_stream* open_replay_stream(Replay_stream* replay, const zend_bool persistent)
+{
+	char persistent_id[64];
+	if (persistent) {
+		snprintf(persistent_id, sizeof(persistent_id), "xmysqlnd_replay_%p", static_cast<void*>(replay));
+	}
+
+	php_stream* stream{ php_stream_alloc(&replay_stream_ops, replay, persistent ? persistent_id : nullptr, "r+b") };
+	if (!stream) return nullptr;
+	stream->flags |= PHP_STREAM_FLAG_NO_BUFFER;
+
+	if (persistent) {
+		stream->in_free = 1;
+		zend_hash_str_del(&EG(persistent_list), persistent_id, strlen(persistent_id));
+		stream->in_free = 0;
+	}
+
+	if (stream->res) {
+		dtor_func_t origin_dtor{ EG(regular_list).pDestructor };
+		EG(regular_list).pDestructor = nullptr;
+		zend_hash_index_del(&EG(regular_list), stream->res->handle);
+		EG(regular_list).pDestructor = origin_dtor;
+		efree(stream->res);
+		stream->res = nullptr;
+	}
+	return stream;
+}
+
+} // anonymous namespace
+
+bool xmysqlnd_is_replay_enabled()
+{
+	const char* replay_file{ MYSQL_XDEVAPI_G(replay_file) };
+	return replay_file && *replay_file;
+}
+
+enum_func_status xmysqlnd_replay_connect(
+	MYSQLND_VIO* vio,
+	const zend_bool persistent,
+	MYSQLND_ERROR_INFO* error_info)
+{
+	DBG_ENTER("xmysqlnd_replay_connect");
+	std::unique_ptr<Replay_stream> replay{ new Replay_stream(MYSQL_XDEVAPI_G(replay_pacing), false) };
+	if (!replay->load(MYSQL_XDEVAPI_G(replay_file))) {
+		SET_CLIENT_ERROR(error_info, CR_CONNECTION_ERROR, UNKNOWN_SQLSTATE, "Cannot load the replay file");
+		DBG_RETURN(FAIL);
+	}
+
+	php_stream* stream{ open_replay_stream(replay.get(), persistent) };
+	if (!stream) {
+		SET_CLIENT_ERROR(error_info, CR_CONNECTION_ERROR, UNKNOWN_SQLSTATE, "Cannot open the replay stream");
+		DBG_RETURN(FAIL);
+	}
+	replay.release();
+
+	vio->data->m.set_stream(vio, stream);
+	DBG_RETURN(PASS);
+}
+
+enum_func_status xmysqlnd_replay_attach(
+	MYSQLND_VIO* vio,
+	const zend_bool persistent,
+	const util::string_view& server_frames)
+{
+	DBG_ENTER("xmysqlnd_replay_attach");
+	std::unique_ptr<Replay_stream> replay{ new Replay_stream(false, true) };
+	if (!replay->assign(server_frames)) {
+		DBG_RETURN(FAIL);
+	}
+
+	php_stream* stream{ open_replay_stream(replay.get(), persistent) };
+	if (!stream) {
+		DBG_RETURN(FAIL);
+	}
+	replay.release();
+
+	vio->data->m.set_stream(vio, stream);
+	DBG_RETURN(PASS);
+}
+
+} // namespace drv
+
+} // namespace mysqlx
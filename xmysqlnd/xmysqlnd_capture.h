@@ -0,0 +1,101 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#ifndef XMYSQLND_CAPTURE_H
+#define XMYSQLND_CAPTURE_H
+
+#include "util/strings.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace mysqlx {
+
+namespace drv {
+
+/*
+	Capture file (.xcap) layout, all integers are little endian:
+		header: "XCAP" magic, u8 version, 3 reserved bytes
+		record: u8 direction, u8 message type, u32 payload size,
+			u64 nanoseconds since the previous record, payload
+	Payloads are the X Protocol messages exactly as they went through the frame
+	codec, i.e. still compressed if the session negotiated compression.
+*/
+enum class Capture_direction : uint8_t
+{
+	client = 0,
+	server = 1
+};
+
+/*
+	Records the frames sent and received by a session, kept by the protocol frame
+	codec. When xmysqlnd.capture_dir is empty it stays closed and the frame codec
+	only tests is_open().
+*/
+class Capture_writer
+{
+public:
+	// starts a new file in xmysqlnd.capture_dir
+	void open();
+	void write(
+		Capture_direction direction,
+		zend_uchar packet_type,
+		const zend_uchar* payload,
+		std::size_t payload_size);
+	void close();
+
+	bool is_open() const { return file != nullptr; }
+
+private:
+	void on_write_error();
+
+private:
+	std::string path;
+	std::FILE* file{nullptr};
+	uint64_t last_record_ns{0};
+};
+
+// true if xmysqlnd.replay_file is set, then sessions don't touch the network
+bool xmysqlnd_is_replay_enabled();
+
+/*
+	Stand-in for MYSQLND_VIO::connect - loads the capture set in xmysqlnd.replay_file
+	into memory and attaches it to the vio as its stream. Reading serves the recorded
+	server frames, either at full speed or with the recorded pacing if
+	xmysqlnd.replay_pacing is set, writing just discards the requests. The session
+	has to issue the same requests as the captured one, and without TLS.
+*/
+enum_func_status xmysqlnd_replay_connect(
+	MYSQLND_VIO* vio,
+	const zend_bool persistent,
+	MYSQLND_ERROR_INFO* error_info);
+
+/*
+	Like xmysqlnd_replay_connect, but serves the given server frames (laid out as
+	on the wire) over and over again - an in-process server for benchmarks.
+*/
+enum_func_status xmysqlnd_replay_attach(
+	MYSQLND_VIO* vio,
+	const zend_bool persistent,
+	const util::string_view& server_frames);
+
+} // namespace drv
+
+} // namespace mysqlx
+
+#endif // XMYSQLND_CAPTURE_H
@@ -32,8 +32,12 @@ extern "C" {
 #include "xmysqlnd_utils.h"
 #include "mysqlx_exception.h"
 #include "util/exceptions.h"
+#include "util/json_utils.h"
 #include "util/pb_utils.h"
 #include "xmysqlnd_extension_plugin.h"
+#include "php_mysqlx.h"
+#include "proto_gen/mysqlx_resultset.pb.h"
+#include <vector>
 
 namespace mysqlx {
 
@@ -54,6 +58,8 @@ xmysqlnd_collection::xmysqlnd_collection(
 
 }
 
+xmysqlnd_collection::~xmysqlnd_collection() = default;
+
 struct st_collection_exists_in_database_var_binder_ctx
 {
 	util::string_view schema_name;
@@ -121,6 +127,15 @@ xmysqlnd_collection::exists_in_database(
 	DBG_ENTER("xmysqlnd_collection::exists_in_database");
 	ZVAL_FALSE(exists);
 
+	if (schema->has_metadata_cache()) {
+		std::string object_type;
+		const enum_func_status ret{ schema->find_cached_db_object_type(collection_name, on_error, object_type) };
+		if (is_collection_object_type(object_type)) {
+			ZVAL_TRUE(exists);
+		}
+		DBG_RETURN(ret);
+	}
+
 	enum_func_status ret;
 	constexpr util::string_view query = "list_objects";
 
@@ -224,7 +239,8 @@ xmysqlnd_collection::add(XMYSQLND_CRUD_COLLECTION_OP__ADD * crud_op)
 		st_xmysqlnd_message_factory msg_factory{ session->data->create_message_factory() };
 		st_xmysqlnd_msg__collection_add collection_add = msg_factory.get__collection_add(&msg_factory);
 		enum_func_status request_ret = collection_add.send_request(&collection_add,
-											xmysqlnd_crud_collection_add__get_protobuf_message(crud_op));
+											xmysqlnd_crud_collection_add__get_protobuf_message(crud_op),
+											xmysqlnd_crud_collection_add__get_encoded_rows(crud_op));
 		if (PASS == request_ret) {
 			xmysqlnd_stmt * stmt = session->create_statement_object(session);
 			stmt->get_msg_stmt_exec() = msg_factory.get__sql_stmt_execute(&msg_factory);
@@ -395,6 +411,368 @@ xmysqlnd_collection::find(XMYSQLND_CRUD_COLLECTION_OP__FIND * op)
 	DBG_RETURN(stmt);
 }
 
+namespace {
+
+Mysqlx::Expr::Expr* add_id_criteria(Mysqlx::Expr::Expr* criteria)
+{
+	criteria->set_type(Mysqlx::Expr::Expr::OPERATOR);
+	Mysqlx::Expr::Operator* op{ criteria->mutable_operator_() };
+	op->set_name("==");
+	Mysqlx::Expr::Expr* id_ident{ op->add_param() };
+	id_ident->set_type(Mysqlx::Expr::Expr::IDENT);
+	Mysqlx::Expr::DocumentPathItem* id_member{ id_ident->mutable_identifier()->add_document_path() };
+	id_member->set_type(Mysqlx::Expr::DocumentPathItem::MEMBER);
+	id_member->set_value("_id");
+	return op->add_param();
+}
+
+std::string* init_string_value(Mysqlx::Datatypes::Scalar* scalar)
+{
+	scalar->set_type(Mysqlx::Datatypes::Scalar::V_STRING);
+	return scalar->mutable_v_string()->mutable_value();
+}
+
+std::string* init_json_value(Mysqlx::Datatypes::Scalar* scalar)
+{
+	const uint32_t Json_content_type{ Mysqlx::Resultset::JSON };
+	scalar->set_type(Mysqlx::Datatypes::Scalar::V_OCTETS);
+	scalar->mutable_v_octets()->set_content_type(Json_content_type);
+	return scalar->mutable_v_octets()->mutable_value();
+}
+
+std::string* init_literal(
+	Mysqlx::Expr::Expr* expr,
+	std::string* (*init_value)(Mysqlx::Datatypes::Scalar*))
+{
+	expr->set_type(Mysqlx::Expr::Expr::LITERAL);
+	return init_value(expr->mutable_literal());
+}
+
+void set_placeholder(Mysqlx::Expr::Expr* expr, const uint32_t position)
+{
+	expr->Clear();
+	expr->set_type(Mysqlx::Expr::Expr::PLACEHOLDER);
+	expr->set_position(position);
+}
+
+template<typename Message>
+void init_key_message(
+	Message& message,
+	const util::string& schema_name,
+	const util::string& collection_name)
+{
+	Mysqlx::Crud::Collection* collection{ message.mutable_collection() };
+	collection->set_schema(schema_name.data(), schema_name.length());
+	collection->set_name(collection_name.data(), collection_name.length());
+	message.set_data_model(Mysqlx::Crud::DOCUMENT);
+}
+
+/*
+	the criteria of the many-ids lookups, the ids are taken from first on while
+	they fit into max_size, but at least one - if there are none left, then the
+	criteria is just false
+*/
+void set_ids_criteria(
+	Mysqlx::Expr::Expr* criteria,
+	const util::strings& ids,
+	std::size_t& first,
+	const std::size_t max_size)
+{
+	if (first >= ids.size()) {
+		criteria->Clear();
+		criteria->set_type(Mysqlx::Expr::Expr::LITERAL);
+		criteria->mutable_literal()->set_type(Mysqlx::Datatypes::Scalar::V_BOOL);
+		criteria->mutable_literal()->set_v_bool(false);
+		return;
+	}
+
+	if (criteria->type() != Mysqlx::Expr::Expr::OPERATOR) {
+		criteria->Clear();
+		criteria->set_type(Mysqlx::Expr::Expr::OPERATOR);
+	}
+	Mysqlx::Expr::Operator* op{ criteria->mutable_operator_() };
+	op->set_name("in");
+	// the cleared params stay allocated, and are reused by the next chunk
+	op->clear_param();
+	Mysqlx::Expr::Expr* id_ident{ op->add_param() };
+	id_ident->set_type(Mysqlx::Expr::Expr::IDENT);
+	Mysqlx::Expr::DocumentPathItem* id_member{ id_ident->mutable_identifier()->add_document_path() };
+	id_member->set_type(Mysqlx::Expr::DocumentPathItem::MEMBER);
+	id_member->set_value("_id");
+
+	// tags and lengths of the literal
+	const std::size_t Id_literal_overhead{ 12 };
+	std::size_t size{0};
+	do {
+		const util::string& id{ ids[first++] };
+		init_literal(op->add_param(), init_string_value)->assign(id.data(), id.length());
+		size += id.length() + Id_literal_overhead;
+	} while ((first < ids.size()) && (!max_size || (size + ids[first].length() + Id_literal_overhead <= max_size)));
+}
+
+std::size_t get_lookup_batch_size()
+{
+	const zend_long batch_size_setting{ MYSQL_XDEVAPI_G(lookup_batch_size) };
+	return batch_size_setting > 0 ? static_cast<std::size_t>(batch_size_setting) : 0;
+}
+
+template<typename Message>
+Mysqlx::Expr::Expr* get_id_criteria_value(Message& message)
+{
+	return message.mutable_criteria()->mutable_operator_()->mutable_param(1);
+}
+
+void use_placeholders(Mysqlx::Crud::Find& message)
+{
+	set_placeholder(get_id_criteria_value(message), 0);
+}
+
+void use_placeholders(Mysqlx::Crud::Delete& message)
+{
+	set_placeholder(get_id_criteria_value(message), 0);
+}
+
+void use_placeholders(Mysqlx::Crud::Update& message)
+{
+	set_placeholder(get_id_criteria_value(message), 0);
+	set_placeholder(message.mutable_operation(0)->mutable_value(), 1);
+}
+
+enum class Key_statement_mode
+{
+	literal,
+	prepared,
+	failed
+};
+
+/*
+	the message with the values as literals goes as is for the first time,
+	and gets prepared with placeholders instead of them on the next use
+*/
+template<typename Message>
+struct Key_statement
+{
+	Key_statement(
+		const util::string& schema_name,
+		const util::string& collection_name,
+		const uint32_t prepared_args_count)
+		: args_count(prepared_args_count)
+	{
+		init_key_message(message, schema_name, collection_name);
+		id_literal = init_literal(add_id_criteria(message.mutable_criteria()), init_string_value);
+		id_arg_value = init_string_value(&id_arg);
+	}
+
+	Key_statement_mode prepare(Prepare_stmt_data& ps_data)
+	{
+		if (ps_id && ps_data.prepare_msg_delivered(ps_id)) {
+			return Key_statement_mode::prepared;
+		}
+		ps_id = 0;
+		if (!ps_data.is_ps_supported() || (executions++ == 0)) {
+			return Key_statement_mode::literal;
+		}
+
+		Message prepared_message(message);
+		use_placeholders(prepared_message);
+		const auto [is_new, msg_id] = ps_data.add_message(prepared_message, args_count);
+		if (is_new && !ps_data.send_prepare_msg(msg_id)) {
+			return ps_data.is_ps_supported() ? Key_statement_mode::failed : Key_statement_mode::literal;
+		}
+		ps_id = msg_id;
+		return Key_statement_mode::prepared;
+	}
+
+	Message message;
+	std::string* id_literal{nullptr};
+	Mysqlx::Datatypes::Scalar id_arg;
+	std::string* id_arg_value{nullptr};
+	const uint32_t args_count;
+	unsigned int executions{0};
+	uint32_t ps_id{0};
+};
+
+xmysqlnd_stmt* execute_prepared(
+	Prepare_stmt_data& ps_data,
+	const uint32_t ps_id,
+	std::vector<Mysqlx::Datatypes::Scalar*> args)
+{
+	if (!ps_data.bind_values(ps_id, std::move(args))) {
+		return nullptr;
+	}
+	return ps_data.send_execute_msg(ps_id);
+}
+
+xmysqlnd_stmt* send_update_or_delete(
+	XMYSQLND_SESSION session,
+	const st_xmysqlnd_pb_message_shell message_shell)
+{
+	st_xmysqlnd_message_factory msg_factory{ session->data->create_message_factory() };
+	st_xmysqlnd_msg__collection_ud collection_ud = msg_factory.get__collection_ud(&msg_factory);
+	const enum_func_status request_ret{ message_shell.command == COM_CRUD_DELETE
+		? collection_ud.send_delete_request(&collection_ud, message_shell)
+		: collection_ud.send_update_request(&collection_ud, message_shell) };
+	if (PASS != request_ret) {
+		return nullptr;
+	}
+	xmysqlnd_stmt* stmt{ session->create_statement_object(session) };
+	stmt->get_msg_stmt_exec() = msg_factory.get__sql_stmt_execute(&msg_factory);
+	return stmt;
+}
+
+} // anonymous namespace
+
+struct xmysqlnd_collection::Key_statements : public util::custom_allocable
+{
+	Key_statements(const util::string& schema_name, const util::string& collection_name)
+		: get_one(schema_name, collection_name, 1)
+		, remove_one(schema_name, collection_name, 1)
+		, replace_one(schema_name, collection_name, 2)
+	{
+		Mysqlx::Crud::UpdateOperation* operation{ replace_one.message.add_operation() };
+		operation->set_operation(Mysqlx::Crud::UpdateOperation::ITEM_SET);
+		// the path "$" is represented as a member without name
+		operation->mutable_source()->add_document_path()->set_type(Mysqlx::Expr::DocumentPathItem::MEMBER);
+		doc_literal = init_literal(operation->mutable_value(), init_json_value);
+		doc_arg_value = init_json_value(&doc_arg);
+		init_key_message(get_many, schema_name, collection_name);
+		init_key_message(remove_many, schema_name, collection_name);
+	}
+
+	Key_statement<Mysqlx::Crud::Find> get_one;
+	Key_statement<Mysqlx::Crud::Delete> remove_one;
+	Key_statement<Mysqlx::Crud::Update> replace_one;
+	std::string* doc_literal{nullptr};
+	Mysqlx::Datatypes::Scalar doc_arg;
+	std::string* doc_arg_value{nullptr};
+	Mysqlx::Crud::Find get_many;
+	Mysqlx::Crud::Delete remove_many;
+};
+
+xmysqlnd_collection::Key_statements&
+xmysqlnd_collection::get_key_statements()
+{
+	if (!key_statements) {
+		key_statements = std::make_unique<Key_statements>(schema->get_name(), collection_name);
+	}
+	return *key_statements;
+}
+
+xmysqlnd_stmt*
+xmysqlnd_collection::get_one(const util::string_view& id)
+{
+	DBG_ENTER("xmysqlnd_collection::get_one");
+	auto session{ get_schema()->get_session() };
+	Prepare_stmt_data& ps_data{ session->get_data()->ps_data };
+	auto& statement{ get_key_statements().get_one };
+	xmysqlnd_stmt* stmt{nullptr};
+	switch (statement.prepare(ps_data)) {
+		case Key_statement_mode::prepared:
+			statement.id_arg_value->assign(id.data(), id.length());
+			stmt = execute_prepared(ps_data, statement.ps_id, { &statement.id_arg });
+			break;
+
+		case Key_statement_mode::literal:
+			statement.id_literal->assign(id.data(), id.length());
+			stmt = session->create_statement_object(session);
+			if (FAIL == stmt->send_raw_message(stmt,
+											   { &statement.message, COM_CRUD_FIND },
+											   session->data->stats, session->data->error_info)) {
+				xmysqlnd_stmt_free(stmt, session->data->stats, session->data->error_info);
+				stmt = nullptr;
+			}
+			break;
+
+		case Key_statement_mode::failed:
+			break;
+	}
+	DBG_RETURN(stmt);
+}
+
+xmysqlnd_stmt*
+xmysqlnd_collection::remove_one(const util::string_view& id)
+{
+	DBG_ENTER("xmysqlnd_collection::remove_one");
+	auto session{ get_schema()->get_session() };
+	Prepare_stmt_data& ps_data{ session->get_data()->ps_data };
+	auto& statement{ get_key_statements().remove_one };
+	xmysqlnd_stmt* stmt{nullptr};
+	switch (statement.prepare(ps_data)) {
+		case Key_statement_mode::prepared:
+			statement.id_arg_value->assign(id.data(), id.length());
+			stmt = execute_prepared(ps_data, statement.ps_id, { &statement.id_arg });
+			break;
+
+		case Key_statement_mode::literal:
+			statement.id_literal->assign(id.data(), id.length());
+			stmt = send_update_or_delete(session, { &statement.message, COM_CRUD_DELETE });
+			break;
+
+		case Key_statement_mode::failed:
+			break;
+	}
+	DBG_RETURN(stmt);
+}
+
+xmysqlnd_stmt*
+xmysqlnd_collection::replace_one(const util::string_view& id, const util::zvalue& doc)
+{
+	DBG_ENTER("xmysqlnd_collection::replace_one");
+	auto session{ get_schema()->get_session() };
+	Prepare_stmt_data& ps_data{ session->get_data()->ps_data };
+	Key_statements& key_stmts{ get_key_statements() };
+	auto& statement{ key_stmts.replace_one };
+	xmysqlnd_stmt* stmt{nullptr};
+	switch (statement.prepare(ps_data)) {
+		case Key_statement_mode::prepared:
+			key_stmts.doc_arg_value->clear();
+			util::json::ensure_doc_id(doc, id, *key_stmts.doc_arg_value);
+			statement.id_arg_value->assign(id.data(), id.length());
+			stmt = execute_prepared(ps_data, statement.ps_id, { &statement.id_arg, &key_stmts.doc_arg });
+			break;
+
+		case Key_statement_mode::literal:
+			key_stmts.doc_literal->clear();
+			util::json::ensure_doc_id(doc, id, *key_stmts.doc_literal);
+			statement.id_literal->assign(id.data(), id.length());
+			stmt = send_update_or_delete(session, { &statement.message, COM_CRUD_UPDATE });
+			break;
+
+		case Key_statement_mode::failed:
+			break;
+	}
+	DBG_RETURN(stmt);
+}
+
+xmysqlnd_stmt*
+xmysqlnd_collection::get_many(const util::strings& ids, std::size_t& first)
+{
+	DBG_ENTER("xmysqlnd_collection::get_many");
+	auto session{ get_schema()->get_session() };
+	Mysqlx::Crud::Find& message{ get_key_statements().get_many };
+	set_ids_criteria(message.mutable_criteria(), ids, first, get_lookup_batch_size());
+	DBG_INF_FMT("next_id=%u of %u", static_cast<unsigned int>(first), static_cast<unsigned int>(ids.size()));
+	xmysqlnd_stmt* stmt{ session->create_statement_object(session) };
+	if (FAIL == stmt->send_raw_message(stmt,
+									   { &message, COM_CRUD_FIND },
+									   session->data->stats, session->data->error_info)) {
+		xmysqlnd_stmt_free(stmt, session->data->stats, session->data->error_info);
+		stmt = nullptr;
+	}
+	DBG_RETURN(stmt);
+}
+
+xmysqlnd_stmt*
+xmysqlnd_collection::remove_many(const util::strings& ids, std::size_t& first)
+{
+	DBG_ENTER("xmysqlnd_collection::remove_many");
+	auto session{ get_schema()->get_session() };
+	Mysqlx::Crud::Delete& message{ get_key_statements().remove_many };
+	set_ids_criteria(message.mutable_criteria(), ids, first, get_lookup_batch_size());
+	DBG_INF_FMT("next_id=%u of %u", static_cast<unsigned int>(first), static_cast<unsigned int>(ids.size()));
+	DBG_RETURN(send_update_or_delete(session, { &message, COM_CRUD_DELETE }));
+}
+
 xmysqlnd_collection *
 xmysqlnd_collection::get_reference()
 {
@@ -421,6 +799,7 @@ xmysqlnd_collection::free_contents()
 {
 	DBG_ENTER("xmysqlnd_collection::free_contents");
 	collection_name.clear();
+	key_statements.reset();
 	DBG_VOID_RETURN;
 }
 
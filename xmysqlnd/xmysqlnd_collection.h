@@ -23,6 +23,9 @@
 #include "xmysqlnd_driver.h"
 #include "xmysqlnd_crud_collection_commands.h"
 #include "util/allocator.h"
+#include "util/strings.h"
+#include "util/value.h"
+#include <memory>
 
 namespace mysqlx {
 
@@ -38,6 +41,7 @@ public:
 	xmysqlnd_collection(xmysqlnd_schema * const cur_schema,
 								const util::string_view& cur_collection_name,
 								zend_bool is_persistent);
+	~xmysqlnd_collection();
 	enum_func_status		exists_in_database(st_xmysqlnd_session_on_error_bind on_error, util::raw_zval* exists);
 	enum_func_status		count(st_xmysqlnd_session_on_error_bind on_error, util::raw_zval* counter);
 	xmysqlnd_stmt*       add(XMYSQLND_CRUD_COLLECTION_OP__ADD * crud_op);
@@ -45,6 +49,23 @@ public:
 	xmysqlnd_stmt*		modify(XMYSQLND_CRUD_COLLECTION_OP__MODIFY * op);
 	xmysqlnd_stmt*		find(XMYSQLND_CRUD_COLLECTION_OP__FIND * op);
 
+	/*
+		single document operations keyed by _id - they send prebuilt messages with
+		the id put straight into them, and prepare them on the server once they
+		are used again
+	*/
+	xmysqlnd_stmt*		get_one(const util::string_view& id);
+	xmysqlnd_stmt*		remove_one(const util::string_view& id);
+	xmysqlnd_stmt*		replace_one(const util::string_view& id, const util::zvalue& doc);
+
+	/*
+		Find / Delete with the criteria "_id IN (...)" built straight from the ids,
+		beginning with ids[first] - as many of them as fit in xmysqlnd.lookup_batch_size
+		(but at least one), first is moved past them. With no ids left nothing matches.
+	*/
+	xmysqlnd_stmt*		get_many(const util::strings& ids, std::size_t& first);
+	xmysqlnd_stmt*		remove_many(const util::strings& ids, std::size_t& first);
+
 	xmysqlnd_collection *   get_reference();
 	enum_func_status		free_reference(MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
 	void					free_contents();
@@ -56,10 +77,14 @@ public:
 		return schema;
 	}
 private:
+	struct Key_statements;
+	Key_statements&		get_key_statements();
+
 	xmysqlnd_schema*	schema;
 	util::string        collection_name;
 	zend_bool           persistent;
 	unsigned int	    refcount;
+	std::unique_ptr<Key_statements> key_statements;
 };
 
 PHP_MYSQL_XDEVAPI_API xmysqlnd_collection * xmysqlnd_collection_create(xmysqlnd_schema* schema,
@@ -21,6 +21,7 @@
 #include "xmysqlnd_compressor_lz4.h"
 #include "xmysqlnd_compressor_zlib.h"
 #include "xmysqlnd_compressor_zstd.h"
+#include "xmysqlnd_perf_statistics.h"
 #include "util/exceptions.h"
 #include "util/types.h"
 #include "util/value.h"
@@ -242,20 +243,37 @@ Compress_result Executor::compress_message(
 	util::byte* msg_payload)
 {
 	assert(enabled());
+	Perf_statistics* const perf_stats{ xmysqlnd_get_perf_statistics() };
+	const Perf_clock::time_point started{ perf_stats ? Perf_clock::now() : Perf_clock::time_point() };
 	Payload_composer payload_composer(msg_payload_size);
 	const util::bytes& uncompressed_payload = payload_composer.run(msg_packet_type, msg_payload_size, msg_payload);
-	return Compress_result{
+	Compress_result result{
 		uncompressed_payload.size(),
 		compressor->compress(uncompressed_payload)
 	};
+	if (perf_stats) {
+		++perf_stats->counters[XMYSQLND_PERF_COMPRESSED_MESSAGES];
+		perf_stats->counters[XMYSQLND_PERF_COMPRESS_BYTES_IN] += result.uncompressed_size;
+		perf_stats->counters[XMYSQLND_PERF_COMPRESS_BYTES_OUT] += result.compressed_payload.size();
+		perf_stats->counters[XMYSQLND_PERF_COMPRESS_NS] += xmysqlnd_perf_elapsed_ns(started);
+	}
+	return result;
 }
 
 void Executor::decompress_messages(const Mysqlx::Connection::Compression& message, Messages& messages)
 {
 	assert(enabled());
+	Perf_statistics* const perf_stats{ xmysqlnd_get_perf_statistics() };
+	const Perf_clock::time_point started{ perf_stats ? Perf_clock::now() : Perf_clock::time_point() };
 	const util::bytes& uncompressed_payload{ compressor->decompress(message) };
 	Message_extractor msg_extractor(messages);
 	msg_extractor.run(uncompressed_payload);
+	if (perf_stats) {
+		++perf_stats->counters[XMYSQLND_PERF_DECOMPRESSED_MESSAGES];
+		perf_stats->counters[XMYSQLND_PERF_DECOMPRESS_BYTES_IN] += message.payload().size();
+		perf_stats->counters[XMYSQLND_PERF_DECOMPRESS_BYTES_OUT] += uncompressed_payload.size();
+		perf_stats->counters[XMYSQLND_PERF_DECOMPRESS_NS] += xmysqlnd_perf_elapsed_ns(started);
+	}
 }
 
 } // namespace compression
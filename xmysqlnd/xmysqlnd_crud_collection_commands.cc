@@ -22,11 +22,15 @@
 #include "xmysqlnd.h"
 #include "xmysqlnd_driver.h"
 #include "xmysqlnd_zval2any.h"
+#include "xmysqlnd_zval2expr.h"
 #include "xmysqlnd_wireprotocol.h"
 #include "mysqlx_enum_n_def.h"
 #include "util/exceptions.h"
 #include "xmysqlnd_crud_collection_commands.h"
+#include "util/json_utils.h"
 #include "util/pb_utils.h"
+#include <limits>
+#include <memory>
 
 namespace mysqlx {
 
@@ -89,15 +93,19 @@ bool Bindings::bind(const util::string& var_name, const util::zvalue& var_value)
 		DBG_RETURN(false);
 	}
 
-	Mysqlx::Datatypes::Any any;
-	zval2any(var_value, any);
-	any2log(any);
+	std::unique_ptr<Mysqlx::Datatypes::Scalar> scalar(new Mysqlx::Datatypes::Scalar);
+	if (!zval2scalar(var_value, scalar.get())) {
+		Mysqlx::Datatypes::Any any;
+		zval2any(var_value, any);
+		any2log(any);
+		scalar.reset(any.release_scalar());
+	}
 
 	auto& bound_value = it->second;
 	if (bound_value) {
 		delete bound_value;
 	}
-	bound_value = any.release_scalar();
+	bound_value = scalar.release();
 
 	scalar2log(*bound_value);
 
@@ -224,6 +232,25 @@ xmysqlnd_crud_collection_add__finalize_bind(XMYSQLND_CRUD_COLLECTION_OP__ADD * o
 	DBG_RETURN(ret);
 }
 
+std::size_t
+xmysqlnd_crud_collection_add__bind_doc(
+	XMYSQLND_CRUD_COLLECTION_OP__ADD * obj,
+	const util::zvalue& doc,
+	const util::string_view& doc_id)
+{
+	DBG_ENTER("xmysqlnd_crud_collection_add__bind_doc");
+	const std::size_t ret{ obj->bind_document(doc, doc_id) };
+	DBG_RETURN(ret);
+}
+
+void
+xmysqlnd_crud_collection_add__clear_docs(XMYSQLND_CRUD_COLLECTION_OP__ADD * obj)
+{
+	DBG_ENTER("xmysqlnd_crud_collection_add__clear_docs");
+	obj->clear_rows();
+	DBG_VOID_RETURN;
+}
+
 struct st_xmysqlnd_pb_message_shell
 		xmysqlnd_crud_collection_add__get_protobuf_message(XMYSQLND_CRUD_COLLECTION_OP__ADD * obj)
 {
@@ -231,6 +258,12 @@ struct st_xmysqlnd_pb_message_shell
 	return ret;
 }
 
+std::string&
+xmysqlnd_crud_collection_add__get_encoded_rows(XMYSQLND_CRUD_COLLECTION_OP__ADD * obj)
+{
+	return obj->encoded_rows;
+}
+
 enum_func_status
 xmysqlnd_crud_collection_add__add_doc(
 	XMYSQLND_CRUD_COLLECTION_OP__ADD * obj,
@@ -242,24 +275,155 @@ xmysqlnd_crud_collection_add__add_doc(
 	DBG_RETURN(ret);
 }
 
+enum_func_status
+xmysqlnd_crud_collection_add__add_doc(
+	XMYSQLND_CRUD_COLLECTION_OP__ADD * obj,
+	const util::zvalue& doc,
+	const util::string_view& doc_id)
+{
+	DBG_ENTER("xmysqlnd_crud_collection_add__add_doc");
+	enum_func_status ret{PASS};
+	obj->add_document(doc, doc_id);
+	DBG_RETURN(ret);
+}
+
+namespace {
+
+constexpr char length_delimited_tag(int field_number)
+{
+	return static_cast<char>((field_number << 3) | 2);
+}
+
+constexpr char varint_tag(int field_number)
+{
+	return static_cast<char>(field_number << 3);
+}
+
+// enum values written here are below 128, so they take a single byte
+void append_varint_field(std::string& dest, int field_number, int value)
+{
+	assert((0 <= value) && (value < 0x80));
+	dest.push_back(varint_tag(field_number));
+	dest.push_back(static_cast<char>(value));
+}
+
+// room for the length of a field, filled in when the field is complete
+constexpr std::size_t Length_placeholder_size{5};
+
+std::size_t reserve_length(std::string& dest, char tag)
+{
+	dest.push_back(tag);
+	const std::size_t placeholder_pos{ dest.size() };
+	dest.append(Length_placeholder_size, '\0');
+	return placeholder_pos;
+}
+
+/*
+	the length runs till the end of dest, it is written as a varint padded to the
+	whole placeholder - protobuf parsers accept such non-minimal encoding
+*/
+void patch_length(std::string& dest, std::size_t placeholder_pos)
+{
+	uint64_t length{ dest.size() - placeholder_pos - Length_placeholder_size };
+	if (length > static_cast<uint64_t>(std::numeric_limits<int32_t>::max())) {
+		throw util::xdevapi_exception(util::xdevapi_exception::Code::add_doc, "document too large");
+	}
+	char* placeholder{ &dest[placeholder_pos] };
+	for (std::size_t i{0}; i < Length_placeholder_size - 1; ++i) {
+		placeholder[i] = static_cast<char>((length & 0x7f) | 0x80);
+		length >>= 7;
+	}
+	placeholder[Length_placeholder_size - 1] = static_cast<char>(length);
+}
+
+} // anonymous namespace
+
+/*
+	appends Insert.row = { field = { type = LITERAL, literal = { type = V_STRING,
+	v_string = { value = <document> } } } } to encoded_rows, the document is
+	encoded straight into its place, and the lengths of the enclosing fields are
+	filled in afterwards - returns the size of the row
+*/
+template<typename Encode_document>
+std::size_t st_xmysqlnd_crud_collection_op__add::add_document_row(Encode_document encode_document)
+{
+	using Mysqlx::Crud::Insert;
+	using Mysqlx::Crud::Insert_TypedRow;
+	using Mysqlx::Datatypes::Scalar;
+	using Mysqlx::Datatypes::Scalar_String;
+	using Mysqlx::Expr::Expr;
+
+	const std::size_t row_begin{ encoded_rows.size() };
+	try {
+		const std::size_t row_length{
+			reserve_length(encoded_rows, length_delimited_tag(Insert::kRowFieldNumber)) };
+		const std::size_t field_length{
+			reserve_length(encoded_rows, length_delimited_tag(Insert_TypedRow::kFieldFieldNumber)) };
+		append_varint_field(encoded_rows, Expr::kTypeFieldNumber, Expr::LITERAL);
+		const std::size_t literal_length{
+			reserve_length(encoded_rows, length_delimited_tag(Expr::kLiteralFieldNumber)) };
+		append_varint_field(encoded_rows, Scalar::kTypeFieldNumber, Scalar::V_STRING);
+		const std::size_t v_string_length{
+			reserve_length(encoded_rows, length_delimited_tag(Scalar::kVStringFieldNumber)) };
+		const std::size_t value_length{
+			reserve_length(encoded_rows, length_delimited_tag(Scalar_String::kValueFieldNumber)) };
+
+		encode_document(encoded_rows);
+
+		for (const std::size_t length_pos : { row_length, field_length, literal_length, v_string_length, value_length }) {
+			patch_length(encoded_rows, length_pos);
+		}
+	} catch (...) {
+		encoded_rows.resize(row_begin);
+		throw;
+	}
+	return encoded_rows.size() - row_begin;
+}
+
 void st_xmysqlnd_crud_collection_op__add::add_document(const util::zvalue& doc)
 {
-	docs.push_back(doc.clone());
+	docs.push_back({doc, std::nullopt});
 }
 
-void st_xmysqlnd_crud_collection_op__add::bind_docs()
+void st_xmysqlnd_crud_collection_op__add::add_document(
+	const util::zvalue& doc,
+	const util::string_view& doc_id)
 {
-	for (auto& doc : docs) {
-		::Mysqlx::Crud::Insert_TypedRow* row = message.add_row();
-		Mysqlx::Expr::Expr * field = row->add_field();
-		field->set_type(Mysqlx::Expr::Expr::LITERAL);
+	docs.push_back({doc, util::string(doc_id)});
+}
 
-		Mysqlx::Datatypes::Scalar * literal = field->mutable_literal();
-		literal->set_type(Mysqlx::Datatypes::Scalar::V_STRING);
-		literal->mutable_v_string()->set_value(doc.c_str(), doc.length());
+void st_xmysqlnd_crud_collection_op__add::bind_docs()
+{
+	for (const auto& doc : docs) {
+		add_document_row([&doc](std::string& doc_value) {
+			if (doc.id) {
+				util::json::encode_document(doc.raw_doc, *doc.id, doc_value);
+			} else {
+				util::json::encode_document(doc.raw_doc, doc_value);
+			}
+		});
 	}
 }
 
+/*
+	used by addOrReplaceMany, which doesn't keep the documents - they are validated
+	and encoded with the id injected in a single pass
+*/
+std::size_t st_xmysqlnd_crud_collection_op__add::bind_document(
+	const util::zvalue& doc,
+	const util::string_view& doc_id)
+{
+	return add_document_row([&doc, &doc_id](std::string& doc_value) {
+		util::json::ensure_doc_id(doc, doc_id, doc_value);
+	});
+}
+
+void st_xmysqlnd_crud_collection_op__add::clear_rows()
+{
+	// the buffer is reused by the next chunk of documents
+	encoded_rows.clear();
+}
+
 /****************************** COLLECTION.REMOVE() *******************************************************/
 
 XMYSQLND_CRUD_COLLECTION_OP__REMOVE *
@@ -509,12 +673,7 @@ xmysqlnd_crud_collection_modify__add_operation(
 				DBG_RETURN(false);
 			}
 		} else {
-			Mysqlx::Datatypes::Any any;
-			zval2any(value, any);
-			any2log(any);
-
-			operation->mutable_value()->set_type(Mysqlx::Expr::Expr::LITERAL);
-			operation->mutable_value()->set_allocated_literal(any.release_scalar());
+			zval2expr(value, operation->mutable_value());
 		}
 	}
 
@@ -847,6 +1006,19 @@ struct st_xmysqlnd_pb_message_shell
 
 /****************************** SQL EXECUTE *******************************************************/
 
+void
+st_xmysqlnd_stmt_op__execute::reset(const util::string_view& namespace_, const util::string_view& stmt)
+{
+	DBG_ENTER("st_xmysqlnd_stmt_op__execute::reset");
+	params.clear();
+	message.Clear();
+	message.set_namespace_(namespace_.data(), namespace_.length());
+	message.set_stmt(stmt.data(), stmt.length());
+	message.set_compact_metadata(false);
+	ps_message_id = 0;
+	DBG_VOID_RETURN;
+}
+
 enum_func_status
 st_xmysqlnd_stmt_op__execute::bind_one_param(const util::zvalue& param)
 {
@@ -41,8 +41,14 @@ XMYSQLND_CRUD_COLLECTION_OP__ADD  * xmysqlnd_crud_collection_add__create(const u
 void                                xmysqlnd_crud_collection_add__destroy(XMYSQLND_CRUD_COLLECTION_OP__ADD * obj);
 enum_func_status                    xmysqlnd_crud_collection_add__set_upsert(XMYSQLND_CRUD_COLLECTION_OP__ADD * obj);
 enum_func_status                    xmysqlnd_crud_collection_add__add_doc(XMYSQLND_CRUD_COLLECTION_OP__ADD * obj, const util::zvalue& doc);
+enum_func_status                    xmysqlnd_crud_collection_add__add_doc(XMYSQLND_CRUD_COLLECTION_OP__ADD * obj, const util::zvalue& doc, const util::string_view& doc_id);
 enum_func_status                    xmysqlnd_crud_collection_add__finalize_bind(XMYSQLND_CRUD_COLLECTION_OP__ADD * obj);
+// encodes the document into the message right away, returns the size of its row
+std::size_t                         xmysqlnd_crud_collection_add__bind_doc(XMYSQLND_CRUD_COLLECTION_OP__ADD * obj, const util::zvalue& doc, const util::string_view& doc_id);
+void                                xmysqlnd_crud_collection_add__clear_docs(XMYSQLND_CRUD_COLLECTION_OP__ADD * obj);
 struct st_xmysqlnd_pb_message_shell xmysqlnd_crud_collection_add__get_protobuf_message(XMYSQLND_CRUD_COLLECTION_OP__ADD * obj);
+// the rows of Insert, sent together with the message, see st_xmysqlnd_msg__collection_add
+std::string&                        xmysqlnd_crud_collection_add__get_encoded_rows(XMYSQLND_CRUD_COLLECTION_OP__ADD * obj);
 
 typedef struct st_xmysqlnd_crud_collection_op__remove XMYSQLND_CRUD_COLLECTION_OP__REMOVE;
 
@@ -194,8 +200,20 @@ struct st_xmysqlnd_crud_collection_op__find
 struct st_xmysqlnd_crud_collection_op__add
 {
 	Mysqlx::Crud::Insert message;
-
-	util::zvalues docs;
+	/*
+		the rows of message, documents are encoded straight into them as on the wire,
+		and the rest of message is appended only when sending - see
+		st_xmysqlnd_msg__collection_add
+	*/
+	std::string encoded_rows;
+
+	struct Document
+	{
+		util::zvalue raw_doc;
+		// if set, then it is injected as "_id" while encoding
+		std::optional<util::string> id;
+	};
+	util::vector<Document> docs;
 
 	st_xmysqlnd_crud_collection_op__add(
 		const util::string_view& schema,
@@ -207,7 +225,14 @@ struct st_xmysqlnd_crud_collection_op__add
 	}
 
 	void add_document(const util::zvalue& doc);
+	void add_document(const util::zvalue& doc, const util::string_view& doc_id);
 	void bind_docs();
+	std::size_t bind_document(const util::zvalue& doc, const util::string_view& doc_id);
+	void clear_rows();
+
+private:
+	template<typename Encode_document>
+	std::size_t add_document_row(Encode_document encode_document);
 };
 
 struct st_xmysqlnd_crud_collection_op__modify
@@ -263,6 +288,9 @@ struct st_xmysqlnd_stmt_op__execute
         message.set_compact_metadata(compact_meta);
     }
 
+    // ready for another statement, the message keeps its allocated fields
+    void reset(const util::string_view& namespace_, const util::string_view& stmt);
+
     enum_func_status bind_one_param(const util::zvalue& param);
     enum_func_status finalize_bind();
 };
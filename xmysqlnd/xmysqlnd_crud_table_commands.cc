@@ -19,10 +19,12 @@
 #include "mysqlnd_api.h"
 #include "xmysqlnd.h"
 #include "xmysqlnd_driver.h"
-#include "xmysqlnd_any2expr.h"
 #include "xmysqlnd_zval2any.h"
+#include "xmysqlnd_zval2expr.h"
+#include "xmysqlnd_stmt_execution_state.h"
 #include "xmysqlnd_wireprotocol.h"
 
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -35,6 +37,10 @@
 #include "util/exceptions.h"
 #include "util/pb_utils.h"
 
+extern "C" {
+#include <zend_interfaces.h>
+}
+
 namespace mysqlx {
 
 namespace drv {
@@ -57,9 +63,13 @@ xmysqlnd_crud_table__bind_value(std::vector<std::string> & placeholders,
 		DBG_RETURN(FAIL);
 	}
 
-	Mysqlx::Datatypes::Any any;
-	zval2any(value, any);
-	any2log(any);
+	std::unique_ptr<Mysqlx::Datatypes::Scalar> scalar(new Mysqlx::Datatypes::Scalar);
+	if (!zval2scalar(value, scalar.get())) {
+		Mysqlx::Datatypes::Any any;
+		zval2any(value, any);
+		any2log(any);
+		scalar.reset(any.release_scalar());
+	}
 
 	const auto offset = index - begin;
 	DBG_INF_FMT("offset=%u", offset);
@@ -67,7 +77,7 @@ xmysqlnd_crud_table__bind_value(std::vector<std::string> & placeholders,
 	if (bound_value) {
 		delete bound_value;
 	}
-	bound_value = any.release_scalar();
+	bound_value = scalar.release();
 
 	scalar2log(*bound_value);
 
@@ -173,13 +183,12 @@ void st_xmysqlnd_crud_table_op__insert::add_column(zval * column_zv)
 
 void st_xmysqlnd_crud_table_op__insert::add_row(zval* row_zv)
 {
-	zval new_row_zv;
-	ZVAL_COPY_VALUE(&new_row_zv, row_zv);
-	rows_zv.push_back(new_row_zv);
+	row_sources.emplace_back(row_zv);
 }
 
 void st_xmysqlnd_crud_table_op__insert::bind_columns()
 {
+	message.clear_projection();
 	for (auto& column_name : column_names)
 	{
 		bind_column(column_name);
@@ -192,43 +201,89 @@ void st_xmysqlnd_crud_table_op__insert::bind_column(const std::string& column_na
 	column->set_name(column_name);
 }
 
-void st_xmysqlnd_crud_table_op__insert::bind_rows()
+void st_xmysqlnd_crud_table_op__insert::rewind_rows()
 {
-	for (auto& values_zv : rows_zv)
-	{
+	close_row_iterator();
+	next_row_source = 0;
+	items_affected = 0;
+	last_insert_id = 0;
+}
+
+bool st_xmysqlnd_crud_table_op__insert::bind_next_rows(const std::size_t max_batch_size)
+{
+	message.clear_row();
+	std::size_t batch_size{0};
+	while ((max_batch_size == 0) || (batch_size < max_batch_size)) {
+		const util::zvalue values{ fetch_next_row() };
+		if (values.is_undef()) break;
+
 		::Mysqlx::Crud::Insert_TypedRow* row = message.add_row();
-		bind_row(&values_zv, row);
+		bind_row(values, row);
+		batch_size += row->ByteSizeLong();
 	}
+	return message.row_size() > 0;
 }
 
-void st_xmysqlnd_crud_table_op__insert::bind_row(zval* values_zv, ::Mysqlx::Crud::Insert_TypedRow* row)
+void st_xmysqlnd_crud_table_op__insert::bind_row(const util::zvalue& values, ::Mysqlx::Crud::Insert_TypedRow* row)
 {
-	switch (Z_TYPE_P(values_zv))
-	{
-		case IS_ARRAY: {
-			zval* entry{nullptr};
-			MYSQLX_HASH_FOREACH_VAL(Z_ARRVAL_P(values_zv), entry)
-			{
-				bind_row_field(entry, row);
-			} ZEND_HASH_FOREACH_END();
-			break;
+	if (values.is_array()) {
+		for (const auto& value : values.values()) {
+			bind_row_field(value, row);
 		}
+	} else {
+		bind_row_field(values, row);
+	}
+}
 
-		default: {
-			bind_row_field(values_zv, row);
-			break;
+// encoded straight into the field, without building an Any first
+void st_xmysqlnd_crud_table_op__insert::bind_row_field(const util::zvalue& value, ::Mysqlx::Crud::Insert_TypedRow* row)
+{
+	zval2expr(value, row->add_field());
+}
+
+/*
+	returns undef when there are no more rows, or when iterating a Traversable
+	has thrown - then EG(exception) is set
+*/
+util::zvalue st_xmysqlnd_crud_table_op__insert::fetch_next_row()
+{
+	while (next_row_source < row_sources.size()) {
+		const util::zvalue& source{ row_sources[next_row_source] };
+		if (!source.is_object() || !source.is_instance_of(zend_ce_traversable)) {
+			++next_row_source;
+			return source;
 		}
+
+		if (!row_iterator) {
+			zend_class_entry* ce{ Z_OBJCE_P(source.ptr()) };
+			row_iterator = ce->get_iterator(ce, source.ptr(), 0);
+			if (row_iterator && row_iterator->funcs->rewind) {
+				row_iterator->funcs->rewind(row_iterator);
+			}
+		} else {
+			row_iterator->funcs->move_forward(row_iterator);
+		}
+
+		if (row_iterator && !EG(exception) && (row_iterator->funcs->valid(row_iterator) == SUCCESS)) {
+			const zval* row_zv{ row_iterator->funcs->get_current_data(row_iterator) };
+			if (row_zv && !EG(exception)) {
+				return util::zvalue(row_zv);
+			}
+		}
+
+		close_row_iterator();
+		if (EG(exception)) break;
+		++next_row_source;
 	}
+	return util::zvalue();
 }
 
-void st_xmysqlnd_crud_table_op__insert::bind_row_field(zval* value_zv, ::Mysqlx::Crud::Insert_TypedRow* row)
+void st_xmysqlnd_crud_table_op__insert::close_row_iterator()
 {
-	Mysqlx::Datatypes::Any any;
-	zval2any(value_zv, any);
-	any2log(any);
-
-	Mysqlx::Expr::Expr * field = row->add_field();
-	any2expr(any, field);
+	if (row_iterator) {
+		zend_iterator_dtor(row_iterator);
+		row_iterator = nullptr;
+	}
 }
 
 /****************************** xmysqlnd_crud_table_insert *******************************************************/
@@ -265,15 +320,51 @@ xmysqlnd_crud_table_insert__add_row(XMYSQLND_CRUD_TABLE_OP__INSERT * obj, zval *
 }
 
 enum_func_status
-xmysqlnd_crud_table_insert__finalize_bind(XMYSQLND_CRUD_TABLE_OP__INSERT * obj)
+xmysqlnd_crud_table_insert__finalize_bind(XMYSQLND_CRUD_TABLE_OP__INSERT * obj, const std::size_t max_batch_size)
 {
 	DBG_ENTER("xmysqlnd_crud_table_insert__finalize_bind");
-	const enum_func_status ret = PASS;
 	obj->bind_columns();
-	obj->bind_rows();
+	obj->rewind_rows();
+	obj->bind_next_rows(max_batch_size);
+	const enum_func_status ret = EG(exception) ? FAIL : PASS;
+	DBG_RETURN(ret);
+}
+
+zend_bool
+xmysqlnd_crud_table_insert__bind_next_batch(XMYSQLND_CRUD_TABLE_OP__INSERT * obj, const std::size_t max_batch_size)
+{
+	DBG_ENTER("xmysqlnd_crud_table_insert__bind_next_batch");
+	const zend_bool ret = (obj->bind_next_rows(max_batch_size) && !EG(exception)) ? TRUE : FALSE;
+	DBG_INF_FMT("rows=%d", obj->message.row_size());
 	DBG_RETURN(ret);
 }
 
+void
+xmysqlnd_crud_table_insert__add_batch_state(XMYSQLND_CRUD_TABLE_OP__INSERT * obj, const st_xmysqlnd_stmt_execution_state * const exec_state)
+{
+	DBG_ENTER("xmysqlnd_crud_table_insert__add_batch_state");
+	obj->items_affected += exec_state->m->get_affected_items_count(exec_state);
+	if (!obj->last_insert_id) {
+		obj->last_insert_id = exec_state->m->get_last_insert_id(exec_state);
+	}
+	DBG_VOID_RETURN;
+}
+
+/*
+	like for a single multi-row INSERT, the last insert id is the one generated for
+	the first row
+*/
+void
+xmysqlnd_crud_table_insert__merge_batch_states(const XMYSQLND_CRUD_TABLE_OP__INSERT * obj, st_xmysqlnd_stmt_execution_state * const exec_state)
+{
+	DBG_ENTER("xmysqlnd_crud_table_insert__merge_batch_states");
+	exec_state->m->set_affected_items_count(exec_state, obj->items_affected + exec_state->m->get_affected_items_count(exec_state));
+	if (obj->last_insert_id) {
+		exec_state->m->set_last_insert_id(exec_state, obj->last_insert_id);
+	}
+	DBG_VOID_RETURN;
+}
+
 struct st_xmysqlnd_pb_message_shell
 xmysqlnd_crud_table_insert__get_protobuf_message(XMYSQLND_CRUD_TABLE_OP__INSERT * obj)
 {
@@ -529,12 +620,7 @@ xmysqlnd_crud_table_update__add_operation(XMYSQLND_CRUD_TABLE_OP__UPDATE * obj,
 			DBG_RETURN(FAIL);
 		}
 	} else {
-		Mysqlx::Datatypes::Any any;
-		zval2any(value, any);
-		any2log(any);
-
-		operation->mutable_value()->set_type(Mysqlx::Expr::Expr::LITERAL);
-		operation->mutable_value()->set_allocated_literal(any.release_scalar());
+		zval2expr(value, operation->mutable_value());
 	}
 
 	DBG_RETURN(PASS);
@@ -21,17 +21,23 @@
 #include "xmysqlnd_crud_commands.h"
 #include "xmysqlnd/crud_parsers/mysqlx_crud_parser.h"
 #include "xmysqlnd/crud_parsers/expression_parser.h"
+#include "util/value.h"
 
 namespace mysqlx {
 
 namespace drv {
 
+struct st_xmysqlnd_stmt_execution_state;
+
 typedef struct st_xmysqlnd_crud_table_op__insert XMYSQLND_CRUD_TABLE_OP__INSERT;
 
 XMYSQLND_CRUD_TABLE_OP__INSERT * xmysqlnd_crud_table_insert__create(const util::string& schema, const util::string& table, zval * columns, const int num_of_columns);
 void xmysqlnd_crud_table_insert__destroy(XMYSQLND_CRUD_TABLE_OP__INSERT * obj);
 enum_func_status xmysqlnd_crud_table_insert__add_row(XMYSQLND_CRUD_TABLE_OP__INSERT * obj, zval * values_zv);
-enum_func_status xmysqlnd_crud_table_insert__finalize_bind(XMYSQLND_CRUD_TABLE_OP__INSERT * obj);
+enum_func_status xmysqlnd_crud_table_insert__finalize_bind(XMYSQLND_CRUD_TABLE_OP__INSERT * obj, const std::size_t max_batch_size);
+zend_bool xmysqlnd_crud_table_insert__bind_next_batch(XMYSQLND_CRUD_TABLE_OP__INSERT * obj, const std::size_t max_batch_size);
+void xmysqlnd_crud_table_insert__add_batch_state(XMYSQLND_CRUD_TABLE_OP__INSERT * obj, const st_xmysqlnd_stmt_execution_state * const exec_state);
+void xmysqlnd_crud_table_insert__merge_batch_states(const XMYSQLND_CRUD_TABLE_OP__INSERT * obj, st_xmysqlnd_stmt_execution_state * const exec_state);
 struct st_xmysqlnd_pb_message_shell xmysqlnd_crud_table_insert__get_protobuf_message(XMYSQLND_CRUD_TABLE_OP__INSERT * obj);
 zend_bool xmysqlnd_crud_table_insert__is_initialized(XMYSQLND_CRUD_TABLE_OP__INSERT * obj);
 
@@ -109,9 +115,20 @@ struct st_xmysqlnd_crud_table_op__insert
 	Mysqlx::Crud::Insert message;
 
 	std::vector<std::string> column_names;
-	std::vector<zval > rows_zv;
+	/*
+		rows as passed to values() - arrays of field values, or Traversables (e.g.
+		generators) of them, which are walked only while the batches are sent, so
+		the rows of a bulk load never exist all at once, neither as zvals nor in
+		the message
+	*/
+	std::vector<util::zvalue> row_sources;
+	std::size_t next_row_source{0};
+	zend_object_iterator* row_iterator{nullptr};
 	std::vector<Mysqlx::Datatypes::Scalar*> bound_values;
 	uint32_t ps_message_id;
+	// counters of the batches sent before the last one, see xmysqlnd_table::insert
+	uint64_t items_affected{0};
+	uint64_t last_insert_id{0};
 
 	st_xmysqlnd_crud_table_op__insert(
 		const util::string& schema,
@@ -127,7 +144,7 @@ struct st_xmysqlnd_crud_table_op__insert
 		add_columns(columns_zv,num_of_columns);
 	}
 
-	~st_xmysqlnd_crud_table_op__insert() {}
+	~st_xmysqlnd_crud_table_op__insert() { close_row_iterator(); }
 
 	void add_columns(zval * columns_zv, const int num_of_columns);
 	void add_column(zval * column_zv);
@@ -137,9 +154,15 @@ struct st_xmysqlnd_crud_table_op__insert
 	void bind_columns();
 	void bind_column(const std::string& column_name);
 
-	void bind_rows();
-	void bind_row(zval* values_zv, ::Mysqlx::Crud::Insert_TypedRow* row);
-	void bind_row_field(zval* value_zv, ::Mysqlx::Crud::Insert_TypedRow* row);
+	void rewind_rows();
+	// replaces the rows in the message with the next ones, up to max_batch_size bytes (0 - no limit)
+	bool bind_next_rows(const std::size_t max_batch_size);
+	void bind_row(const util::zvalue& values, ::Mysqlx::Crud::Insert_TypedRow* row);
+	void bind_row_field(const util::zvalue& value, ::Mysqlx::Crud::Insert_TypedRow* row);
+
+private:
+	util::zvalue fetch_next_row();
+	void close_row_iterator();
 
 };
 
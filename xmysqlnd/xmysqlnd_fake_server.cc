@@ -0,0 +1,653 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#include "php_api.h"
+#include "mysqlnd_api.h"
+#include "xmysqlnd_fake_server.h"
+
+#ifdef MYSQL_XDEVAPI_DEV_MODE
+
+#include "proto_gen/mysqlx.pb.h"
+#include "proto_gen/mysqlx_connection.pb.h"
+#include "proto_gen/mysqlx_crud.pb.h"
+#include "proto_gen/mysqlx_datatypes.pb.h"
+#include "proto_gen/mysqlx_notice.pb.h"
+#include "proto_gen/mysqlx_prepare.pb.h"
+#include "proto_gen/mysqlx_resultset.pb.h"
+#include "proto_gen/mysqlx_session.pb.h"
+#include "proto_gen/mysqlx_sql.pb.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <thread>
+#ifndef PHP_WIN32
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace mysqlx {
+
+namespace drv {
+
+namespace {
+
+const std::size_t Frame_header_size{5}; /* payload length + message type */
+const std::size_t Auth_salt_size{20};
+
+void append_frame(std::string& frames, Mysqlx::ServerMessages::Type message_type, const google::protobuf::Message& message)
+{
+	const std::string payload{ message.SerializeAsString() };
+	char header[Frame_header_size];
+	int4store(header, static_cast<uint32_t>(payload.length() + 1));
+	header[Frame_header_size - 1] = static_cast<char>(message_type);
+	frames.append(header, sizeof(header));
+	frames += payload;
+}
+
+void append_ok(std::string& frames)
+{
+	append_frame(frames, Mysqlx::ServerMessages::OK, Mysqlx::Ok());
+}
+
+void append_error(std::string& frames, unsigned int code, const std::string& message)
+{
+	Mysqlx::Error error;
+	error.set_severity(Mysqlx::Error::ERROR);
+	error.set_code(code);
+	error.set_sql_state("HY000");
+	error.set_msg(message);
+	append_frame(frames, Mysqlx::ServerMessages::ERROR, error);
+}
+
+void append_state_changed(std::string& frames, Mysqlx::Notice::SessionStateChanged::Parameter param, uint64_t value)
+{
+	Mysqlx::Notice::SessionStateChanged state_changed;
+	state_changed.set_param(param);
+	Mysqlx::Datatypes::Scalar* scalar{ state_changed.add_value() };
+	scalar->set_type(Mysqlx::Datatypes::Scalar::V_UINT);
+	scalar->set_v_unsigned_int(value);
+
+	Mysqlx::Notice::Frame notice;
+	notice.set_type(Mysqlx::Notice::Frame::SESSION_STATE_CHANGED);
+	notice.set_scope(Mysqlx::Notice::Frame::LOCAL);
+	notice.set_payload(state_changed.SerializeAsString());
+	append_frame(frames, Mysqlx::ServerMessages::NOTICE, notice);
+}
+
+void add_string_capability(Mysqlx::Connection::Capabilities& capabilities, const char* name, const char* value)
+{
+	Mysqlx::Connection::Capability* capability{ capabilities.add_capabilities() };
+	capability->set_name(name);
+	Mysqlx::Datatypes::Any* any{ capability->mutable_value() };
+	any->set_type(Mysqlx::Datatypes::Any::SCALAR);
+	any->mutable_scalar()->set_type(Mysqlx::Datatypes::Scalar::V_STRING);
+	any->mutable_scalar()->mutable_v_string()->set_value(value);
+}
+
+void add_auth_mechanisms_capability(Mysqlx::Connection::Capabilities& capabilities)
+{
+	Mysqlx::Connection::Capability* capability{ capabilities.add_capabilities() };
+	capability->set_name("authentication.mechanisms");
+	Mysqlx::Datatypes::Any* any{ capability->mutable_value() };
+	any->set_type(Mysqlx::Datatypes::Any::ARRAY);
+	for (const char* mech_name : { "PLAIN", "MYSQL41", "SHA256_MEMORY" }) {
+		Mysqlx::Datatypes::Any* item{ any->mutable_array()->add_value() };
+		item->set_type(Mysqlx::Datatypes::Any::SCALAR);
+		item->mutable_scalar()->set_type(Mysqlx::Datatypes::Scalar::V_STRING);
+		item->mutable_scalar()->mutable_v_string()->set_value(mech_name);
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+void encode_varint(std::string& buffer, uint64_t value)
+{
+	do {
+		uint8_t byte{ static_cast<uint8_t>(value & 0x7F) };
+		value >>= 7;
+		if (value) byte |= 0x80;
+		buffer += static_cast<char>(byte);
+	} while (value);
+}
+
+std::string encode_cell(const Fake_value& value)
+{
+	std::string cell;
+	if (const int64_t* sint = std::get_if<int64_t>(&value)) {
+		encode_varint(cell, (static_cast<uint64_t>(*sint) << 1) ^ static_cast<uint64_t>(*sint >> 63));
+	} else if (const uint64_t* uint = std::get_if<uint64_t>(&value)) {
+		encode_varint(cell, *uint);
+	} else if (const double* real = std::get_if<double>(&value)) {
+		uint64_t bits;
+		std::memcpy(&bits, real, sizeof(bits));
+		char buffer[sizeof(bits)];
+		int8store(buffer, bits);
+		cell.assign(buffer, sizeof(buffer));
+	} else if (const std::string* bytes = std::get_if<std::string>(&value)) {
+		// BYTES cells come with a trailing '\0'
+		cell = *bytes;
+		cell += '\0';
+	}
+	return cell;
+}
+
+Mysqlx::Resultset::ColumnMetaData::FieldType to_field_type(Fake_column_type column_type)
+{
+	switch (column_type) {
+		case Fake_column_type::sint:
+			return Mysqlx::Resultset::ColumnMetaData::SINT;
+		case Fake_column_type::uint:
+			return Mysqlx::Resultset::ColumnMetaData::UINT;
+		case Fake_column_type::real:
+			return Mysqlx::Resultset::ColumnMetaData::DOUBLE;
+		default:
+			return Mysqlx::Resultset::ColumnMetaData::BYTES;
+	}
+}
+
+template<typename Crud_message>
+std::string get_crud_key(const char* op, const Crud_message& message)
+{
+	return std::string(op) + ' ' + message.collection().schema() + '.' + message.collection().name();
+}
+
+std::string get_prepared_key(const Mysqlx::Prepare::Prepare::OneOfMessage& stmt)
+{
+	switch (stmt.type()) {
+		case Mysqlx::Prepare::Prepare::OneOfMessage::FIND:
+			return get_crud_key("find", stmt.find());
+		case Mysqlx::Prepare::Prepare::OneOfMessage::INSERT:
+			return get_crud_key("insert", stmt.insert());
+		case Mysqlx::Prepare::Prepare::OneOfMessage::UPDATE:
+			return get_crud_key("update", stmt.update());
+		case Mysqlx::Prepare::Prepare::OneOfMessage::DELETE:
+			return get_crud_key("delete", stmt.delete_());
+		case Mysqlx::Prepare::Prepare::OneOfMessage::STMT:
+			return stmt.stmt_execute().stmt();
+		default:
+			return std::string();
+	}
+}
+
+#ifndef PHP_WIN32
+
+#ifdef MSG_NOSIGNAL
+const int Send_flags{ MSG_NOSIGNAL };
+#else
+const int Send_flags{ 0 };
+#endif
+
+bool read_exactly(int fd, char* buffer, std::size_t count)
+{
+	while (count) {
+		const ssize_t received{ ::recv(fd, buffer, count, 0) };
+		if (received <= 0) {
+			if ((received < 0) && (errno == EINTR)) continue;
+			return false;
+		}
+		buffer += received;
+		count -= static_cast<std::size_t>(received);
+	}
+	return true;
+}
+
+bool write_all(int fd, const std::string& data)
+{
+	const char* buffer{ data.data() };
+	std::size_t count{ data.length() };
+	while (count) {
+		const ssize_t sent{ ::send(fd, buffer, count, Send_flags) };
+		if (sent <= 0) {
+			if ((sent < 0) && (errno == EINTR)) continue;
+			return false;
+		}
+		buffer += sent;
+		count -= static_cast<std::size_t>(sent);
+	}
+	return true;
+}
+
+#endif // PHP_WIN32
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+
+struct Fake_server::Connection
+{
+	int fd;
+	uint64_t client_id;
+	std::string output;
+	uint64_t latency_us;
+	// prepared statement id => key of its response
+	std::map<uint32_t, std::string> prepared;
+};
+
+Fake_server::Fake_server(const Fake_server_config& config)
+	: config{ config }
+{
+	for (const auto& key_response : config.responses) {
+		responses.emplace(key_response.first, encode_response(key_response.second));
+	}
+
+	const std::string Version_query{ "SELECT VERSION()" };
+	if (responses.find(Version_query) == responses.end()) {
+		Fake_response version;
+		version.columns.push_back({ "VERSION()", Fake_column_type::bytes });
+		version.rows.push_back({ config.server_version });
+		responses.emplace(Version_query, encode_response(version));
+	}
+
+	empty_response = encode_response(Fake_response());
+}
+
+Fake_server::~Fake_server()
+{
+	stop();
+}
+
+Fake_server::Encoded_response Fake_server::encode_response(const Fake_response& response) const
+{
+	Encoded_response encoded{
+		std::string(),
+		response.rows_affected,
+		response.error_code,
+		response.error_message,
+		response.latency_us < 0 ? config.latency_us : static_cast<uint64_t>(response.latency_us)
+	};
+	if (response.columns.empty()) return encoded;
+
+	for (const Fake_column& column : response.columns) {
+		Mysqlx::Resultset::ColumnMetaData meta;
+		meta.set_type(to_field_type(column.type));
+		meta.set_name(column.name);
+		meta.set_original_name(column.name);
+		meta.set_catalog("def");
+		if (column.type == Fake_column_type::bytes || column.type == Fake_column_type::json) {
+			meta.set_collation(255);
+		}
+		if (column.type == Fake_column_type::json) {
+			meta.set_content_type(Mysqlx::Resultset::JSON);
+		}
+		append_frame(encoded.resultset, Mysqlx::ServerMessages::RESULTSET_COLUMN_META_DATA, meta);
+	}
+
+	for (const std::vector<Fake_value>& values : response.rows) {
+		Mysqlx::Resultset::Row row;
+		for (std::size_t i{0}; i < response.columns.size(); ++i) {
+			row.add_field(i < values.size() ? encode_cell(values[i]) : std::string());
+		}
+		append_frame(encoded.resultset, Mysqlx::ServerMessages::RESULTSET_ROW, row);
+	}
+	append_frame(encoded.resultset, Mysqlx::ServerMessages::RESULTSET_FETCH_DONE, Mysqlx::Resultset::FetchDone());
+	return encoded;
+}
+
+const Fake_server::Encoded_response& Fake_server::find_response(const std::string& key) const
+{
+	auto it{ responses.find(key) };
+	return it == responses.end() ? empty_response : it->second;
+}
+
+#ifndef PHP_WIN32
+
+bool Fake_server::start()
+{
+	if (listen_fd != -1) return true;
+
+	int fd{-1};
+	if (!config.socket.empty()) {
+		sockaddr_un address{};
+		address.sun_family = AF_UNIX;
+		if (config.socket.length() >= sizeof(address.sun_path)) {
+			error = "socket path too long";
+			return false;
+		}
+		std::strcpy(address.sun_path, config.socket.c_str());
+		::unlink(config.socket.c_str());
+		fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+		if ((fd == -1) || (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)) {
+			error = std::string("cannot bind the socket: ") + std::strerror(errno);
+			if (fd != -1) ::close(fd);
+			return false;
+		}
+	} else {
+		addrinfo hints{};
+		hints.ai_family = AF_UNSPEC;
+		hints.ai_socktype = SOCK_STREAM;
+		hints.ai_flags = AI_PASSIVE;
+		addrinfo* addresses{nullptr};
+		const std::string service{ std::to_string(config.port) };
+		const int ret{ ::getaddrinfo(config.host.c_str(), service.c_str(), &hints, &addresses) };
+		if (ret != 0) {
+			error = std::string("cannot resolve the host: ") + ::gai_strerror(ret);
+			return false;
+		}
+		for (addrinfo* address{ addresses }; address; address = address->ai_next) {
+			fd = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+			if (fd == -1) continue;
+			const int reuse_address{1};
+			::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse_address, sizeof(reuse_address));
+			if (::bind(fd, address->ai_addr, address->ai_addrlen) == 0) break;
+			::close(fd);
+			fd = -1;
+		}
+		::freeaddrinfo(addresses);
+		if (fd == -1) {
+			error = std::string("cannot bind the port: ") + std::strerror(errno);
+			return false;
+		}
+
+		sockaddr_storage bound_address{};
+		socklen_t bound_address_len{ sizeof(bound_address) };
+		::getsockname(fd, reinterpret_cast<sockaddr*>(&bound_address), &bound_address_len);
+		port = ntohs(bound_address.ss_family == AF_INET6
+			? reinterpret_cast<sockaddr_in6*>(&bound_address)->sin6_port
+			: reinterpret_cast<sockaddr_in*>(&bound_address)->sin_port);
+	}
+
+	if (::listen(fd, SOMAXCONN) == -1) {
+		error = std::string("cannot listen: ") + std::strerror(errno);
+		::close(fd);
+		return false;
+	}
+
+	listen_fd = fd;
+	stopping = false;
+	running_threads = 1;
+	std::thread(&Fake_server::accept_connections, this).detach();
+	return true;
+}
+
+void Fake_server::stop()
+{
+	if (listen_fd == -1) return;
+
+	std::unique_lock<std::mutex> lck(mtx);
+	stopping = true;
+	// wakes up accept() and recv() in the server threads
+	::shutdown(listen_fd, SHUT_RDWR);
+	for (int fd : client_fds) {
+		::shutdown(fd, SHUT_RDWR);
+	}
+	threads_done.wait(lck, [this] { return running_threads == 0; });
+	lck.unlock();
+
+	::close(listen_fd);
+	listen_fd = -1;
+	if (!config.socket.empty()) {
+		::unlink(config.socket.c_str());
+	}
+}
+
+void Fake_server::accept_connections()
+{
+	for (;;) {
+		const int fd{ ::accept(listen_fd, nullptr, nullptr) };
+		std::lock_guard<std::mutex> lck(mtx);
+		if (stopping) {
+			if (fd != -1) ::close(fd);
+			break;
+		}
+		if (fd == -1) {
+			if ((errno == EINTR) || (errno == ECONNABORTED)) continue;
+			break;
+		}
+		if (config.socket.empty()) {
+			// latency is what the server is configured with, not what Nagle adds to it
+			int no_delay{1};
+			::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+		}
+		client_fds.insert(fd);
+		++running_threads;
+		std::thread(&Fake_server::serve, this, fd).detach();
+	}
+
+	std::lock_guard<std::mutex> lck(mtx);
+	--running_threads;
+	threads_done.notify_all();
+}
+
+void Fake_server::serve(int fd)
+{
+	Connection connection{ fd, 0, std::string(), 0, {} };
+	{
+		std::lock_guard<std::mutex> lck(mtx);
+		connection.client_id = next_client_id++;
+	}
+
+	char header[Frame_header_size];
+	std::string payload;
+	while (read_exactly(fd, header, sizeof(header))) {
+		const uint32_t frame_size{ uint4korr(header) };
+		if (frame_size == 0) break;
+		payload.resize(frame_size - 1);
+		if (!read_exactly(fd, &payload[0], payload.size())) break;
+
+		connection.output.clear();
+		const bool keep_open{ dispatch(connection, static_cast<uint8_t>(header[Frame_header_size - 1]), payload) };
+		if (!write_all(fd, connection.output) || !keep_open) break;
+	}
+
+	std::lock_guard<std::mutex> lck(mtx);
+	client_fds.erase(fd);
+	::close(fd);
+	--running_threads;
+	threads_done.notify_all();
+}
+
+#else
+
+bool Fake_server::start()
+{
+	error = "the fake server is not supported on this platform";
+	return false;
+}
+
+void Fake_server::stop()
+{
+}
+
+void Fake_server::accept_connections()
+{
+}
+
+void Fake_server::serve(int /*fd*/)
+{
+}
+
+#endif // PHP_WIN32
+
+/*
+	handles a single client message, the response is collected in connection.output,
+	returns false if the connection is to be closed
+*/
+bool Fake_server::dispatch(Connection& connection, uint8_t message_type, const std::string& payload)
+{
+	connection.latency_us = config.latency_us;
+	std::string& output{ connection.output };
+	switch (message_type) {
+		case Mysqlx::ClientMessages::CON_CAPABILITIES_GET: {
+			Mysqlx::Connection::Capabilities capabilities;
+			add_auth_mechanisms_capability(capabilities);
+			add_string_capability(capabilities, "doc.formats", "text");
+			add_string_capability(capabilities, "node_type", config.node_type.c_str());
+			append_frame(output, Mysqlx::ServerMessages::CONN_CAPABILITIES, capabilities);
+			break;
+		}
+
+		case Mysqlx::ClientMessages::CON_CAPABILITIES_SET: {
+			Mysqlx::Connection::CapabilitiesSet capabilities_set;
+			capabilities_set.ParseFromString(payload);
+			bool tls_requested{false};
+			for (const auto& capability : capabilities_set.capabilities().capabilities()) {
+				tls_requested |= (capability.name() == "tls");
+			}
+			if (tls_requested) {
+				append_error(output, 5001, "Capability prepare failed for 'tls'");
+			} else {
+				append_ok(output);
+			}
+			break;
+		}
+
+		case Mysqlx::ClientMessages::SESS_AUTHENTICATE_START: {
+			Mysqlx::Session::AuthenticateStart auth_start;
+			auth_start.ParseFromString(payload);
+			if (auth_start.mech_name() == "PLAIN") {
+				append_state_changed(output, Mysqlx::Notice::SessionStateChanged::CLIENT_ID_ASSIGNED, connection.client_id);
+				append_frame(output, Mysqlx::ServerMessages::SESS_AUTHENTICATE_OK, Mysqlx::Session::AuthenticateOk());
+			} else if ((auth_start.mech_name() == "MYSQL41") || (auth_start.mech_name() == "SHA256_MEMORY")) {
+				std::random_device random_device;
+				std::uniform_int_distribution<int> printable('!', '~');
+				std::string salt(Auth_salt_size, '\0');
+				for (char& c : salt) {
+					c = static_cast<char>(printable(random_device));
+				}
+				Mysqlx::Session::AuthenticateContinue auth_continue;
+				auth_continue.set_auth_data(salt);
+				append_frame(output, Mysqlx::ServerMessages::SESS_AUTHENTICATE_CONTINUE, auth_continue);
+			} else {
+				append_error(output, 1251, "Invalid authentication method " + auth_start.mech_name());
+			}
+			break;
+		}
+
+		case Mysqlx::ClientMessages::SESS_AUTHENTICATE_CONTINUE:
+			// any credentials are fine
+			append_state_changed(output, Mysqlx::Notice::SessionStateChanged::CLIENT_ID_ASSIGNED, connection.client_id);
+			append_frame(output, Mysqlx::ServerMessages::SESS_AUTHENTICATE_OK, Mysqlx::Session::AuthenticateOk());
+			break;
+
+		case Mysqlx::ClientMessages::SESS_RESET:
+			connection.prepared.clear();
+			append_ok(output);
+			break;
+
+		case Mysqlx::ClientMessages::SESS_CLOSE:
+		case Mysqlx::ClientMessages::EXPECT_OPEN:
+		case Mysqlx::ClientMessages::EXPECT_CLOSE:
+			append_ok(output);
+			break;
+
+		case Mysqlx::ClientMessages::CON_CLOSE:
+			append_ok(output);
+			return false;
+
+		case Mysqlx::ClientMessages::SQL_STMT_EXECUTE: {
+			Mysqlx::Sql::StmtExecute stmt_execute;
+			stmt_execute.ParseFromString(payload);
+			respond(connection, stmt_execute.stmt());
+			break;
+		}
+
+		case Mysqlx::ClientMessages::CRUD_FIND: {
+			Mysqlx::Crud::Find find;
+			find.ParseFromString(payload);
+			respond(connection, get_crud_key("find", find));
+			break;
+		}
+
+		case Mysqlx::ClientMessages::CRUD_INSERT: {
+			Mysqlx::Crud::Insert insert;
+			insert.ParseFromString(payload);
+			respond(connection, get_crud_key("insert", insert));
+			break;
+		}
+
+		case Mysqlx::ClientMessages::CRUD_UPDATE: {
+			Mysqlx::Crud::Update update;
+			update.ParseFromString(payload);
+			respond(connection, get_crud_key("update", update));
+			break;
+		}
+
+		case Mysqlx::ClientMessages::CRUD_DELETE: {
+			Mysqlx::Crud::Delete del;
+			del.ParseFromString(payload);
+			respond(connection, get_crud_key("delete", del));
+			break;
+		}
+
+		case Mysqlx::ClientMessages::PREPARE_PREPARE: {
+			Mysqlx::Prepare::Prepare prepare;
+			prepare.ParseFromString(payload);
+			connection.prepared[prepare.stmt_id()] = get_prepared_key(prepare.stmt());
+			append_ok(output);
+			break;
+		}
+
+		case Mysqlx::ClientMessages::PREPARE_EXECUTE: {
+			Mysqlx::Prepare::Execute execute;
+			execute.ParseFromString(payload);
+			auto it{ connection.prepared.find(execute.stmt_id()) };
+			if (it == connection.prepared.end()) {
+				append_error(output, 5110, "Statement with ID=" + std::to_string(execute.stmt_id()) + " was not prepared");
+			} else {
+				respond(connection, it->second);
+			}
+			break;
+		}
+
+		case Mysqlx::ClientMessages::PREPARE_DEALLOCATE: {
+			Mysqlx::Prepare::Deallocate deallocate;
+			deallocate.ParseFromString(payload);
+			connection.prepared.erase(deallocate.stmt_id());
+			append_ok(output);
+			break;
+		}
+
+		default:
+			append_error(output, 1047, "Unexpected message received");
+			break;
+	}
+
+	if (connection.latency_us) {
+		std::this_thread::sleep_for(std::chrono::microseconds(connection.latency_us));
+	}
+	return true;
+}
+
+void Fake_server::respond(Connection& connection, const std::string& key)
+{
+	const Encoded_response& response{ find_response(key) };
+	connection.latency_us = response.latency_us;
+
+	std::string& output{ connection.output };
+	if (response.error_code) {
+		append_error(output, response.error_code, response.error_message);
+		return;
+	}
+
+	output += response.resultset;
+	if (response.resultset.empty()) {
+		append_state_changed(output, Mysqlx::Notice::SessionStateChanged::ROWS_AFFECTED, response.rows_affected);
+	}
+	append_frame(output, Mysqlx::ServerMessages::SQL_STMT_EXECUTE_OK, Mysqlx::Sql::StmtExecuteOk());
+}
+
+} // namespace drv
+
+} // namespace mysqlx
+
+#endif // MYSQL_XDEVAPI_DEV_MODE
@@ -0,0 +1,155 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#ifndef XMYSQLND_FAKE_SERVER_H
+#define XMYSQLND_FAKE_SERVER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace mysqlx {
+
+namespace drv {
+
+#ifdef MYSQL_XDEVAPI_DEV_MODE
+
+enum class Fake_column_type
+{
+	sint,
+	uint,
+	real,
+	bytes,
+	json
+};
+
+struct Fake_column
+{
+	std::string name;
+	Fake_column_type type;
+};
+
+// null, or a value of the type of its column (int64_t for sint, std::string for bytes and json)
+using Fake_value = std::variant<std::monostate, int64_t, uint64_t, double, std::string>;
+
+/*
+	Scripted response to a statement - a result set, or an error if error_code is
+	set. The latency overrides the server-wide one unless it is negative.
+*/
+struct Fake_response
+{
+	std::vector<Fake_column> columns;
+	std::vector<std::vector<Fake_value>> rows;
+	uint64_t rows_affected{0};
+	unsigned int error_code{0};
+	std::string error_message;
+	int64_t latency_us{-1};
+};
+
+struct Fake_server_config
+{
+	std::string host{"127.0.0.1"};
+	// 0 means any free port, see Fake_server::get_port
+	unsigned int port{0};
+	// if set, the server listens on this unix socket instead of tcp
+	std::string socket;
+	// delay before every response
+	uint64_t latency_us{0};
+	std::string server_version{"8.0.99-fake"};
+	// returned in the capabilities, changing it makes the server look like another one
+	std::string node_type{"mysql"};
+	/*
+		keyed by the SQL text, or by "<op> <schema>.<name>" for CRUD statements, where
+		op is one of find, insert, update, delete
+	*/
+	std::map<std::string, Fake_response> responses;
+};
+
+/*
+	Small X Protocol responder for load testing the client without MySQL. It
+	serves each connection in a thread of its own, so that latency doesn't
+	serialize the clients. It accepts any credentials (PLAIN, MYSQL41 or
+	SHA256_MEMORY), supports neither TLS nor compression, and answers statements
+	with the scripted responses. Statements without one get an empty result,
+	except for SELECT VERSION(). The responses are encoded up front, and the
+	server threads never touch the PHP or mysqlnd API.
+*/
+class Fake_server
+{
+public:
+	explicit Fake_server(const Fake_server_config& config);
+	Fake_server(const Fake_server&) = delete;
+	Fake_server& operator=(const Fake_server&) = delete;
+	~Fake_server();
+
+	// binds the listening socket and starts serving, on failure see get_error()
+	bool start();
+	// closes all the connections and waits for their threads
+	void stop();
+
+	unsigned int get_port() const { return port; }
+	const std::string& get_error() const { return error; }
+
+private:
+	struct Encoded_response
+	{
+		// column metadata, rows and fetch done, laid out as on the wire
+		std::string resultset;
+		uint64_t rows_affected;
+		unsigned int error_code;
+		std::string error_message;
+		uint64_t latency_us;
+	};
+
+	struct Connection;
+
+	void accept_connections();
+	void serve(int fd);
+	bool dispatch(Connection& connection, uint8_t message_type, const std::string& payload);
+	void respond(Connection& connection, const std::string& key);
+
+	const Encoded_response& find_response(const std::string& key) const;
+	Encoded_response encode_response(const Fake_response& response) const;
+
+	const Fake_server_config config;
+	std::map<std::string, Encoded_response> responses;
+	Encoded_response empty_response;
+
+	int listen_fd{-1};
+	unsigned int port{0};
+	std::string error;
+
+	std::mutex mtx;
+	std::condition_variable threads_done;
+	std::set<int> client_fds;
+	std::size_t running_threads{0};
+	uint64_t next_client_id{1};
+	bool stopping{false};
+};
+
+#endif // MYSQL_XDEVAPI_DEV_MODE
+
+} // namespace drv
+
+} // namespace mysqlx
+
+#endif // XMYSQLND_FAKE_SERVER_H
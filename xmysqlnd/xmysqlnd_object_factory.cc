@@ -185,16 +185,18 @@ XMYSQLND_METHOD(xmysqlnd_object_factory, get_stmt_result)(const MYSQLND_CLASS_ME
 
 static XMYSQLND_ROWSET_BUFFERED *
 XMYSQLND_METHOD(xmysqlnd_object_factory, get_rowset_buffered)(const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory)* const factory,
+															  util::Arena* const arena,
 															  xmysqlnd_stmt* stmt,
 															  const zend_bool persistent,
 															  MYSQLND_STATS* stats,
 															  MYSQLND_ERROR_INFO* error_info)
 {
-	XMYSQLND_ROWSET_BUFFERED* object = new XMYSQLND_ROWSET_BUFFERED;
+	XMYSQLND_ROWSET_BUFFERED* object = arena ? ::new (*arena) XMYSQLND_ROWSET_BUFFERED() : new XMYSQLND_ROWSET_BUFFERED;
 
 	DBG_ENTER("xmysqlnd_object_factory::get_rowset_buffered");
-	DBG_INF_FMT("persistent=%u", persistent);
+	DBG_INF_FMT("persistent=%u arena=%p", persistent, arena);
 	if (object) {
+		object->arena = arena;
 		object->m = *xmysqlnd_rowset_buffered_get_methods();
 
 		if (PASS != object->m.init(object, factory, stmt, stats, error_info)) {
@@ -207,17 +209,19 @@ XMYSQLND_METHOD(xmysqlnd_object_factory, get_rowset_buffered)(const MYSQLND_CLAS
 
 static XMYSQLND_ROWSET_FWD *
 XMYSQLND_METHOD(xmysqlnd_object_factory, get_rowset_fwd)(const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory)* const factory,
+														 util::Arena* const arena,
 														 const size_t prefetch_rows,
 														 xmysqlnd_stmt* stmt,
 														 const zend_bool persistent,
 														 MYSQLND_STATS* stats,
 														 MYSQLND_ERROR_INFO* error_info)
 {
-	XMYSQLND_ROWSET_FWD* object = new XMYSQLND_ROWSET_FWD;
+	XMYSQLND_ROWSET_FWD* object = arena ? ::new (*arena) XMYSQLND_ROWSET_FWD() : new XMYSQLND_ROWSET_FWD;
 
 	DBG_ENTER("xmysqlnd_object_factory::get_rowset_fwd");
-	DBG_INF_FMT("persistent=%u", persistent);
+	DBG_INF_FMT("persistent=%u arena=%p", persistent, arena);
 	if (object) {
+		object->arena = arena;
 		object->m = *xmysqlnd_rowset_fwd_get_methods();
 
 		if (PASS != object->m.init(object, factory, prefetch_rows, stmt, stats, error_info)) {
@@ -230,6 +234,7 @@ XMYSQLND_METHOD(xmysqlnd_object_factory, get_rowset_fwd)(const MYSQLND_CLASS_MET
 
 static XMYSQLND_ROWSET *
 XMYSQLND_METHOD(xmysqlnd_object_factory, get_rowset)(const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory)* const factory,
+													 util::Arena* const arena,
 													 unsigned int type,
 													 const size_t prefetch_rows,
 													 xmysqlnd_stmt* stmt,
@@ -237,11 +242,13 @@ XMYSQLND_METHOD(xmysqlnd_object_factory, get_rowset)(const MYSQLND_CLASS_METHODS
 													 MYSQLND_STATS* stats,
 													 MYSQLND_ERROR_INFO* error_info)
 {
-	XMYSQLND_ROWSET* object = new XMYSQLND_ROWSET;
+	/* with an arena the rowset and the set behind it are released together with the result */
+	XMYSQLND_ROWSET* object = arena ? ::new (*arena) XMYSQLND_ROWSET() : new XMYSQLND_ROWSET;
 
 	DBG_ENTER("xmysqlnd_object_factory::get_rowset");
-	DBG_INF_FMT("persistent=%u", persistent);
+	DBG_INF_FMT("persistent=%u arena=%p", persistent, arena);
 	if (object) {
+		object->arena = arena;
 		object->m = *xmysqlnd_rowset_get_methods();
 
 		if (PASS != object->m.init(object, factory, static_cast<xmysqlnd_rowset_type>(type), prefetch_rows, stmt, stats, error_info)) {
@@ -276,15 +283,18 @@ XMYSQLND_METHOD(xmysqlnd_object_factory, get_stmt_result_meta)(const MYSQLND_CLA
 
 static XMYSQLND_RESULT_FIELD_META *
 XMYSQLND_METHOD(xmysqlnd_object_factory, get_result_field_meta)(const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory)* const factory,
+																XMYSQLND_STMT_RESULT_META* const meta,
 																const zend_bool persistent,
 																MYSQLND_STATS* stats,
 																MYSQLND_ERROR_INFO* error_info)
 {
-	XMYSQLND_RESULT_FIELD_META* object = new XMYSQLND_RESULT_FIELD_META;
+	/* lives and dies with the meta, see st_xmysqlnd_stmt_result_meta::arena */
+	XMYSQLND_RESULT_FIELD_META* object = new (meta->arena) XMYSQLND_RESULT_FIELD_META();
 
 	DBG_ENTER("xmysqlnd_object_factory::get_result_field_meta");
 	DBG_INF_FMT("persistent=%u", persistent);
 	if (object) {
+		object->arena = &meta->arena;
 		object->persistent = persistent;
 		object->m = xmysqlnd_result_field_meta_get_methods();
 
@@ -339,15 +349,17 @@ XMYSQLND_METHOD(xmysqlnd_object_factory, get_warnings_list)(const MYSQLND_CLASS_
 
 static XMYSQLND_STMT_EXECUTION_STATE *
 XMYSQLND_METHOD(xmysqlnd_object_factory, get_stmt_execution_state)(const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory)* const factory,
+																   util::Arena* const arena,
 																   const zend_bool persistent,
 																   MYSQLND_STATS* stats,
 																   MYSQLND_ERROR_INFO* error_info)
 {
-	XMYSQLND_STMT_EXECUTION_STATE* object = new XMYSQLND_STMT_EXECUTION_STATE;
+	XMYSQLND_STMT_EXECUTION_STATE* object = arena ? ::new (*arena) XMYSQLND_STMT_EXECUTION_STATE() : new XMYSQLND_STMT_EXECUTION_STATE;
 
 	DBG_ENTER("xmysqlnd_object_factory::get_stmt_execution_state");
-	DBG_INF_FMT("persistent=%u", persistent);
+	DBG_INF_FMT("persistent=%u arena=%p", persistent, arena);
 	if (object) {
+		object->arena = arena;
 		object->persistent = persistent;
 		object->m = xmysqlnd_stmt_execution_state_get_methods();
 
@@ -24,6 +24,12 @@
 
 namespace mysqlx {
 
+namespace util {
+
+class Arena;
+
+} // namespace util
+
 namespace drv {
 
 class xmysqlnd_session;
@@ -38,6 +44,7 @@ struct st_xmysqlnd_stmt_rowset;
 struct st_xmysqlnd_rowset_buffered;
 struct st_xmysqlnd_rowset_fwd;
 struct st_xmysqlnd_result_field_meta;
+struct st_xmysqlnd_stmt_result_meta;
 struct st_xmysqlnd_protocol_frame_codec;
 class xmysqlnd_warning_list;
 struct st_xmysqlnd_stmt_execution_state;
@@ -96,6 +103,7 @@ typedef struct st_xmysqlnd_stmt_result * (*func_xmysqlnd_object_factory__get_stm
 
 typedef struct st_xmysqlnd_rowset_buffered * (*func_xmysqlnd_object_factory__get_rowset_buffered)(
 			const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const factory,
+			util::Arena * const arena,
 			class xmysqlnd_stmt * stmt,
 			const zend_bool persistent,
 			MYSQLND_STATS * stats,
@@ -103,6 +111,7 @@ typedef struct st_xmysqlnd_rowset_buffered * (*func_xmysqlnd_object_factory__get
 
 typedef struct st_xmysqlnd_rowset_fwd *	(*func_xmysqlnd_object_factory__get_rowset_fwd)(
 			const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const factory,
+			util::Arena * const arena,
 			const size_t prefetch_rows,
 			class xmysqlnd_stmt * stmt,
 			const zend_bool persistent,
@@ -111,6 +120,7 @@ typedef struct st_xmysqlnd_rowset_fwd *	(*func_xmysqlnd_object_factory__get_rows
 
 typedef struct st_xmysqlnd_rowset * (*func_xmysqlnd_object_factory__get_rowset)(
 			const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const factory,
+			util::Arena * const arena,
 			unsigned int type,
 			const size_t prefetch_rows,
 			class xmysqlnd_stmt * stmt,
@@ -126,6 +136,7 @@ typedef struct st_xmysqlnd_stmt_result_meta * (*func_xmysqlnd_object_factory__ge
 
 typedef struct st_xmysqlnd_result_field_meta * (*func_xmysqlnd_object_factory__get_result_field_meta)(
 			const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const factory,
+			struct st_xmysqlnd_stmt_result_meta * const meta,
 			const zend_bool persistent,
 			MYSQLND_STATS * stats,
 			MYSQLND_ERROR_INFO * error_info);
@@ -144,6 +155,7 @@ typedef xmysqlnd_warning_list * (*func_xmysqlnd_object_factory__get_warnings_lis
 
 typedef struct st_xmysqlnd_stmt_execution_state *(*func_xmysqlnd_object_factory__get_stmt_execution_state)(
 			const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const factory,
+			util::Arena * const arena,
 			const zend_bool persistent,
 			MYSQLND_STATS * stats,
 			MYSQLND_ERROR_INFO * error_info);
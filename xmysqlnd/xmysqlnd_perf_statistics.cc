@@ -0,0 +1,199 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#include "php_api.h"
+#include "mysqlnd_api.h"
+#include "php_mysqlx.h"
+#include "xmysqlnd_perf_statistics.h"
+#include <algorithm>
+#include <cstring>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace mysqlx {
+
+namespace drv {
+
+const char* const xmysqlnd_perf_op_names[XMYSQLND_PERF_OP_LAST] =
+{
+	"connect",
+	"auth",
+	"find",
+	"insert",
+	"update",
+	"delete",
+	"sql",
+	"prepare",
+	"execute",
+	"reset",
+	"pool_wait",
+};
+
+const char* const xmysqlnd_perf_counter_names[XMYSQLND_PERF_LAST] =
+{
+	"rows_decoded",
+	"rows_decode_sampled",
+	"rows_decode_sampled_ns",
+	"compressed_messages",
+	"compress_bytes_in",
+	"compress_bytes_out",
+	"compress_ns",
+	"decompressed_messages",
+	"decompress_bytes_in",
+	"decompress_bytes_out",
+	"decompress_ns",
+	"ps_cache_hits",
+	"ps_cache_misses",
+};
+
+namespace {
+
+unsigned int most_significant_bit(uint64_t value)
+{
+	assert(value != 0);
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanReverse64(&index, value);
+	return static_cast<unsigned int>(index);
+#else
+	return 63 - static_cast<unsigned int>(__builtin_clzll(value));
+#endif
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+
+void Latency_histogram::record(uint64_t value_us)
+{
+	++buckets[bucket_index(value_us)];
+	if (count == 0 || value_us < min) min = value_us;
+	if (max < value_us) max = value_us;
+	++count;
+	sum += value_us;
+}
+
+void Latency_histogram::reset()
+{
+	std::memset(buckets, 0, sizeof(buckets));
+	count = 0;
+	sum = 0;
+	min = 0;
+	max = 0;
+}
+
+uint64_t Latency_histogram::get_percentile(double percentile) const
+{
+	if (count == 0) return 0;
+
+	const double rank{ percentile * static_cast<double>(count) / 100.0 };
+	const uint64_t wanted{ std::max<uint64_t>(1, static_cast<uint64_t>(rank + 0.5)) };
+	uint64_t seen{0};
+	for (unsigned int i{0}; i < Bucket_count; ++i) {
+		seen += buckets[i];
+		if (seen >= wanted) {
+			return std::min(bucket_upper_bound(i), max);
+		}
+	}
+	return max;
+}
+
+/*
+	values below Sub_bucket_count get a bucket of their own, above that every magnitude
+	(power of two) is split into Sub_bucket_count buckets by the bits just below its msb
+*/
+unsigned int Latency_histogram::bucket_index(uint64_t value)
+{
+	if (value < Sub_bucket_count) return static_cast<unsigned int>(value);
+
+	const unsigned int magnitude{ std::min(most_significant_bit(value), Max_magnitude) };
+	if (magnitude == Max_magnitude && (value >> (Max_magnitude + 1))) return Bucket_count - 1;
+
+	const unsigned int shift{ magnitude - Sub_bucket_bits };
+	const unsigned int sub_bucket{ static_cast<unsigned int>(value >> shift) & (Sub_bucket_count - 1) };
+	return ((shift + 1) << Sub_bucket_bits) + sub_bucket;
+}
+
+uint64_t Latency_histogram::bucket_upper_bound(unsigned int index)
+{
+	if (index < Sub_bucket_count) return index;
+
+	const unsigned int shift{ (index >> Sub_bucket_bits) - 1 };
+	const uint64_t lower_bound{ uint64_t{Sub_bucket_count | (index & (Sub_bucket_count - 1))} << shift };
+	return lower_bound + (uint64_t{1} << shift) - 1;
+}
+
+// ----------------------------------------------------------------------------
+
+void Perf_statistics::reset()
+{
+	for (Latency_histogram& histogram : latency) {
+		histogram.reset();
+	}
+	std::memset(counters, 0, sizeof(counters));
+}
+
+// ----------------------------------------------------------------------------
+
+void Perf_pending_op::start(enum_xmysqlnd_perf_op pending_op)
+{
+	pending = (xmysqlnd_get_perf_statistics() != nullptr);
+	if (!pending) return;
+	op = pending_op;
+	started = Perf_clock::now();
+}
+
+void Perf_pending_op::finish()
+{
+	if (!pending) return;
+	pending = false;
+	xmysqlnd_perf_record_latency(op, started);
+}
+
+// ----------------------------------------------------------------------------
+
+Perf_statistics* xmysqlnd_get_perf_statistics()
+{
+	return MYSQL_XDEVAPI_G(collect_perf_statistics) ? &MYSQL_XDEVAPI_G(perf_statistics) : nullptr;
+}
+
+void xmysqlnd_perf_record_latency(enum_xmysqlnd_perf_op op, const Perf_clock::time_point& started)
+{
+	Perf_statistics* perf_stats{ xmysqlnd_get_perf_statistics() };
+	if (!perf_stats) return;
+	const auto elapsed{ Perf_clock::now() - started };
+	perf_stats->latency[op].record(
+		static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+}
+
+void xmysqlnd_perf_inc(enum_xmysqlnd_perf_counter counter, uint64_t value)
+{
+	Perf_statistics* perf_stats{ xmysqlnd_get_perf_statistics() };
+	if (!perf_stats) return;
+	perf_stats->counters[counter] += value;
+}
+
+uint64_t xmysqlnd_perf_elapsed_ns(const Perf_clock::time_point& started)
+{
+	const auto elapsed{ Perf_clock::now() - started };
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+} // namespace drv
+
+} // namespace mysqlx
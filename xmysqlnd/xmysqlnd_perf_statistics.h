@@ -0,0 +1,140 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#ifndef XMYSQLND_PERF_STATISTICS_H
+#define XMYSQLND_PERF_STATISTICS_H
+
+#include <chrono>
+#include <cstdint>
+
+namespace mysqlx {
+
+namespace drv {
+
+typedef enum xmysqlnd_perf_op
+{
+	XMYSQLND_PERF_OP_CONNECT,
+	XMYSQLND_PERF_OP_AUTH,
+	XMYSQLND_PERF_OP_FIND,
+	XMYSQLND_PERF_OP_INSERT,
+	XMYSQLND_PERF_OP_UPDATE,
+	XMYSQLND_PERF_OP_DELETE,
+	XMYSQLND_PERF_OP_SQL,
+	XMYSQLND_PERF_OP_PREPARE,
+	XMYSQLND_PERF_OP_EXECUTE,
+	XMYSQLND_PERF_OP_RESET,
+	XMYSQLND_PERF_OP_POOL_WAIT,
+	XMYSQLND_PERF_OP_LAST /* Should be always the last */
+} enum_xmysqlnd_perf_op;
+
+typedef enum xmysqlnd_perf_counter
+{
+	XMYSQLND_PERF_ROWS_DECODED,
+	XMYSQLND_PERF_ROWS_DECODE_SAMPLED,
+	XMYSQLND_PERF_ROWS_DECODE_SAMPLED_NS,
+	XMYSQLND_PERF_COMPRESSED_MESSAGES,
+	XMYSQLND_PERF_COMPRESS_BYTES_IN,
+	XMYSQLND_PERF_COMPRESS_BYTES_OUT,
+	XMYSQLND_PERF_COMPRESS_NS,
+	XMYSQLND_PERF_DECOMPRESSED_MESSAGES,
+	XMYSQLND_PERF_DECOMPRESS_BYTES_IN,
+	XMYSQLND_PERF_DECOMPRESS_BYTES_OUT,
+	XMYSQLND_PERF_DECOMPRESS_NS,
+	XMYSQLND_PERF_PS_CACHE_HITS,
+	XMYSQLND_PERF_PS_CACHE_MISSES,
+	XMYSQLND_PERF_LAST /* Should be always the last */
+} enum_xmysqlnd_perf_counter;
+
+extern const char* const xmysqlnd_perf_op_names[XMYSQLND_PERF_OP_LAST];
+extern const char* const xmysqlnd_perf_counter_names[XMYSQLND_PERF_LAST];
+
+using Perf_clock = std::chrono::steady_clock;
+
+/*
+	HDR-like log-linear histogram of latencies in microseconds - every power of two
+	is split into 2^Sub_bucket_bits equal buckets, so the relative error of a reported
+	percentile stays below 12.5% from 1us up to Max_magnitude (about 19 hours),
+	while recording is just a bit scan and an increment.
+	It has no constructor as it lives in the module globals - call reset() before use.
+*/
+class Latency_histogram
+{
+public:
+	static constexpr unsigned int Sub_bucket_bits{3};
+	static constexpr unsigned int Sub_bucket_count{1u << Sub_bucket_bits};
+	static constexpr unsigned int Max_magnitude{35};
+	static constexpr unsigned int Bucket_count{(Max_magnitude - Sub_bucket_bits + 2) << Sub_bucket_bits};
+
+	void record(uint64_t value_us);
+	void reset();
+
+	uint64_t get_count() const { return count; }
+	uint64_t get_sum() const { return sum; }
+	uint64_t get_min() const { return count ? min : 0; }
+	uint64_t get_max() const { return max; }
+	uint64_t get_percentile(double percentile) const;
+
+private:
+	static unsigned int bucket_index(uint64_t value);
+	static uint64_t bucket_upper_bound(unsigned int index);
+
+	uint64_t buckets[Bucket_count];
+	uint64_t count;
+	uint64_t sum;
+	uint64_t min;
+	uint64_t max;
+};
+
+/*
+	Per-thread (ZTS) or per-process performance statistics, kept in the module
+	globals, so updating them doesn't need any locks nor atomics.
+*/
+struct Perf_statistics
+{
+	void reset();
+
+	Latency_histogram latency[XMYSQLND_PERF_OP_LAST];
+	uint64_t counters[XMYSQLND_PERF_LAST];
+};
+
+/*
+	Request awaiting its response on a connection - it is sent and read by different
+	message objects, so it is tracked by the protocol frame codec they share.
+*/
+struct Perf_pending_op
+{
+	void start(enum_xmysqlnd_perf_op pending_op);
+	void finish();
+
+	enum_xmysqlnd_perf_op op{XMYSQLND_PERF_OP_LAST};
+	Perf_clock::time_point started;
+	bool pending{false};
+};
+
+// returns nullptr if xmysqlnd.collect_perf_statistics is disabled
+Perf_statistics* xmysqlnd_get_perf_statistics();
+
+void xmysqlnd_perf_record_latency(enum_xmysqlnd_perf_op op, const Perf_clock::time_point& started);
+void xmysqlnd_perf_inc(enum_xmysqlnd_perf_counter counter, uint64_t value = 1);
+
+uint64_t xmysqlnd_perf_elapsed_ns(const Perf_clock::time_point& started);
+
+} // namespace drv
+
+} // namespace mysqlx
+
+#endif // XMYSQLND_PERF_STATISTICS_H
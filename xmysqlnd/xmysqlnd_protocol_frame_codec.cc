@@ -44,6 +44,22 @@ XMYSQLND_METHOD(xmysqlnd_pfc, reset)(XMYSQLND_PFC * const /*pfc*/, MYSQLND_STATS
 	DBG_RETURN(PASS);
 }
 
+// while a batch of writes is active the frames are only queued
+static size_t
+write_frame_part(XMYSQLND_PFC * const pfc,
+				 MYSQLND_VIO * const vio,
+				 const zend_uchar * const data,
+				 const size_t count,
+				 MYSQLND_STATS * const stats,
+				 MYSQLND_ERROR_INFO * const error_info)
+{
+	if (pfc->data->write_batch) {
+		pfc->data->queued_frames.append(reinterpret_cast<const char*>(data), count);
+		return count;
+	}
+	return vio->data->m.network_write(vio, data, count, stats, error_info);
+}
+
 static enum_func_status
 XMYSQLND_METHOD(xmysqlnd_pfc, send)(XMYSQLND_PFC * const pfc,
 									MYSQLND_VIO * const vio,
@@ -69,6 +85,9 @@ XMYSQLND_METHOD(xmysqlnd_pfc, send)(XMYSQLND_PFC * const pfc,
 #ifdef PHP_DEBUG
 	xmysqlnd_dump_client_message(packet_type, buffer, static_cast<int>(count));
 #endif
+	if (pfc->data->capture.is_open()) {
+		pfc->data->capture.write(Capture_direction::client, packet_type, buffer, count);
+	}
 
 	*bytes_sent = 0;
 	do {
@@ -79,9 +98,9 @@ XMYSQLND_METHOD(xmysqlnd_pfc, send)(XMYSQLND_PFC * const pfc,
 			/* the packet type is part of the payload so we have always + 1 and never 0 as length */
 			XMYSQLND_PAYLOAD_LENGTH_STORE(header, to_be_sent + XMYSQLND_PACKET_TYPE_SIZE);
 			XMYSQLND_PACKET_TYPE_STORE(header + XMYSQLND_PAYLOAD_LENGTH_SIZE, packet_type);
-			bytes_sent += vio->data->m.network_write(vio, header, XMYSQLND_PAYLOAD_LENGTH_SIZE + XMYSQLND_PACKET_TYPE_SIZE, stats, error_info);
+			bytes_sent += write_frame_part(pfc, vio, header, XMYSQLND_PAYLOAD_LENGTH_SIZE + XMYSQLND_PACKET_TYPE_SIZE, stats, error_info);
 			if (to_be_sent) { /* the first packet can be empty, only packet_type */
-				bytes_sent += vio->data->m.network_write(vio, p, to_be_sent, stats, error_info);
+				bytes_sent += write_frame_part(pfc, vio, p, to_be_sent, stats, error_info);
 			}
 		}
 		p += to_be_sent;
@@ -104,8 +123,35 @@ XMYSQLND_METHOD(xmysqlnd_pfc, send)(XMYSQLND_PFC * const pfc,
 	DBG_RETURN(PASS);
 }
 
+// writes the frames queued during a batch of writes, all at once
+static enum_func_status
+XMYSQLND_METHOD(xmysqlnd_pfc, flush)(XMYSQLND_PFC * const pfc,
+									 MYSQLND_VIO * const vio,
+									 MYSQLND_STATS * const stats,
+									 MYSQLND_ERROR_INFO * const error_info)
+{
+	DBG_ENTER("xmysqlnd_pfc::flush");
+	if (pfc->data->queued_frames.empty()) {
+		DBG_RETURN(PASS);
+	}
+	std::string frames;
+	frames.swap(pfc->data->queued_frames);
+	DBG_INF_FMT("count=" MYSQLND_SZ_T_SPEC, frames.size());
+	if (!vio || FALSE == vio->data->m.has_valid_stream(vio)) {
+		DBG_RETURN(FAIL);
+	}
+	const size_t bytes_sent = vio->data->m.network_write(
+		vio, reinterpret_cast<const zend_uchar*>(frames.data()), frames.size(), stats, error_info);
+	if (bytes_sent != frames.size()) {
+		DBG_ERR_FMT("Can't %u send bytes", frames.size());
+		SET_CLIENT_ERROR(error_info, CR_SERVER_GONE_ERROR, UNKNOWN_SQLSTATE, mysqlnd_server_gone);
+		DBG_RETURN(FAIL);
+	}
+	DBG_RETURN(PASS);
+}
+
 static enum_func_status
-XMYSQLND_METHOD(xmysqlnd_pfc, receive)(XMYSQLND_PFC * const /*pfc*/,
+XMYSQLND_METHOD(xmysqlnd_pfc, receive)(XMYSQLND_PFC * const pfc,
 									   MYSQLND_VIO * const vio,
 									   zend_uchar * prealloc_buffer,
 									   const size_t prealloc_buffer_len,
@@ -135,6 +181,9 @@ XMYSQLND_METHOD(xmysqlnd_pfc, receive)(XMYSQLND_PFC * const /*pfc*/,
 #ifdef PHP_DEBUG
 			xmysqlnd_dump_server_message(*packet_type, *buffer, static_cast<int>(*count));
 #endif
+			if (pfc->data->capture.is_open()) {
+				pfc->data->capture.write(Capture_direction::server, *packet_type, *buffer, *count);
+			}
 			XMYSQLND_INC_SESSION_STATISTIC_W_VALUE3(stats,
 				XMYSQLND_STAT_BYTES_RECEIVED, count + packets_received * (XMYSQLND_PAYLOAD_LENGTH_SIZE + XMYSQLND_PACKET_TYPE_SIZE),
 				XMYSQLND_STAT_PROTOCOL_OVERHEAD_IN, packets_received * (XMYSQLND_PAYLOAD_LENGTH_SIZE + XMYSQLND_PACKET_TYPE_SIZE),
@@ -157,9 +206,11 @@ XMYSQLND_METHOD(xmysqlnd_pfc, set_client_option)(XMYSQLND_PFC * const /*pfc*/, e
 }
 
 static void
-XMYSQLND_METHOD(xmysqlnd_pfc, free_contents)(XMYSQLND_PFC * /*pfc*/)
+XMYSQLND_METHOD(xmysqlnd_pfc, free_contents)(XMYSQLND_PFC * pfc)
 {
 	DBG_ENTER("xmysqlnd_pfc::free_contents");
+	pfc->data->capture.close();
+	std::string().swap(pfc->data->queued_frames);
 
 	DBG_VOID_RETURN;
 }
@@ -192,6 +243,7 @@ MYSQLND_CLASS_METHODS_START(xmysqlnd_protocol_packet_frame_codec)
 	XMYSQLND_METHOD(xmysqlnd_pfc, set_client_option),
 
 	XMYSQLND_METHOD(xmysqlnd_pfc, send),
+	XMYSQLND_METHOD(xmysqlnd_pfc, flush),
 	XMYSQLND_METHOD(xmysqlnd_pfc, receive),
 
 	XMYSQLND_METHOD(xmysqlnd_pfc, free_contents),
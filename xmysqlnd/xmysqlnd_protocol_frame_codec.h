@@ -20,12 +20,18 @@
 
 #include "xmysqlnd_enum_n_def.h"
 #include "xmysqlnd_driver.h"
+#include "xmysqlnd_capture.h"
+#include "xmysqlnd_perf_statistics.h"
+#include "xmysqlnd_trace.h"
 #include "util/allocator.h"
+#include <string>
 
 namespace mysqlx {
 
 namespace drv {
 
+class Write_batch;
+
 typedef struct st_xmysqlnd_protocol_frame_codec			XMYSQLND_PFC;
 typedef struct st_xmysqlnd_protocol_frame_codec_data	XMYSQLND_PFC_DATA;
 
@@ -33,6 +39,7 @@ typedef enum_func_status	(*func_xmysqlnd_pfc__init)(XMYSQLND_PFC * const pfc, co
 typedef enum_func_status	(*func_xmysqlnd_pfc__reset)(XMYSQLND_PFC * const pfc, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
 typedef enum_func_status	(*func_xmysqlnd_pfc__set_client_option)(XMYSQLND_PFC * const pfc, enum_xmysqlnd_client_option option, const char * const value);
 typedef enum_func_status	(*func_xmysqlnd_pfc__send)(XMYSQLND_PFC * const pfc, MYSQLND_VIO * const vio, zend_uchar packet_type, const zend_uchar * const buffer, const size_t count, size_t * bytes_sent, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
+typedef enum_func_status	(*func_xmysqlnd_pfc__flush)(XMYSQLND_PFC * const pfc, MYSQLND_VIO * const vio, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
 typedef enum_func_status	(*func_xmysqlnd_pfc__receive)(XMYSQLND_PFC * const pfc, MYSQLND_VIO * const vio, zend_uchar * prealloc_buffer, const size_t prealloc_buffer_len, zend_uchar * packet_type, zend_uchar ** buffer, size_t * count, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
 typedef void				(*func_xmysqlnd_pfc__free_contents)(XMYSQLND_PFC * pfc);
 typedef void				(*func_xmysqlnd_pfc__dtor)(XMYSQLND_PFC * const pfc, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
@@ -44,6 +51,7 @@ MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_protocol_packet_frame_codec)
 	func_xmysqlnd_pfc__reset reset;
 	func_xmysqlnd_pfc__set_client_option set_client_option;
 	func_xmysqlnd_pfc__send send;
+	func_xmysqlnd_pfc__flush flush;
 	func_xmysqlnd_pfc__receive receive;
 
 	func_xmysqlnd_pfc__free_contents free_contents;
@@ -57,6 +65,24 @@ struct st_xmysqlnd_protocol_frame_codec_data : public util::custom_allocable
 	zend_bool		ssl;
 
 	zend_bool		persistent;
+	Perf_pending_op	pending_op;
+	Trace_span_recorder	trace;
+	Capture_writer	capture;
+	/*
+		START TRANSACTION deferred by the session, sent right before the next statement
+		in an expectation block, and its response, which is skipped before reading the
+		response to that statement, then the response to the closing of the block is
+		skipped after it, see xmysqlnd_send_message and xmysqlnd_receive_message
+	*/
+	zend_bool		trx_begin_deferred{FALSE};
+	zend_bool		trx_begin_unread{FALSE};
+	zend_bool		trx_begin_end_unread{FALSE};
+	/*
+		while the session batches writes, the frames are queued here instead of
+		written, and go out with one write on flush, see Write_batch
+	*/
+	Write_batch*	write_batch{nullptr};
+	std::string		queued_frames;
 	MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_protocol_packet_frame_codec) m;
 };
 
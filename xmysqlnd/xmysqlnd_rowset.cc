@@ -46,13 +46,13 @@ XMYSQLND_METHOD(xmysqlnd_rowset, init)(XMYSQLND_ROWSET * const result,
 	DBG_ENTER("xmysqlnd_rowset::init");
 	switch (type) {
 		case XMYSQLND_TYPE_ROWSET_FWD_ONLY:
-			result->fwd = xmysqlnd_rowset_fwd_create(prefetch_rows, stmt, result->persistent, factory, stats, error_info);
+			result->fwd = xmysqlnd_rowset_fwd_create(result->arena, prefetch_rows, stmt, result->persistent, factory, stats, error_info);
 			if (result->fwd) {
 				ret = PASS;
 			}
 			break;
 		case XMYSQLND_TYPE_ROWSET_BUFFERED:
-			result->buffered = xmysqlnd_rowset_buffered_create(stmt, result->persistent, factory, stats, error_info);
+			result->buffered = xmysqlnd_rowset_buffered_create(result->arena, stmt, result->persistent, factory, stats, error_info);
 			if (result->buffered) {
 				ret = PASS;
 			}
@@ -139,6 +139,71 @@ XMYSQLND_METHOD(xmysqlnd_rowset, fetch_all_c)(XMYSQLND_ROWSET * const result, zv
 	DBG_RETURN(ret);
 }
 
+static enum_func_status
+XMYSQLND_METHOD(xmysqlnd_rowset, fetch_current_field)(XMYSQLND_ROWSET * const result, const unsigned int field, zval * value, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info)
+{
+	enum_func_status ret{FAIL};
+	DBG_ENTER("xmysqlnd_rowset::fetch_current_field");
+	if (result->fwd) {
+		ret = result->fwd->m.fetch_current_field(result->fwd, field, value, stats, error_info);
+	} else if (result->buffered) {
+		ret = result->buffered->m.fetch_current_field(result->buffered, field, value, stats, error_info);
+	}
+	DBG_RETURN(ret);
+}
+
+static const zval *
+XMYSQLND_METHOD(xmysqlnd_rowset, get_current_cells)(XMYSQLND_ROWSET * const result, st_xmysqlnd_stmt_result_meta ** const meta)
+{
+	const zval* ret{nullptr};
+	DBG_ENTER("xmysqlnd_rowset::get_current_cells");
+	if (result->fwd) {
+		ret = result->fwd->m.get_current_cells(result->fwd, meta);
+	} else if (result->buffered) {
+		ret = result->buffered->m.get_current_cells(result->buffered, meta);
+	}
+	DBG_RETURN(ret);
+}
+
+static enum_func_status
+XMYSQLND_METHOD(xmysqlnd_rowset, fetch_all_field)(XMYSQLND_ROWSET * const result, const unsigned int field, zval * set, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info)
+{
+	enum_func_status ret{FAIL};
+	DBG_ENTER("xmysqlnd_rowset::fetch_all_field");
+	if (result->fwd) {
+		ret = result->fwd->m.fetch_all_field(result->fwd, field, set, stats, error_info);
+	} else if (result->buffered) {
+		ret = result->buffered->m.fetch_all_field(result->buffered, field, set, stats, error_info);
+	}
+	DBG_RETURN(ret);
+}
+
+static enum_func_status
+XMYSQLND_METHOD(xmysqlnd_rowset, fetch_current_list)(XMYSQLND_ROWSET * const result, zval * row, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info)
+{
+	enum_func_status ret{FAIL};
+	DBG_ENTER("xmysqlnd_rowset::fetch_current_list");
+	if (result->fwd) {
+		ret = result->fwd->m.fetch_current_list(result->fwd, row, stats, error_info);
+	} else if (result->buffered) {
+		ret = result->buffered->m.fetch_current_list(result->buffered, row, stats, error_info);
+	}
+	DBG_RETURN(ret);
+}
+
+static enum_func_status
+XMYSQLND_METHOD(xmysqlnd_rowset, fetch_all_lists)(XMYSQLND_ROWSET * const result, zval * set, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info)
+{
+	enum_func_status ret{FAIL};
+	DBG_ENTER("xmysqlnd_rowset::fetch_all_lists");
+	if (result->fwd) {
+		ret = result->fwd->m.fetch_all_lists(result->fwd, set, stats, error_info);
+	} else if (result->buffered) {
+		ret = result->buffered->m.fetch_all_lists(result->buffered, set, stats, error_info);
+	}
+	DBG_RETURN(ret);
+}
+
 static enum_func_status
 XMYSQLND_METHOD(xmysqlnd_rowset, rewind)(XMYSQLND_ROWSET * const result)
 {
@@ -278,7 +343,9 @@ XMYSQLND_METHOD(xmysqlnd_rowset, dtor)(XMYSQLND_ROWSET* const result, MYSQLND_ST
 	if (result) {
 		result->m.free_contents(result, stats, error_info);
 
-		mnd_efree(result);
+		if (!result->arena) {
+			mnd_efree(result);
+		}
 	}
 	DBG_VOID_RETURN;
 }
@@ -293,6 +360,11 @@ MYSQLND_CLASS_METHODS_START(xmysqlnd_rowset)
 	XMYSQLND_METHOD(xmysqlnd_rowset, fetch_one_c),
 	XMYSQLND_METHOD(xmysqlnd_rowset, fetch_all),
 	XMYSQLND_METHOD(xmysqlnd_rowset, fetch_all_c),
+	XMYSQLND_METHOD(xmysqlnd_rowset, fetch_current_field),
+	XMYSQLND_METHOD(xmysqlnd_rowset, get_current_cells),
+	XMYSQLND_METHOD(xmysqlnd_rowset, fetch_all_field),
+	XMYSQLND_METHOD(xmysqlnd_rowset, fetch_current_list),
+	XMYSQLND_METHOD(xmysqlnd_rowset, fetch_all_lists),
 	XMYSQLND_METHOD(xmysqlnd_rowset, rewind),
 	XMYSQLND_METHOD(xmysqlnd_rowset, eof),
 
@@ -313,7 +385,8 @@ MYSQLND_CLASS_METHODS_END;
 PHP_MYSQL_XDEVAPI_API MYSQLND_CLASS_METHODS_INSTANCE_DEFINE(xmysqlnd_rowset);
 
 PHP_MYSQL_XDEVAPI_API XMYSQLND_ROWSET *
-xmysqlnd_rowset_create(const enum xmysqlnd_rowset_type type,
+xmysqlnd_rowset_create(util::Arena* const arena,
+					   const enum xmysqlnd_rowset_type type,
 					   const size_t prefetch_rows,
 					   xmysqlnd_stmt * stmt,
 					   const zend_bool persistent,
@@ -323,7 +396,7 @@ xmysqlnd_rowset_create(const enum xmysqlnd_rowset_type type,
 {
 	XMYSQLND_ROWSET* result{nullptr};
 	DBG_ENTER("xmysqlnd_rowset_create");
-	result = object_factory->get_rowset(object_factory, type, prefetch_rows, stmt, persistent, stats, error_info);
+	result = object_factory->get_rowset(object_factory, arena, type, prefetch_rows, stmt, persistent, stats, error_info);
 	DBG_RETURN(result);
 }
 
@@ -19,6 +19,7 @@
 #define XMYSQLND_ROWSET_H
 
 #include "xmysqlnd_driver.h"
+#include "util/arena.h"
 
 namespace mysqlx {
 
@@ -45,6 +46,11 @@ typedef enum_func_status	(*func_xmysqlnd_rowset__fetch_one)(XMYSQLND_ROWSET * co
 typedef enum_func_status	(*func_xmysqlnd_rowset__fetch_one_c)(XMYSQLND_ROWSET * const result, const size_t row_cursor, zval ** row, const zend_bool duplicate, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
 typedef enum_func_status	(*func_xmysqlnd_rowset__fetch_all)(XMYSQLND_ROWSET * const result, zval * set, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
 typedef enum_func_status	(*func_xmysqlnd_rowset__fetch_all_c)(XMYSQLND_ROWSET * const result, zval ** set, const zend_bool duplicate, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
+typedef enum_func_status	(*func_xmysqlnd_rowset__fetch_current_field)(XMYSQLND_ROWSET * const result, const unsigned int field, zval * value, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
+typedef const zval *		(*func_xmysqlnd_rowset__get_current_cells)(XMYSQLND_ROWSET * const result, st_xmysqlnd_stmt_result_meta ** const meta);
+typedef enum_func_status	(*func_xmysqlnd_rowset__fetch_all_field)(XMYSQLND_ROWSET * const result, const unsigned int field, zval * set, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
+typedef enum_func_status	(*func_xmysqlnd_rowset__fetch_current_list)(XMYSQLND_ROWSET * const result, zval * row, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
+typedef enum_func_status	(*func_xmysqlnd_rowset__fetch_all_lists)(XMYSQLND_ROWSET * const result, zval * set, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
 typedef enum_func_status	(*func_xmysqlnd_rowset__rewind)(XMYSQLND_ROWSET * const result);
 typedef zend_bool			(*func_xmysqlnd_rowset__eof)(const XMYSQLND_ROWSET * const result);
 
@@ -70,6 +76,11 @@ MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_rowset)
 	func_xmysqlnd_rowset__fetch_one_c fetch_one_c;
 	func_xmysqlnd_rowset__fetch_all fetch_all;
 	func_xmysqlnd_rowset__fetch_all_c fetch_all_c;
+	func_xmysqlnd_rowset__fetch_current_field fetch_current_field;
+	func_xmysqlnd_rowset__get_current_cells get_current_cells;
+	func_xmysqlnd_rowset__fetch_all_field fetch_all_field;
+	func_xmysqlnd_rowset__fetch_current_list fetch_current_list;
+	func_xmysqlnd_rowset__fetch_all_lists fetch_all_lists;
 	func_xmysqlnd_rowset__rewind rewind;
 	func_xmysqlnd_rowset__eof eof;
 
@@ -92,13 +103,15 @@ struct st_xmysqlnd_rowset : public util::custom_allocable
 	st_xmysqlnd_rowset_fwd* fwd;
 	enum xmysqlnd_rowset_type type;
 
+	/* set when allocated in the arena of the result, then it is not freed on its own */
+	util::Arena* arena;
 	MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_rowset) m;
 	zend_bool	persistent;
 };
 
 
 PHP_MYSQL_XDEVAPI_API MYSQLND_CLASS_METHODS_INSTANCE_DECLARE(xmysqlnd_rowset);
-PHP_MYSQL_XDEVAPI_API XMYSQLND_ROWSET * xmysqlnd_rowset_create(const enum xmysqlnd_rowset_type type, const size_t prefetch_rows, xmysqlnd_stmt* stmt, const zend_bool persistent, const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const object_factory, MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
+PHP_MYSQL_XDEVAPI_API XMYSQLND_ROWSET * xmysqlnd_rowset_create(util::Arena* const arena, const enum xmysqlnd_rowset_type type, const size_t prefetch_rows, xmysqlnd_stmt* stmt, const zend_bool persistent, const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const object_factory, MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
 PHP_MYSQL_XDEVAPI_API void xmysqlnd_rowset_free(XMYSQLND_ROWSET* const result, MYSQLND_STATS* stats, MYSQLND_ERROR_INFO* error_info);
 
 } // namespace drv
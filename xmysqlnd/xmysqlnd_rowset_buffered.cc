@@ -67,12 +67,6 @@ XMYSQLND_METHOD(xmysqlnd_rowset_buffered, fetch_current)(XMYSQLND_ROWSET_BUFFERE
 	DBG_RETURN(ret);
 }
 
-/*!!!
-  For Collection.find() this method should not call array_init_size() but ZVAL_STRINGL(row).
-  Or just a new method is needed, that fetches only the first column. A flag may be needed to
-  flatten to not use an array in case of just one column.
-*/
-
 static enum_func_status
 XMYSQLND_METHOD(xmysqlnd_rowset_buffered, fetch_one)(XMYSQLND_ROWSET_BUFFERED * const result,
 													 const size_t row_cursor,
@@ -86,8 +80,17 @@ XMYSQLND_METHOD(xmysqlnd_rowset_buffered, fetch_one)(XMYSQLND_ROWSET_BUFFERED *
 	if (row_cursor >= row_count || !result->rows[row_cursor]) {
 		DBG_RETURN(FAIL);
 	}
-	array_init_size(row, field_count);
-	if (field_count) {
+	HashTable * const row_template = result->meta->m->get_row_template(result->meta);
+	if (row_template) {
+		/* the keys are already hashed and laid out in column order, only the values are missing */
+		const zval * cell = result->rows[row_cursor];
+		zval * zv;
+		ZVAL_ARR(row, zend_array_dup(row_template));
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(row), zv) {
+			ZVAL_COPY(zv, cell++);
+		} ZEND_HASH_FOREACH_END();
+	} else {
+		array_init_size(row, field_count);
 		zval * const row_cursor_zv = result->rows[row_cursor];
 		for (unsigned int col{0}; col < field_count; ++col) {
 			const XMYSQLND_RESULT_FIELD_META * field_meta = result->meta->m->get_field(result->meta, col);
@@ -187,6 +190,126 @@ XMYSQLND_METHOD(xmysqlnd_rowset_buffered, fetch_all_c)(XMYSQLND_ROWSET_BUFFERED
 	DBG_RETURN(PASS);
 }
 
+/*
+  Fetches a single column of the current row without building the row hash,
+  e.g. the `doc` column of Collection.find(). The cell is shared, not duplicated.
+*/
+static enum_func_status
+XMYSQLND_METHOD(xmysqlnd_rowset_buffered, fetch_current_field)(XMYSQLND_ROWSET_BUFFERED * const result,
+															   const unsigned int field,
+															   zval * value,
+															   MYSQLND_STATS * const /*stats*/,
+															   MYSQLND_ERROR_INFO * const /*error_info*/)
+{
+	const size_t row_cursor = result->row_cursor;
+	DBG_ENTER("xmysqlnd_rowset_buffered::fetch_current_field");
+	DBG_INF_FMT("field=%u", field);
+	if (row_cursor >= result->row_count || !result->rows[row_cursor] || !result->meta || field >= result->meta->m->get_field_count(result->meta)) {
+		DBG_RETURN(FAIL);
+	}
+	ZVAL_COPY(value, &result->rows[row_cursor][field]);
+	DBG_RETURN(PASS);
+}
+
+/*
+  Cells of the current row, in column order, without copying them. They live as
+  long as the rowset, the cursor moving on doesn't touch them.
+*/
+static const zval *
+XMYSQLND_METHOD(xmysqlnd_rowset_buffered, get_current_cells)(XMYSQLND_ROWSET_BUFFERED * const result,
+															 st_xmysqlnd_stmt_result_meta ** const meta)
+{
+	const size_t row_cursor = result->row_cursor;
+	DBG_ENTER("xmysqlnd_rowset_buffered::get_current_cells");
+	if (row_cursor >= result->row_count || !result->rows[row_cursor] || !result->meta) {
+		DBG_RETURN(nullptr);
+	}
+	*meta = result->meta;
+	DBG_RETURN(result->rows[row_cursor]);
+}
+
+static enum_func_status
+XMYSQLND_METHOD(xmysqlnd_rowset_buffered, fetch_all_field)(XMYSQLND_ROWSET_BUFFERED * const result,
+														   const unsigned int field,
+														   zval * set,
+														   MYSQLND_STATS * const /*stats*/,
+														   MYSQLND_ERROR_INFO * const /*error_info*/)
+{
+	const size_t row_count = result->row_count;
+	DBG_ENTER("xmysqlnd_rowset_buffered::fetch_all_field");
+	DBG_INF_FMT("field=%u", field);
+	if (!result->meta || field >= result->meta->m->get_field_count(result->meta)) {
+		DBG_RETURN(FAIL);
+	}
+	array_init_size(set, static_cast<uint32_t>(row_count));
+	zend_hash_real_init_packed(Z_ARRVAL_P(set));
+	for (size_t row_cursor{0}; row_cursor < row_count; ++row_cursor) {
+		if (result->rows[row_cursor]) {
+			zval * const zv = &result->rows[row_cursor][field];
+			Z_TRY_ADDREF_P(zv);
+			zend_hash_next_index_insert(Z_ARRVAL_P(set), zv);
+		}
+	}
+	DBG_RETURN(PASS);
+}
+
+/*
+  Row as a packed list in column order, used by fetch_current_list() and
+  fetch_all_lists() - no column name gets hashed. Cells are shared, not duplicated.
+*/
+static void
+xmysqlnd_rowset_buffered_row_to_list(zval * list, zval * const cells, const unsigned int field_count)
+{
+	array_init_size(list, field_count);
+	zend_hash_real_init_packed(Z_ARRVAL_P(list));
+	ZEND_HASH_FILL_PACKED(Z_ARRVAL_P(list)) {
+		for (unsigned int col{0}; col < field_count; ++col) {
+			zval * const zv = &cells[col];
+			Z_TRY_ADDREF_P(zv);
+			ZEND_HASH_FILL_ADD(zv);
+		}
+	} ZEND_HASH_FILL_END();
+}
+
+static enum_func_status
+XMYSQLND_METHOD(xmysqlnd_rowset_buffered, fetch_current_list)(XMYSQLND_ROWSET_BUFFERED * const result,
+															  zval * row,
+															  MYSQLND_STATS * const /*stats*/,
+															  MYSQLND_ERROR_INFO * const /*error_info*/)
+{
+	const size_t row_cursor = result->row_cursor;
+	DBG_ENTER("xmysqlnd_rowset_buffered::fetch_current_list");
+	if (row_cursor >= result->row_count || !result->rows[row_cursor] || !result->meta) {
+		DBG_RETURN(FAIL);
+	}
+	xmysqlnd_rowset_buffered_row_to_list(row, result->rows[row_cursor], result->meta->m->get_field_count(result->meta));
+	DBG_RETURN(PASS);
+}
+
+static enum_func_status
+XMYSQLND_METHOD(xmysqlnd_rowset_buffered, fetch_all_lists)(XMYSQLND_ROWSET_BUFFERED * const result,
+														   zval * set,
+														   MYSQLND_STATS * const /*stats*/,
+														   MYSQLND_ERROR_INFO * const /*error_info*/)
+{
+	const size_t row_count = result->row_count;
+	DBG_ENTER("xmysqlnd_rowset_buffered::fetch_all_lists");
+	if (!result->meta) {
+		DBG_RETURN(FAIL);
+	}
+	const unsigned int field_count = result->meta->m->get_field_count(result->meta);
+	array_init_size(set, static_cast<uint32_t>(row_count));
+	zend_hash_real_init_packed(Z_ARRVAL_P(set));
+	for (size_t row_cursor{0}; row_cursor < row_count; ++row_cursor) {
+		if (result->rows[row_cursor]) {
+			zval row;
+			xmysqlnd_rowset_buffered_row_to_list(&row, result->rows[row_cursor], field_count);
+			zend_hash_next_index_insert(Z_ARRVAL_P(set), &row);
+		}
+	}
+	DBG_RETURN(PASS);
+}
+
 static enum_func_status
 XMYSQLND_METHOD(xmysqlnd_rowset_buffered, rewind)(XMYSQLND_ROWSET_BUFFERED * const result)
 {
@@ -339,7 +462,9 @@ XMYSQLND_METHOD(xmysqlnd_rowset_buffered, dtor)(XMYSQLND_ROWSET_BUFFERED * const
 			result->stmt->free_reference(result->stmt);
 		}
 
-		mnd_efree(result);
+		if (!result->arena) {
+			mnd_efree(result);
+		}
 	}
 	DBG_VOID_RETURN;
 }
@@ -354,6 +479,11 @@ MYSQLND_CLASS_METHODS_START(xmysqlnd_rowset_buffered)
 	XMYSQLND_METHOD(xmysqlnd_rowset_buffered, fetch_one_c),
 	XMYSQLND_METHOD(xmysqlnd_rowset_buffered, fetch_all),
 	XMYSQLND_METHOD(xmysqlnd_rowset_buffered, fetch_all_c),
+	XMYSQLND_METHOD(xmysqlnd_rowset_buffered, fetch_current_field),
+	XMYSQLND_METHOD(xmysqlnd_rowset_buffered, get_current_cells),
+	XMYSQLND_METHOD(xmysqlnd_rowset_buffered, fetch_all_field),
+	XMYSQLND_METHOD(xmysqlnd_rowset_buffered, fetch_current_list),
+	XMYSQLND_METHOD(xmysqlnd_rowset_buffered, fetch_all_lists),
 	XMYSQLND_METHOD(xmysqlnd_rowset_buffered, rewind),
 	XMYSQLND_METHOD(xmysqlnd_rowset_buffered, eof),
 
@@ -373,7 +503,8 @@ MYSQLND_CLASS_METHODS_END;
 PHP_MYSQL_XDEVAPI_API MYSQLND_CLASS_METHODS_INSTANCE_DEFINE(xmysqlnd_rowset_buffered);
 
 PHP_MYSQL_XDEVAPI_API XMYSQLND_ROWSET_BUFFERED *
-xmysqlnd_rowset_buffered_create(xmysqlnd_stmt * stmt,
+xmysqlnd_rowset_buffered_create(util::Arena* const arena,
+								xmysqlnd_stmt * stmt,
 								const zend_bool persistent,
 								const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const object_factory,
 								MYSQLND_STATS * stats,
@@ -381,7 +512,7 @@ xmysqlnd_rowset_buffered_create(xmysqlnd_stmt * stmt,
 {
 	XMYSQLND_ROWSET_BUFFERED* result{nullptr};
 	DBG_ENTER("xmysqlnd_rowset_buffered_create");
-	result = object_factory->get_rowset_buffered(object_factory, stmt, persistent, stats, error_info);
+	result = object_factory->get_rowset_buffered(object_factory, arena, stmt, persistent, stats, error_info);
 	DBG_RETURN(result);
 }
 
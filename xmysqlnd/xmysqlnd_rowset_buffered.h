@@ -19,6 +19,7 @@
 #define XMYSQLND_ROWSET_BUFFERED_H
 
 #include "xmysqlnd_driver.h"
+#include "util/arena.h"
 
 namespace mysqlx {
 
@@ -38,6 +39,11 @@ typedef enum_func_status	(*func_xmysqlnd_rowset_buffered__fetch_one)(XMYSQLND_RO
 typedef enum_func_status	(*func_xmysqlnd_rowset_buffered__fetch_one_c)(XMYSQLND_ROWSET_BUFFERED * const result, const size_t row_cursor, zval ** row, const zend_bool duplicate, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
 typedef enum_func_status	(*func_xmysqlnd_rowset_buffered__fetch_all)(XMYSQLND_ROWSET_BUFFERED * const result, zval * set, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
 typedef enum_func_status	(*func_xmysqlnd_rowset_buffered__fetch_all_c)(XMYSQLND_ROWSET_BUFFERED * const result, zval ** set, const zend_bool duplicate, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
+typedef enum_func_status	(*func_xmysqlnd_rowset_buffered__fetch_current_field)(XMYSQLND_ROWSET_BUFFERED * const result, const unsigned int field, zval * value, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
+typedef const zval *		(*func_xmysqlnd_rowset_buffered__get_current_cells)(XMYSQLND_ROWSET_BUFFERED * const result, st_xmysqlnd_stmt_result_meta ** const meta);
+typedef enum_func_status	(*func_xmysqlnd_rowset_buffered__fetch_all_field)(XMYSQLND_ROWSET_BUFFERED * const result, const unsigned int field, zval * set, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
+typedef enum_func_status	(*func_xmysqlnd_rowset_buffered__fetch_current_list)(XMYSQLND_ROWSET_BUFFERED * const result, zval * row, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
+typedef enum_func_status	(*func_xmysqlnd_rowset_buffered__fetch_all_lists)(XMYSQLND_ROWSET_BUFFERED * const result, zval * set, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
 typedef enum_func_status	(*func_xmysqlnd_rowset_buffered__rewind)(XMYSQLND_ROWSET_BUFFERED * const result);
 typedef zend_bool			(*func_xmysqlnd_rowset_buffered__eof)(const XMYSQLND_ROWSET_BUFFERED * const result);
 
@@ -63,6 +69,11 @@ MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_rowset_buffered)
 	func_xmysqlnd_rowset_buffered__fetch_one_c fetch_one_c;
 	func_xmysqlnd_rowset_buffered__fetch_all fetch_all;
 	func_xmysqlnd_rowset_buffered__fetch_all_c fetch_all_c;
+	func_xmysqlnd_rowset_buffered__fetch_current_field fetch_current_field;
+	func_xmysqlnd_rowset_buffered__get_current_cells get_current_cells;
+	func_xmysqlnd_rowset_buffered__fetch_all_field fetch_all_field;
+	func_xmysqlnd_rowset_buffered__fetch_current_list fetch_current_list;
+	func_xmysqlnd_rowset_buffered__fetch_all_lists fetch_all_lists;
 	func_xmysqlnd_rowset_buffered__rewind rewind;
 	func_xmysqlnd_rowset_buffered__eof eof;
 
@@ -89,13 +100,14 @@ struct st_xmysqlnd_rowset_buffered : public util::custom_allocable
 	size_t rows_allocated;
 	size_t row_cursor;
 
+	util::Arena* arena;
 	MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_rowset_buffered) m;
 	zend_bool		persistent;
 };
 
 
 PHP_MYSQL_XDEVAPI_API MYSQLND_CLASS_METHODS_INSTANCE_DECLARE(xmysqlnd_rowset_buffered);
-PHP_MYSQL_XDEVAPI_API XMYSQLND_ROWSET_BUFFERED * xmysqlnd_rowset_buffered_create(xmysqlnd_stmt* stmt, const zend_bool persistent, const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const object_factory,  MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
+PHP_MYSQL_XDEVAPI_API XMYSQLND_ROWSET_BUFFERED * xmysqlnd_rowset_buffered_create(util::Arena* const arena, xmysqlnd_stmt* stmt, const zend_bool persistent, const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const object_factory,  MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
 PHP_MYSQL_XDEVAPI_API void xmysqlnd_rowset_buffered_free(XMYSQLND_ROWSET_BUFFERED* const result, MYSQLND_STATS* stats, MYSQLND_ERROR_INFO* error_info);
 
 } // namespace drv
@@ -95,8 +95,17 @@ XMYSQLND_METHOD(xmysqlnd_rowset_fwd, fetch_one)(XMYSQLND_ROWSET_FWD * const resu
 	if (row_cursor >= row_count || !result->rows[row_cursor]) {
 		DBG_RETURN(FAIL);
 	}
-	array_init_size(row, field_count);
-	if (field_count) {
+	HashTable * const row_template = result->meta->m->get_row_template(result->meta);
+	if (row_template) {
+		/* the keys are already hashed and laid out in column order, only the values are missing */
+		const zval * cell = result->rows[row_cursor];
+		zval * zv;
+		ZVAL_ARR(row, zend_array_dup(row_template));
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(row), zv) {
+			ZVAL_COPY(zv, cell++);
+		} ZEND_HASH_FOREACH_END();
+	} else {
+		array_init_size(row, field_count);
 		zval * const row_cursor_zv = result->rows[row_cursor];
 		for (unsigned int col{0}; col < field_count; ++col) {
 			const XMYSQLND_RESULT_FIELD_META * field_meta = result->meta->m->get_field(result->meta, col);
@@ -144,6 +153,151 @@ XMYSQLND_METHOD(xmysqlnd_rowset_fwd, fetch_all)(XMYSQLND_ROWSET_FWD * const resu
 	DBG_RETURN(PASS);
 }
 
+static enum_func_status
+XMYSQLND_METHOD(xmysqlnd_rowset_fwd, fetch_current_field)(XMYSQLND_ROWSET_FWD * const result,
+														  const unsigned int field,
+														  zval * value,
+														  MYSQLND_STATS * const /*stats*/,
+														  MYSQLND_ERROR_INFO * const /*error_info*/)
+{
+	const size_t row_cursor = result->row_cursor;
+	DBG_ENTER("xmysqlnd_rowset_fwd::fetch_current_field");
+	DBG_INF_FMT("row_cursor=" MYSQLX_LLU_SPEC "  row_count=" MYSQLX_LLU_SPEC "  field=%u", result->row_cursor, result->row_count, field);
+	if (row_cursor >= result->row_count || !result->rows[row_cursor] || !result->meta || field >= result->meta->m->get_field_count(result->meta)) {
+		DBG_RETURN(FAIL);
+	}
+	ZVAL_COPY(value, &result->rows[row_cursor][field]);
+	++result->total_fetched;
+	DBG_RETURN(PASS);
+}
+
+/*
+  Cells of the current row, in column order, without copying them. They are
+  freed with the next prefetch, so the caller has to copy what it keeps.
+*/
+static const zval *
+XMYSQLND_METHOD(xmysqlnd_rowset_fwd, get_current_cells)(XMYSQLND_ROWSET_FWD * const result,
+														st_xmysqlnd_stmt_result_meta ** const meta)
+{
+	const size_t row_cursor = result->row_cursor;
+	DBG_ENTER("xmysqlnd_rowset_fwd::get_current_cells");
+	DBG_INF_FMT("row_cursor=" MYSQLX_LLU_SPEC "  row_count=" MYSQLX_LLU_SPEC, result->row_cursor, result->row_count);
+	if (row_cursor >= result->row_count || !result->rows[row_cursor] || !result->meta) {
+		DBG_RETURN(nullptr);
+	}
+	*meta = result->meta;
+	++result->total_fetched;
+	DBG_RETURN(result->rows[row_cursor]);
+}
+
+static enum_func_status
+XMYSQLND_METHOD(xmysqlnd_rowset_fwd, fetch_all_field)(XMYSQLND_ROWSET_FWD * const result,
+													  const unsigned int field,
+													  zval * set,
+													  MYSQLND_STATS * const stats,
+													  MYSQLND_ERROR_INFO * const error_info)
+{
+	DBG_ENTER("xmysqlnd_rowset_fwd::fetch_all_field");
+	DBG_INF_FMT("field=%u", field);
+	if (!result->meta || field >= result->meta->m->get_field_count(result->meta)) {
+		DBG_RETURN(FAIL);
+	}
+
+	/* read the rest, same as fetch_all() */
+	if (FAIL == result->stmt->get_msg_stmt_exec().read_response(&result->stmt->get_msg_stmt_exec(), nullptr)) {
+		DBG_RETURN(FAIL);
+	}
+
+	array_init_size(set, static_cast<uint32_t>(result->row_count));
+	zend_hash_real_init_packed(Z_ARRVAL_P(set));
+	for (size_t row_cursor{0}; row_cursor < result->row_count; ++row_cursor) {
+		if (result->rows[row_cursor]) {
+			zval * const zv = &result->rows[row_cursor][field];
+			Z_TRY_ADDREF_P(zv);
+			zend_hash_next_index_insert(Z_ARRVAL_P(set), zv);
+		}
+	}
+
+	if (result->row_count) {
+		result->total_fetched += result->row_count;
+
+		/* Remove what we have, as we don't need it anymore */
+		result->m.free_rows_contents(result, stats, error_info);
+	}
+	DBG_RETURN(PASS);
+}
+
+/*
+  Row as a packed list in column order, used by fetch_current_list() and
+  fetch_all_lists() - no column name gets hashed. Cells are shared, not duplicated.
+*/
+static void
+xmysqlnd_rowset_fwd_row_to_list(zval * list, zval * const cells, const unsigned int field_count)
+{
+	array_init_size(list, field_count);
+	zend_hash_real_init_packed(Z_ARRVAL_P(list));
+	ZEND_HASH_FILL_PACKED(Z_ARRVAL_P(list)) {
+		for (unsigned int col{0}; col < field_count; ++col) {
+			zval * const zv = &cells[col];
+			Z_TRY_ADDREF_P(zv);
+			ZEND_HASH_FILL_ADD(zv);
+		}
+	} ZEND_HASH_FILL_END();
+}
+
+static enum_func_status
+XMYSQLND_METHOD(xmysqlnd_rowset_fwd, fetch_current_list)(XMYSQLND_ROWSET_FWD * const result,
+														 zval * row,
+														 MYSQLND_STATS * const /*stats*/,
+														 MYSQLND_ERROR_INFO * const /*error_info*/)
+{
+	const size_t row_cursor = result->row_cursor;
+	DBG_ENTER("xmysqlnd_rowset_fwd::fetch_current_list");
+	DBG_INF_FMT("row_cursor=" MYSQLX_LLU_SPEC "  row_count=" MYSQLX_LLU_SPEC, result->row_cursor, result->row_count);
+	if (row_cursor >= result->row_count || !result->rows[row_cursor] || !result->meta) {
+		DBG_RETURN(FAIL);
+	}
+	xmysqlnd_rowset_fwd_row_to_list(row, result->rows[row_cursor], result->meta->m->get_field_count(result->meta));
+	++result->total_fetched;
+	DBG_RETURN(PASS);
+}
+
+static enum_func_status
+XMYSQLND_METHOD(xmysqlnd_rowset_fwd, fetch_all_lists)(XMYSQLND_ROWSET_FWD * const result,
+													  zval * set,
+													  MYSQLND_STATS * const stats,
+													  MYSQLND_ERROR_INFO * const error_info)
+{
+	DBG_ENTER("xmysqlnd_rowset_fwd::fetch_all_lists");
+	if (!result->meta) {
+		DBG_RETURN(FAIL);
+	}
+
+	/* read the rest, same as fetch_all() */
+	if (FAIL == result->stmt->get_msg_stmt_exec().read_response(&result->stmt->get_msg_stmt_exec(), nullptr)) {
+		DBG_RETURN(FAIL);
+	}
+
+	const unsigned int field_count = result->meta->m->get_field_count(result->meta);
+	array_init_size(set, static_cast<uint32_t>(result->row_count));
+	zend_hash_real_init_packed(Z_ARRVAL_P(set));
+	for (size_t row_cursor{0}; row_cursor < result->row_count; ++row_cursor) {
+		if (result->rows[row_cursor]) {
+			zval row;
+			xmysqlnd_rowset_fwd_row_to_list(&row, result->rows[row_cursor], field_count);
+			zend_hash_next_index_insert(Z_ARRVAL_P(set), &row);
+		}
+	}
+
+	if (result->row_count) {
+		result->total_fetched += result->row_count;
+
+		/* Remove what we have, as we don't need it anymore */
+		result->m.free_rows_contents(result, stats, error_info);
+	}
+	DBG_RETURN(PASS);
+}
+
 static enum_func_status
 XMYSQLND_METHOD(xmysqlnd_rowset_fwd, rewind)(XMYSQLND_ROWSET_FWD * const result)
 {
@@ -302,7 +456,9 @@ XMYSQLND_METHOD(xmysqlnd_rowset_fwd, dtor)(XMYSQLND_ROWSET_FWD* const result, MY
 			result->stmt->free_reference(result->stmt);
 		}
 
-		mnd_efree(result);
+		if (!result->arena) {
+			mnd_efree(result);
+		}
 	}
 	DBG_VOID_RETURN;
 }
@@ -315,6 +471,11 @@ MYSQLND_CLASS_METHODS_START(xmysqlnd_rowset_fwd)
 	XMYSQLND_METHOD(xmysqlnd_rowset_fwd, fetch_current),
 	XMYSQLND_METHOD(xmysqlnd_rowset_fwd, fetch_one),
 	XMYSQLND_METHOD(xmysqlnd_rowset_fwd, fetch_all),
+	XMYSQLND_METHOD(xmysqlnd_rowset_fwd, fetch_current_field),
+	XMYSQLND_METHOD(xmysqlnd_rowset_fwd, get_current_cells),
+	XMYSQLND_METHOD(xmysqlnd_rowset_fwd, fetch_all_field),
+	XMYSQLND_METHOD(xmysqlnd_rowset_fwd, fetch_current_list),
+	XMYSQLND_METHOD(xmysqlnd_rowset_fwd, fetch_all_lists),
 	XMYSQLND_METHOD(xmysqlnd_rowset_fwd, rewind),
 	XMYSQLND_METHOD(xmysqlnd_rowset_fwd, eof),
 
@@ -334,7 +495,8 @@ MYSQLND_CLASS_METHODS_END;
 PHP_MYSQL_XDEVAPI_API MYSQLND_CLASS_METHODS_INSTANCE_DEFINE(xmysqlnd_rowset_fwd);
 
 PHP_MYSQL_XDEVAPI_API XMYSQLND_ROWSET_FWD *
-xmysqlnd_rowset_fwd_create(const size_t prefetch_rows,
+xmysqlnd_rowset_fwd_create(util::Arena* const arena,
+						   const size_t prefetch_rows,
 						   xmysqlnd_stmt * stmt,
 						   const zend_bool persistent,
 						   const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const object_factory,
@@ -343,7 +505,7 @@ xmysqlnd_rowset_fwd_create(const size_t prefetch_rows,
 {
 	XMYSQLND_ROWSET_FWD* result{nullptr};
 	DBG_ENTER("xmysqlnd_rowset_fwd_create");
-	result = object_factory->get_rowset_fwd(object_factory, prefetch_rows, stmt, persistent, stats, error_info);
+	result = object_factory->get_rowset_fwd(object_factory, arena, prefetch_rows, stmt, persistent, stats, error_info);
 	DBG_RETURN(result);
 }
 
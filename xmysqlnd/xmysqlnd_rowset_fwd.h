@@ -19,6 +19,7 @@
 #define XMYSQLND_ROWSET_FWD_H
 
 #include "xmysqlnd_driver.h"
+#include "util/arena.h"
 
 namespace mysqlx {
 
@@ -36,6 +37,11 @@ typedef enum_func_status	(*func_xmysqlnd_rowset_fwd__next)(XMYSQLND_ROWSET_FWD *
 typedef enum_func_status	(*func_xmysqlnd_rowset_fwd__fetch_current)(XMYSQLND_ROWSET_FWD * const result, zval * row, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
 typedef enum_func_status	(*func_xmysqlnd_rowset_fwd__fetch_one)(XMYSQLND_ROWSET_FWD * const result, const size_t row_cursor, zval * row, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
 typedef enum_func_status	(*func_xmysqlnd_rowset_fwd__fetch_all)(XMYSQLND_ROWSET_FWD * const result, zval * set, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
+typedef enum_func_status	(*func_xmysqlnd_rowset_fwd__fetch_current_field)(XMYSQLND_ROWSET_FWD * const result, const unsigned int field, zval * value, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
+typedef const zval *		(*func_xmysqlnd_rowset_fwd__get_current_cells)(XMYSQLND_ROWSET_FWD * const result, st_xmysqlnd_stmt_result_meta ** const meta);
+typedef enum_func_status	(*func_xmysqlnd_rowset_fwd__fetch_all_field)(XMYSQLND_ROWSET_FWD * const result, const unsigned int field, zval * set, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
+typedef enum_func_status	(*func_xmysqlnd_rowset_fwd__fetch_current_list)(XMYSQLND_ROWSET_FWD * const result, zval * row, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
+typedef enum_func_status	(*func_xmysqlnd_rowset_fwd__fetch_all_lists)(XMYSQLND_ROWSET_FWD * const result, zval * set, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
 typedef enum_func_status	(*func_xmysqlnd_rowset_fwd__rewind)(XMYSQLND_ROWSET_FWD * const result);
 typedef zend_bool			(*func_xmysqlnd_rowset_fwd__eof)(const XMYSQLND_ROWSET_FWD * const result);
 
@@ -59,6 +65,11 @@ MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_rowset_fwd)
 	func_xmysqlnd_rowset_fwd__fetch_current fetch_current;
 	func_xmysqlnd_rowset_fwd__fetch_one fetch_one;
 	func_xmysqlnd_rowset_fwd__fetch_all fetch_all;
+	func_xmysqlnd_rowset_fwd__fetch_current_field fetch_current_field;
+	func_xmysqlnd_rowset_fwd__get_current_cells get_current_cells;
+	func_xmysqlnd_rowset_fwd__fetch_all_field fetch_all_field;
+	func_xmysqlnd_rowset_fwd__fetch_current_list fetch_current_list;
+	func_xmysqlnd_rowset_fwd__fetch_all_lists fetch_all_lists;
 	func_xmysqlnd_rowset_fwd__rewind rewind;
 	func_xmysqlnd_rowset_fwd__eof eof;
 
@@ -91,13 +102,14 @@ struct st_xmysqlnd_rowset_fwd : public util::custom_allocable
 	size_t total_fetched;
 
 	size_t prefetch_rows;
+	util::Arena* arena;
 	MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_rowset_fwd) m;
 	zend_bool		persistent;
 };
 
 
 PHP_MYSQL_XDEVAPI_API MYSQLND_CLASS_METHODS_INSTANCE_DECLARE(xmysqlnd_rowset_fwd);
-PHP_MYSQL_XDEVAPI_API XMYSQLND_ROWSET_FWD * xmysqlnd_rowset_fwd_create(const size_t prefetch_rows, xmysqlnd_stmt* stmt, const zend_bool persistent, const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const object_factory,  MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
+PHP_MYSQL_XDEVAPI_API XMYSQLND_ROWSET_FWD * xmysqlnd_rowset_fwd_create(util::Arena* const arena, const size_t prefetch_rows, xmysqlnd_stmt* stmt, const zend_bool persistent, const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const object_factory,  MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
 PHP_MYSQL_XDEVAPI_API void xmysqlnd_rowset_fwd_free(XMYSQLND_ROWSET_FWD* const result, MYSQLND_STATS* stats, MYSQLND_ERROR_INFO* error_info);
 
 } // namespace drv
@@ -172,6 +172,15 @@ xmysqlnd_schema::exists_in_database(
 	DBG_ENTER("xmysqlnd_schema::exists_in_database");
 	ZVAL_FALSE(exists);
 
+	Schema_cache* schema_cache{ session->data->schema_cache.get() };
+	if (schema_cache) {
+		const std::optional<bool> cached_exists{ schema_cache->find_schema(schema_name) };
+		if (cached_exists) {
+			ZVAL_BOOL(exists, *cached_exists);
+			DBG_RETURN(PASS);
+		}
+	}
+
 	enum_func_status ret;
 	constexpr util::string_view query{"SHOW SCHEMAS LIKE ?"};
 
@@ -201,6 +210,10 @@ xmysqlnd_schema::exists_in_database(
 							   noop__on_result_end,
 							   noop__on_statement_ok);
 
+	if (schema_cache && (PASS == ret)) {
+		schema_cache->store_schema(schema_name, Z_TYPE_P(exists) == IS_TRUE);
+	}
+
 	DBG_RETURN(ret);
 }
 
@@ -329,6 +342,10 @@ xmysqlnd_schema::create_collection(
 	DBG_INF_FMT("schema_name=%s collection_name=%s collection_options=%s",
 		schema_name.data(), collection_name.data(), collection_options.data());
 	if (PASS == xmysqlnd_collection_op(this, collection_name, collection_options, query, handler_on_error)) {
+		if (session->data->schema_cache) {
+			session->data->schema_cache->on_object_created(
+				schema_name, collection_name, db_object_type_filter_collection_tag);
+		}
 		collection = xmysqlnd_collection_create(
 			this,
 			collection_name,
@@ -363,6 +380,9 @@ xmysqlnd_schema::drop_collection(
 	DBG_INF_FMT("schema_name=%s collection_name=%s", schema_name.data(), collection_name.data());
 
 	ret = xmysqlnd_collection_op(this, collection_name, query, handler_on_error);
+	if ((PASS == ret) && session->data->schema_cache) {
+		session->data->schema_cache->on_object_dropped(schema_name, collection_name);
+	}
 
 	DBG_RETURN(ret);
 }
@@ -392,6 +412,9 @@ xmysqlnd_schema::drop_table(
 	DBG_INF_FMT("schema_name=%s table_name=%s ", schema_name.data(), table_name.data());
 
 	ret = xmysqlnd_collection_op(this, table_name, query, handler_on_error);
+	if ((PASS == ret) && session->data->schema_cache) {
+		session->data->schema_cache->on_object_dropped(schema_name, table_name);
+	}
 
 	DBG_RETURN(ret);
 }
@@ -475,8 +498,95 @@ collection_get_objects_var_binder(
 	DBG_RETURN(HND_PASS);
 }
 
+struct st_list_db_objects_ctx
+{
+	Schema_objects* objects;
+};
+
+static const enum_hnd_func_status
+list_db_objects_on_row(void * context,
+					   XMYSQLND_SESSION /*session*/,
+					   xmysqlnd_stmt * const /*stmt*/,
+					   const XMYSQLND_STMT_RESULT_META * const /*meta*/,
+					   const zval * const row,
+					   MYSQLND_STATS * const /*stats*/,
+					   MYSQLND_ERROR_INFO * const /*error_info*/)
+{
+	st_list_db_objects_ctx* ctx = static_cast<st_list_db_objects_ctx*>(context);
+	DBG_ENTER("list_db_objects_on_row");
+	if (ctx && row) {
+		ctx->objects->emplace(
+			std::string(Z_STRVAL(row[0]), Z_STRLEN(row[0])),
+			std::string(Z_STRVAL(row[1]), Z_STRLEN(row[1])));
+	}
+	DBG_RETURN(HND_AGAIN);
+}
+
 } // anonymous namespace
 
+bool
+xmysqlnd_schema::has_metadata_cache() const
+{
+	return session->data->schema_cache != nullptr;
+}
+
+enum_func_status
+xmysqlnd_schema::get_cached_db_objects(
+	const st_xmysqlnd_session_on_error_bind on_error,
+	std::shared_ptr<const Schema_objects>& objects)
+{
+	DBG_ENTER("xmysqlnd_schema::get_cached_db_objects");
+	Schema_cache& schema_cache{ *session->data->schema_cache };
+	objects = schema_cache.find_objects(schema_name);
+	if (objects) {
+		DBG_RETURN(PASS);
+	}
+
+	constexpr util::string_view query("list_objects");
+	st_collection_get_objects_var_binder_ctx var_binder_ctx = {
+		schema_name,
+		0
+	};
+	const st_xmysqlnd_session_query_bind_variable_bind var_binder = { collection_get_objects_var_binder, &var_binder_ctx };
+
+	Schema_objects listed_objects;
+	st_list_db_objects_ctx on_row_ctx{ &listed_objects };
+	const st_xmysqlnd_session_on_row_bind on_row{ list_db_objects_on_row, &on_row_ctx };
+
+	const enum_func_status ret = session->query_cb(namespace_mysqlx,
+							   query,
+							   var_binder,
+							   noop__on_result_start,
+							   on_row,
+							   noop__on_warning,
+							   on_error,
+							   noop__on_result_end,
+							   noop__on_statement_ok);
+	if (PASS == ret) {
+		objects = schema_cache.store_objects(schema_name, std::move(listed_objects));
+	}
+	DBG_RETURN(ret);
+}
+
+enum_func_status
+xmysqlnd_schema::find_cached_db_object_type(
+	const util::string_view& object_name,
+	const st_xmysqlnd_session_on_error_bind on_error,
+	std::string& object_type)
+{
+	DBG_ENTER("xmysqlnd_schema::find_cached_db_object_type");
+	object_type.clear();
+	std::shared_ptr<const Schema_objects> objects;
+	const enum_func_status ret{ get_cached_db_objects(on_error, objects) };
+	if (PASS == ret) {
+		auto it{ objects->find(object_name) };
+		if (it != objects->end()) {
+			object_type = it->second;
+		}
+	}
+	DBG_RETURN(ret);
+}
+
 enum_func_status
 xmysqlnd_schema::get_db_objects(
 	const util::string_view& /*collection_name*/,
@@ -503,6 +613,19 @@ xmysqlnd_schema::get_db_objects(
 
 	DBG_ENTER("xmysqlnd_schema::get_db_objects");
 
+	if (has_metadata_cache()) {
+		std::shared_ptr<const Schema_objects> objects;
+		ret = get_cached_db_objects(on_error, objects);
+		if ((PASS == ret) && on_object.handler) {
+			for (const auto& [object_name, object_type] : *objects) {
+				if (match_object_type(object_type_filter, object_type)) {
+					on_object.handler(on_object.ctx, this, object_name, object_type);
+				}
+			}
+		}
+		DBG_RETURN(ret);
+	}
+
 	ret = session->query_cb(namespace_mysqlx,
 							   query,
 							   var_binder,
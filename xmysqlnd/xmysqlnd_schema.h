@@ -79,6 +79,21 @@ public:
 	enum_func_status        drop_table(const util::string_view& table_name,const st_xmysqlnd_schema_on_error_bind on_error);
 	enum_func_status        get_db_objects(const util::string_view& collection_name,const db_object_type_filter object_type_filter,const st_xmysqlnd_schema_on_database_object_bind on_object,const st_xmysqlnd_schema_on_error_bind on_error);
 
+	// true if the session belongs to a client with the metadata cache enabled
+	bool                    has_metadata_cache() const;
+	/*
+	  all the objects of the schema from the metadata cache, listed and stored there if
+	  missing or expired - valid only if has_metadata_cache()
+	*/
+	enum_func_status        get_cached_db_objects(
+		const st_xmysqlnd_session_on_error_bind on_error,
+		std::shared_ptr<const Schema_objects>& objects);
+	// as above, object_type stays empty if there is no such object
+	enum_func_status        find_cached_db_object_type(
+		const util::string_view& object_name,
+		const st_xmysqlnd_session_on_error_bind on_error,
+		std::string& object_type);
+
 	xmysqlnd_schema *	    get_reference();
 	enum_func_status	    free_reference(MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
 	void				    free_contents();
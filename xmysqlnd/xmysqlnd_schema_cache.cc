@@ -0,0 +1,176 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#include "xmysqlnd_schema_cache.h"
+
+namespace mysqlx {
+
+namespace drv {
+
+Schema_cache::Schema_cache(const std::chrono::milliseconds& ttl)
+	: ttl(ttl)
+{
+}
+
+std::optional<bool> Schema_cache::find_schema(const util::string_view& schema_name)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	auto it{ schemas.find(schema_name) };
+	if ((it != schemas.end()) && is_valid(it->second.exists_expiration)) {
+		return it->second.exists;
+	}
+
+	if (schema_names && is_valid(schema_names_expiration)) {
+		return schema_names->count(schema_name) != 0;
+	}
+
+	return std::nullopt;
+}
+
+void Schema_cache::store_schema(const util::string_view& schema_name, bool exists)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	Schema_entry& entry{ get_entry(schema_name) };
+	entry.exists = exists;
+	entry.exists_expiration = next_expiration();
+}
+
+std::shared_ptr<const Schema_names> Schema_cache::find_schema_names()
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	if (!is_valid(schema_names_expiration)) return nullptr;
+	return schema_names;
+}
+
+void Schema_cache::store_schema_names(Schema_names names)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	schema_names = std::make_shared<const Schema_names>(std::move(names));
+	schema_names_expiration = next_expiration();
+}
+
+std::shared_ptr<const Schema_objects> Schema_cache::find_objects(const util::string_view& schema_name)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	auto it{ schemas.find(schema_name) };
+	if ((it == schemas.end()) || !is_valid(it->second.objects_expiration)) return nullptr;
+	return it->second.objects;
+}
+
+std::shared_ptr<const Schema_objects> Schema_cache::store_objects(
+	const util::string_view& schema_name,
+	Schema_objects objects)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	Schema_entry& entry{ get_entry(schema_name) };
+	entry.objects = std::make_shared<const Schema_objects>(std::move(objects));
+	entry.objects_expiration = next_expiration();
+	return entry.objects;
+}
+
+void Schema_cache::on_schema_created(const util::string_view& schema_name)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	Schema_entry& entry{ get_entry(schema_name) };
+	entry.exists = true;
+	entry.exists_expiration = next_expiration();
+	entry.objects = std::make_shared<const Schema_objects>();
+	entry.objects_expiration = entry.exists_expiration;
+
+	if (schema_names && !schema_names->count(schema_name)) {
+		auto names{ std::make_shared<Schema_names>(*schema_names) };
+		names->emplace(schema_name);
+		schema_names = std::move(names);
+	}
+}
+
+void Schema_cache::on_schema_dropped(const util::string_view& schema_name)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	Schema_entry& entry{ get_entry(schema_name) };
+	entry.exists = false;
+	entry.exists_expiration = next_expiration();
+	entry.objects = std::make_shared<const Schema_objects>();
+	entry.objects_expiration = entry.exists_expiration;
+
+	if (schema_names && schema_names->count(schema_name)) {
+		auto names{ std::make_shared<Schema_names>(*schema_names) };
+		names->erase(names->find(schema_name));
+		schema_names = std::move(names);
+	}
+}
+
+void Schema_cache::on_object_created(
+	const util::string_view& schema_name,
+	const util::string_view& object_name,
+	const util::string_view& object_type)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	Schema_entry& entry{ get_entry(schema_name) };
+	if (!entry.objects || !is_valid(entry.objects_expiration)) return;
+
+	// readers may still hold the previous list, so it is replaced rather than modified
+	auto objects{ std::make_shared<Schema_objects>(*entry.objects) };
+	(*objects)[std::string(object_name)] = std::string(object_type);
+	entry.objects = std::move(objects);
+}
+
+void Schema_cache::on_object_dropped(
+	const util::string_view& schema_name,
+	const util::string_view& object_name)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	auto it{ schemas.find(schema_name) };
+	if (it == schemas.end()) return;
+
+	Schema_entry& entry{ it->second };
+	if (!entry.objects || !entry.objects->count(object_name)) return;
+
+	auto objects{ std::make_shared<Schema_objects>(*entry.objects) };
+	objects->erase(objects->find(object_name));
+	entry.objects = std::move(objects);
+}
+
+void Schema_cache::invalidate()
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	schemas.clear();
+	schema_names.reset();
+}
+
+Schema_cache::Schema_entry& Schema_cache::get_entry(const util::string_view& schema_name)
+{
+	auto it{ schemas.find(schema_name) };
+	if (it == schemas.end()) {
+		it = schemas.emplace(std::string(schema_name), Schema_entry()).first;
+	}
+	return it->second;
+}
+
+Schema_cache::Clock::time_point Schema_cache::next_expiration() const
+{
+	return Clock::now() + ttl;
+}
+
+bool Schema_cache::is_valid(const Clock::time_point& expiration) const
+{
+	return Clock::now() < expiration;
+}
+
+} // namespace drv
+
+} // namespace mysqlx
@@ -0,0 +1,105 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#ifndef XMYSQLND_SCHEMA_CACHE_H
+#define XMYSQLND_SCHEMA_CACHE_H
+
+#include "util/strings.h"
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+
+namespace mysqlx {
+
+namespace drv {
+
+// object name => object type as reported by list_objects (TABLE, VIEW or COLLECTION)
+using Schema_objects = std::map<std::string, std::string, std::less<>>;
+using Schema_names = std::set<std::string, std::less<>>;
+
+/*
+	Opt-in cache of server side metadata shared by all the sessions of a client
+	(see the metadataCacheTtl client option) - which schemas exist, and the
+	objects of each schema with their types. Entries expire after the ttl. DDL
+	issued through the sessions of the client (createSchema, dropSchema,
+	createCollection, dropCollection, dropTable) updates the cache in place,
+	while DDL issued as plain SQL or by other clients is seen only after
+	expiration or an explicit invalidate(). The cache outlives requests and may
+	be used by many threads, so it keeps its own std strings under a mutex.
+*/
+class Schema_cache
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	explicit Schema_cache(const std::chrono::milliseconds& ttl);
+	Schema_cache(const Schema_cache&) = delete;
+	Schema_cache& operator=(const Schema_cache&) = delete;
+
+	// nothing if not cached or expired
+	std::optional<bool> find_schema(const util::string_view& schema_name);
+	void store_schema(const util::string_view& schema_name, bool exists);
+
+	std::shared_ptr<const Schema_names> find_schema_names();
+	void store_schema_names(Schema_names schema_names);
+
+	std::shared_ptr<const Schema_objects> find_objects(const util::string_view& schema_name);
+	std::shared_ptr<const Schema_objects> store_objects(const util::string_view& schema_name, Schema_objects objects);
+
+	void on_schema_created(const util::string_view& schema_name);
+	void on_schema_dropped(const util::string_view& schema_name);
+	void on_object_created(
+		const util::string_view& schema_name,
+		const util::string_view& object_name,
+		const util::string_view& object_type);
+	void on_object_dropped(
+		const util::string_view& schema_name,
+		const util::string_view& object_name);
+
+	void invalidate();
+
+private:
+	struct Schema_entry
+	{
+		std::optional<bool> exists;
+		Clock::time_point exists_expiration;
+		std::shared_ptr<const Schema_objects> objects;
+		Clock::time_point objects_expiration;
+	};
+
+	Schema_entry& get_entry(const util::string_view& schema_name);
+	Clock::time_point next_expiration() const;
+	bool is_valid(const Clock::time_point& expiration) const;
+
+private:
+	const std::chrono::milliseconds ttl;
+
+	std::mutex mtx;
+	std::map<std::string, Schema_entry, std::less<>> schemas;
+	std::shared_ptr<const Schema_names> schema_names;
+	Clock::time_point schema_names_expiration;
+};
+
+} // namespace drv
+
+} // namespace mysqlx
+
+#endif // XMYSQLND_SCHEMA_CACHE_H
@@ -0,0 +1,81 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#include "xmysqlnd_server_info_cache.h"
+
+namespace mysqlx {
+
+namespace drv {
+
+std::optional<std::string> Server_info::get_version() const
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	return version;
+}
+
+void Server_info::set_version(const util::string_view& server_version)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	version = std::string(server_version);
+}
+
+std::optional<bool> Server_info::get_session_properly_supported() const
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	return session_properly_supported;
+}
+
+void Server_info::set_session_properly_supported(bool supported)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	session_properly_supported = supported;
+}
+
+// ----------------------------------------------------------------------------
+
+Server_info_cache& Server_info_cache::get()
+{
+	static Server_info_cache instance;
+	return instance;
+}
+
+std::shared_ptr<Server_info> Server_info_cache::acquire(
+	const std::string& endpoint,
+	const util::string_view& capabilities,
+	const std::chrono::seconds& ttl)
+{
+	const auto now{ std::chrono::steady_clock::now() };
+	std::lock_guard<std::mutex> lck(mtx);
+	Entry& entry{ endpoints[endpoint] };
+	if (!entry.info || (entry.capabilities != capabilities) || (now >= entry.expires)) {
+		entry.capabilities = std::string(capabilities);
+		entry.info = std::make_shared<Server_info>();
+		entry.expires = now + ttl;
+	}
+	return entry.info;
+}
+
+// sessions still holding the info keep it, it is just not handed out anymore
+void Server_info_cache::invalidate(const std::string& endpoint)
+{
+	std::lock_guard<std::mutex> lck(mtx);
+	endpoints.erase(endpoint);
+}
+
+} // namespace drv
+
+} // namespace mysqlx
@@ -0,0 +1,101 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#ifndef XMYSQLND_SERVER_INFO_CACHE_H
+#define XMYSQLND_SERVER_INFO_CACHE_H
+
+#include "util/strings.h"
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace mysqlx {
+
+namespace drv {
+
+/*
+	What sessions learn about the server behind an endpoint besides the
+	capabilities - its version (SELECT VERSION()) and whether it supports
+	resetting a session without closing it (the Expect::Open probe). Shared by
+	all the sessions connected to the endpoint, so each of them is asked at most
+	once per process, not once per session.
+*/
+class Server_info
+{
+public:
+	std::optional<std::string> get_version() const;
+	void set_version(const util::string_view& version);
+
+	std::optional<bool> get_session_properly_supported() const;
+	void set_session_properly_supported(bool supported);
+
+private:
+	mutable std::mutex mtx;
+	std::optional<std::string> version;
+	std::optional<bool> session_properly_supported;
+};
+
+/*
+	Process wide map of endpoints (as in xmysqlnd_session_data::scheme) to the
+	server info. The X Protocol handshake carries no server UUID, so the
+	capabilities returned by CapabilitiesGet - which every new connection reads
+	anyway, and which contain e.g. the compression algorithms and the
+	authentication mechanisms - serve as the identity of the server. If they
+	differ from what was seen before on the endpoint, it is assumed to lead to
+	another server now (failover, upgrade) and its info starts from scratch.
+	Since an upgraded server may return the same capabilities, the info also
+	expires after xmysqlnd.server_info_ttl seconds, and it is dropped as soon
+	as a connection to the endpoint is lost or cannot be made.
+	Disabled while replaying captured sessions, which have to issue exactly the
+	recorded requests.
+*/
+class Server_info_cache
+{
+public:
+	static Server_info_cache& get();
+
+	std::shared_ptr<Server_info> acquire(
+		const std::string& endpoint,
+		const util::string_view& capabilities,
+		const std::chrono::seconds& ttl);
+
+	void invalidate(const std::string& endpoint);
+
+private:
+	Server_info_cache() = default;
+	Server_info_cache(const Server_info_cache&) = delete;
+	Server_info_cache& operator=(const Server_info_cache&) = delete;
+
+	struct Entry
+	{
+		std::string capabilities;
+		std::shared_ptr<Server_info> info;
+		std::chrono::steady_clock::time_point expires;
+	};
+
+	std::mutex mtx;
+	std::map<std::string, Entry> endpoints;
+};
+
+} // namespace drv
+
+} // namespace mysqlx
+
+#endif // XMYSQLND_SERVER_INFO_CACHE_H
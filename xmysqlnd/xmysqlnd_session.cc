@@ -275,13 +275,18 @@ xmysqlnd_session_data::connect_handshake(
 {
 	enum_func_status ret{FAIL};
 	DBG_ENTER("xmysqlnd_session_data::connect_handshake");
+	const Perf_clock::time_point started{ xmysqlnd_get_perf_statistics() ? Perf_clock::now() : Perf_clock::time_point() };
+	io.pfc->data->capture.open();
 
+	const bool replay{ xmysqlnd_is_replay_enabled() };
 	if (set_connection_options(auth.get(), io.vio)
-		&& (PASS == io.vio->data->m.connect(io.vio,
-											util::to_mysqlnd_cstr(scheme_name),
-											persistent,
-											stats,
-											error_info))
+		&& (PASS == (replay
+			? xmysqlnd_replay_connect(io.vio, persistent, error_info)
+			: io.vio->data->m.connect(io.vio,
+									  util::to_mysqlnd_cstr(scheme_name),
+									  persistent,
+									  stats,
+									  error_info)))
 		&& (PASS == io.pfc->data->m.reset(io.pfc,
 										  stats,
 										  error_info))) {
@@ -291,6 +296,7 @@ xmysqlnd_session_data::connect_handshake(
 			ret = authenticate(scheme_name, default_schema, set_capabilities);
 		}
 	}
+	xmysqlnd_perf_record_latency(XMYSQLND_PERF_OP_CONNECT, started);
 	DBG_RETURN(ret);
 }
 
@@ -302,6 +308,7 @@ xmysqlnd_session_data::authenticate(
 	const bool re_auth)
 {
 	DBG_ENTER("xmysqlnd_session_data::authenticate");
+	const Perf_clock::time_point started{ xmysqlnd_get_perf_statistics() ? Perf_clock::now() : Perf_clock::time_point() };
 	Authenticate authenticate(this, scheme_name, default_schema);
 	enum_func_status ret{FAIL};
 	if (authenticate.run(re_auth)) {
@@ -309,6 +316,7 @@ xmysqlnd_session_data::authenticate(
 		ret = PASS;
 	}
 	capabilities = authenticate.get_capabilities();
+	xmysqlnd_perf_record_latency(XMYSQLND_PERF_OP_AUTH, started);
 	DBG_RETURN(ret);
 }
 
@@ -434,6 +442,9 @@ xmysqlnd_session_data::connect(
 			php_error_docref(nullptr, E_WARNING, "[%u] %.128s (trying to connect via %s)",
 							 error_info->error_no, error_info->error, scheme.c_str());
 		}
+		if (!scheme.empty()) {
+			Server_info_cache::get().invalidate(scheme);
+		}
 		cleanup();
 		XMYSQLND_INC_SESSION_STATISTIC(stats, XMYSQLND_STAT_CONNECT_FAILURE);
 	}
@@ -508,10 +519,15 @@ xmysqlnd_session_data::send_reset(bool keep_open)
 {
 	DBG_ENTER("mysqlnd_send_reset");
 
+	end_write_batch();
+	const xmysqlnd_session_state state_val{ state.get() };
+	if (state_val == SESSION_READY) {
+		settle_deferred_trx_begin();
+	}
+	io.pfc->data->trx_begin_deferred = FALSE;
 	enum_func_status ret{ PASS };
 	MYSQLND_VIO* vio{ io.vio };
 	php_stream* net_stream{ vio->data->m.get_stream(vio) };
-	const xmysqlnd_session_state state_val{ state.get() };
 
 	DBG_INF_FMT("session=%p vio->data->stream->abstract=%p", this, net_stream ? net_stream->abstract : nullptr);
 	DBG_INF_FMT("state=%u", state_val);
@@ -554,9 +570,16 @@ xmysqlnd_session_data::send_close(Session_close_reason reason)
 {
 	DBG_ENTER("xmysqlnd_session_data::send_close");
 
+	const xmysqlnd_session_state state_val{ state.get() };
+	if (io.pfc) {
+		end_write_batch();
+		if ((state_val == SESSION_READY) && (reason != Session_close_reason::Disconnect)) {
+			settle_deferred_trx_begin();
+		}
+		io.pfc->data->trx_begin_deferred = FALSE;
+	}
 	enum_func_status ret{PASS};
 	MYSQLND_VIO* vio{ io.vio };
-	const xmysqlnd_session_state state_val{ state.get() };
 
 	DBG_INF_FMT("state=%u", state_val);
 
@@ -579,8 +602,11 @@ xmysqlnd_session_data::send_close(Session_close_reason reason)
 
 		DBG_INF("Connection clean, sending CON_CLOSE");
 		st_xmysqlnd_msg__connection_close conn_close_msg = msg_factory.get__connection_close(&msg_factory);
-		conn_close_msg.send_request(&conn_close_msg);
-		conn_close_msg.read_response(&conn_close_msg);
+		if ((conn_close_msg.send_request(&conn_close_msg) != PASS)
+			|| (conn_close_msg.read_response(&conn_close_msg) != PASS)) {
+			// the connection has been lost, maybe the server behind the endpoint is being replaced
+			Server_info_cache::get().invalidate(scheme);
+		}
 
 		php_stream* net_stream{ vio->data->m.get_stream(vio) };
 		DBG_INF_FMT("session=%p vio->data->stream->abstract=%p", this, net_stream? net_stream->abstract:nullptr);
@@ -612,6 +638,110 @@ xmysqlnd_session_data::send_close(Session_close_reason reason)
 	DBG_RETURN(ret);
 }
 
+namespace {
+
+const enum_hnd_func_status
+trx_control_on_error(void* context, const unsigned int code, const util::string_view& sql_state, const util::string_view& message)
+{
+	DBG_ENTER("trx_control_on_error");
+	xmysqlnd_session_data* session = static_cast<xmysqlnd_session_data*>(context);
+	SET_CLIENT_ERROR(session->error_info, code, sql_state.data(), message.data());
+	DBG_RETURN(HND_PASS_RETURN_FAIL);
+}
+
+} // anonymous namespace
+
+enum_func_status
+xmysqlnd_session_data::execute_trx_control(const util::string_view& query)
+{
+	DBG_ENTER("xmysqlnd_session_data::execute_trx_control");
+	DBG_INF_FMT("query=%s", query.data());
+	SET_EMPTY_ERROR(error_info);
+
+	XMYSQLND_STMT_OP__EXECUTE* stmt_execute{ stmt_pool.acquire_stmt_execute(namespace_sql, query) };
+	if (!stmt_execute) {
+		SET_OOM_ERROR(error_info);
+		DBG_RETURN(FAIL);
+	}
+
+	st_xmysqlnd_message_factory msg_factory{ create_message_factory() };
+	st_xmysqlnd_msg__sql_stmt_execute msg{ msg_factory.get__sql_stmt_execute(&msg_factory) };
+	enum_func_status ret{ msg.send_execute_request(&msg, xmysqlnd_stmt_execute__get_protobuf_message(stmt_execute)) };
+	if (PASS == ret) {
+		const st_xmysqlnd_on_error_bind on_error{ trx_control_on_error, this };
+		msg.init_read(&msg, {}, {}, {}, {}, {}, on_error, {}, {}, {}, {}, {}, {});
+		ret = msg.read_response(&msg, nullptr);
+	}
+	stmt_pool.release_stmt_execute(stmt_execute);
+
+	DBG_INF(ret == PASS? "PASS":"FAIL");
+	DBG_RETURN(ret);
+}
+
+enum_func_status
+xmysqlnd_session_data::start_transaction()
+{
+	DBG_ENTER("xmysqlnd_session_data::start_transaction");
+	if (compression_executor.enabled()) {
+		// the deferred begin goes out as a plain frame, so it can't be mixed with compressed ones
+		DBG_RETURN(execute_trx_control("START TRANSACTION"));
+	}
+	SET_EMPTY_ERROR(error_info);
+	io.pfc->data->trx_begin_deferred = TRUE;
+	DBG_RETURN(PASS);
+}
+
+enum_func_status
+xmysqlnd_session_data::commit()
+{
+	DBG_ENTER("xmysqlnd_session_data::commit");
+	io.pfc->data->trx_begin_deferred = FALSE;
+	DBG_RETURN(execute_trx_control("COMMIT"));
+}
+
+enum_func_status
+xmysqlnd_session_data::rollback()
+{
+	DBG_ENTER("xmysqlnd_session_data::rollback");
+	if (io.pfc->data->trx_begin_deferred) {
+		DBG_RETURN(settle_deferred_trx_begin());
+	}
+	DBG_RETURN(execute_trx_control("ROLLBACK"));
+}
+
+enum_func_status
+xmysqlnd_session_data::settle_deferred_trx_begin()
+{
+	DBG_ENTER("xmysqlnd_session_data::settle_deferred_trx_begin");
+	if (!io.pfc->data->trx_begin_deferred) {
+		DBG_RETURN(PASS);
+	}
+	/*
+		nothing has been executed since the transaction started, so it is empty,
+		but START TRANSACTION would commit the one opened earlier, e.g. by a previous
+		startTransaction() or plain SQL, and so does COMMIT
+	*/
+	io.pfc->data->trx_begin_deferred = FALSE;
+	DBG_RETURN(execute_trx_control("COMMIT"));
+}
+
+void
+xmysqlnd_session_data::begin_write_batch()
+{
+	DBG_ENTER("xmysqlnd_session_data::begin_write_batch");
+	write_batch.begin(io.pfc, io.vio);
+	DBG_VOID_RETURN;
+}
+
+std::size_t
+xmysqlnd_session_data::end_write_batch()
+{
+	DBG_ENTER("xmysqlnd_session_data::end_write_batch");
+	const std::size_t failed_count{ write_batch.end(stats, error_info) };
+	DBG_INF_FMT("failed_count=%zu", failed_count);
+	DBG_RETURN(failed_count);
+}
+
 size_t
 xmysqlnd_session_data::negotiate_client_api_capabilities(const size_t flags)
 {
@@ -628,6 +758,11 @@ bool xmysqlnd_session_data::is_session_properly_supported()
 {
 	if (session_properly_supported) return *session_properly_supported;
 
+	if (server_info) {
+		session_properly_supported = server_info->get_session_properly_supported();
+		if (session_properly_supported) return *session_properly_supported;
+	}
+
 	st_xmysqlnd_message_factory msg_factory{ create_message_factory() };
 	st_xmysqlnd_msg__expectations_open conn_expectations_open{ msg_factory.get__expectations_open(&msg_factory) };
 	conn_expectations_open.condition_key = Mysqlx::Expect::Open_Condition::EXPECT_FIELD_EXIST;
@@ -642,6 +777,9 @@ bool xmysqlnd_session_data::is_session_properly_supported()
 	conn_expectations_close.read_response(&conn_expectations_close);
 
 	session_properly_supported.emplace(conn_expectations_open.result == st_xmysqlnd_msg__expectations_open::Result::ok);
+	if (server_info) {
+		server_info->set_session_properly_supported(*session_properly_supported);
+	}
 	return *session_properly_supported;
 }
 
@@ -824,6 +962,8 @@ xmysqlnd_session_data::xmysqlnd_session_data(xmysqlnd_session_data&& rhs) noexce
 	error_info = &error_info_impl;
 	state = rhs.state;
 	client_api_capabilities = rhs.client_api_capabilities;
+	session_properly_supported = rhs.session_properly_supported;
+	server_info = std::move(rhs.server_info);
 
 	stats = rhs.stats;
 	rhs.stats = nullptr;
@@ -833,6 +973,7 @@ xmysqlnd_session_data::xmysqlnd_session_data(xmysqlnd_session_data&& rhs) noexce
 	persistent = rhs.persistent;
 	savepoint_name_seed = rhs.savepoint_name_seed;
 	rhs.savepoint_name_seed = 0;
+	schema_cache = std::move(rhs.schema_cache);
 }
 
 xmysqlnd_session_data::~xmysqlnd_session_data()
@@ -864,6 +1005,10 @@ void xmysqlnd_session_data::cleanup()
 	default_schema.clear();
 	scheme.clear();
 	server_host_info.clear();
+	result_meta_cache.clear();
+	stmt_pool.clear();
+	session_properly_supported.reset();
+	server_info.reset();
 	util::zend::free_error_info_list(error_info, persistent);
 	charset = nullptr;
 
@@ -1657,7 +1802,16 @@ bool Authenticate::init_capabilities()
 	};
 
 	caps_get.init_read(&caps_get, on_error);
-	return caps_get.read_response(&caps_get, &capabilities) == PASS;
+	if (caps_get.read_response(&caps_get, &capabilities) != PASS) return false;
+
+	if (!xmysqlnd_is_replay_enabled()) {
+		const zend_long ttl_setting{ MYSQL_XDEVAPI_G(server_info_ttl) };
+		session->server_info = Server_info_cache::get().acquire(
+			session->scheme,
+			capabilities.serialize(),
+			std::chrono::seconds(ttl_setting > 0 ? ttl_setting : 0));
+	}
+	return true;
 }
 
 void Authenticate::setup_compression()
@@ -2051,6 +2205,9 @@ xmysqlnd_session::create_db(const util::string_view& db)
 	constexpr std::string_view operation("CREATE DATABASE ");
 	DBG_ENTER("xmysqlnd_session::create_db");
 	ret = xmysqlnd_schema_operation( operation, db);
+	if ((PASS == ret) && data->schema_cache) {
+		data->schema_cache->on_schema_created(db);
+	}
 	DBG_RETURN(ret);
 }
 
@@ -2061,6 +2218,9 @@ xmysqlnd_session::drop_db(const util::string_view& db)
 	constexpr util::string_view operation("DROP DATABASE ");
 	DBG_ENTER("xmysqlnd_session::drop_db");
 	ret = xmysqlnd_schema_operation( operation, db);
+	if ((PASS == ret) && data->schema_cache) {
+		data->schema_cache->on_schema_dropped(db);
+	}
 	DBG_RETURN(ret);
 }
 
@@ -2179,9 +2339,9 @@ xmysqlnd_session::query_cb(			const std::string_view& namespace_,
 {
 	enum_func_status ret{FAIL};
 	DBG_ENTER("xmysqlnd_session::query_cb");
-	XMYSQLND_SESSION session_handle(this);
+	XMYSQLND_SESSION session_handle(shared_from_this());
 	xmysqlnd_stmt * const stmt = create_statement_object(session_handle);
-	XMYSQLND_STMT_OP__EXECUTE * stmt_execute = xmysqlnd_stmt_execute__create(namespace_, query);
+	XMYSQLND_STMT_OP__EXECUTE * stmt_execute = data->stmt_pool.acquire_stmt_execute(namespace_, query);
 	if (stmt && stmt_execute) {
 		ret = PASS;
 		if (var_binder.handler) {
@@ -2250,7 +2410,7 @@ xmysqlnd_session::query_cb(			const std::string_view& namespace_,
 		xmysqlnd_stmt_free(stmt, data->stats, data->error_info);
 	}
 	if (stmt_execute) {
-		xmysqlnd_stmt_execute__destroy(stmt_execute);
+		data->stmt_pool.release_stmt_execute(stmt_execute);
 	}
 
 	session_handle.reset();
@@ -2279,7 +2439,7 @@ xmysqlnd_session::query(const std::string_view& namespace_,
 	enum_func_status ret{FAIL};
 
 	DBG_ENTER("xmysqlnd_session::query");
-	XMYSQLND_STMT_OP__EXECUTE * stmt_execute = xmysqlnd_stmt_execute__create(namespace_, query);
+	XMYSQLND_STMT_OP__EXECUTE * stmt_execute = data->stmt_pool.acquire_stmt_execute(namespace_, query);
 	xmysqlnd_stmt * stmt = create_statement_object(shared_from_this());
 	if (stmt && stmt_execute) {
 		ret = PASS;
@@ -2324,7 +2484,7 @@ xmysqlnd_session::query(const std::string_view& namespace_,
 		xmysqlnd_stmt_free(stmt, data->stats, data->error_info);
 	}
 	if (stmt_execute) {
-		xmysqlnd_stmt_execute__destroy(stmt_execute);
+		data->stmt_pool.release_stmt_execute(stmt_execute);
 	}
 
 	DBG_INF(ret == PASS? "PASS":"FAIL");
@@ -2335,10 +2495,15 @@ zend_ulong
 xmysqlnd_session::get_server_version()
 {
 	DBG_ENTER("xmysqlnd_session::get_server_version");
+	if (server_version_string.empty() && data->server_info) {
+		if (const std::optional<std::string> version{ data->server_info->get_version() }) {
+			server_version_string = *version;
+		}
+	}
 	if (server_version_string.empty()) {
 		constexpr util::string_view query("SELECT VERSION()");
-		XMYSQLND_STMT_OP__EXECUTE * stmt_execute = xmysqlnd_stmt_execute__create(namespace_sql, query);
-		XMYSQLND_SESSION session_handle(this);
+		XMYSQLND_STMT_OP__EXECUTE * stmt_execute = data->stmt_pool.acquire_stmt_execute(namespace_sql, query);
+		XMYSQLND_SESSION session_handle(shared_from_this());
 		xmysqlnd_stmt * stmt = create_statement_object(session_handle);
 		if (stmt && stmt_execute) {
 			if (PASS == stmt->send_raw_message(stmt, xmysqlnd_stmt_execute__get_protobuf_message(stmt_execute), data->stats, data->error_info)) {
@@ -2353,6 +2518,9 @@ xmysqlnd_session::get_server_version()
 					{
 						DBG_INF_FMT("Found %*s", Z_STRLEN(set[0 * 0]), Z_STRVAL(set[0 * 0]));
 						server_version_string.assign(Z_STRVAL(set[0 * 0]), Z_STRLEN(set[0 * 0]));
+						if (data->server_info) {
+							data->server_info->set_version(server_version_string);
+						}
 					}
 					if (set) {
 						mnd_efree(set);
@@ -2366,7 +2534,7 @@ xmysqlnd_session::get_server_version()
 			xmysqlnd_stmt_free(stmt, data->stats, data->error_info);
 		}
 		if (stmt_execute) {
-			xmysqlnd_stmt_execute__destroy(stmt_execute);
+			data->stmt_pool.release_stmt_execute(stmt_execute);
 		}
 		session_handle.reset();
 	} else {
@@ -2396,6 +2564,10 @@ xmysqlnd_session::create_statement_object(XMYSQLND_SESSION session_handle)
 {
 	xmysqlnd_stmt* stmt{nullptr};
 	DBG_ENTER("xmysqlnd_session::create_statement_object");
+	stmt = data->stmt_pool.acquire_stmt(session_handle);
+	if (stmt) {
+		DBG_RETURN(stmt);
+	}
 	stmt = xmysqlnd_stmt_create(session_handle, data->object_factory, data->stats, data->error_info);
 	DBG_RETURN(stmt);
 }
@@ -2445,11 +2617,13 @@ xmysqlnd_session::close(const Session_close_reason close_type)
 
 void xmysqlnd_session::on_io_read_error()
 {
+	Server_info_cache::get().invalidate(data->scheme);
 	data->send_close(Session_close_reason::Connection_io_read_error);
 }
 
 void xmysqlnd_session::on_server_shutdown()
 {
+	Server_info_cache::get().invalidate(data->scheme);
 	data->send_close(Session_close_reason::Connection_server_shutdown);
 }
 
@@ -28,7 +28,11 @@ extern "C" {
 #include "xmysqlnd_compression.h"
 #include "xmysqlnd_driver.h"
 #include "xmysqlnd_protocol_frame_codec.h"
+#include "xmysqlnd_schema_cache.h"
+#include "xmysqlnd_server_info_cache.h"
 #include "xmysqlnd_stmt.h"
+#include "xmysqlnd_stmt_result_meta.h"
+#include "xmysqlnd_write_batch.h"
 #include "util/strings.h"
 #include "util/types.h"
 #include <array>
@@ -470,6 +474,29 @@ public:
 
 	enum_func_status  send_reset(bool keep_open);
 	enum_func_status  send_close(Session_close_reason reason);
+
+	/*
+		transaction control without statement nor result objects - START TRANSACTION
+		is deferred till the next statement, and goes out with it, on failure see
+		get_error_no()
+	*/
+	enum_func_status  start_transaction();
+	enum_func_status  commit();
+	enum_func_status  rollback();
+	// SAVEPOINT, ROLLBACK TO, RELEASE SAVEPOINT and alike
+	enum_func_status  execute_trx_control(const util::string_view& query);
+	/*
+		drops a pending deferred START TRANSACTION, but commits what the begin would
+		have committed implicitly - a transaction opened earlier is not to be lost
+	*/
+	enum_func_status  settle_deferred_trx_begin();
+	/*
+		writes executed while a batch is active go out together, and their results
+		are read on end_write_batch, see Write_batch - returns the number of the
+		writes which failed
+	*/
+	void              begin_write_batch();
+	std::size_t       end_write_batch();
 	bool is_closed() const { return state.is_closed(); }
 	size_t            negotiate_client_api_capabilities(const size_t flags);
 
@@ -506,6 +533,8 @@ public:
 		more details: WL#12375 WL#12396
 	*/
 	mutable std::optional<bool>      session_properly_supported;
+	/* shared by the sessions connected to the same server, nullptr until the handshake */
+	std::shared_ptr<Server_info>       server_info;
 	/* stats */
 	MYSQLND_STATS*                     stats;
 	zend_bool		                   own_stats;
@@ -515,6 +544,11 @@ public:
 	unsigned int                       savepoint_name_seed;
 	vec_of_attribs                     connection_attribs;
 	drv::Prepare_stmt_data             ps_data;
+	Result_meta_cache                  result_meta_cache;
+	drv::Stmt_pool                     stmt_pool;
+	drv::Write_batch                   write_batch;
+	/* shared by the sessions of a client, if it has enabled the metadata cache */
+	std::shared_ptr<Schema_cache>      schema_cache;
 	util::zvalue                       capabilities;
 private:
 	void free_contents();
@@ -58,7 +58,20 @@ xmysqlnd_stmt::send_raw_message(xmysqlnd_stmt * const stmt,
 	DBG_ENTER("xmysqlnd_stmt::send_raw_message");
 
 	stmt->partial_read_started = FALSE;
-	stmt->get_msg_stmt_exec() = msg_factory.get__collection_read(&msg_factory);
+	{
+		/* a reused statement keeps the capacity of its reader buffers */
+		st_xmysqlnd_result_set_reader_ctx& reader_ctx{ stmt->get_msg_stmt_exec().reader_ctx };
+		util::vector<st_xmysqlnd_row_field_decode_step> decode_plan;
+		util::string meta_frames;
+		decode_plan.swap(reader_ctx.decode_plan);
+		meta_frames.swap(reader_ctx.meta_frames);
+		decode_plan.clear();
+		meta_frames.clear();
+
+		stmt->get_msg_stmt_exec() = msg_factory.get__collection_read(&msg_factory);
+		reader_ctx.decode_plan.swap(decode_plan);
+		reader_ctx.meta_frames.swap(meta_frames);
+	}
 
 	ret = stmt->get_msg_stmt_exec().send_execute_request(&stmt->get_msg_stmt_exec(), message_shell);
 
@@ -67,12 +80,22 @@ xmysqlnd_stmt::send_raw_message(xmysqlnd_stmt * const stmt,
 	DBG_RETURN(PASS);
 }
 
+/*
+  Objects of the result being read come from its arena. Without a result, e.g.
+  when the caller only gets callbacks, they are allocated and freed one by one.
+*/
+static util::Arena* get_result_arena(const st_xmysqlnd_stmt_bind_ctx* const ctx)
+{
+	return ctx->result ? &ctx->result->arena : nullptr;
+}
+
 static XMYSQLND_ROWSET * create_rowset_fwd(void * context)
 {
 	const st_xmysqlnd_stmt_bind_ctx* const ctx = (const st_xmysqlnd_stmt_bind_ctx* ) context;
 	XMYSQLND_ROWSET * result;
 	DBG_ENTER("xmysqlnd_stmt::create_rowset_fwd");
-	result = xmysqlnd_rowset_create(XMYSQLND_TYPE_ROWSET_FWD_ONLY,
+	result = xmysqlnd_rowset_create(get_result_arena(ctx),
+									XMYSQLND_TYPE_ROWSET_FWD_ONLY,
 									ctx->fwd_prefetch_count,
 									ctx->stmt,
 									ctx->stmt->get_persistent(),
@@ -87,7 +110,7 @@ static XMYSQLND_ROWSET * create_rowset_buffered(void * context)
 	const st_xmysqlnd_stmt_bind_ctx* const ctx = (const st_xmysqlnd_stmt_bind_ctx* ) context;
 	XMYSQLND_ROWSET * result;
 	DBG_ENTER("xmysqlnd_stmt::create_rowset_buffered");
-	result = xmysqlnd_rowset_create(XMYSQLND_TYPE_ROWSET_BUFFERED, (size_t)~0, ctx->stmt, ctx->stmt->get_persistent(), ctx->stmt->object_factory, ctx->stats, ctx->error_info);
+	result = xmysqlnd_rowset_create(get_result_arena(ctx), XMYSQLND_TYPE_ROWSET_BUFFERED, (size_t)~0, ctx->stmt, ctx->stmt->get_persistent(), ctx->stmt->object_factory, ctx->stats, ctx->error_info);
 	DBG_RETURN(result);
 }
 
@@ -103,48 +126,78 @@ XMYSQLND_METHOD(xmysqlnd_stmt, create_meta)(void * context)
 
 static XMYSQLND_RESULT_FIELD_META * create_meta_field(void * context)
 {
-	const st_xmysqlnd_stmt_bind_ctx* const ctx = (const st_xmysqlnd_stmt_bind_ctx* ) context;
-	XMYSQLND_RESULT_FIELD_META * field;
+	st_xmysqlnd_stmt_bind_ctx* const ctx = (st_xmysqlnd_stmt_bind_ctx* ) context;
+	XMYSQLND_RESULT_FIELD_META * field{nullptr};
 	DBG_ENTER("xmysqlnd_stmt::create_meta_field");
-	field = xmysqlnd_result_field_meta_create(ctx->stmt->get_persistent(), ctx->stmt->object_factory, ctx->stats, ctx->error_info);
+	/* fields are allocated in the arena of their meta */
+	if (!ctx->meta) {
+		ctx->meta = xmysqlnd_stmt_result_meta_create(ctx->stmt->get_persistent(), ctx->stmt->object_factory, ctx->stats, ctx->error_info);
+	}
+	if (ctx->meta) {
+		field = xmysqlnd_result_field_meta_create(ctx->meta, ctx->stmt->get_persistent(), ctx->stmt->object_factory, ctx->stats, ctx->error_info);
+	}
 	DBG_RETURN(field);
 }
 
-static const enum_hnd_func_status handler_on_row_field(void * context,
-														  const util::string_view& buffer,
-														  const unsigned int idx,
-														  const func_xmysqlnd_wireprotocol__row_field_decoder decoder)
+static const XMYSQLND_STMT_RESULT_META * lookup_meta(void * context, const util::string_view& frames)
+{
+	st_xmysqlnd_stmt_bind_ctx* const ctx = (st_xmysqlnd_stmt_bind_ctx*) context;
+	DBG_ENTER("xmysqlnd_stmt::lookup_meta");
+	if (ctx->meta) {
+		DBG_RETURN(nullptr);
+	}
+	XMYSQLND_STMT_RESULT_META* meta = ctx->stmt->get_session()->get_data()->result_meta_cache.find(frames);
+	if (meta) {
+		ctx->meta = xmysqlnd_stmt_result_meta_get_reference(meta);
+	}
+	DBG_INF_FMT("meta=%p", ctx->meta);
+	DBG_RETURN(ctx->meta);
+}
+
+static void store_meta(void * context, const util::string_view& frames)
+{
+	const st_xmysqlnd_stmt_bind_ctx* const ctx = (const st_xmysqlnd_stmt_bind_ctx* ) context;
+	DBG_ENTER("xmysqlnd_stmt::store_meta");
+	DBG_INF_FMT("meta=%p", ctx->meta);
+	if (ctx->meta) {
+		ctx->stmt->get_session()->get_data()->result_meta_cache.add(frames, ctx->meta);
+	}
+	DBG_VOID_RETURN;
+}
+
+static zval * create_row(void * context)
 {
 	st_xmysqlnd_stmt_bind_ctx* const ctx = (st_xmysqlnd_stmt_bind_ctx*) context;
-	enum_hnd_func_status ret{HND_AGAIN};
 
-	DBG_ENTER("xmysqlnd_stmt::handler_on_row_field");
-	DBG_INF_FMT("rowset=%p  meta=%p  on_row.handler=%p", ctx->rowset, ctx->meta, ctx->on_row.handler);
+	DBG_ENTER("xmysqlnd_stmt::create_row");
+	DBG_INF_FMT("rowset=%p  meta=%p", ctx->rowset, ctx->meta);
 	if (!ctx->rowset && ctx->meta) {
 		ctx->rowset = ctx->create_rowset(ctx);
 		if (ctx->rowset) {
 			ctx->rowset->m.attach_meta(ctx->rowset, ctx->meta, ctx->stats, ctx->error_info);
 		}
 	}
-	if (ctx->rowset) {
-		if (idx == 0) {
-			ctx->current_row = ctx->rowset->m.create_row(ctx->rowset, ctx->meta, ctx->stats, ctx->error_info);
-		}
-		decoder(buffer, ctx->meta->m->get_field(ctx->meta, idx), idx, &ctx->current_row[idx]);
+	ctx->current_row = ctx->rowset? ctx->rowset->m.create_row(ctx->rowset, ctx->meta, ctx->stats, ctx->error_info) : nullptr;
+	DBG_RETURN(ctx->current_row);
+}
 
-		if ((idx + 1) == ctx->meta->m->get_field_count(ctx->meta)) {
-			if (ctx->on_row.handler) {
-				ret = ctx->on_row.handler(ctx->on_row.ctx, ctx->stmt, ctx->meta, ctx->current_row, ctx->stats, ctx->error_info);
-				ret = HND_AGAIN; /* for now we don't allow fetching to be suspended and continued later */
+static const enum_hnd_func_status handler_on_row(void * context, zval * row)
+{
+	st_xmysqlnd_stmt_bind_ctx* const ctx = (st_xmysqlnd_stmt_bind_ctx*) context;
+	enum_hnd_func_status ret{HND_AGAIN};
 
-				ctx->rowset->m.destroy_row(ctx->rowset, ctx->current_row, ctx->stats, ctx->error_info);
-			} else {
-				DBG_INF_FMT("fwd_prefetch_count=" MYSQLX_LLU_SPEC " prefetch_counter=" MYSQLX_LLU_SPEC, ctx->fwd_prefetch_count, ctx->prefetch_counter);
-				ctx->rowset->m.add_row(ctx->rowset, ctx->current_row, ctx->stats, ctx->error_info);
-				if (ctx->fwd_prefetch_count && !--ctx->prefetch_counter) {
-					ret = HND_PASS; /* Otherwise it is HND_AGAIN */
-				}
-			}
+	DBG_ENTER("xmysqlnd_stmt::handler_on_row");
+	DBG_INF_FMT("rowset=%p  on_row.handler=%p", ctx->rowset, ctx->on_row.handler);
+	if (ctx->on_row.handler) {
+		ret = ctx->on_row.handler(ctx->on_row.ctx, ctx->stmt, ctx->meta, row, ctx->stats, ctx->error_info);
+		ret = HND_AGAIN; /* for now we don't allow fetching to be suspended and continued later */
+
+		ctx->rowset->m.destroy_row(ctx->rowset, row, ctx->stats, ctx->error_info);
+	} else {
+		DBG_INF_FMT("fwd_prefetch_count=" MYSQLX_LLU_SPEC " prefetch_counter=" MYSQLX_LLU_SPEC, ctx->fwd_prefetch_count, ctx->prefetch_counter);
+		ctx->rowset->m.add_row(ctx->rowset, row, ctx->stats, ctx->error_info);
+		if (ctx->fwd_prefetch_count && !--ctx->prefetch_counter) {
+			ret = HND_PASS; /* Otherwise it is HND_AGAIN */
 		}
 	}
 
@@ -210,7 +263,7 @@ handler_on_exec_state_change(void * context, const enum xmysqlnd_execution_state
 
 	DBG_ENTER("xmysqlnd_stmt::handler_on_exec_state_change");
 	if (!ctx->exec_state) {
-		ctx->exec_state = xmysqlnd_stmt_execution_state_create(ctx->stmt->get_persistent(), ctx->stmt->object_factory, ctx->stats, ctx->error_info);
+		ctx->exec_state = xmysqlnd_stmt_execution_state_create(get_result_arena(ctx), ctx->stmt->get_persistent(), ctx->stmt->object_factory, ctx->stats, ctx->error_info);
 	}
 	if (ctx->exec_state) {
 		switch (type) {
@@ -315,7 +368,8 @@ xmysqlnd_stmt::read_one_result(xmysqlnd_stmt * const stmt,
 		on_statement_ok,
 	};
 	const st_xmysqlnd_meta_field_create_bind create_meta_field_bind = { create_meta_field, &create_ctx };
-	const st_xmysqlnd_on_row_field_bind handler_on_row_field_msg = { on_row.handler? handler_on_row_field : nullptr, &create_ctx };
+	const st_xmysqlnd_meta_cache_bind meta_cache_bind = { lookup_meta, store_meta, &create_ctx };
+	const st_xmysqlnd_on_row_bind handler_on_row_msg = { create_row, on_row.handler? handler_on_row : nullptr, &create_ctx };
 	const st_xmysqlnd_on_meta_field_bind handler_on_meta_field_msg = { handler_on_meta_field, &create_ctx };
 	const st_xmysqlnd_on_warning_bind handler_on_warning_msg = { on_warning.handler? handler_on_warning : nullptr, &create_ctx };
 	const st_xmysqlnd_on_error_bind handler_on_error_msg = { on_error.handler? handler_on_error : nullptr , on_error.handler? &create_ctx : nullptr };
@@ -340,7 +394,8 @@ xmysqlnd_stmt::read_one_result(xmysqlnd_stmt * const stmt,
 	*/
 	if (FAIL == stmt->get_msg_stmt_exec().init_read(&stmt->get_msg_stmt_exec(),
 													create_meta_field_bind,
-													handler_on_row_field_msg,
+													meta_cache_bind,
+													handler_on_row_msg,
 													handler_on_meta_field_msg,
 													handler_on_warning_msg,
 													handler_on_error_msg,
@@ -452,8 +507,10 @@ xmysqlnd_stmt::get_buffered_result(xmysqlnd_stmt * const stmt,
 
 	const st_xmysqlnd_meta_field_create_bind create_meta_field_bind = {
 		create_meta_field, &create_ctx };
-	const st_xmysqlnd_on_row_field_bind on_row_field = {
-		handler_on_row_field, &create_ctx };
+	const st_xmysqlnd_meta_cache_bind meta_cache_bind = {
+		lookup_meta, store_meta, &create_ctx };
+	const st_xmysqlnd_on_row_bind on_row = {
+		create_row, handler_on_row, &create_ctx };
 	const st_xmysqlnd_on_meta_field_bind on_meta_field = {
 		handler_on_meta_field, &create_ctx };
 	const st_xmysqlnd_on_warning_bind on_warning = {
@@ -471,14 +528,22 @@ xmysqlnd_stmt::get_buffered_result(xmysqlnd_stmt * const stmt,
 	const st_xmysqlnd_on_resultset_end_bind on_resultset_end = { nullptr, nullptr };
 	DBG_ENTER("xmysqlnd_stmt::get_buffered_result");
 
+	/* created upfront, the rowset and the exec state are allocated in its arena */
+	result = xmysqlnd_stmt_result_create(stmt->get_persistent(), stmt->object_factory, stats, error_info);
+	if (!result) {
+		DBG_RETURN(nullptr);
+	}
+	create_ctx.result = result;
+
 	/*
 	  Maybe we can inject a callbacks that creates `meta` on demand, but we still DI it.
 	  This way we don't pre-create `meta` and in case of UPSERT we don't waste cycles.
 	  For now, we just pre-create.
 	*/
-	if (FAIL == stmt->get_msg_stmt_exec().init_read(&stmt->get_msg_stmt_exec(),
+	enum_func_status ret = stmt->get_msg_stmt_exec().init_read(&stmt->get_msg_stmt_exec(),
 													create_meta_field_bind,
-													on_row_field,
+													meta_cache_bind,
+													on_row,
 													on_meta_field,
 													on_warning,
 													on_error,
@@ -487,41 +552,23 @@ xmysqlnd_stmt::get_buffered_result(xmysqlnd_stmt * const stmt,
 													on_session_var_change,
 													on_trx_state_change,
 													on_stmt_execute_ok,
-													on_resultset_end)) {
-		DBG_RETURN(nullptr);
-	}
-
-	if (FAIL == stmt->get_msg_stmt_exec().read_response(&stmt->get_msg_stmt_exec(), nullptr)) {
-		DBG_RETURN(nullptr);
+													on_resultset_end);
+	if (PASS == ret) {
+		ret = stmt->get_msg_stmt_exec().read_response(&stmt->get_msg_stmt_exec(), nullptr);
 	}
 	*has_more_results = stmt->get_msg_stmt_exec().reader_ctx.has_more_results;
 	DBG_INF_FMT("rowset     =%p  has_more=%s", create_ctx.rowset, *has_more_results? "TRUE":"FALSE");
 	DBG_INF_FMT("exec_state =%p", create_ctx.exec_state);
 	DBG_INF_FMT("warnings   =%p", create_ctx.warnings);
 
-	result = xmysqlnd_stmt_result_create(stmt->get_persistent(), stmt->object_factory, stats, error_info);
-	if (result) {
-		result->m.attach_rowset(result, create_ctx.rowset, stats, error_info);
-		result->m.attach_meta(result, create_ctx.meta, stats, error_info);
-		result->m.attach_execution_state(result, create_ctx.exec_state);
-		result->m.attach_warning_list(result, create_ctx.warnings);
-	} else {
-		if (create_ctx.rowset) {
-			xmysqlnd_rowset_free(create_ctx.rowset, stats, error_info);
-			create_ctx.rowset = nullptr;
-		}
-		if (create_ctx.meta) {
-			xmysqlnd_stmt_result_meta_free(create_ctx.meta, stats, error_info);
-			create_ctx.meta = nullptr;
-		}
-		if (create_ctx.exec_state) {
-			xmysqlnd_stmt_execution_state_free(create_ctx.exec_state);
-			create_ctx.exec_state = nullptr;
-		}
-		if (create_ctx.warnings) {
-			xmysqlnd_warning_list_free(create_ctx.warnings);
-			create_ctx.warnings = nullptr;
-		}
+	/* also on failure, so whatever was read goes away with the result */
+	result->m.attach_rowset(result, create_ctx.rowset, stats, error_info);
+	result->m.attach_meta(result, create_ctx.meta, stats, error_info);
+	result->m.attach_execution_state(result, create_ctx.exec_state);
+	result->m.attach_warning_list(result, create_ctx.warnings);
+	if (FAIL == ret) {
+		xmysqlnd_stmt_result_free(result, stats, error_info);
+		result = nullptr;
 	}
 	DBG_RETURN(result);
 }
@@ -538,7 +585,8 @@ xmysqlnd_stmt::get_fwd_result(xmysqlnd_stmt * const stmt,
 {
 	XMYSQLND_STMT_RESULT* result{nullptr};
 	const st_xmysqlnd_meta_field_create_bind create_meta_field_bind = { create_meta_field, &read_ctx };
-	const st_xmysqlnd_on_row_field_bind on_row_field = { handler_on_row_field, &read_ctx };
+	const st_xmysqlnd_meta_cache_bind meta_cache_bind = { lookup_meta, store_meta, &read_ctx };
+	const st_xmysqlnd_on_row_bind on_row = { create_row, handler_on_row, &read_ctx };
 	const st_xmysqlnd_on_meta_field_bind on_meta_field = { handler_on_meta_field, &read_ctx };
 	const st_xmysqlnd_on_warning_bind on_warning = { handler_on_warning_bind.handler? handler_on_warning : nullptr, &read_ctx };
 	const st_xmysqlnd_on_error_bind on_error = { (handler_on_error_bind.handler || error_info) ? handler_on_error : nullptr, &read_ctx };
@@ -561,19 +609,21 @@ xmysqlnd_stmt::get_fwd_result(xmysqlnd_stmt * const stmt,
 		read_ctx.meta = nullptr;
 		read_ctx.result = xmysqlnd_stmt_result_create(stmt->get_persistent(), stmt->object_factory, stats, error_info);
 		read_ctx.warnings = xmysqlnd_warning_list_create(stmt->get_persistent(), stmt->object_factory, stats, error_info);
-		read_ctx.exec_state = xmysqlnd_stmt_execution_state_create(stmt->get_persistent(), stmt->object_factory, stats, error_info);
+		read_ctx.exec_state = nullptr;
 		read_ctx.on_warning = handler_on_warning_bind;
 		read_ctx.on_error = handler_on_error_bind;
 
 		if ((result = read_ctx.result) == nullptr) {
 			DBG_RETURN(nullptr);
 		}
+		read_ctx.exec_state = xmysqlnd_stmt_execution_state_create(&result->arena, stmt->get_persistent(), stmt->object_factory, stats, error_info);
 		result->m.attach_execution_state(result, read_ctx.exec_state);
 		result->m.attach_warning_list(result, read_ctx.warnings);
 
 		if (FAIL == stmt->get_msg_stmt_exec().init_read(&stmt->get_msg_stmt_exec(),
 														create_meta_field_bind,
-														on_row_field,
+														meta_cache_bind,
+														on_row,
 														on_meta_field,
 														on_warning,
 														on_error,
@@ -623,7 +673,8 @@ xmysqlnd_stmt::skip_one_result(xmysqlnd_stmt * const stmt, zend_bool * const has
 {
 	st_xmysqlnd_stmt_bind_ctx create_ctx = { stmt, stats, error_info };
 	const st_xmysqlnd_meta_field_create_bind create_meta_field = { nullptr, nullptr };
-	const st_xmysqlnd_on_row_field_bind on_row_field = { nullptr, nullptr };
+	const st_xmysqlnd_meta_cache_bind meta_cache = { nullptr, nullptr, nullptr };
+	const st_xmysqlnd_on_row_bind on_row = { nullptr, nullptr, nullptr };
 	const st_xmysqlnd_on_meta_field_bind on_meta_field = { nullptr, nullptr };
 	const st_xmysqlnd_on_warning_bind on_warning = { nullptr, nullptr };
 	const st_xmysqlnd_on_error_bind on_error = { nullptr, nullptr };
@@ -637,7 +688,8 @@ xmysqlnd_stmt::skip_one_result(xmysqlnd_stmt * const stmt, zend_bool * const has
 	DBG_ENTER("xmysqlnd_stmt::skip_one_result");
 	if (FAIL == stmt->get_msg_stmt_exec().init_read(&stmt->get_msg_stmt_exec(),
 													create_meta_field,
-													on_row_field,
+													meta_cache,
+													on_row,
 													on_meta_field,
 													on_warning,
 													on_error,
@@ -694,6 +746,15 @@ xmysqlnd_stmt::free_reference(xmysqlnd_stmt * const stmt)
 	DBG_INF_FMT("old_refcount=%u", refcount);
 	if (!(--refcount)) {
 		cleanup(stmt);
+		/*
+		  the pool doesn't keep the session, otherwise the two would never be freed, and
+		  a session going away with this very reference doesn't get it at all
+		*/
+		XMYSQLND_SESSION owner;
+		owner.swap(session);
+		if (!owner || (owner.use_count() == 1) || !owner->get_data()->stmt_pool.release_stmt(stmt)) {
+			delete stmt;
+		}
 	}
 	DBG_RETURN(ret);
 }
@@ -713,6 +774,16 @@ xmysqlnd_stmt::cleanup(xmysqlnd_stmt * const stmt)
 	DBG_VOID_RETURN;
 }
 
+void
+xmysqlnd_stmt::reuse(XMYSQLND_SESSION cur_session)
+{
+	DBG_ENTER("xmysqlnd_stmt::reuse");
+	session = cur_session;
+	partial_read_started = FALSE;
+	read_ctx = st_xmysqlnd_stmt_bind_ctx{};
+	DBG_VOID_RETURN;
+}
+
 xmysqlnd_stmt *
 xmysqlnd_stmt_create(XMYSQLND_SESSION session,
 						  const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const object_factory,
@@ -738,6 +809,70 @@ xmysqlnd_stmt_free(xmysqlnd_stmt* const stmt, MYSQLND_STATS* stats, MYSQLND_ERRO
 	DBG_VOID_RETURN;
 }
 
+Stmt_pool::~Stmt_pool()
+{
+	clear();
+}
+
+xmysqlnd_stmt*
+Stmt_pool::acquire_stmt(XMYSQLND_SESSION session)
+{
+	DBG_ENTER("Stmt_pool::acquire_stmt");
+	if (stmts.empty()) {
+		DBG_RETURN(nullptr);
+	}
+	xmysqlnd_stmt* stmt{ stmts.back() };
+	stmts.pop_back();
+	stmt->reuse(session);
+	DBG_RETURN(stmt->get_reference(stmt));
+}
+
+bool
+Stmt_pool::release_stmt(xmysqlnd_stmt* stmt)
+{
+	if (stmts.size() == max_size) {
+		return false;
+	}
+	stmts.push_back(stmt);
+	return true;
+}
+
+XMYSQLND_STMT_OP__EXECUTE*
+Stmt_pool::acquire_stmt_execute(const std::string_view& namespace_, const util::string_view& query)
+{
+	DBG_ENTER("Stmt_pool::acquire_stmt_execute");
+	if (stmt_executes.empty()) {
+		DBG_RETURN(xmysqlnd_stmt_execute__create(namespace_, query));
+	}
+	XMYSQLND_STMT_OP__EXECUTE* stmt_execute{ stmt_executes.back() };
+	stmt_executes.pop_back();
+	stmt_execute->reset(namespace_, query);
+	DBG_RETURN(stmt_execute);
+}
+
+void
+Stmt_pool::release_stmt_execute(XMYSQLND_STMT_OP__EXECUTE* stmt_execute)
+{
+	if (stmt_executes.size() == max_size) {
+		xmysqlnd_stmt_execute__destroy(stmt_execute);
+	} else {
+		stmt_executes.push_back(stmt_execute);
+	}
+}
+
+void
+Stmt_pool::clear()
+{
+	for (xmysqlnd_stmt* stmt : stmts) {
+		delete stmt;
+	}
+	stmts.clear();
+	for (XMYSQLND_STMT_OP__EXECUTE* stmt_execute : stmt_executes) {
+		xmysqlnd_stmt_execute__destroy(stmt_execute);
+	}
+	stmt_executes.clear();
+}
+
 Prepare_stmt_data::Prepare_stmt_data() :
 	next_ps_id{ DEFAULT_PS_ID },
     ps_supported{ true }
@@ -830,19 +965,15 @@ bool
 Prepare_stmt_data::send_prepare_msg( uint32_t message_id )
 {
 	st_xmysqlnd_message_factory msg_factory{ session->data->create_message_factory() };
-	Mysqlx::Prepare::Prepare prep_msg;
 	size_t                   db_idx = get_ps_entry(message_id);
 	bool                     res{ true };
 	if( db_idx < ps_db.size() ) {
         ps_deliver_message_code = 0;
-		prep_msg = ps_db[ db_idx ].prepare_msg;
 		st_xmysqlnd_msg__prepare_prepare prepare_prepare = msg_factory.get__prepare_prepare(&msg_factory);
 		enum_func_status request_ret = prepare_prepare.send_prepare_request(&prepare_prepare,
-											get_protobuf_msg(&prep_msg, COM_PREPARE_PREPARE));
+											get_protobuf_msg(&ps_db[ db_idx ].prepare_msg, COM_PREPARE_PREPARE));
 		if( PASS == request_ret ) {
-			drv::xmysqlnd_stmt * stmt = session->create_statement_object(session);
-			stmt->get_msg_stmt_exec() = msg_factory.get__sql_stmt_execute(&msg_factory);
-			if( get_prepare_resp( stmt ) ) {
+			if( get_prepare_resp() ) {
 				ps_db[ db_idx ].delivered_ps = true;
                 if( ps_deliver_message_code != 0 ) {
                     ps_db.erase( ps_db.begin() + db_idx );
@@ -865,7 +996,7 @@ Prepare_stmt_data::set_ps_server_error( const uint32_t message_code )
 }
 
 bool
-Prepare_stmt_data::get_prepare_resp( drv::xmysqlnd_stmt * stmt )
+Prepare_stmt_data::get_prepare_resp()
 {
 	st_xmysqlnd_message_factory msg_factory{ session->data->create_message_factory() };
 	st_xmysqlnd_msg__prepare_prepare prepare_prepare = msg_factory.get__prepare_prepare(&msg_factory);
@@ -883,17 +1014,11 @@ void Prepare_stmt_data::add_limit_expr_mutable_arg(
 			const int32_t value
 )
 {
-	Mysqlx::Datatypes::Scalar * scalar;
-	Mysqlx::Datatypes::Any * any;
-
-	scalar = new Mysqlx::Datatypes::Scalar;
-	any = new Mysqlx::Datatypes::Any;
-
+	Mysqlx::Datatypes::Any* any{ execute_msg.add_args() };
 	any->set_type( Mysqlx::Datatypes::Any_Type::Any_Type_SCALAR );
+	Mysqlx::Datatypes::Scalar* scalar{ any->mutable_scalar() };
 	scalar->set_type( Mysqlx::Datatypes::Scalar_Type::Scalar_Type_V_SINT );
 	scalar->set_v_signed_int( value );
-	any->set_allocated_scalar(scalar);
-	execute_msg.mutable_args()->AddAllocated(any);
 }
 
 xmysqlnd_stmt *
@@ -906,7 +1031,8 @@ Prepare_stmt_data::send_execute_msg(
 		return nullptr;
 	}
 	xmysqlnd_stmt * stmt{ nullptr };
-	Mysqlx::Prepare::Execute execute_msg;
+	/* Clear() keeps the args allocated by the previous execution for reuse */
+	execute_msg.Clear();
 	execute_msg.set_stmt_id( message_id );
 	auto& ps_entry = ps_db[ db_idx ];
 
@@ -914,16 +1040,12 @@ Prepare_stmt_data::send_execute_msg(
 	const std::vector<Mysqlx::Datatypes::Scalar*>::iterator begin = ps_entry.bound_values.begin();
 	const std::vector<Mysqlx::Datatypes::Scalar*>::iterator end = ps_entry.bound_values.end();
 	const std::vector<Mysqlx::Datatypes::Scalar*>::const_iterator index = std::find(begin, end, null_value);
-	execute_msg.clear_args();
 	if (index == end) {
 		std::vector<Mysqlx::Datatypes::Scalar*>::iterator it = begin;
 		for (; it != end; ++it) {
-            Mysqlx::Datatypes::Any*  any = new Mysqlx::Datatypes::Any;
-            Mysqlx::Datatypes::Scalar* scalar = new Mysqlx::Datatypes::Scalar;
-			scalar->CopyFrom(**it);
-            any->set_type( Mysqlx::Datatypes::Any_Type::Any_Type_SCALAR );
-            any->set_allocated_scalar( scalar );
-            execute_msg.mutable_args()->AddAllocated(any);
+			Mysqlx::Datatypes::Any* any{ execute_msg.add_args() };
+			any->set_type( Mysqlx::Datatypes::Any_Type::Any_Type_SCALAR );
+			any->mutable_scalar()->CopyFrom(**it);
 		}
 	}
 
@@ -159,6 +159,8 @@ public:
 	enum_func_status				free_reference(xmysqlnd_stmt * const stmt);
 	void							free_contents(xmysqlnd_stmt * const stmt);
 	void							cleanup(xmysqlnd_stmt * const stmt);
+	// binds a statement taken from the pool of a session for another execution
+	void							reuse(XMYSQLND_SESSION cur_session);
 	XMYSQLND_SESSION				get_session() {
 		return session;
 	}
@@ -190,6 +192,38 @@ xmysqlnd_stmt * xmysqlnd_stmt_create(XMYSQLND_SESSION session,
 
 void xmysqlnd_stmt_free(xmysqlnd_stmt* const result, MYSQLND_STATS* stats, MYSQLND_ERROR_INFO* error_info);
 
+/*
+  Per-session free lists of statement objects and SQL execute ops. A statement whose
+  last reference is gone comes back here instead of being destroyed, keeping the
+  buffers of its reader (decode plan, metadata frames), and an execute op keeps its
+  protobuf message, which is Clear()-ed rather than rebuilt. Steady-state queries
+  then allocate neither of them.
+*/
+class Stmt_pool
+{
+public:
+	Stmt_pool() = default;
+	Stmt_pool(const Stmt_pool&) = delete;
+	Stmt_pool& operator=(const Stmt_pool&) = delete;
+	~Stmt_pool();
+
+	// nullptr if the pool is empty, otherwise a statement of the session with one reference
+	xmysqlnd_stmt* acquire_stmt(XMYSQLND_SESSION session);
+	// false if the pool is full, then the caller destroys the statement
+	bool release_stmt(xmysqlnd_stmt* stmt);
+
+	XMYSQLND_STMT_OP__EXECUTE* acquire_stmt_execute(const std::string_view& namespace_, const util::string_view& query);
+	void release_stmt_execute(XMYSQLND_STMT_OP__EXECUTE* stmt_execute);
+
+	void clear();
+
+private:
+	static constexpr std::size_t max_size{4};
+
+	util::vector<xmysqlnd_stmt*> stmts;
+	util::vector<XMYSQLND_STMT_OP__EXECUTE*> stmt_executes;
+};
+
 struct Prepare_statement_entry
 {
 	std::string                             type_name;
@@ -247,7 +281,7 @@ private:
 	Prepare_statement_entry      prepare_ps_entry( const MSG_T& msg);
 	size_t                       get_ps_entry( const google::protobuf::Message& msg );
 	size_t                       get_ps_entry( const uint32_t msg_id );
-	bool                         get_prepare_resp( drv::xmysqlnd_stmt * stmt );
+	bool                         get_prepare_resp();
 	template< typename MSG_T >
 	void                         handle_limit_expr( Prepare_statement_entry& prepare, MSG_T* msg,uint32_t bound_values_count );
 	template< typename MSG_T >
@@ -259,6 +293,7 @@ private:
 	XMYSQLND_SESSION                  session;
     uint32_t                          ps_deliver_message_code;
 	std::vector< Prepare_statement_entry > ps_db;
+	Mysqlx::Prepare::Execute          execute_msg;
 	template< typename T >
 	void set_allocated_type( Mysqlx::Prepare::Prepare_OneOfMessage* one_msg, T msg );
 };
@@ -387,8 +422,10 @@ std::pair<bool,uint32_t> Prepare_stmt_data::add_message(
 	if( db_idx > ps_db.size() ) {
 		new_entry.prepare_msg.set_stmt_id( next_ps_id++ );
 		ps_db.push_back( new_entry );
+		xmysqlnd_perf_inc( XMYSQLND_PERF_PS_CACHE_MISSES );
 		return { true, new_entry.msg_id };
 	} else {
+		xmysqlnd_perf_inc( XMYSQLND_PERF_PS_CACHE_HITS );
 		ps_db[ db_idx ].row_count = new_entry.row_count;
 		ps_db[ db_idx ].offset = new_entry.offset;
 	}
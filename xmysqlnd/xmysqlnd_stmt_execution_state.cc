@@ -135,7 +135,9 @@ XMYSQLND_METHOD(xmysqlnd_stmt_execution_state, dtor)(XMYSQLND_STMT_EXECUTION_STA
 	DBG_ENTER("xmysqlnd_stmt_execution_state::dtor");
 	if (state) {
 		state->m->free_contents(state);
-		mnd_efree(state);
+		if (!state->arena) {
+			mnd_efree(state);
+		}
 	}
 	DBG_VOID_RETURN;
 }
@@ -163,14 +165,15 @@ MYSQLND_CLASS_METHODS_END;
 PHP_MYSQL_XDEVAPI_API MYSQLND_CLASS_METHODS_INSTANCE_DEFINE(xmysqlnd_stmt_execution_state);
 
 PHP_MYSQL_XDEVAPI_API XMYSQLND_STMT_EXECUTION_STATE *
-xmysqlnd_stmt_execution_state_create(const zend_bool persistent,
+xmysqlnd_stmt_execution_state_create(util::Arena* const arena,
+									 const zend_bool persistent,
 									 const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const object_factory,
 									 MYSQLND_STATS * stats,
 									 MYSQLND_ERROR_INFO * error_info)
 {
 	XMYSQLND_STMT_EXECUTION_STATE* result{nullptr};
 	DBG_ENTER("xmysqlnd_stmt_execution_state_create");
-	result = object_factory->get_stmt_execution_state(object_factory, persistent, stats, error_info);
+	result = object_factory->get_stmt_execution_state(object_factory, arena, persistent, stats, error_info);
 	DBG_RETURN(result);
 }
 
@@ -20,6 +20,7 @@
 
 #include "xmysqlnd_driver.h"
 #include "util/allocator.h"
+#include "util/arena.h"
 #include "util/types.h"
 #include "util/strings.h"
 
@@ -74,12 +75,14 @@ struct st_xmysqlnd_stmt_execution_state : public util::custom_allocable
 	uint64_t last_insert_id;
 	util::vector< util::string> generated_doc_ids;
 
+	/* set when allocated in the arena of the result, see free_contents for the ids */
+	util::Arena* arena;
 	const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_stmt_execution_state) * m;
 	zend_bool persistent;
 };
 
 PHP_MYSQL_XDEVAPI_API MYSQLND_CLASS_METHODS_INSTANCE_DECLARE(xmysqlnd_stmt_execution_state);
-PHP_MYSQL_XDEVAPI_API XMYSQLND_STMT_EXECUTION_STATE * xmysqlnd_stmt_execution_state_create(const zend_bool persistent, const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const object_factory, MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
+PHP_MYSQL_XDEVAPI_API XMYSQLND_STMT_EXECUTION_STATE * xmysqlnd_stmt_execution_state_create(util::Arena* const arena, const zend_bool persistent, const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const object_factory, MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
 PHP_MYSQL_XDEVAPI_API void xmysqlnd_stmt_execution_state_free(XMYSQLND_STMT_EXECUTION_STATE * const state);
 
 } // namespace drv
@@ -116,6 +116,66 @@ XMYSQLND_METHOD(xmysqlnd_stmt_result, fetch_all_c)(XMYSQLND_STMT_RESULT * const
 	DBG_RETURN(ret);
 }
 
+static enum_func_status
+XMYSQLND_METHOD(xmysqlnd_stmt_result, fetch_current_field)(XMYSQLND_STMT_RESULT * const result, const unsigned int field, zval * value, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info)
+{
+	enum_func_status ret{FAIL};
+	DBG_ENTER("xmysqlnd_stmt_result::fetch_current_field");
+	if (result->rowset) {
+		ret = result->rowset->m.fetch_current_field(result->rowset, field, value, stats, error_info);
+	}
+	DBG_INF(ret == PASS? "PASS":"FAIL");
+	DBG_RETURN(ret);
+}
+
+static const zval *
+XMYSQLND_METHOD(xmysqlnd_stmt_result, get_current_cells)(XMYSQLND_STMT_RESULT * const result, st_xmysqlnd_stmt_result_meta ** const meta)
+{
+	const zval* ret{nullptr};
+	DBG_ENTER("xmysqlnd_stmt_result::get_current_cells");
+	if (result->rowset) {
+		ret = result->rowset->m.get_current_cells(result->rowset, meta);
+	}
+	DBG_INF_FMT("cells=%p", ret);
+	DBG_RETURN(ret);
+}
+
+static enum_func_status
+XMYSQLND_METHOD(xmysqlnd_stmt_result, fetch_all_field)(XMYSQLND_STMT_RESULT * const result, const unsigned int field, zval * set, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info)
+{
+	enum_func_status ret{FAIL};
+	DBG_ENTER("xmysqlnd_stmt_result::fetch_all_field");
+	if (result->rowset) {
+		ret = result->rowset->m.fetch_all_field(result->rowset, field, set, stats, error_info);
+	}
+	DBG_INF(ret == PASS? "PASS":"FAIL");
+	DBG_RETURN(ret);
+}
+
+static enum_func_status
+XMYSQLND_METHOD(xmysqlnd_stmt_result, fetch_current_list)(XMYSQLND_STMT_RESULT * const result, zval * row, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info)
+{
+	enum_func_status ret{FAIL};
+	DBG_ENTER("xmysqlnd_stmt_result::fetch_current_list");
+	if (result->rowset) {
+		ret = result->rowset->m.fetch_current_list(result->rowset, row, stats, error_info);
+	}
+	DBG_INF(ret == PASS? "PASS":"FAIL");
+	DBG_RETURN(ret);
+}
+
+static enum_func_status
+XMYSQLND_METHOD(xmysqlnd_stmt_result, fetch_all_lists)(XMYSQLND_STMT_RESULT * const result, zval * set, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info)
+{
+	enum_func_status ret{FAIL};
+	DBG_ENTER("xmysqlnd_stmt_result::fetch_all_lists");
+	if (result->rowset) {
+		ret = result->rowset->m.fetch_all_lists(result->rowset, set, stats, error_info);
+	}
+	DBG_INF(ret == PASS? "PASS":"FAIL");
+	DBG_RETURN(ret);
+}
+
 static enum_func_status
 XMYSQLND_METHOD(xmysqlnd_stmt_result, rewind)(XMYSQLND_STMT_RESULT * const result)
 {
@@ -334,6 +394,8 @@ XMYSQLND_METHOD(xmysqlnd_stmt_result, dtor)(XMYSQLND_STMT_RESULT* const result,
 	DBG_ENTER("xmysqlnd_stmt_result::dtor");
 	if (result) {
 		result->m.free_contents(result, stats, error_info);
+		/* after free_contents, the rowset and the exec state were dtored in place */
+		result->arena.release();
 
 		mnd_efree(result);
 	}
@@ -350,6 +412,11 @@ MYSQLND_CLASS_METHODS_START(xmysqlnd_stmt_result)
 	XMYSQLND_METHOD(xmysqlnd_stmt_result, fetch_one_c),
 	XMYSQLND_METHOD(xmysqlnd_stmt_result, fetch_all),
 	XMYSQLND_METHOD(xmysqlnd_stmt_result, fetch_all_c),
+	XMYSQLND_METHOD(xmysqlnd_stmt_result, fetch_current_field),
+	XMYSQLND_METHOD(xmysqlnd_stmt_result, get_current_cells),
+	XMYSQLND_METHOD(xmysqlnd_stmt_result, fetch_all_field),
+	XMYSQLND_METHOD(xmysqlnd_stmt_result, fetch_current_list),
+	XMYSQLND_METHOD(xmysqlnd_stmt_result, fetch_all_lists),
 	XMYSQLND_METHOD(xmysqlnd_stmt_result, rewind),
 	XMYSQLND_METHOD(xmysqlnd_stmt_result, eof),
 
@@ -390,6 +457,27 @@ xmysqlnd_stmt_result_create(const zend_bool persistent,
 	DBG_RETURN(result);
 }
 
+/*
+  The result of a statement that had nothing to do and so wasn't sent: no rows,
+  no warnings, nothing affected.
+*/
+PHP_MYSQL_XDEVAPI_API XMYSQLND_STMT_RESULT *
+xmysqlnd_stmt_result_create_empty(const zend_bool persistent,
+									   const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const object_factory,
+									   MYSQLND_STATS * stats,
+									   MYSQLND_ERROR_INFO * error_info)
+{
+	DBG_ENTER("xmysqlnd_stmt_result_create_empty");
+	XMYSQLND_STMT_RESULT* result{ xmysqlnd_stmt_result_create(persistent, object_factory, stats, error_info) };
+	if (result) {
+		result->m.attach_execution_state(result,
+			xmysqlnd_stmt_execution_state_create(&result->arena, persistent, object_factory, stats, error_info));
+		result->m.attach_warning_list(result,
+			xmysqlnd_warning_list_create(persistent, object_factory, stats, error_info));
+	}
+	DBG_RETURN(result);
+}
+
 PHP_MYSQL_XDEVAPI_API void
 xmysqlnd_stmt_result_free(XMYSQLND_STMT_RESULT* const result, MYSQLND_STATS* stats, MYSQLND_ERROR_INFO* error_info)
 {
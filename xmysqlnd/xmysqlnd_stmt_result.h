@@ -20,6 +20,7 @@
 
 #include "xmysqlnd_driver.h"
 #include "util/allocator.h"
+#include "util/arena.h"
 
 namespace mysqlx {
 
@@ -41,6 +42,11 @@ typedef enum_func_status	(*func_xmysqlnd_stmt_result__fetch_one)(XMYSQLND_STMT_R
 typedef enum_func_status	(*func_xmysqlnd_stmt_result__fetch_one_c)(XMYSQLND_STMT_RESULT * const result, const size_t row_cursor, zval ** row, const zend_bool duplicate, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
 typedef enum_func_status	(*func_xmysqlnd_stmt_result__fetch_all)(XMYSQLND_STMT_RESULT * const result, zval * set, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
 typedef enum_func_status	(*func_xmysqlnd_stmt_result__fetch_all_c)(XMYSQLND_STMT_RESULT * const result, zval ** set, const zend_bool duplicate, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
+typedef enum_func_status	(*func_xmysqlnd_stmt_result__fetch_current_field)(XMYSQLND_STMT_RESULT * const result, const unsigned int field, zval * value, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
+typedef const zval *		(*func_xmysqlnd_stmt_result__get_current_cells)(XMYSQLND_STMT_RESULT * const result, st_xmysqlnd_stmt_result_meta ** const meta);
+typedef enum_func_status	(*func_xmysqlnd_stmt_result__fetch_all_field)(XMYSQLND_STMT_RESULT * const result, const unsigned int field, zval * set, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
+typedef enum_func_status	(*func_xmysqlnd_stmt_result__fetch_current_list)(XMYSQLND_STMT_RESULT * const result, zval * row, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
+typedef enum_func_status	(*func_xmysqlnd_stmt_result__fetch_all_lists)(XMYSQLND_STMT_RESULT * const result, zval * set, MYSQLND_STATS * const stats, MYSQLND_ERROR_INFO * const error_info);
 typedef enum_func_status	(*func_xmysqlnd_stmt_result__rewind)(XMYSQLND_STMT_RESULT * const result);
 typedef zend_bool			(*func_xmysqlnd_stmt_result__eof)(const XMYSQLND_STMT_RESULT * const result);
 
@@ -73,6 +79,11 @@ MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_stmt_result)
 	func_xmysqlnd_stmt_result__fetch_one_c fetch_one_c;
 	func_xmysqlnd_stmt_result__fetch_all fetch_all;
 	func_xmysqlnd_stmt_result__fetch_all_c fetch_all_c;
+	func_xmysqlnd_stmt_result__fetch_current_field fetch_current_field;
+	func_xmysqlnd_stmt_result__get_current_cells get_current_cells;
+	func_xmysqlnd_stmt_result__fetch_all_field fetch_all_field;
+	func_xmysqlnd_stmt_result__fetch_current_list fetch_current_list;
+	func_xmysqlnd_stmt_result__fetch_all_lists fetch_all_lists;
 	func_xmysqlnd_stmt_result__rewind rewind;
 	func_xmysqlnd_stmt_result__eof eof;
 
@@ -97,12 +108,18 @@ MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_stmt_result)
 
 
 
+/*
+  The rowset (with the set behind it) and the execution state are allocated in
+  the arena of the result, so they cost a single block and go at once in dtor.
+  The meta is not, it can be shared through the per-session meta cache.
+*/
 struct st_xmysqlnd_stmt_result : public util::custom_allocable
 {
 	st_xmysqlnd_rowset* rowset;
 	st_xmysqlnd_stmt_result_meta* meta;
 	st_xmysqlnd_stmt_execution_state* exec_state;
 	xmysqlnd_warning_list* warnings;
+	util::Arena arena;
 
 	MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_stmt_result) m;
 	size_t		refcount;
@@ -112,6 +129,7 @@ struct st_xmysqlnd_stmt_result : public util::custom_allocable
 
 PHP_MYSQL_XDEVAPI_API MYSQLND_CLASS_METHODS_INSTANCE_DECLARE(xmysqlnd_stmt_result);
 PHP_MYSQL_XDEVAPI_API XMYSQLND_STMT_RESULT * xmysqlnd_stmt_result_create(const zend_bool persistent, const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const object_factory, MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
+PHP_MYSQL_XDEVAPI_API XMYSQLND_STMT_RESULT * xmysqlnd_stmt_result_create_empty(const zend_bool persistent, const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const object_factory, MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
 PHP_MYSQL_XDEVAPI_API void xmysqlnd_stmt_result_free(XMYSQLND_STMT_RESULT* const result, MYSQLND_STATS* stats, MYSQLND_ERROR_INFO* error_info);
 
 } // namespace drv
@@ -48,15 +48,10 @@ XMYSQLND_METHOD(xmysqlnd_result_field_meta, set_type)(XMYSQLND_RESULT_FIELD_META
 }
 
 static inline enum_func_status
-xmysqlnd_set_mysqlnd_string(util::string* str, const char * const value, const size_t value_len, const zend_bool persistent MYSQLND_MEM_D)
+xmysqlnd_set_mysqlnd_string(XMYSQLND_RESULT_FIELD_META * const field, util::string_view* str, const char * const value, const size_t value_len)
 {
-#if ZEND_DEBUG
-	UNUSED(__zend_lineno);
-	UNUSED(__zend_filename);
-#endif
-
 	if (value) {
-		*str = value ? value : "";
+		*str = field->arena->copy({value, value_len});
 		return !str->empty() ? PASS:FAIL;
 	}
 	return PASS;
@@ -70,10 +65,10 @@ XMYSQLND_METHOD(xmysqlnd_result_field_meta, set_name)(XMYSQLND_RESULT_FIELD_META
 	DBG_ENTER("xmysqlnd_result_field_meta::set_name");
 	if (len) {
 		field->zend_hash_key.sname = zend_string_init(str, len, field->persistent);
-		field->name = util::to_string(field->zend_hash_key.sname);
+		field->name = util::string_view(ZSTR_VAL(field->zend_hash_key.sname), ZSTR_LEN(field->zend_hash_key.sname));
 	} else {
 		field->zend_hash_key.sname = ZSTR_EMPTY_ALLOC();
-		field->name.clear();
+		field->name = util::string_view();
 	}
 
 	if (field->zend_hash_key.is_numeric == ZEND_HANDLE_NUMERIC(field->zend_hash_key.sname, idx)) {
@@ -87,35 +82,35 @@ static enum_func_status
 XMYSQLND_METHOD(xmysqlnd_result_field_meta, set_original_name)(XMYSQLND_RESULT_FIELD_META * const field, const char * const str, const size_t len)
 {
 	DBG_ENTER("xmysqlnd_result_field_meta::set_original_name");
-	DBG_RETURN(xmysqlnd_set_mysqlnd_string(&field->original_name, str, len, field->persistent MYSQLND_MEM_C));
+	DBG_RETURN(xmysqlnd_set_mysqlnd_string(field, &field->original_name, str, len));
 }
 
 static enum_func_status
 XMYSQLND_METHOD(xmysqlnd_result_field_meta, set_table)(XMYSQLND_RESULT_FIELD_META * const field, const char * const str, const size_t len)
 {
 	DBG_ENTER("xmysqlnd_result_field_meta::set_table");
-	DBG_RETURN(xmysqlnd_set_mysqlnd_string(&field->table, str, len, field->persistent MYSQLND_MEM_C));
+	DBG_RETURN(xmysqlnd_set_mysqlnd_string(field, &field->table, str, len));
 }
 
 static enum_func_status
 XMYSQLND_METHOD(xmysqlnd_result_field_meta, set_original_table)(XMYSQLND_RESULT_FIELD_META * const field, const char * const str, const size_t len)
 {
 	DBG_ENTER("xmysqlnd_result_field_meta::set_original_table");
-	DBG_RETURN(xmysqlnd_set_mysqlnd_string(&field->original_table, str, len, field->persistent MYSQLND_MEM_C));
+	DBG_RETURN(xmysqlnd_set_mysqlnd_string(field, &field->original_table, str, len));
 }
 
 static enum_func_status
 XMYSQLND_METHOD(xmysqlnd_result_field_meta, set_schema)(XMYSQLND_RESULT_FIELD_META * const field, const char * const str, const size_t len)
 {
 	DBG_ENTER("xmysqlnd_result_field_meta::set_schema");
-	DBG_RETURN(xmysqlnd_set_mysqlnd_string(&field->schema, str, len, field->persistent MYSQLND_MEM_C));
+	DBG_RETURN(xmysqlnd_set_mysqlnd_string(field, &field->schema, str, len));
 }
 
 static enum_func_status
 XMYSQLND_METHOD(xmysqlnd_result_field_meta, set_catalog)(XMYSQLND_RESULT_FIELD_META * const field, const char * const str, const size_t len)
 {
 	DBG_ENTER("xmysqlnd_result_field_meta::set_catalog");
-	DBG_RETURN(xmysqlnd_set_mysqlnd_string(&field->catalog, str, len, field->persistent MYSQLND_MEM_C));
+	DBG_RETURN(xmysqlnd_set_mysqlnd_string(field, &field->catalog, str, len));
 }
 
 static enum_func_status
@@ -164,18 +159,18 @@ XMYSQLND_METHOD(xmysqlnd_result_field_meta, set_content_type)(XMYSQLND_RESULT_FI
 }
 
 static XMYSQLND_RESULT_FIELD_META *
-XMYSQLND_METHOD(xmysqlnd_result_field_meta, clone)(const XMYSQLND_RESULT_FIELD_META * const origin, MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info)
+XMYSQLND_METHOD(xmysqlnd_result_field_meta, clone)(const XMYSQLND_RESULT_FIELD_META * const origin, XMYSQLND_STMT_RESULT_META * const meta, MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info)
 {
 	XMYSQLND_RESULT_FIELD_META* cloned{nullptr};
 	DBG_ENTER("xmysqlnd_result_field_meta::clone");
-	cloned = xmysqlnd_result_field_meta_create(origin->persistent, origin->object_factory, stats, error_info);
+	cloned = xmysqlnd_result_field_meta_create(meta, origin->persistent, origin->object_factory, stats, error_info);
 	if (cloned) {
 		cloned->m->set_type(cloned, origin->type);
 		cloned->m->set_name(cloned, origin->name.data(), origin->name.length());
 		cloned->m->set_original_name(cloned, origin->original_name.data(), origin->original_name.length());
 		cloned->m->set_table(cloned, origin->table.data(), origin->table.length());
 		cloned->m->set_original_table(cloned, origin->original_table.data(), origin->original_table.length());
-		cloned->m->set_schema(cloned, origin->schema.c_str(), origin->schema.length());
+		cloned->m->set_schema(cloned, origin->schema.data(), origin->schema.length());
 		cloned->m->set_catalog(cloned, origin->catalog.data(), origin->catalog.length());
 		cloned->m->set_collation(cloned, origin->collation);
 		cloned->m->set_fractional_digits(cloned, origin->fractional_digits);
@@ -191,12 +186,13 @@ XMYSQLND_METHOD(xmysqlnd_result_field_meta, free_contents)(XMYSQLND_RESULT_FIELD
 {
 	DBG_ENTER("xmysqlnd_result_field_meta::free_contents");
 
-	field->name.clear();
-	field->original_name.clear();
-	field->table.clear();
-	field->original_table.clear();
-	field->schema.clear();
-	field->catalog.clear();
+	/* the strings go with the arena */
+	field->name = util::string_view();
+	field->original_name = util::string_view();
+	field->table = util::string_view();
+	field->original_table = util::string_view();
+	field->schema = util::string_view();
+	field->catalog = util::string_view();
 	if (field->zend_hash_key.sname) {
 		zend_string_release(field->zend_hash_key.sname);
 		field->zend_hash_key.sname = nullptr;
@@ -220,8 +216,8 @@ XMYSQLND_METHOD(xmysqlnd_result_field_meta, dtor)(
 {
 	DBG_ENTER("xmysqlnd_result_field_meta::dtor");
 	if (field) {
+		/* the memory is released together with the arena of the meta */
 		field->m->free_contents(field);
-		mnd_efree(field);
 	}
 	DBG_VOID_RETURN;
 }
@@ -250,14 +246,15 @@ MYSQLND_CLASS_METHODS_END;
 PHP_MYSQL_XDEVAPI_API MYSQLND_CLASS_METHODS_INSTANCE_DEFINE(xmysqlnd_result_field_meta);
 
 PHP_MYSQL_XDEVAPI_API XMYSQLND_RESULT_FIELD_META *
-xmysqlnd_result_field_meta_create(const zend_bool persistent,
+xmysqlnd_result_field_meta_create(XMYSQLND_STMT_RESULT_META * const meta,
+								  const zend_bool persistent,
 								  const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const object_factory,
 								  MYSQLND_STATS * stats,
 								  MYSQLND_ERROR_INFO * error_info)
 {
 	XMYSQLND_RESULT_FIELD_META* object{nullptr};
 	DBG_ENTER("xmysqlnd_result_field_meta_create");
-	object = object_factory->get_result_field_meta(object_factory, persistent, stats, error_info);
+	object = object_factory->get_result_field_meta(object_factory, meta, persistent, stats, error_info);
 	DBG_RETURN(object);
 }
 
@@ -276,10 +273,11 @@ xmysqlnd_result_field_meta_free(XMYSQLND_RESULT_FIELD_META * const object, MYSQL
 
 static enum_func_status
 XMYSQLND_METHOD(xmysqlnd_stmt_result_meta, init)(
-	XMYSQLND_STMT_RESULT_META* const /*meta*/,
+	XMYSQLND_STMT_RESULT_META* const meta,
 	MYSQLND_STATS* const /*stats*/,
 	MYSQLND_ERROR_INFO* const /*error_info*/)
 {
+	meta->refcount = 1;
 	return PASS;
 }
 
@@ -288,16 +286,19 @@ XMYSQLND_METHOD(xmysqlnd_stmt_result_meta, add_field)(
 	XMYSQLND_STMT_RESULT_META* const meta,
 	XMYSQLND_RESULT_FIELD_META* field,
 	MYSQLND_STATS* /*stats*/,
-	MYSQLND_ERROR_INFO* error_info)
+	MYSQLND_ERROR_INFO* /*error_info*/)
 {
 	DBG_ENTER("xmysqlnd_stmt_result_meta::add_field");
 	if (!meta->fields || meta->field_count == meta->fields_size) {
-		meta->fields_size += 8;
-		meta->fields = static_cast<XMYSQLND_RESULT_FIELD_META**>(mnd_erealloc(meta->fields, meta->fields_size * sizeof(field)));
-		if (!meta->fields) {
-			SET_OOM_ERROR(error_info);
-			DBG_RETURN(FAIL);
+		/* the previous array is left in the arena, it is just a few pointers */
+		const unsigned int fields_size{ meta->fields_size ? meta->fields_size * 2 : 8 };
+		XMYSQLND_RESULT_FIELD_META** fields{
+			static_cast<XMYSQLND_RESULT_FIELD_META**>(meta->arena.allocate(fields_size * sizeof(field))) };
+		if (meta->field_count) {
+			memcpy(fields, meta->fields, meta->field_count * sizeof(field));
 		}
+		meta->fields = fields;
+		meta->fields_size = fields_size;
 	}
 	meta->fields[meta->field_count++] = field;
 
@@ -316,6 +317,106 @@ XMYSQLND_METHOD(xmysqlnd_stmt_result_meta, get_field)(const XMYSQLND_STMT_RESULT
 	return((meta->field_count > 0 && field < meta->field_count)? meta->fields[field] : nullptr);
 }
 
+static HashTable *
+XMYSQLND_METHOD(xmysqlnd_stmt_result_meta, get_row_template)(XMYSQLND_STMT_RESULT_META * const meta)
+{
+	DBG_ENTER("xmysqlnd_stmt_result_meta::get_row_template");
+	if (!meta->row_template_built) {
+		meta->row_template_built = TRUE;
+
+		zval row_template;
+		zval null_zv;
+		ZVAL_NULL(&null_zv);
+		array_init_size(&row_template, meta->field_count);
+		for (unsigned int i{0}; i < meta->field_count; ++i) {
+			const XMYSQLND_RESULT_FIELD_META* field_meta = meta->fields[i];
+			if (!field_meta->zend_hash_key.sname) {
+				break;
+			}
+			if (field_meta->zend_hash_key.is_numeric == FALSE) {
+				zend_hash_update(Z_ARRVAL(row_template), field_meta->zend_hash_key.sname, &null_zv);
+			} else {
+				zend_hash_index_update(Z_ARRVAL(row_template), field_meta->zend_hash_key.key, &null_zv);
+			}
+		}
+		/* with duplicated names the n-th element isn't the n-th column anymore */
+		if (zend_hash_num_elements(Z_ARRVAL(row_template)) == meta->field_count) {
+			meta->row_template = Z_ARRVAL(row_template);
+		} else {
+			zval_ptr_dtor(&row_template);
+		}
+	}
+	DBG_INF_FMT("row_template=%p", meta->row_template);
+	DBG_RETURN(meta->row_template);
+}
+
+/*
+  Looks the column up by the key it has in the row array, a string or an integer,
+  without building the row - used by the lazy rows of the devapi.
+*/
+static zend_bool
+XMYSQLND_METHOD(xmysqlnd_stmt_result_meta, find_field)(XMYSQLND_STMT_RESULT_META * const meta, const zval * const name, unsigned int * const field)
+{
+	DBG_ENTER("xmysqlnd_stmt_result_meta::find_field");
+	if (!meta->field_index) {
+		ALLOC_HASHTABLE(meta->field_index);
+		zend_hash_init(meta->field_index, meta->field_count, nullptr, nullptr, 0);
+		for (unsigned int i{0}; i < meta->field_count; ++i) {
+			const XMYSQLND_RESULT_FIELD_META* field_meta = meta->fields[i];
+			if (!field_meta->zend_hash_key.sname) {
+				break;
+			}
+			zval index_zv;
+			ZVAL_LONG(&index_zv, i);
+			if (field_meta->zend_hash_key.is_numeric == FALSE) {
+				zend_hash_update(meta->field_index, field_meta->zend_hash_key.sname, &index_zv);
+			} else {
+				zend_hash_index_update(meta->field_index, field_meta->zend_hash_key.key, &index_zv);
+			}
+		}
+	}
+
+	const zval* index_zv{nullptr};
+	switch (Z_TYPE_P(name)) {
+		case IS_STRING:
+			index_zv = zend_symtable_find(meta->field_index, Z_STR_P(name));
+			break;
+		case IS_LONG:
+			index_zv = zend_hash_index_find(meta->field_index, Z_LVAL_P(name));
+			break;
+		default:
+			break;
+	}
+	if (!index_zv) {
+		DBG_RETURN(FALSE);
+	}
+	*field = static_cast<unsigned int>(Z_LVAL_P(index_zv));
+	DBG_INF_FMT("field=%u", *field);
+	DBG_RETURN(TRUE);
+}
+
+static zend_bool
+XMYSQLND_METHOD(xmysqlnd_stmt_result_meta, find_doc_field)(XMYSQLND_STMT_RESULT_META * const meta, unsigned int * const field)
+{
+	DBG_ENTER("xmysqlnd_stmt_result_meta::find_doc_field");
+	if (!meta->doc_field_resolved) {
+		meta->doc_field_resolved = TRUE;
+		meta->doc_field = meta->field_count;
+		for (unsigned int i{0}; i < meta->field_count; ++i) {
+			if (meta->fields[i]->name == "doc") {
+				meta->doc_field = i;
+				break;
+			}
+		}
+	}
+	if (meta->doc_field == meta->field_count) {
+		DBG_RETURN(FALSE);
+	}
+	*field = meta->doc_field;
+	DBG_INF_FMT("field=%u", *field);
+	DBG_RETURN(TRUE);
+}
+
 static void
 XMYSQLND_METHOD(xmysqlnd_stmt_result_meta, free_contents)(XMYSQLND_STMT_RESULT_META * const meta, MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info)
 {
@@ -324,9 +425,21 @@ XMYSQLND_METHOD(xmysqlnd_stmt_result_meta, free_contents)(XMYSQLND_STMT_RESULT_M
 		for (unsigned int i{0}; i < meta->field_count; ++i) {
 			meta->fields[i]->m->dtor(meta->fields[i], stats, error_info);
 		}
-		mnd_efree(meta->fields);
 		meta->fields = nullptr;
+		meta->field_count = meta->fields_size = 0;
+	}
+	if (meta->row_template) {
+		zend_array_destroy(meta->row_template);
+		meta->row_template = nullptr;
 	}
+	meta->row_template_built = FALSE;
+	meta->doc_field_resolved = FALSE;
+	if (meta->field_index) {
+		zend_hash_destroy(meta->field_index);
+		FREE_HASHTABLE(meta->field_index);
+		meta->field_index = nullptr;
+	}
+	meta->arena.release();
 	DBG_VOID_RETURN;
 }
 
@@ -347,6 +460,9 @@ MYSQLND_CLASS_METHODS_START(xmysqlnd_stmt_result_meta)
 	XMYSQLND_METHOD(xmysqlnd_stmt_result_meta, add_field),
 	XMYSQLND_METHOD(xmysqlnd_stmt_result_meta, count),
 	XMYSQLND_METHOD(xmysqlnd_stmt_result_meta, get_field),
+	XMYSQLND_METHOD(xmysqlnd_stmt_result_meta, get_row_template),
+	XMYSQLND_METHOD(xmysqlnd_stmt_result_meta, find_field),
+	XMYSQLND_METHOD(xmysqlnd_stmt_result_meta, find_doc_field),
 	XMYSQLND_METHOD(xmysqlnd_stmt_result_meta, free_contents),
 	XMYSQLND_METHOD(xmysqlnd_stmt_result_meta, dtor),
 MYSQLND_CLASS_METHODS_END;
@@ -366,13 +482,73 @@ xmysqlnd_stmt_result_meta_create(const zend_bool persistent,
 	DBG_RETURN(object);
 }
 
+PHP_MYSQL_XDEVAPI_API XMYSQLND_STMT_RESULT_META *
+xmysqlnd_stmt_result_meta_get_reference(XMYSQLND_STMT_RESULT_META * const object)
+{
+	DBG_ENTER("xmysqlnd_stmt_result_meta_get_reference");
+	++object->refcount;
+	DBG_INF_FMT("new_refcount=%u", object->refcount);
+	DBG_RETURN(object);
+}
+
 PHP_MYSQL_XDEVAPI_API void
 xmysqlnd_stmt_result_meta_free(XMYSQLND_STMT_RESULT_META * const object, MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info)
 {
 	DBG_ENTER("xmysqlnd_stmt_result_meta_free");
 	if (object) {
-		object->m->dtor(object, stats, error_info);
+		DBG_INF_FMT("old_refcount=%u", object->refcount);
+		if (!(--object->refcount)) {
+			object->m->dtor(object, stats, error_info);
+		}
+	}
+	DBG_VOID_RETURN;
+}
+
+/*******************************************************************************************************************************************/
+
+Result_meta_cache::~Result_meta_cache()
+{
+	clear();
+}
+
+XMYSQLND_STMT_RESULT_META*
+Result_meta_cache::find(const util::string_view& frames) const
+{
+	DBG_ENTER("Result_meta_cache::find");
+	XMYSQLND_STMT_RESULT_META* meta{nullptr};
+	auto it = entries.find(std::hash<util::string_view>{}(frames));
+	if ((it != entries.end()) && (it->second.frames == frames)) {
+		meta = it->second.meta;
+	}
+	DBG_INF_FMT("meta=%p", meta);
+	DBG_RETURN(meta);
+}
+
+void
+Result_meta_cache::add(const util::string_view& frames, XMYSQLND_STMT_RESULT_META* meta)
+{
+	DBG_ENTER("Result_meta_cache::add");
+	if (entries.size() >= max_entries) {
+		clear();
+	}
+	const std::size_t key{ std::hash<util::string_view>{}(frames) };
+	auto it = entries.find(key);
+	if (it != entries.end()) {
+		xmysqlnd_stmt_result_meta_free(it->second.meta, nullptr, nullptr);
+		entries.erase(it);
+	}
+	entries.emplace(key, Entry{ util::string(frames), xmysqlnd_stmt_result_meta_get_reference(meta) });
+	DBG_VOID_RETURN;
+}
+
+void
+Result_meta_cache::clear()
+{
+	DBG_ENTER("Result_meta_cache::clear");
+	for (auto& entry : entries) {
+		xmysqlnd_stmt_result_meta_free(entry.second.meta, nullptr, nullptr);
 	}
+	entries.clear();
 	DBG_VOID_RETURN;
 }
 
@@ -20,6 +20,9 @@
 
 #include "xmysqlnd_enum_n_def.h"
 #include "xmysqlnd_driver.h"
+#include "util/arena.h"
+#include "util/strings.h"
+#include "util/types.h"
 
 namespace mysqlx {
 
@@ -61,7 +64,7 @@ typedef enum_func_status	(*func_xmysqlnd_result_field_meta__set_fractional_digit
 typedef enum_func_status	(*func_xmysqlnd_result_field_meta__set_length)(XMYSQLND_RESULT_FIELD_META * const field, const uint32_t length);
 typedef enum_func_status	(*func_xmysqlnd_result_field_meta__set_flags)(XMYSQLND_RESULT_FIELD_META * const field, const uint32_t flags);
 typedef enum_func_status	(*func_xmysqlnd_result_field_meta__set_content_type)(XMYSQLND_RESULT_FIELD_META * const field, const uint32_t content_type);
-typedef XMYSQLND_RESULT_FIELD_META * (*func_xmysqlnd_result_field_meta__clone)(const XMYSQLND_RESULT_FIELD_META * const field, MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
+typedef XMYSQLND_RESULT_FIELD_META * (*func_xmysqlnd_result_field_meta__clone)(const XMYSQLND_RESULT_FIELD_META * const field, struct st_xmysqlnd_stmt_result_meta * const meta, MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
 typedef void				(*func_xmysqlnd_result_field_meta__free_contents)(XMYSQLND_RESULT_FIELD_META * const field);
 typedef void				(*func_xmysqlnd_result_field_meta__dtor)(XMYSQLND_RESULT_FIELD_META * const field, MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
 
@@ -86,15 +89,20 @@ MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_result_field_meta)
 	func_xmysqlnd_result_field_meta__dtor dtor;
 };
 
-struct st_xmysqlnd_result_field_meta : public util::custom_allocable
+/*
+  Allocated in the arena of the meta it belongs to, together with its strings, so
+  it is value-initialized rather than zeroed by the allocator, and never freed on
+  its own. The name views the zend_string used as the hash key.
+*/
+struct st_xmysqlnd_result_field_meta
 {
 	enum xmysqlnd_field_type type;
-	util::string name;
-	util::string original_name;
-	util::string table;
-	util::string original_table;
-	util::string schema;
-	util::string catalog;
+	util::string_view name;
+	util::string_view original_name;
+	util::string_view table;
+	util::string_view original_table;
+	util::string_view schema;
+	util::string_view catalog;
 	uint64_t collation;
 	uint32_t fractional_digits;
 	uint32_t length;
@@ -114,13 +122,14 @@ struct st_xmysqlnd_result_field_meta : public util::custom_allocable
 	zend_bool flags_set:1;
 	zend_bool content_type_set:1;
 
+	util::Arena * arena;
 	const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * object_factory;
 	const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_result_field_meta) * m;
 	zend_bool persistent;
 };
 
 PHP_MYSQL_XDEVAPI_API MYSQLND_CLASS_METHODS_INSTANCE_DECLARE(xmysqlnd_result_field_meta);
-PHP_MYSQL_XDEVAPI_API XMYSQLND_RESULT_FIELD_META * xmysqlnd_result_field_meta_create(const zend_bool persistent, const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const object_factory,  MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
+PHP_MYSQL_XDEVAPI_API XMYSQLND_RESULT_FIELD_META * xmysqlnd_result_field_meta_create(struct st_xmysqlnd_stmt_result_meta * const meta, const zend_bool persistent, const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const object_factory,  MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
 PHP_MYSQL_XDEVAPI_API void xmysqlnd_result_field_meta_free(XMYSQLND_RESULT_FIELD_META * const field, MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
 
 
@@ -132,6 +141,9 @@ typedef enum_func_status	(*func_xmysqlnd_stmt_result_meta__init)(XMYSQLND_STMT_R
 typedef enum_func_status	(*func_xmysqlnd_stmt_result_meta__add_field)(XMYSQLND_STMT_RESULT_META * const meta, XMYSQLND_RESULT_FIELD_META * field, MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
 typedef unsigned int		(*func_xmysqlnd_stmt_result_meta__get_field_count)(const XMYSQLND_STMT_RESULT_META * const meta);
 typedef const XMYSQLND_RESULT_FIELD_META * (*func_xmysqlnd_stmt_result_meta__get_field)(const XMYSQLND_STMT_RESULT_META * const meta, unsigned int field);
+typedef HashTable *			(*func_xmysqlnd_stmt_result_meta__get_row_template)(XMYSQLND_STMT_RESULT_META * const meta);
+typedef zend_bool			(*func_xmysqlnd_stmt_result_meta__find_field)(XMYSQLND_STMT_RESULT_META * const meta, const zval * const name, unsigned int * const field);
+typedef zend_bool			(*func_xmysqlnd_stmt_result_meta__find_doc_field)(XMYSQLND_STMT_RESULT_META * const meta, unsigned int * const field);
 typedef void				(*func_xmysqlnd_stmt_result_meta__free_contents)(XMYSQLND_STMT_RESULT_META * const meta, MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
 typedef void				(*func_xmysqlnd_stmt_result_meta__dtor)(XMYSQLND_STMT_RESULT_META * const meta, MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
 
@@ -141,6 +153,9 @@ MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_stmt_result_meta)
 	func_xmysqlnd_stmt_result_meta__add_field add_field;
 	func_xmysqlnd_stmt_result_meta__get_field_count get_field_count;
 	func_xmysqlnd_stmt_result_meta__get_field get_field;
+	func_xmysqlnd_stmt_result_meta__get_row_template get_row_template;
+	func_xmysqlnd_stmt_result_meta__find_field find_field;
+	func_xmysqlnd_stmt_result_meta__find_doc_field find_doc_field;
 	func_xmysqlnd_stmt_result_meta__free_contents free_contents;
 	func_xmysqlnd_stmt_result_meta__dtor dtor;
 };
@@ -151,6 +166,34 @@ struct st_xmysqlnd_stmt_result_meta : public util::custom_allocable
 	XMYSQLND_RESULT_FIELD_META ** fields;
 	unsigned int fields_size;
 
+	/*
+	  Row array with the column names as keys and nulls as values, built on first use.
+	  Rows are fetched as copies of it, nullptr when the names are not unique.
+	*/
+	HashTable * row_template;
+	zend_bool row_template_built;
+
+	/*
+	  Column name -> column number, built on first use. With duplicated names the
+	  last column wins, the same as in the row array.
+	*/
+	HashTable * field_index;
+
+	/*
+	  Number of the `doc` column Collection.find() returns the documents in, looked
+	  up on first use, field_count when the result has no such column.
+	*/
+	unsigned int doc_field;
+	zend_bool doc_field_resolved;
+
+	unsigned int refcount;
+
+	/*
+	  Backs the fields, their strings and the fields array, one or two blocks for
+	  the whole meta instead of a handful of allocations per column.
+	*/
+	util::Arena arena;
+
 	const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_stmt_result_meta) * m;
 	zend_bool		persistent;
 };
@@ -158,8 +201,37 @@ struct st_xmysqlnd_stmt_result_meta : public util::custom_allocable
 
 PHP_MYSQL_XDEVAPI_API MYSQLND_CLASS_METHODS_INSTANCE_DECLARE(xmysqlnd_stmt_result_meta);
 PHP_MYSQL_XDEVAPI_API XMYSQLND_STMT_RESULT_META * xmysqlnd_stmt_result_meta_create(const zend_bool persistent, const MYSQLND_CLASS_METHODS_TYPE(xmysqlnd_object_factory) * const object_factory, MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
+PHP_MYSQL_XDEVAPI_API XMYSQLND_STMT_RESULT_META * xmysqlnd_stmt_result_meta_get_reference(XMYSQLND_STMT_RESULT_META * const meta);
 PHP_MYSQL_XDEVAPI_API void xmysqlnd_stmt_result_meta_free(XMYSQLND_STMT_RESULT_META * const meta, MYSQLND_STATS * stats, MYSQLND_ERROR_INFO * error_info);
 
+/*
+  Per-session cache of result set metadata, keyed by the raw ColumnMetaData frames.
+  A statement which returns the same columns over and over gets one shared, immutable
+  meta (with its names and row template) instead of a fresh one for every result.
+*/
+class Result_meta_cache
+{
+public:
+	Result_meta_cache() = default;
+	Result_meta_cache(const Result_meta_cache&) = delete;
+	Result_meta_cache& operator=(const Result_meta_cache&) = delete;
+	~Result_meta_cache();
+
+	XMYSQLND_STMT_RESULT_META* find(const util::string_view& frames) const;
+	void add(const util::string_view& frames, XMYSQLND_STMT_RESULT_META* meta);
+	void clear();
+
+private:
+	static constexpr std::size_t max_entries{64};
+
+	struct Entry
+	{
+		util::string frames;
+		XMYSQLND_STMT_RESULT_META* meta;
+	};
+	util::unordered_map<std::size_t, Entry> entries;
+};
+
 } // namespace drv
 
 } // namespace mysqlx
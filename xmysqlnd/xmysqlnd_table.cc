@@ -25,12 +25,14 @@ extern "C" {
 #include "xmysqlnd_session.h"
 #include "xmysqlnd_schema.h"
 #include "xmysqlnd_stmt.h"
+#include "xmysqlnd_stmt_result.h"
 #include "xmysqlnd_stmt_result_meta.h"
 #include "xmysqlnd_table.h"
 #include "xmysqlnd_utils.h"
 #include <vector>
 #include "util/exceptions.h"
 #include "util/pb_utils.h"
+#include "php_mysqlx.h"
 
 namespace mysqlx {
 
@@ -126,6 +128,15 @@ xmysqlnd_table::exists_in_database(
 	xmysqlnd_schema * schema = get_schema();
 	auto session = schema->get_session();
 
+	if (schema->has_metadata_cache()) {
+		std::string object_type;
+		ret = schema->find_cached_db_object_type(get_name(), on_error, object_type);
+		if (is_table_object_type(object_type) || is_view_object_type(object_type)) {
+			ZVAL_TRUE(exists);
+		}
+		DBG_RETURN(ret);
+	}
+
 	table_or_view_var_binder_ctx var_binder_ctx = {
 		schema->get_name(),
 		get_name(),
@@ -193,6 +204,15 @@ xmysqlnd_table::is_view(
 	xmysqlnd_schema * schema = get_schema();
 	auto session = schema->get_session();
 
+	if (schema->has_metadata_cache()) {
+		std::string object_type;
+		ret = schema->find_cached_db_object_type(get_name(), on_error, object_type);
+		if (is_view_object_type(object_type)) {
+			ZVAL_TRUE(exists);
+		}
+		DBG_RETURN(ret);
+	}
+
 	table_or_view_var_binder_ctx var_binder_ctx = {
 		schema->get_name(),
 		get_name(),
@@ -289,8 +309,48 @@ xmysqlnd_table::count(
 	DBG_RETURN(ret);
 }
 
+namespace {
+
+xmysqlnd_stmt* send_insert_batch(XMYSQLND_SESSION& session, XMYSQLND_CRUD_TABLE_OP__INSERT* op)
+{
+	st_xmysqlnd_message_factory msg_factory{ session->data->create_message_factory() };
+	st_xmysqlnd_msg__table_insert table_insert = msg_factory.get__table_insert(&msg_factory);
+	if (FAIL == table_insert.send_insert_request(&table_insert, xmysqlnd_crud_table_insert__get_protobuf_message(op))) {
+		return nullptr;
+	}
+	xmysqlnd_stmt* stmt = session->create_statement_object(session);
+	stmt->get_msg_stmt_exec() = msg_factory.get__sql_stmt_execute(&msg_factory);
+	return stmt;
+}
+
+/*
+	reads the response to a batch which isn't the last one, and frees its statement,
+	the rows it inserted are counted in op
+*/
+bool read_insert_batch(
+	XMYSQLND_SESSION& session,
+	xmysqlnd_stmt* stmt,
+	XMYSQLND_CRUD_TABLE_OP__INSERT* op,
+	const st_xmysqlnd_stmt_on_error_bind on_error)
+{
+	const st_xmysqlnd_stmt_on_warning_bind on_warning{ nullptr, nullptr };
+	zend_bool has_more{FALSE};
+	XMYSQLND_STMT_RESULT* result = stmt->get_buffered_result(
+		stmt, &has_more, on_warning, on_error, session->data->stats, session->data->error_info);
+	if (result) {
+		if (result->exec_state) {
+			xmysqlnd_crud_table_insert__add_batch_state(op, result->exec_state);
+		}
+		xmysqlnd_stmt_result_free(result, session->data->stats, session->data->error_info);
+	}
+	xmysqlnd_stmt_free(stmt, session->data->stats, session->data->error_info);
+	return result != nullptr;
+}
+
+} // anonymous namespace
+
 xmysqlnd_stmt *
-xmysqlnd_table::insert(XMYSQLND_CRUD_TABLE_OP__INSERT * op)
+xmysqlnd_table::insert(XMYSQLND_CRUD_TABLE_OP__INSERT * op, const st_xmysqlnd_stmt_on_error_bind on_error)
 {
 	DBG_ENTER("xmysqlnd_table::opinsert");
 	xmysqlnd_stmt *         stmt{nullptr};
@@ -298,19 +358,57 @@ xmysqlnd_table::insert(XMYSQLND_CRUD_TABLE_OP__INSERT * op)
 	if (!op) {
 		DBG_RETURN(stmt);
 	}
-	if ( FAIL == xmysqlnd_crud_table_insert__finalize_bind(op)) {
+	const zend_long batch_size_setting{ MYSQL_XDEVAPI_G(insert_batch_size) };
+	const std::size_t max_batch_size{ batch_size_setting > 0 ? static_cast<std::size_t>(batch_size_setting) : 0 };
+	const bool pipelined{ MYSQL_XDEVAPI_G(insert_pipelining) == TRUE };
+	if ( FAIL == xmysqlnd_crud_table_insert__finalize_bind(op, max_batch_size)) {
 		DBG_RETURN(stmt);
 	}
-	if (xmysqlnd_crud_table_insert__is_initialized(op)) {
-		st_xmysqlnd_message_factory msg_factory{ session->data->create_message_factory() };
-		st_xmysqlnd_msg__table_insert table_insert = msg_factory.get__table_insert(&msg_factory);
-		if (PASS == table_insert.send_insert_request(&table_insert, xmysqlnd_crud_table_insert__get_protobuf_message(op)))
-		{
-			stmt = session->create_statement_object(session);
-			stmt->get_msg_stmt_exec() = msg_factory.get__sql_stmt_execute(&msg_factory);
+	if (!xmysqlnd_crud_table_insert__is_initialized(op)) {
+		DBG_RETURN(stmt);
+	}
+
+	/*
+		the next batch is encoded while the server inserts the one just sent, and
+		with pipelining it is sent before reading the response to the previous one,
+		so there are at most two batches in flight
+		a batch is a statement of its own, so when one fails the batches before it
+		stay inserted, and so does the one pipelined behind it - their rows are
+		counted in op, for the caller to report them
+	*/
+	const st_xmysqlnd_stmt_on_error_bind drop_error{ nullptr, nullptr };
+	xmysqlnd_stmt* unread_stmt{nullptr};
+	for (;;) {
+		if (unread_stmt && !pipelined) {
+			const bool batch_ok{ read_insert_batch(session, unread_stmt, op, on_error) };
+			unread_stmt = nullptr;
+			if (!batch_ok) break;
+		}
+
+		xmysqlnd_stmt* batch_stmt{ send_insert_batch(session, op) };
+		if (unread_stmt) {
+			const bool batch_ok{ read_insert_batch(session, unread_stmt, op, on_error) };
+			unread_stmt = nullptr;
+			if (!batch_ok) {
+				if (batch_stmt) {
+					read_insert_batch(session, batch_stmt, op, drop_error);
+				}
+				break;
+			}
+		}
+		if (!batch_stmt) break;
+
+		unread_stmt = batch_stmt;
+		if (!xmysqlnd_crud_table_insert__bind_next_batch(op, max_batch_size)) {
+			if (EG(exception)) {
+				read_insert_batch(session, unread_stmt, op, drop_error);
+				unread_stmt = nullptr;
+			}
+			break;
 		}
-		DBG_INF(stmt != nullptr ? "PASS" : "FAIL");
 	}
+	stmt = unread_stmt;
+	DBG_INF(stmt != nullptr ? "PASS" : "FAIL");
 
 	DBG_RETURN(stmt);
 }
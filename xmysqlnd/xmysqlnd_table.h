@@ -29,6 +29,7 @@ namespace drv {
 
 class xmysqlnd_schema;
 struct st_xmysqlnd_session_on_error_bind;
+struct st_xmysqlnd_stmt_on_error_bind;
 
 struct xmysqlnd_table : util::custom_allocable
 {
@@ -41,7 +42,14 @@ public:
 	enum_func_status		exists_in_database(st_xmysqlnd_session_on_error_bind on_error, zval* exists);
 	enum_func_status		is_view(st_xmysqlnd_session_on_error_bind on_error, zval* exists);
 	enum_func_status		count(st_xmysqlnd_session_on_error_bind on_error, zval* counter);
-	xmysqlnd_stmt*       insert(XMYSQLND_CRUD_TABLE_OP__INSERT * op);
+	/*
+		rows beyond xmysqlnd.insert_batch_size are sent in several Insert messages,
+		the responses to all but the last one are read here, and reported through
+		on_error. The statement returned is the one of the last message, see
+		xmysqlnd_crud_table_insert__merge_batch_states. When it fails, op counts
+		the rows of the messages which went through.
+	*/
+	xmysqlnd_stmt*       insert(XMYSQLND_CRUD_TABLE_OP__INSERT * op, const st_xmysqlnd_stmt_on_error_bind on_error);
 	xmysqlnd_stmt*       opdelete(XMYSQLND_CRUD_TABLE_OP__DELETE * op);
 	xmysqlnd_stmt*		update(XMYSQLND_CRUD_TABLE_OP__UPDATE * op);
 	xmysqlnd_stmt*		select(XMYSQLND_CRUD_TABLE_OP__SELECT * op);
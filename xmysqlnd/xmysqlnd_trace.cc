@@ -0,0 +1,169 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#include "php_api.h"
+#include "mysqlnd_api.h"
+#include "php_mysqlx.h"
+#include "xmysqlnd_trace.h"
+#include <random>
+
+namespace mysqlx {
+
+namespace drv {
+
+void Trace_buffer::init()
+{
+	spans = nullptr;
+	capacity = 0;
+	pushed = 0;
+	dropped = 0;
+	sample_counter = 0;
+	span_id_seed = 0;
+}
+
+void Trace_buffer::release()
+{
+	if (spans) {
+		pefree(spans, 1);
+	}
+	init();
+}
+
+bool Trace_buffer::sample()
+{
+	const zend_long sample_rate{ MYSQL_XDEVAPI_G(trace_sample_rate) };
+	if (sample_rate <= 0) return false;
+	return (sample_counter++ % static_cast<uint64_t>(sample_rate)) == 0;
+}
+
+uint64_t Trace_buffer::next_span_id()
+{
+	if (span_id_seed == 0) {
+		std::random_device random_device;
+		span_id_seed = (static_cast<uint64_t>(random_device()) << 32) | random_device();
+		span_id_seed |= 1;
+	}
+	return span_id_seed++;
+}
+
+void Trace_buffer::push(const Trace_span& span)
+{
+	if (!reserve()) return;
+	if (pushed >= capacity) ++dropped;
+	spans[pushed++ % capacity] = span;
+}
+
+std::size_t Trace_buffer::size() const
+{
+	return static_cast<std::size_t>(pushed < capacity ? pushed : capacity);
+}
+
+const Trace_span& Trace_buffer::get(std::size_t i) const
+{
+	// oldest first
+	const uint64_t first{ pushed < capacity ? 0 : pushed - capacity };
+	return spans[(first + i) % capacity];
+}
+
+void Trace_buffer::clear()
+{
+	pushed = 0;
+	dropped = 0;
+}
+
+bool Trace_buffer::reserve()
+{
+	if (spans) return true;
+	const zend_long buffer_size{ MYSQL_XDEVAPI_G(trace_buffer_size) };
+	if (buffer_size <= 0) return false;
+	capacity = static_cast<std::size_t>(buffer_size);
+	spans = static_cast<Trace_span*>(pemalloc(capacity * sizeof(Trace_span), 1));
+	if (!spans) {
+		capacity = 0;
+		return false;
+	}
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+
+void Trace_span_recorder::start(enum_xmysqlnd_perf_op op, unsigned int command, std::size_t bytes_sent)
+{
+	if (active) finish();
+
+	Trace_buffer& trace_buffer{ xmysqlnd_get_trace_buffer() };
+	if (!trace_buffer.sample()) return;
+
+	active = true;
+	span = Trace_span{};
+	span.span_id = trace_buffer.next_span_id();
+	span.op = op;
+	span.command = command;
+	span.send_ns = xmysqlnd_trace_now_ns();
+	span.bytes_sent = bytes_sent;
+}
+
+void Trace_span_recorder::on_frame_received(std::size_t frame_size)
+{
+	const uint64_t now_ns{ xmysqlnd_trace_now_ns() };
+	if (span.first_byte_ns == 0) {
+		span.first_byte_ns = now_ns;
+	}
+	span.last_byte_ns = now_ns;
+	span.bytes_received += frame_size;
+}
+
+void Trace_span_recorder::on_row_decoded(const Perf_clock::time_point& decode_started)
+{
+	++span.rows;
+	span.decode_ns += xmysqlnd_perf_elapsed_ns(decode_started);
+}
+
+void Trace_span_recorder::finish()
+{
+	if (!active) return;
+	active = false;
+	if (span.first_byte_ns == 0) {
+		span.first_byte_ns = span.last_byte_ns = xmysqlnd_trace_now_ns();
+	}
+	xmysqlnd_get_trace_buffer().push(span);
+}
+
+// ----------------------------------------------------------------------------
+
+uint64_t xmysqlnd_trace_now_ns()
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		Perf_clock::now().time_since_epoch()).count());
+}
+
+uint64_t xmysqlnd_trace_to_unix_ns(uint64_t steady_ns)
+{
+	const uint64_t steady_now_ns{ xmysqlnd_trace_now_ns() };
+	const uint64_t unix_now_ns{ static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count()) };
+	return unix_now_ns - (steady_now_ns - steady_ns);
+}
+
+Trace_buffer& xmysqlnd_get_trace_buffer()
+{
+	return MYSQL_XDEVAPI_G(trace_buffer);
+}
+
+} // namespace drv
+
+} // namespace mysqlx
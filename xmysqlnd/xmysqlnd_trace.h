@@ -0,0 +1,112 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#ifndef XMYSQLND_TRACE_H
+#define XMYSQLND_TRACE_H
+
+#include "xmysqlnd_perf_statistics.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace mysqlx {
+
+namespace drv {
+
+/*
+	Wire-level span of a single statement - from sending its request until its
+	response has been read. Timestamps are steady clock nanoseconds.
+*/
+struct Trace_span
+{
+	uint64_t span_id;
+	enum_xmysqlnd_perf_op op;
+	unsigned int command;
+	uint64_t send_ns;
+	uint64_t first_byte_ns;
+	uint64_t last_byte_ns;
+	uint64_t rows;
+	uint64_t bytes_sent;
+	uint64_t bytes_received;
+	uint64_t decode_ns;
+};
+
+/*
+	Ring of finished spans, the oldest ones are overwritten when it is full. It
+	lives in the module globals, so it is per thread (ZTS) or per process and is
+	written and drained without any locks. It has no constructor - call init()
+	before use and release() at the end.
+*/
+class Trace_buffer
+{
+public:
+	void init();
+	void release();
+
+	// decides whether the next statement is traced, according to xmysqlnd.trace_sample_rate
+	bool sample();
+	uint64_t next_span_id();
+
+	void push(const Trace_span& span);
+
+	std::size_t size() const;
+	const Trace_span& get(std::size_t i) const;
+	uint64_t get_dropped() const { return dropped; }
+	void clear();
+
+private:
+	bool reserve();
+
+	Trace_span* spans;
+	std::size_t capacity;
+	uint64_t pushed;
+	uint64_t dropped;
+	uint64_t sample_counter;
+	uint64_t span_id_seed;
+};
+
+/*
+	Span of the statement awaiting its response on a connection, kept by the
+	protocol frame codec like Perf_pending_op. When tracing is disabled start()
+	costs a single check, and the receive path just tests is_active().
+*/
+class Trace_span_recorder
+{
+public:
+	void start(enum_xmysqlnd_perf_op op, unsigned int command, std::size_t bytes_sent);
+	void on_frame_received(std::size_t frame_size);
+	void on_row_decoded(const Perf_clock::time_point& decode_started);
+	void finish();
+
+	bool is_active() const { return active; }
+
+private:
+	Trace_span span{};
+	bool active{false};
+};
+
+uint64_t xmysqlnd_trace_now_ns();
+
+// converts a steady clock timestamp to nanoseconds since the unix epoch
+uint64_t xmysqlnd_trace_to_unix_ns(uint64_t steady_ns);
+
+Trace_buffer& xmysqlnd_get_trace_buffer();
+
+} // namespace drv
+
+} // namespace mysqlx
+
+#endif // XMYSQLND_TRACE_H
@@ -21,40 +21,201 @@ extern "C" {
 #include <ext/json/php_json.h>
 }
 #include "xmysqlnd_utils.h"
+#include "util/types.h"
+#include "rapidjson/memorystream.h"
+#include "rapidjson/reader.h"
 #include <algorithm>
+#include <charconv>
 
 namespace mysqlx {
 
 namespace drv {
 
+namespace {
+
+/*
+  SAX handler building the same value as php_json_decode(assoc=TRUE), straight
+  from the raw document bytes - no intermediate DOM, no row hash.
+*/
+class Doc_decoder : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Doc_decoder>
+{
+public:
+	explicit Doc_decoder(zval* dest);
+	~Doc_decoder();
+
+	bool Null();
+	bool Bool(bool value);
+	bool RawNumber(const char* str, rapidjson::SizeType length, bool copy);
+	bool String(const char* str, rapidjson::SizeType length, bool copy);
+
+	bool StartObject();
+	bool Key(const char* str, rapidjson::SizeType length, bool copy);
+	bool EndObject(rapidjson::SizeType member_count);
+
+	bool StartArray();
+	bool EndArray(rapidjson::SizeType element_count);
+
+private:
+	bool open_container();
+	bool close_container();
+	bool add(zval* value);
+
+private:
+	struct Container
+	{
+		zval value;
+		zend_string* key;
+	};
+
+	zval* dest;
+	util::vector<Container> containers;
+};
+
+Doc_decoder::Doc_decoder(zval* dest)
+	: dest(dest)
+{
+}
+
+Doc_decoder::~Doc_decoder()
+{
+	// non-empty only if parsing failed in the middle of the document
+	for (auto& container : containers) {
+		zval_ptr_dtor(&container.value);
+		if (container.key) {
+			zend_string_release(container.key);
+		}
+	}
+}
+
+bool Doc_decoder::Null()
+{
+	zval value;
+	ZVAL_NULL(&value);
+	return add(&value);
+}
+
+bool Doc_decoder::Bool(bool flag)
+{
+	zval value;
+	ZVAL_BOOL(&value, flag);
+	return add(&value);
+}
+
+bool Doc_decoder::RawNumber(const char* str, rapidjson::SizeType length, bool /*copy*/)
+{
+	// the same as ext/json: integers which don't fit into zend_long become doubles
+	zval value;
+	const char* end{ str + length };
+	if (std::find_if(str, end, [](char c) { return c == '.' || c == 'e' || c == 'E'; }) == end) {
+		zend_long number{0};
+		const auto [ptr, ec]{ std::from_chars(str, end, number) };
+		if ((ec == std::errc()) && (ptr == end)) {
+			ZVAL_LONG(&value, number);
+			return add(&value);
+		}
+	}
+	ZVAL_DOUBLE(&value, zend_strtod(str, nullptr));
+	return add(&value);
+}
+
+bool Doc_decoder::String(const char* str, rapidjson::SizeType length, bool /*copy*/)
+{
+	zval value;
+	ZVAL_STRINGL(&value, str, length);
+	return add(&value);
+}
+
+bool Doc_decoder::StartObject()
+{
+	return open_container();
+}
+
+bool Doc_decoder::Key(const char* str, rapidjson::SizeType length, bool /*copy*/)
+{
+	Container& container{ containers.back() };
+	container.key = zend_string_init(str, length, 0);
+	return true;
+}
+
+bool Doc_decoder::EndObject(rapidjson::SizeType /*member_count*/)
+{
+	return close_container();
+}
+
+bool Doc_decoder::StartArray()
+{
+	return open_container();
+}
+
+bool Doc_decoder::EndArray(rapidjson::SizeType /*element_count*/)
+{
+	return close_container();
+}
+
+bool Doc_decoder::open_container()
+{
+	if (containers.size() >= PHP_JSON_PARSER_DEFAULT_DEPTH) return false;
+	Container container{};
+	array_init(&container.value);
+	containers.push_back(container);
+	return true;
+}
+
+bool Doc_decoder::close_container()
+{
+	zval value;
+	ZVAL_COPY_VALUE(&value, &containers.back().value);
+	containers.pop_back();
+	return add(&value);
+}
+
+bool Doc_decoder::add(zval* value)
+{
+	if (containers.empty()) {
+		ZVAL_COPY_VALUE(dest, value);
+		return true;
+	}
+
+	Container& container{ containers.back() };
+	if (container.key) {
+		zend_symtable_update(Z_ARRVAL(container.value), container.key, value);
+		zend_string_release(container.key);
+		container.key = nullptr;
+	} else {
+		zend_hash_next_index_insert(Z_ARRVAL(container.value), value);
+	}
+	return true;
+}
+
+} // anonymous namespace
+
 util::zvalue
-xmysqlnd_utils_decode_doc_row(const util::zvalue& src)
-{
-	assert(src.is_array());
-	util::zvalue row_data = src.find("doc");
-	util::zvalue dest;
-	if (row_data.is_string()) {
-		php_json_decode(
-			dest.ptr(),
-			const_cast<char*>(row_data.c_str()),
-			static_cast<int>(row_data.length()),
-			TRUE,
-			PHP_JSON_PARSER_DEFAULT_DEPTH);
+xmysqlnd_utils_decode_doc(const util::zvalue& raw_doc)
+{
+	util::zvalue doc;
+	if (!raw_doc.is_string()) return doc;
+
+	Doc_decoder decoder(doc.ptr());
+	rapidjson::MemoryStream stream(raw_doc.c_str(), raw_doc.length());
+	rapidjson::Reader reader;
+	const rapidjson::ParseResult result{
+		reader.Parse<rapidjson::kParseNumbersAsStringsFlag | rapidjson::kParseValidateEncodingFlag>(
+			stream, decoder) };
+	if (result.IsError()) {
+		// the same as php_json_decode on failure
+		doc.reset();
 	}
-	return dest;
+	return doc;
 }
 
 util::zvalue
-xmysqlnd_utils_decode_doc_rows(const util::zvalue& src)
+xmysqlnd_utils_decode_docs(const util::zvalue& raw_docs)
 {
-	util::zvalue dest = util::zvalue::create_array();
-	if (src.is_array()) {
-		for (util::zvalue raw_row : src.values()) {
-			util::zvalue row = xmysqlnd_utils_decode_doc_row(raw_row);
-			dest.push_back(row);
-		}
+	util::zvalue docs = util::zvalue::create_array(raw_docs.size());
+	for (const util::zvalue& raw_doc : raw_docs.values()) {
+		docs.push_back(xmysqlnd_utils_decode_doc(raw_doc));
 	}
-	return dest;
+	return docs;
 }
 
 /* The ascii-to-ebcdic table: */
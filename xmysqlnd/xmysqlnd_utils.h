@@ -26,8 +26,8 @@ namespace mysqlx {
 
 namespace drv {
 
-util::zvalue xmysqlnd_utils_decode_doc_row(const util::zvalue& src);
-util::zvalue xmysqlnd_utils_decode_doc_rows(const util::zvalue& src);
+util::zvalue xmysqlnd_utils_decode_doc(const util::zvalue& raw_doc);
+util::zvalue xmysqlnd_utils_decode_docs(const util::zvalue& raw_docs);
 
 //https://en.wikipedia.org/wiki/Percent-encoding
 util::string decode_pct_path(const util::string& encoded_path);
@@ -46,6 +46,8 @@
 #include "util/string_utils.h"
 #include "util/value.h"
 #include "protobuf_api.h"
+#include <algorithm>
+#include <cstring>
 
 namespace mysqlx {
 
@@ -363,16 +365,128 @@ std::string prepare_compression_message_payload(
 }
 
 const std::size_t SIZE_OF_STACK_BUFFER = 1024;
+const std::size_t FRAME_HEADER_SIZE = 5; /* payload length + message type */
 
-static const enum_func_status
-xmysqlnd_send_message(
+/*
+	operation whose latency is measured from sending the request until its response
+	has been read, XMYSQLND_PERF_OP_LAST if the message isn't timed
+*/
+static enum_xmysqlnd_perf_op
+get_perf_op(xmysqlnd_client_message_type packet_type)
+{
+	switch (packet_type) {
+		case COM_CRUD_FIND:
+			return XMYSQLND_PERF_OP_FIND;
+		case COM_CRUD_INSERT:
+			return XMYSQLND_PERF_OP_INSERT;
+		case COM_CRUD_UPDATE:
+			return XMYSQLND_PERF_OP_UPDATE;
+		case COM_CRUD_DELETE:
+			return XMYSQLND_PERF_OP_DELETE;
+		case COM_SQL_STMT_EXECUTE:
+			return XMYSQLND_PERF_OP_SQL;
+		case COM_PREPARE_PREPARE:
+			return XMYSQLND_PERF_OP_PREPARE;
+		case COM_PREPARE_EXECUTE:
+			return XMYSQLND_PERF_OP_EXECUTE;
+		case COM_SESSION_RESET:
+			return XMYSQLND_PERF_OP_RESET;
+		default:
+			return XMYSQLND_PERF_OP_LAST;
+	}
+}
+
+// messages which may start a transaction, the ones of the connection and session itself don't
+static bool
+is_statement_message(const xmysqlnd_client_message_type packet_type)
+{
+	switch (packet_type) {
+		case COM_SQL_STMT_EXECUTE:
+		case COM_CRUD_FIND:
+		case COM_CRUD_INSERT:
+		case COM_CRUD_UPDATE:
+		case COM_CRUD_DELETE:
+		case COM_CRUD_CREATE_VIEW:
+		case COM_CRUD_MODIFY_VIEW:
+		case COM_CRUD_DROP_VIEW:
+		case COM_PREPARE_PREPARE:
+		case COM_PREPARE_EXECUTE:
+		case COM_CURSOR_OPEN:
+			return true;
+		default:
+			return false;
+	}
+}
+
+// the deferred START TRANSACTION is never mixed with compression, so it goes out in plain frames
+static enum_func_status
+send_plain_message(
 	xmysqlnd_client_message_type packet_type,
-	::google::protobuf::Message& message,
+	const ::google::protobuf::Message& message,
+	Message_context& msg_ctx)
+{
+	const std::string payload{ message.SerializeAsString() };
+	size_t bytes_sent{0};
+	return msg_ctx.pfc->data->m.send(
+		msg_ctx.pfc,
+		msg_ctx.vio,
+		static_cast<zend_uchar>(packet_type),
+		reinterpret_cast<const zend_uchar*>(payload.data()),
+		payload.length(),
+		&bytes_sent,
+		msg_ctx.stats,
+		msg_ctx.error_info);
+}
+
+/*
+	sends START TRANSACTION deferred by xmysqlnd_session_data::start_transaction,
+	right before the first statement of the transaction, so that it doesn't cost a
+	round trip of its own. Both go in an expectation block, so that if START
+	TRANSACTION fails, the server skips the statement instead of running it in
+	autocommit mode - the block is closed by send_deferred_trx_begin_end, right
+	after the statement.
+*/
+static enum_func_status
+send_deferred_trx_begin(Message_context& msg_ctx)
+{
+	DBG_ENTER("send_deferred_trx_begin");
+	Mysqlx::Expect::Open expect_open;
+	Mysqlx::Expect::Open_Condition* condition{ expect_open.add_cond() };
+	condition->set_condition_key(Mysqlx::Expect::Open_Condition::EXPECT_NO_ERROR);
+	condition->set_op(Mysqlx::Expect::Open_Condition::EXPECT_OP_SET);
+	if (FAIL == send_plain_message(COM_EXPECTATIONS_OPEN, expect_open, msg_ctx)) {
+		DBG_RETURN(FAIL);
+	}
+
+	Mysqlx::Sql::StmtExecute message;
+	message.set_namespace_("sql");
+	message.set_stmt("START TRANSACTION");
+	const enum_func_status ret{ send_plain_message(COM_SQL_STMT_EXECUTE, message, msg_ctx) };
+	if (PASS == ret) {
+		msg_ctx.pfc->data->trx_begin_unread = TRUE;
+	}
+	DBG_RETURN(ret);
+}
+
+static enum_func_status
+send_deferred_trx_begin_end(Message_context& msg_ctx)
+{
+	DBG_ENTER("send_deferred_trx_begin_end");
+	const Mysqlx::Expect::Close expect_close;
+	DBG_RETURN(send_plain_message(COM_EXPECTATIONS_CLOSE, expect_close, msg_ctx));
+}
+
+// sends the payload of an already serialized message, compressed if it is worth it
+static enum_func_status
+xmysqlnd_send_payload(
+	xmysqlnd_client_message_type packet_type,
+	util::byte* payload,
+	const size_t payload_size,
 	Message_context& msg_ctx,
 	size_t* bytes_sent)
 {
 	enum_func_status ret;
-	DBG_ENTER("xmysqlnd_send_message");
+	DBG_ENTER("xmysqlnd_send_payload");
 #ifdef PHP_DEBUG
 	if (!xmysqlnd_client_message_type_is_valid(packet_type)) {
 		SET_CLIENT_ERROR(msg_ctx.error_info, CR_UNKNOWN_ERROR, UNKNOWN_SQLSTATE, "The client wants to send invalid packet type");
@@ -380,25 +494,20 @@ xmysqlnd_send_message(
 		DBG_RETURN(FAIL);
 	}
 #endif
-	char stack_buffer[SIZE_OF_STACK_BUFFER];
-	void* payload = stack_buffer;
-
-	const size_t payload_size = message.ByteSize();
-	if (payload_size > sizeof(stack_buffer)) {
-		payload = payload_size? mnd_emalloc(payload_size) : nullptr;
-		if (payload_size && !payload) {
-			php_error_docref(nullptr, E_WARNING, "Memory allocation problem");
-			SET_OOM_ERROR(msg_ctx.error_info);
+	const bool trx_begin_sent{ msg_ctx.pfc->data->trx_begin_deferred && is_statement_message(packet_type) };
+	if (trx_begin_sent) {
+		msg_ctx.pfc->data->trx_begin_deferred = FALSE;
+		if (FAIL == send_deferred_trx_begin(msg_ctx)) {
 			DBG_RETURN(FAIL);
 		}
 	}
-	message.SerializeToArray(payload, static_cast<int>(payload_size));
+	size_t frame_size{FRAME_HEADER_SIZE + payload_size};
 	if ((payload_size < compression::Client_compression_threshold) || !msg_ctx.compression_executor->enabled()) {
 		ret = msg_ctx.pfc->data->m.send(
 			msg_ctx.pfc,
 			msg_ctx.vio,
 			static_cast<zend_uchar>(packet_type),
-			static_cast<zend_uchar*>(payload),
+			payload,
 			payload_size,
 			bytes_sent,
 			msg_ctx.stats,
@@ -407,7 +516,7 @@ xmysqlnd_send_message(
 		const compression::Compress_result& compress_result = msg_ctx.compression_executor->compress_message(
 			packet_type,
 			payload_size,
-			static_cast<util::byte*>(payload));
+			payload);
 		const std::string& msg_payload = prepare_compression_message_payload(
 			packet_type,
 			compress_result,
@@ -421,13 +530,83 @@ xmysqlnd_send_message(
 			bytes_sent,
 			msg_ctx.stats,
 			msg_ctx.error_info);
+		frame_size = FRAME_HEADER_SIZE + msg_payload.length();
 	}
+	if ((PASS == ret) && trx_begin_sent) {
+		ret = send_deferred_trx_begin_end(msg_ctx);
+	}
+	if (PASS == ret) {
+		const enum_xmysqlnd_perf_op perf_op{ get_perf_op(packet_type) };
+		if (perf_op != XMYSQLND_PERF_OP_LAST) {
+			msg_ctx.pfc->data->pending_op.start(perf_op);
+			msg_ctx.pfc->data->trace.start(perf_op, packet_type, frame_size);
+		}
+	}
+	DBG_RETURN(ret);
+}
+
+static const enum_func_status
+xmysqlnd_send_message(
+	xmysqlnd_client_message_type packet_type,
+	::google::protobuf::Message& message,
+	Message_context& msg_ctx,
+	size_t* bytes_sent)
+{
+	DBG_ENTER("xmysqlnd_send_message");
+	char stack_buffer[SIZE_OF_STACK_BUFFER];
+	void* payload = stack_buffer;
+
+	const size_t payload_size = message.ByteSize();
+	if (payload_size > sizeof(stack_buffer)) {
+		payload = payload_size? mnd_emalloc(payload_size) : nullptr;
+		if (payload_size && !payload) {
+			php_error_docref(nullptr, E_WARNING, "Memory allocation problem");
+			SET_OOM_ERROR(msg_ctx.error_info);
+			DBG_RETURN(FAIL);
+		}
+	}
+	message.SerializeToArray(payload, static_cast<int>(payload_size));
+	const enum_func_status ret = xmysqlnd_send_payload(
+		packet_type,
+		static_cast<util::byte*>(payload),
+		payload_size,
+		msg_ctx,
+		bytes_sent);
 	if (payload != stack_buffer) {
 		mnd_efree(payload);
 	}
 	DBG_RETURN(ret);
 }
 
+/*
+	encoded_fields are fields of the message laid out as on the wire by the caller,
+	e.g. the rows of Insert with documents encoded straight into them. The rest
+	of the message is appended to them, protobuf doesn't require any order of the
+	fields, so the big part is never copied. encoded_fields are restored before
+	return.
+*/
+static const enum_func_status
+xmysqlnd_send_message(
+	xmysqlnd_client_message_type packet_type,
+	const ::google::protobuf::Message& message,
+	std::string& encoded_fields,
+	Message_context& msg_ctx,
+	size_t* bytes_sent)
+{
+	DBG_ENTER("xmysqlnd_send_message");
+	const std::size_t encoded_size{ encoded_fields.size() };
+	message.AppendToString(&encoded_fields);
+	DBG_INF_FMT("encoded=" MYSQLND_SZ_T_SPEC " payload=" MYSQLND_SZ_T_SPEC, encoded_size, encoded_fields.size());
+	const enum_func_status ret = xmysqlnd_send_payload(
+		packet_type,
+		reinterpret_cast<util::byte*>(&encoded_fields[0]),
+		encoded_fields.size(),
+		msg_ctx,
+		bytes_sent);
+	encoded_fields.resize(encoded_size);
+	DBG_RETURN(ret);
+}
+
 struct st_xmysqlnd_server_messages_handlers
 {
 	const enum_hnd_func_status (*on_OK)(const Mysqlx::Ok & message, void * context);
@@ -436,7 +615,7 @@ struct st_xmysqlnd_server_messages_handlers
 	const enum_hnd_func_status (*on_AUTHENTICATE_CONTINUE)(const Mysqlx::Session::AuthenticateContinue & message, void * context);
 	const enum_hnd_func_status (*on_AUTHENTICATE_OK)(const Mysqlx::Session::AuthenticateOk & message, void * context);
 	const enum_hnd_func_status (*on_NOTICE)(const Mysqlx::Notice::Frame & message, void * context);
-	const enum_hnd_func_status (*on_COLUMN_META)(const Mysqlx::Resultset::ColumnMetaData & message, void * context);
+	const enum_hnd_func_status (*on_COLUMN_META)(const zend_uchar * const payload, const size_t payload_size, void * context);
 	const enum_hnd_func_status (*on_RSET_ROW)(const Mysqlx::Resultset::Row & message, void * context);
 	const enum_hnd_func_status (*on_RSET_FETCH_DONE)(const Mysqlx::Resultset::FetchDone & message, void * context);
 	const enum_hnd_func_status (*on_RSET_FETCH_SUSPENDED)(void * context); /*  there is no Mysqlx::Resultset::FetchSuspended*/
@@ -523,18 +702,21 @@ xmysqlnd_handler_func_status process_received_message(
 
 		case XMSG_COLUMN_METADATA:
 			if (handlers->on_COLUMN_META) {
-				Mysqlx::Resultset::ColumnMetaData message;
-				message.ParseFromArray(payload, payload_size);
-				hnd_ret = handlers->on_COLUMN_META(message, handler_ctx);
+				hnd_ret = handlers->on_COLUMN_META(payload, payload_size, handler_ctx);
 				handled = true;
 			}
 			break;
 
 		case XMSG_RSET_ROW:
 			if (handlers->on_RSET_ROW) {
+				Trace_span_recorder& trace{ msg_ctx.pfc->data->trace };
+				const Perf_clock::time_point decode_started{ trace.is_active() ? Perf_clock::now() : Perf_clock::time_point() };
 				Mysqlx::Resultset::Row message;
 				message.ParseFromArray(payload, payload_size);
 				hnd_ret = handlers->on_RSET_ROW(message, handler_ctx);
+				if (trace.is_active()) {
+					trace.on_row_decoded(decode_started);
+				}
 				handled = true;
 			}
 			break;
@@ -609,6 +791,93 @@ xmysqlnd_handler_func_status process_received_message(
 	DBG_RETURN(hnd_ret);
 }
 
+// the message which completes the response to a request, what follows belongs to the next one
+static bool
+is_response_end(const zend_uchar type)
+{
+	switch (type) {
+		case XMSG_OK:
+		case XMSG_ERROR:
+		case XMSG_STMT_EXECUTE_OK:
+		case XMGS_RSET_FETCH_SUSPENDED:
+			return true;
+		default:
+			return false;
+	}
+}
+
+/*
+	reads a response without handling it, returns FAIL only if it couldn't be read -
+	if the server returned an error, failed is set, and unless it was set already,
+	the error is stored in error
+*/
+static enum_func_status
+skip_response(Message_context& msg_ctx, bool& failed, Mysqlx::Error* error)
+{
+	DBG_ENTER("skip_response");
+	zend_uchar stack_buffer[SIZE_OF_STACK_BUFFER];
+	bool response_done{ false };
+	while (!response_done) {
+		size_t payload_size{0};
+		zend_uchar* payload{nullptr};
+		zend_uchar type{0};
+		if (FAIL == msg_ctx.pfc->data->m.receive(
+			msg_ctx.pfc,
+			msg_ctx.vio,
+			stack_buffer,
+			sizeof(stack_buffer),
+			&type,
+			&payload,
+			&payload_size,
+			msg_ctx.stats,
+			msg_ctx.error_info))
+		{
+			DBG_RETURN(FAIL);
+		}
+
+		if (type == XMSG_ERROR) {
+			if (!failed && error) {
+				error->ParseFromArray(payload, static_cast<int>(payload_size));
+				DBG_ERR_FMT("error: %s", error->msg().c_str());
+			}
+			failed = true;
+		}
+		// anything else is a notice, or a part of a response which is dropped anyway
+		response_done = is_response_end(type);
+		if (payload != stack_buffer) {
+			mnd_efree(payload);
+		}
+	}
+	DBG_RETURN(PASS);
+}
+
+/*
+	reads the responses to the expectation block opened by send_deferred_trx_begin,
+	and to START TRANSACTION. If that failed, the server skipped the statement sent
+	after it, so the responses to the statement and to the closing of the block are
+	read too, and trx_begin_failed is set, with the error of START TRANSACTION in
+	error.
+*/
+static enum_func_status
+skip_deferred_trx_begin_responses(Message_context& msg_ctx, bool& trx_begin_failed, Mysqlx::Error& error)
+{
+	DBG_ENTER("skip_deferred_trx_begin_responses");
+	if ((FAIL == skip_response(msg_ctx, trx_begin_failed, &error))
+		|| (FAIL == skip_response(msg_ctx, trx_begin_failed, &error)))
+	{
+		DBG_RETURN(FAIL);
+	}
+	if (trx_begin_failed) {
+		bool skipped_failed{ false };
+		if ((FAIL == skip_response(msg_ctx, skipped_failed, nullptr))
+			|| (FAIL == skip_response(msg_ctx, skipped_failed, nullptr)))
+		{
+			DBG_RETURN(FAIL);
+		}
+	}
+	DBG_RETURN(PASS);
+}
+
 enum_func_status
 xmysqlnd_receive_message(
 	st_xmysqlnd_server_messages_handlers* handlers,
@@ -621,10 +890,54 @@ xmysqlnd_receive_message(
 	size_t rcv_payload_size;
 	zend_uchar* payload;
 	zend_uchar type;
+	zend_uchar last_type{XMSG_NONE};
 	Messages decompressed_messages;
 
 	DBG_ENTER("xmysqlnd_receive_message");
 
+	/*
+		the messages queued by a batch of writes go out before anything is read, and
+		the responses to the batched writes come before the one expected here
+	*/
+	if (FAIL == msg_ctx.pfc->data->m.flush(msg_ctx.pfc, msg_ctx.vio, msg_ctx.stats, msg_ctx.error_info)) {
+		msg_ctx.pfc->data->pending_op.finish();
+		msg_ctx.pfc->data->trace.finish();
+		DBG_RETURN(FAIL);
+	}
+	Write_batch* write_batch{ msg_ctx.pfc->data->write_batch };
+	if (write_batch && !write_batch->is_draining()) {
+		write_batch->drain();
+	}
+
+	/*
+		if START TRANSACTION failed, the statement sent after it was skipped by the
+		server, and so the statement is reported as failed, with the error of START
+		TRANSACTION - otherwise the closing of the expectation block is left unread
+		until the response to the statement is complete
+	*/
+	if (msg_ctx.pfc->data->trx_begin_unread) {
+		msg_ctx.pfc->data->trx_begin_unread = FALSE;
+		bool trx_begin_failed{ false };
+		Mysqlx::Error trx_begin_error;
+		ret = skip_deferred_trx_begin_responses(msg_ctx, trx_begin_failed, trx_begin_error);
+		if ((FAIL == ret) || trx_begin_failed) {
+			if (PASS == ret) {
+				SET_CLIENT_ERROR(
+					msg_ctx.error_info,
+					trx_begin_error.code(),
+					trx_begin_error.sql_state().c_str(),
+					trx_begin_error.msg().c_str());
+				if (handlers->on_ERROR) {
+					handlers->on_ERROR(trx_begin_error, handler_ctx);
+				}
+			}
+			msg_ctx.pfc->data->pending_op.finish();
+			msg_ctx.pfc->data->trace.finish();
+			DBG_RETURN(FAIL);
+		}
+		msg_ctx.pfc->data->trx_begin_end_unread = TRUE;
+	}
+
 	do {
 		if (decompressed_messages.empty()) {
 			ret = msg_ctx.pfc->data->m.receive(
@@ -638,8 +951,14 @@ xmysqlnd_receive_message(
 				msg_ctx.stats,
 				msg_ctx.error_info);
 			if (FAIL == ret) {
+				msg_ctx.pfc->data->pending_op.finish();
+				msg_ctx.pfc->data->trace.finish();
 				DBG_RETURN(FAIL);
 			}
+			last_type = type;
+			if (msg_ctx.pfc->data->trace.is_active()) {
+				msg_ctx.pfc->data->trace.on_frame_received(FRAME_HEADER_SIZE + rcv_payload_size);
+			}
 			hnd_ret = process_received_message(
 				handlers,
 				handler_ctx,
@@ -671,8 +990,22 @@ xmysqlnd_receive_message(
 			decompressed_messages.clear();
 		}
 	} while (hnd_ret == HND_AGAIN);
+	/*
+		a forward-only cursor is read in chunks, so for it the latency covers the
+		request and the first chunk of rows only, and so does the trace span
+	*/
+	msg_ctx.pfc->data->pending_op.finish();
+	msg_ctx.pfc->data->trace.finish();
 	DBG_INF_FMT("hnd_ret=%d", hnd_ret);
 	ret = (hnd_ret == HND_PASS || hnd_ret == HND_AGAIN_ASYNC)? PASS:FAIL;
+	if (msg_ctx.pfc->data->trx_begin_end_unread && is_response_end(last_type)) {
+		// if the statement failed, so does the closing of the block, it's been reported already
+		msg_ctx.pfc->data->trx_begin_end_unread = FALSE;
+		bool block_failed{ false };
+		if (FAIL == skip_response(msg_ctx, block_failed, nullptr)) {
+			ret = FAIL;
+		}
+	}
 	DBG_INF(ret == PASS? "PASS":"FAIL");
 	DBG_RETURN(ret);
 }
@@ -1073,9 +1406,108 @@ stmt_execute_on_NOTICE(const Mysqlx::Notice::Frame& message, void* context)
 }
 
 static const enum_hnd_func_status
-stmt_execute_on_COLUMN_META(const Mysqlx::Resultset::ColumnMetaData& message, void* context)
+stmt_execute_add_meta_field(st_xmysqlnd_result_set_reader_ctx* const ctx, const Mysqlx::Resultset::ColumnMetaData& message)
+{
+	enum_hnd_func_status ret{HND_AGAIN};
+	DBG_ENTER("stmt_execute_add_meta_field");
+
+	XMYSQLND_RESULT_FIELD_META * field = ctx->create_meta_field.create(ctx->create_meta_field.ctx);
+	if (!field) {
+		if (ctx->msg_ctx.error_info) {
+			SET_OOM_ERROR(ctx->msg_ctx.error_info);
+		}
+		DBG_INF("HND_FAIL");
+		DBG_RETURN(HND_FAIL);
+	}
+	if (message.has_type()) {
+		field->m->set_type(field, static_cast<xmysqlnd_field_type>(message.type()));
+	}
+	if (message.has_name()) {
+		field->m->set_name(field, message.name().c_str(), message.name().size());
+	}
+	if (message.has_original_name()) {
+		field->m->set_original_name(field, message.original_name().c_str(), message.original_name().size());
+	}
+	if (message.has_table()) {
+		field->m->set_table(field, message.table().c_str(), message.table().size());
+	}
+	if (message.has_original_table()) {
+		field->m->set_original_table(field, message.original_table().c_str(), message.original_table().size());
+	}
+	if (message.has_schema()) {
+		field->m->set_schema(field, message.schema().c_str(), message.schema().size());
+	}
+	if (message.has_catalog()) {
+		field->m->set_catalog(field, message.catalog().c_str(), message.catalog().size());
+	}
+	if (message.has_collation()) {
+		field->m->set_collation(field, message.collation());
+	}
+	if (message.has_fractional_digits()) {
+		field->m->set_fractional_digits(field, message.fractional_digits());
+	}
+	if (message.has_length()) {
+		field->m->set_length(field, message.length());
+	}
+	if (message.has_flags()) {
+		field->m->set_flags(field, message.flags());
+	}
+	if (message.has_content_type()) {
+		field->m->set_content_type(field, message.content_type());
+	}
+
+	ctx->decode_plan.push_back({xmysqlnd_row_field_decoder(field), field});
+
+	ret = ctx->on_meta_field.handler(ctx->on_meta_field.ctx, field);
+
+	DBG_INF_FMT("ret=%s", ret == HND_AGAIN? "HND_AGAIN":"n/a");
+	DBG_RETURN(ret);
+}
+
+/*
+  Called by every message which may follow the metadata. A cached meta built from the
+  very same frames is reused as is, otherwise the frames are parsed into a new one.
+*/
+static const enum_hnd_func_status
+stmt_execute_flush_meta(st_xmysqlnd_result_set_reader_ctx* const ctx)
 {
 	enum_hnd_func_status ret{HND_AGAIN};
+	if (ctx->meta_frames.empty()) {
+		return ret;
+	}
+	DBG_ENTER("stmt_execute_flush_meta");
+	const util::string_view frames(ctx->meta_frames);
+	const st_xmysqlnd_stmt_result_meta* const cached_meta{
+		ctx->meta_cache.lookup? ctx->meta_cache.lookup(ctx->meta_cache.ctx, frames) : nullptr };
+	DBG_INF_FMT("cached_meta=%p", cached_meta);
+	if (cached_meta) {
+		for (unsigned int i{0}; i < cached_meta->field_count; ++i) {
+			const XMYSQLND_RESULT_FIELD_META* field = cached_meta->fields[i];
+			ctx->decode_plan.push_back({xmysqlnd_row_field_decoder(field), field});
+		}
+	} else {
+		size_t offset{0};
+		while (ret == HND_AGAIN && offset < frames.size()) {
+			uint32_t frame_size;
+			memcpy(&frame_size, frames.data() + offset, sizeof(frame_size));
+			offset += sizeof(frame_size);
+
+			Mysqlx::Resultset::ColumnMetaData message;
+			message.ParseFromArray(frames.data() + offset, static_cast<int>(frame_size));
+			offset += frame_size;
+			ret = stmt_execute_add_meta_field(ctx, message);
+		}
+		if (ret == HND_AGAIN && ctx->meta_cache.store) {
+			ctx->meta_cache.store(ctx->meta_cache.ctx, frames);
+		}
+	}
+	ctx->meta_frames.clear();
+	DBG_RETURN(ret);
+}
+
+static const enum_hnd_func_status
+stmt_execute_on_COLUMN_META(const zend_uchar * const payload, const size_t payload_size, void* context)
+{
 	st_xmysqlnd_result_set_reader_ctx* const ctx = static_cast<st_xmysqlnd_result_set_reader_ctx* >(context);
 
 	DBG_ENTER("stmt_execute_on_COLUMN_META");
@@ -1088,89 +1520,20 @@ stmt_execute_on_COLUMN_META(const Mysqlx::Resultset::ColumnMetaData& message, vo
 	DBG_INF_FMT("field_count=%u", ctx->field_count);
 
 	if (ctx->create_meta_field.create && ctx->on_meta_field.handler) {
-		XMYSQLND_RESULT_FIELD_META * field = ctx->create_meta_field.create(ctx->create_meta_field.ctx);
-		if (!field) {
-			if (ctx->msg_ctx.error_info) {
-				SET_OOM_ERROR(ctx->msg_ctx.error_info);
-			}
-			DBG_INF("HND_FAIL");
-			DBG_RETURN(HND_FAIL);
-		}
-		if (message.has_type()) {
-			field->m->set_type(field, static_cast<xmysqlnd_field_type>(message.type()));
-		}
-		if (message.has_name()) {
-			field->m->set_name(field, message.name().c_str(), message.name().size());
-		}
-		if (message.has_original_name()) {
-			field->m->set_original_name(field, message.original_name().c_str(), message.original_name().size());
-		}
-		if (message.has_table()) {
-			field->m->set_table(field, message.table().c_str(), message.table().size());
-		}
-		if (message.has_original_table()) {
-			field->m->set_original_table(field, message.original_table().c_str(), message.original_table().size());
-		}
-		if (message.has_schema()) {
-			field->m->set_schema(field, message.schema().c_str(), message.schema().size());
-		}
-		if (message.has_catalog()) {
-			field->m->set_catalog(field, message.catalog().c_str(), message.catalog().size());
-		}
-		if (message.has_collation()) {
-			field->m->set_collation(field, message.collation());
-		}
-		if (message.has_fractional_digits()) {
-			field->m->set_fractional_digits(field, message.fractional_digits());
-		}
-		if (message.has_length()) {
-			field->m->set_length(field, message.length());
-		}
-		if (message.has_flags()) {
-			field->m->set_flags(field, message.flags());
-		}
-		if (message.has_content_type()) {
-			field->m->set_content_type(field, message.content_type());
-		}
-
-		ret = ctx->on_meta_field.handler(ctx->on_meta_field.ctx, field);
-
-		DBG_INF_FMT("ret=%s", ret == HND_AGAIN? "HND_AGAIN":"n/a");
-		DBG_RETURN(ret);
-	} else {
-		/* skipping */
-		DBG_INF("HND_AGAIN");
-		DBG_RETURN(ret);
+		/* parsing waits for stmt_execute_flush_meta(), the session may know these columns already */
+		const uint32_t frame_size{ static_cast<uint32_t>(payload_size) };
+		ctx->meta_frames.append(reinterpret_cast<const char*>(&frame_size), sizeof(frame_size));
+		ctx->meta_frames.append(reinterpret_cast<const char*>(payload), payload_size);
 	}
-}
-
-static const char * zt2str[] =
-{
-	"UNDEF",
-	"NULL",
-	"FALSE",
-	"TRUE",
-	"LONG",
-	"DOUBLE",
-	"STRING",
-	"ARRAY",
-	"OBJECT",
-	"RESOURCE",
-	"REFERENCE",
-};
-
-static inline const char *
-ztype2str(const zval * const zv)
-{
-	const unsigned int type = Z_TYPE_P(zv);
-	if (type > IS_REFERENCE) return "n/a";
-	return zt2str[type];
+	DBG_INF("HND_AGAIN");
+	DBG_RETURN(HND_AGAIN);
 }
 
 static
 enum_func_status xmysqlnd_row_sint_field_to_zval( zval* zv,
 									  const uint8_t * buf,
-									  const size_t buf_size )
+									  const size_t buf_size,
+									  const XMYSQLND_RESULT_FIELD_META * const /*field_meta*/ )
 {
 	DBG_ENTER("xmysqlnd_row_sint_field_to_zval");
 	enum_func_status ret{PASS};
@@ -1199,7 +1562,8 @@ enum_func_status xmysqlnd_row_sint_field_to_zval( zval* zv,
 static
 enum_func_status xmysqlnd_row_uint_field_to_zval( zval* zv,
 									  const uint8_t * buf,
-									  const size_t buf_size )
+									  const size_t buf_size,
+									  const XMYSQLND_RESULT_FIELD_META * const /*field_meta*/ )
 {
 	DBG_ENTER("xmysqlnd_row_uint_field_to_zval");
 	enum_func_status ret{PASS};
@@ -1228,7 +1592,8 @@ enum_func_status xmysqlnd_row_uint_field_to_zval( zval* zv,
 static
 enum_func_status xmysqlnd_row_double_field_to_zval( zval* zv,
 									  const uint8_t * buf,
-									  const size_t buf_size )
+									  const size_t buf_size,
+									  const XMYSQLND_RESULT_FIELD_META * const /*field_meta*/ )
 {
 	DBG_ENTER("xmysqlnd_row_double_field_to_zval");
 	enum_func_status ret{PASS};
@@ -1250,7 +1615,7 @@ static
 enum_func_status xmysqlnd_row_float_field_to_zval( zval* zv,
 									  const uint8_t * buf,
 									  const size_t buf_size,
-										const XMYSQLND_RESULT_FIELD_META * const field_meta )
+									  const XMYSQLND_RESULT_FIELD_META * const field_meta )
 {
 	DBG_ENTER("xmysqlnd_row_float_field_to_zval");
 	enum_func_status ret{PASS};
@@ -1274,15 +1639,124 @@ enum_func_status xmysqlnd_row_float_field_to_zval( zval* zv,
 	DBG_RETURN( ret );
 }
 
+namespace {
+
+/*
+	Lookup tables for the hot decoders below - every packed BCD byte of a DECIMAL
+	and every two-digit part of a temporal value becomes two chars at once.
+*/
+struct Digit_pairs
+{
+	constexpr Digit_pairs(bool bcd) : pairs{}
+	{
+		for (unsigned int i{0}; i < 256; ++i) {
+			pairs[i][0] = static_cast<char>('0' + (bcd ? (i >> 4) : (i / 10 % 10)));
+			pairs[i][1] = static_cast<char>('0' + (bcd ? (i & 0x0F) : (i % 10)));
+		}
+	}
+
+	char pairs[256][2];
+};
+
+constexpr Digit_pairs bcd_digit_pairs{true};
+constexpr Digit_pairs decimal_digit_pairs{false};
+
+/*
+	Protobuf varint. X Protocol omits trailing zero parts of temporal values, so
+	the value is zeroed when the buffer is exhausted.
+*/
+inline bool read_varint(const uint8_t*& pos, const uint8_t* const end, uint64_t& value)
+{
+	value = 0;
+	if (pos == end) return false;
+	if (*pos < 0x80) {
+		value = *pos++;
+		return true;
+	}
+	for (unsigned int shift{0}; (pos != end) && (shift < 64); shift += 7) {
+		const uint8_t byte{*pos++};
+		value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) return true;
+	}
+	value = 0;
+	return false;
+}
+
+struct Padded_number
+{
+	uint64_t value;
+	unsigned int width;
+	char suffix; /* '\0' - none */
+};
+
+inline std::size_t padded_length(const Padded_number& number)
+{
+	std::size_t digits{1};
+	for (uint64_t value{number.value}; value >= 10; value /= 10) {
+		++digits;
+	}
+	return std::max<std::size_t>(digits, number.width) + (number.suffix ? 1 : 0);
+}
+
+inline char* write_padded(char* pos, const Padded_number& number)
+{
+	const std::size_t length{padded_length(number) - (number.suffix ? 1 : 0)};
+	char* digit{pos + length};
+	uint64_t value{number.value};
+	while (value >= 100) {
+		digit -= 2;
+		std::memcpy(digit, decimal_digit_pairs.pairs[value % 100], 2);
+		value /= 100;
+	}
+	if (value >= 10) {
+		digit -= 2;
+		std::memcpy(digit, decimal_digit_pairs.pairs[value], 2);
+	} else {
+		*--digit = static_cast<char>('0' + value);
+	}
+	while (digit > pos) {
+		*--digit = '0';
+	}
+	pos += length;
+	if (number.suffix) {
+		*pos++ = number.suffix;
+	}
+	return pos;
+}
+
+/*
+	printf("%s%0*u...") without the formatter - the exact length is computed first,
+	so the digits are written straight into the zend_string which ends up in the row.
+*/
+template<std::size_t Count>
+zend_string* format_padded_numbers(const util::string_view& prefix, const Padded_number (&numbers)[Count])
+{
+	std::size_t length{prefix.length()};
+	for (const Padded_number& number : numbers) {
+		length += padded_length(number);
+	}
+
+	zend_string* str{zend_string_alloc(length, 0)};
+	char* pos{ZSTR_VAL(str)};
+	std::memcpy(pos, prefix.data(), prefix.length());
+	pos += prefix.length();
+	for (const Padded_number& number : numbers) {
+		pos = write_padded(pos, number);
+	}
+	*pos = '\0';
+	return str;
+}
+
+} // anonymous namespace
+
 static
 enum_func_status xmysqlnd_row_time_field_to_zval( zval* zv,
 									  const uint8_t * buf,
-									  const size_t buf_size )
+									  const size_t buf_size,
+									  const XMYSQLND_RESULT_FIELD_META * const /*field_meta*/ )
 {
 	DBG_ENTER("xmysqlnd_row_time_field_to_zval");
 	enum_func_status ret{PASS};
-	::google::protobuf::io::CodedInputStream input_stream(buf, static_cast<int>(buf_size));
-	::google::protobuf::uint64 neg = 0, hours = 0, minutes = 0, seconds = 0, useconds = 0;
 	if ( buf_size != 0 )
 	{
 		if (buf_size == 1) {
@@ -1296,27 +1770,24 @@ enum_func_status xmysqlnd_row_time_field_to_zval( zval* zv,
 				ret = FAIL;
 			}
 		} else {
-			do {
-				if (!util::pb::read_variant_64(input_stream, &neg)) break;
-				DBG_INF_FMT("neg     =" MYSQLX_LLU_SPEC, neg);
-				if (!util::pb::read_variant_64(input_stream, &hours)) break;
-				DBG_INF_FMT("hours   =" MYSQLX_LLU_SPEC, hours);
-				if (!util::pb::read_variant_64(input_stream, &minutes)) break;
-				DBG_INF_FMT("mins    =" MYSQLX_LLU_SPEC, minutes);
-				if (!util::pb::read_variant_64(input_stream, &seconds)) break;
-				DBG_INF_FMT("secs    =" MYSQLX_LLU_SPEC, seconds);
-				if (!util::pb::read_variant_64(input_stream, &useconds)) break;
-				DBG_INF_FMT("usecs   =" MYSQLX_LLU_SPEC, useconds);
-			} while (0);
-
-			auto time_formatter = util::formatter("%s%02u:%02u:%02u.%08u")
-				% (neg ? "-" : "")
-				% hours
-				% minutes
-				% seconds
-				% useconds;
-			util::zvalue formatted_time = time_formatter.str();
-			formatted_time.move_to(zv);
+			const uint8_t* pos{buf};
+			const uint8_t* const end{buf + buf_size};
+			uint64_t neg{0}, hours{0}, minutes{0}, seconds{0}, useconds{0};
+			read_varint(pos, end, neg)
+				&& read_varint(pos, end, hours)
+				&& read_varint(pos, end, minutes)
+				&& read_varint(pos, end, seconds)
+				&& read_varint(pos, end, useconds);
+			DBG_INF_FMT("neg=" MYSQLX_LLU_SPEC "  time=" MYSQLX_LLU_SPEC ":" MYSQLX_LLU_SPEC ":" MYSQLX_LLU_SPEC "." MYSQLX_LLU_SPEC,
+				neg, hours, minutes, seconds, useconds);
+
+			const Padded_number time[]{
+				{hours, 2, ':'},
+				{minutes, 2, ':'},
+				{seconds, 2, '.'},
+				{useconds, 8, '\0'}
+			};
+			ZVAL_NEW_STR(zv, format_padded_numbers(neg ? "-" : "", time));
 		}
 	}
 	DBG_RETURN( ret );
@@ -1325,12 +1796,11 @@ enum_func_status xmysqlnd_row_time_field_to_zval( zval* zv,
 static
 enum_func_status xmysqlnd_row_datetime_field_to_zval( zval* zv,
 									  const uint8_t * buf,
-									  const size_t buf_size )
+									  const size_t buf_size,
+									  const XMYSQLND_RESULT_FIELD_META * const /*field_meta*/ )
 {
 	DBG_ENTER("xmysqlnd_row_datetime_field_to_zval");
 	enum_func_status ret{PASS};
-	::google::protobuf::io::CodedInputStream input_stream(buf, static_cast<int>(buf_size));
-	::google::protobuf::uint64 year = 0, month = 0, day = 0, hours = 0, minutes = 0, seconds = 0, useconds = 0;
 	if ( buf_size != 0 ) {
 		if (buf_size == 1) {
 			if (!buf[0]) {
@@ -1342,32 +1812,27 @@ enum_func_status xmysqlnd_row_datetime_field_to_zval( zval* zv,
 				ret = FAIL;
 			}
 		} else {
-			do {
-				if (!util::pb::read_variant_64(input_stream, &year)) break;
-				DBG_INF_FMT("year    =" MYSQLX_LLU_SPEC, year);
-				if (!util::pb::read_variant_64(input_stream, &month)) break;
-				DBG_INF_FMT("month   =" MYSQLX_LLU_SPEC, month);
-				if (!util::pb::read_variant_64(input_stream, &day)) break;
-				DBG_INF_FMT("day     =" MYSQLX_LLU_SPEC, day);
-				if (!util::pb::read_variant_64(input_stream, &hours)) break;
-				DBG_INF_FMT("hours   =" MYSQLX_LLU_SPEC, hours);
-				if (!util::pb::read_variant_64(input_stream, &minutes)) break;
-				DBG_INF_FMT("mins    =" MYSQLX_LLU_SPEC, minutes);
-				if (!util::pb::read_variant_64(input_stream, &seconds)) break;
-				DBG_INF_FMT("secs    =" MYSQLX_LLU_SPEC, seconds);
-				if (!util::pb::read_variant_64(input_stream, &useconds)) break;
-				DBG_INF_FMT("usecs   =" MYSQLX_LLU_SPEC, useconds);
-			} while (0);
-
-			auto datetime_formatter = util::formatter("%04u-%02u-%02u %02u:%02u:%02u")
-				% year
-				% month
-				% day
-				% hours
-				% minutes
-				% seconds;
-			util::zvalue formatted_datetime = datetime_formatter.str();
-			formatted_datetime.move_to(zv);
+			const uint8_t* pos{buf};
+			const uint8_t* const end{buf + buf_size};
+			uint64_t year{0}, month{0}, day{0}, hours{0}, minutes{0}, seconds{0};
+			read_varint(pos, end, year)
+				&& read_varint(pos, end, month)
+				&& read_varint(pos, end, day)
+				&& read_varint(pos, end, hours)
+				&& read_varint(pos, end, minutes)
+				&& read_varint(pos, end, seconds);
+			DBG_INF_FMT("datetime=" MYSQLX_LLU_SPEC "-" MYSQLX_LLU_SPEC "-" MYSQLX_LLU_SPEC " " MYSQLX_LLU_SPEC ":" MYSQLX_LLU_SPEC ":" MYSQLX_LLU_SPEC,
+				year, month, day, hours, minutes, seconds);
+
+			const Padded_number datetime[]{
+				{year, 4, '-'},
+				{month, 2, '-'},
+				{day, 2, ' '},
+				{hours, 2, ':'},
+				{minutes, 2, ':'},
+				{seconds, 2, '\0'}
+			};
+			ZVAL_NEW_STR(zv, format_padded_numbers({}, datetime));
 		}
 	}
 	DBG_RETURN( ret );
@@ -1377,39 +1842,36 @@ static
 enum_func_status xmysqlnd_row_date_field_to_zval(
 	zval* zv,
 	const uint8_t * buf,
-	const size_t buf_size)
+	const size_t buf_size,
+	const XMYSQLND_RESULT_FIELD_META * const /*field_meta*/)
 {
 	DBG_ENTER("xmysqlnd_row_date_field_to_zval");
 	enum_func_status ret{FAIL};
 	if (buf_size) {
-		::google::protobuf::io::CodedInputStream input_stream(buf, static_cast<int>(buf_size));
-		::google::protobuf::uint64 year = 0;
-		::google::protobuf::uint64 month = 0;
-		::google::protobuf::uint64 day = 0;
 		if (buf_size == 1) {
 			if (!buf[0]) {
-				const std::string date_null_value("0000-00-00");
-				ZVAL_NEW_STR(zv, zend_string_init(date_null_value.c_str(), date_null_value.length(), 0));
+#define	DATE_NULL_VALUE "0000-00-00"
+				ZVAL_NEW_STR(zv, zend_string_init(DATE_NULL_VALUE, sizeof(DATE_NULL_VALUE)-1, 0));
+#undef DATE_NULL_VALUE
 				ret = PASS;
 			} else {
 				php_error_docref(nullptr, E_WARNING, "Unexpected value %d for first byte of DATE", static_cast<unsigned int>(buf[0]));
 			}
 		} else {
-			do {
-				if (!util::pb::read_variant_64(input_stream, &year)) break;
-				DBG_INF_FMT("year  =" MYSQLX_LLU_SPEC, year);
-				if (!util::pb::read_variant_64(input_stream, &month)) break;
-				DBG_INF_FMT("month =" MYSQLX_LLU_SPEC, month);
-				if (!util::pb::read_variant_64(input_stream, &day)) break;
-				DBG_INF_FMT("day   =" MYSQLX_LLU_SPEC, day);
-			} while (0);
-
-			auto date_formatter = util::formatter("%04u-%02u-%02u")
-				% year
-				% month
-				% day;
-			util::zvalue formatted_date = date_formatter.str();
-			formatted_date.move_to(zv);
+			const uint8_t* pos{buf};
+			const uint8_t* const end{buf + buf_size};
+			uint64_t year{0}, month{0}, day{0};
+			read_varint(pos, end, year)
+				&& read_varint(pos, end, month)
+				&& read_varint(pos, end, day);
+			DBG_INF_FMT("date=" MYSQLX_LLU_SPEC "-" MYSQLX_LLU_SPEC "-" MYSQLX_LLU_SPEC, year, month, day);
+
+			const Padded_number date[]{
+				{year, 4, '-'},
+				{month, 2, '-'},
+				{day, 2, '\0'}
+			};
+			ZVAL_NEW_STR(zv, format_padded_numbers({}, date));
 			ret = PASS;
 		}
 	}
@@ -1419,40 +1881,30 @@ enum_func_status xmysqlnd_row_date_field_to_zval(
 static
 enum_func_status xmysqlnd_row_set_field_to_zval( zval* zv,
 									  const uint8_t * buf,
-									  const size_t buf_size )
+									  const size_t buf_size,
+									  const XMYSQLND_RESULT_FIELD_META * const /*field_meta*/ )
 {
 	DBG_ENTER("xmysqlnd_row_set_field_to_zval");
 	enum_func_status ret{PASS};
-	unsigned int j{0};
-	::google::protobuf::io::CodedInputStream input_stream(buf, static_cast<int>(buf_size));
-	::google::protobuf::uint64 gval;
-	bool length_read_ok{true};
 	array_init(zv);
 	if (buf_size == 1 && buf[0] == 0x1) { /* Empty set */
 		DBG_RETURN( ret );
 	}
-	while (length_read_ok) {
-		if ((length_read_ok = util::pb::read_variant_64(input_stream, &gval)) == true) {
-			char* set_value{nullptr};
-			int rest_buffer_size{0};
-			if (input_stream.GetDirectBufferPointer((const void**) &set_value, &rest_buffer_size)) {
-				zval set_entry;
-				DBG_INF_FMT("[%u]value length=%3u  rest_buffer_size=%3d", j, static_cast<unsigned int>(gval), rest_buffer_size);
-				if ((rest_buffer_size < 0) || (gval > static_cast<decltype(gval)>(rest_buffer_size))) {
-					DBG_ERR("Length pointing outside of the buffer");
-					php_error_docref(nullptr, E_WARNING, "Length pointing outside of the buffer");
-					ret = FAIL;
-					break;
-				}
-				ZVAL_STRINGL(&set_entry, set_value, static_cast<zend_long>(gval));
-				DBG_INF_FMT("[%u]subvalue=%s", j, Z_STRVAL(set_entry));
-				zend_hash_next_index_insert(Z_ARRVAL_P(zv), &set_entry);
-				if (!input_stream.Skip(static_cast<int>(gval))) {
-					break;
-				}
-			}
+	const uint8_t* pos{buf};
+	const uint8_t* const end{buf + buf_size};
+	uint64_t length;
+	while ((pos != end) && read_varint(pos, end, length)) {
+		if (length > static_cast<uint64_t>(end - pos)) {
+			DBG_ERR("Length pointing outside of the buffer");
+			php_error_docref(nullptr, E_WARNING, "Length pointing outside of the buffer");
+			ret = FAIL;
+			break;
 		}
-		j++;
+		zval set_entry;
+		ZVAL_STRINGL(&set_entry, reinterpret_cast<const char*>(pos), static_cast<size_t>(length));
+		DBG_INF_FMT("subvalue=%s", Z_STRVAL(set_entry));
+		zend_hash_next_index_insert(Z_ARRVAL_P(zv), &set_entry);
+		pos += length;
 	}
 	DBG_INF_FMT("set elements=%u", zend_hash_num_elements(Z_ARRVAL_P(zv)));
 	DBG_RETURN( ret );
@@ -1461,7 +1913,8 @@ enum_func_status xmysqlnd_row_set_field_to_zval( zval* zv,
 static
 enum_func_status xmysqlnd_row_decimal_field_to_zval( zval* zv,
 									  const uint8_t * buf,
-									  const size_t buf_size )
+									  const size_t buf_size,
+									  const XMYSQLND_RESULT_FIELD_META * const /*field_meta*/ )
 {
 	DBG_ENTER("xmysqlnd_row_decimal_field_to_zval");
 	enum_func_status ret{PASS};
@@ -1469,10 +1922,11 @@ enum_func_status xmysqlnd_row_decimal_field_to_zval( zval* zv,
 		DBG_RETURN( ret );
 	}
 	if (buf_size == 1) {
-		DBG_ERR_FMT("Unexpected value for first byte of TIME");
-		php_error_docref(nullptr, E_WARNING, "Unexpected value for first byte of TIME");
+		DBG_ERR_FMT("Unexpected value for first byte of DECIMAL");
+		php_error_docref(nullptr, E_WARNING, "Unexpected value for first byte of DECIMAL");
+		DBG_RETURN( FAIL );
 	}
-	const uint8_t scale = buf[0];
+	const size_t scale = buf[0];
 	const uint8_t last_byte = buf[buf_size - 1]; /* last byte is the sign and the last 4 bits, if any */
 	const uint8_t sign = ((last_byte & 0xF)? last_byte  : last_byte >> 4) & 0xF;
 	const size_t digits = (buf_size - 2 /* scale & last */) * 2  + ((last_byte & 0xF) > 0x9? 1:0);
@@ -1482,36 +1936,53 @@ enum_func_status xmysqlnd_row_decimal_field_to_zval( zval* zv,
 	if (!digits) {
 		DBG_ERR_FMT("Wrong value for DECIMAL. scale=%u  last_byte=%u", static_cast<unsigned int>(scale), last_byte);
 		php_error_docref(nullptr, E_WARNING, "Wrong value for DECIMAL. scale=%u  last_byte=%u", static_cast<unsigned int>(scale), last_byte);
-		ret = FAIL;
-	} else {
-		const size_t d_val_len = digits + (sign == 0xD? 1:0) + (digits > scale? 1:0); /* one for the dot, one for the sign*/
-		char * d_val = new char [d_val_len + 1];
-		d_val[d_val_len] = '\0';
-		char * p = d_val;
-		if (sign == 0xD) {
-			*(p++) = '-';
-		}
-		const size_t dot_position = digits - scale - 1;
-		for (unsigned int pos{0}; pos < digits; ++pos) {
-			const size_t offset = 1 + (pos >> 1);
-			/* if uneven (&0x01) then use the second 4-bits, otherwise shift (>>) the first 4 to the right and then use them */
-			const uint8_t digit = (pos & 0x01 ? buf[offset] : buf[offset] >> 4) & 0x0F;
-			*(p++) = '0' + digit;
-			if (pos == dot_position) {
-				*(p++) = '.';
-			}
-		}
-		DBG_INF_FMT("value   =%*s", d_val_len, d_val);
-		ZVAL_STRINGL(zv, d_val, d_val_len);
-		delete [] d_val;
+		DBG_RETURN( FAIL );
 	}
+
+	/* [-]integral[.fractional], values below 1 get "0." and zero padding if the digits don't cover the scale */
+	const bool negative = (sign == 0xD);
+	const size_t integral_digits = digits > scale ? digits - scale : 1;
+	const size_t leading_zeros = digits > scale ? 0 : scale - digits;
+	const size_t length = (negative ? 1 : 0) + integral_digits + (scale ? 1 + scale : 0);
+	zend_string* str = zend_string_alloc(length, 0);
+	char* pos = ZSTR_VAL(str);
+	if (negative) {
+		*pos++ = '-';
+	}
+	if (leading_zeros || (digits == scale)) {
+		std::memcpy(pos, "0.", 2);
+		pos += 2;
+		std::memset(pos, '0', leading_zeros);
+		pos += leading_zeros;
+	}
+
+	/* two digits per packed byte, the odd one sits in the upper half of the sign byte */
+	char* const digits_begin = pos;
+	const uint8_t* bcd = buf + 1;
+	for (size_t pairs = digits >> 1; pairs; --pairs, pos += 2) {
+		std::memcpy(pos, bcd_digit_pairs.pairs[*bcd++], 2);
+	}
+	if (digits & 0x01) {
+		*pos++ = bcd_digit_pairs.pairs[*bcd][0];
+	}
+
+	if (scale && (digits > scale)) {
+		char* const dot = digits_begin + integral_digits;
+		std::memmove(dot + 1, dot, scale);
+		*dot = '.';
+		++pos;
+	}
+	*pos = '\0';
+	DBG_INF_FMT("value   =%s", ZSTR_VAL(str));
+	ZVAL_NEW_STR(zv, str);
 	DBG_RETURN( ret );
 }
 
 static
 enum_func_status xmysqlnd_row_string_field_to_zval( zval* zv,
 									  const uint8_t * buf,
-									  const size_t buf_size )
+									  const size_t buf_size,
+									  const XMYSQLND_RESULT_FIELD_META * const /*field_meta*/ )
 {
 	DBG_ENTER("xmysqlnd_row_string_field_to_zval");
 	enum_func_status ret{PASS};
@@ -1528,97 +1999,72 @@ enum_func_status xmysqlnd_row_string_field_to_zval( zval* zv,
 	DBG_RETURN( ret );
 }
 
-static enum_func_status
-xmysqlnd_row_field_to_zval(const util::string_view& buffer,
-						   const XMYSQLND_RESULT_FIELD_META * const field_meta,
-						   const unsigned int /*i*/,
-						   zval * zv)
-{
-	enum_func_status ret{PASS};
-	const uint8_t * buf = reinterpret_cast<const uint8_t*>(buffer.data());
-	const size_t buf_size = buffer.length();
-	DBG_ENTER("xmysqlnd_row_field_to_zval");
-	DBG_INF_FMT("buf_size=%u", static_cast<unsigned int>(buf_size));
-	DBG_INF_FMT("name    =%s", field_meta->name.c_str());
-	/*
-		  Precaution, as if something misbehaves and doesn't initialize `zv` then `zv` will be at
-		  the same place in the stack and have the previous value. String reuse will lead to
-		  double-free and a crash.
-	*/
-	ZVAL_NULL(zv);
-	if ( buf_size != 0 ) {
-		switch (field_meta->type) {
-		case XMYSQLND_TYPE_SIGNED_INT:
-		{
-			DBG_INF("type    =SINT");
-			ret = xmysqlnd_row_sint_field_to_zval( zv, buf, buf_size );
-			break;
-		}
-		case XMYSQLND_TYPE_BIT:
-			DBG_INF("type    =BIT handled as UINT");
-		case XMYSQLND_TYPE_UNSIGNED_INT:
-		{
-			DBG_INF("type    =UINT");
-			ret = xmysqlnd_row_uint_field_to_zval( zv, buf, buf_size );
-			break;
-		}
-		case XMYSQLND_TYPE_DOUBLE:
-		{
-			DBG_INF("type    =DOUBLE");
-			ret = xmysqlnd_row_double_field_to_zval( zv, buf, buf_size );
-			break;
-		}
-		case XMYSQLND_TYPE_FLOAT:
-		{
-			DBG_INF_FMT("type    =FLOAT");
-			ret = xmysqlnd_row_float_field_to_zval( zv, buf, buf_size, field_meta );
-			break;
-		}
-		case XMYSQLND_TYPE_ENUM:
-			DBG_INF("type    =ENUM handled as STRING");
-		case XMYSQLND_TYPE_BYTES:
-		{
-			ret = xmysqlnd_row_string_field_to_zval( zv, buf, buf_size );
-			break;
-		}
-		case XMYSQLND_TYPE_TIME:
-		{
-			DBG_INF("[%2u]type    =TIME");
-			ret = xmysqlnd_row_time_field_to_zval( zv, buf, buf_size );
-			break;
-		}
-		case XMYSQLND_TYPE_DATETIME:
-		{
+static
+enum_func_status xmysqlnd_row_none_field_to_zval( zval* /*zv*/,
+									  const uint8_t * /*buf*/,
+									  const size_t /*buf_size*/,
+									  const XMYSQLND_RESULT_FIELD_META * const /*field_meta*/ )
+{
+	DBG_ENTER("xmysqlnd_row_none_field_to_zval");
+	DBG_INF("type    =NONE");
+	DBG_RETURN( PASS );
+}
+
+func_xmysqlnd_wireprotocol__row_field_decoder
+xmysqlnd_row_field_decoder(const XMYSQLND_RESULT_FIELD_META * const field_meta)
+{
+	DBG_ENTER("xmysqlnd_row_field_decoder");
+	DBG_INF_FMT("name    =%.*s", static_cast<int>(field_meta->name.length()), field_meta->name.data());
+	func_xmysqlnd_wireprotocol__row_field_decoder decoder{xmysqlnd_row_none_field_to_zval};
+	switch (field_meta->type) {
+	case XMYSQLND_TYPE_SIGNED_INT:
+		DBG_INF("type    =SINT");
+		decoder = xmysqlnd_row_sint_field_to_zval;
+		break;
+	case XMYSQLND_TYPE_BIT:
+		DBG_INF("type    =BIT handled as UINT");
+	case XMYSQLND_TYPE_UNSIGNED_INT:
+		DBG_INF("type    =UINT");
+		decoder = xmysqlnd_row_uint_field_to_zval;
+		break;
+	case XMYSQLND_TYPE_DOUBLE:
+		DBG_INF("type    =DOUBLE");
+		decoder = xmysqlnd_row_double_field_to_zval;
+		break;
+	case XMYSQLND_TYPE_FLOAT:
+		DBG_INF("type    =FLOAT");
+		decoder = xmysqlnd_row_float_field_to_zval;
+		break;
+	case XMYSQLND_TYPE_ENUM:
+		DBG_INF("type    =ENUM handled as STRING");
+	case XMYSQLND_TYPE_BYTES:
+		decoder = xmysqlnd_row_string_field_to_zval;
+		break;
+	case XMYSQLND_TYPE_TIME:
+		DBG_INF("type    =TIME");
+		decoder = xmysqlnd_row_time_field_to_zval;
+		break;
+	case XMYSQLND_TYPE_DATETIME:
+		if (get_datetime_type(field_meta) == FIELD_TYPE_DATETIME) {
 			DBG_INF("type    =DATETIME");
-			const int datetime_type = get_datetime_type(field_meta);
-			if (datetime_type == FIELD_TYPE_DATETIME) {
-				ret = xmysqlnd_row_datetime_field_to_zval( zv, buf, buf_size );
-			} else {
-				assert(datetime_type == FIELD_TYPE_DATE);
-				ret = xmysqlnd_row_date_field_to_zval( zv, buf, buf_size );
-			}
-			break;
-		}
-		case XMYSQLND_TYPE_SET:
-		{
-			DBG_INF_FMT("type    =SET");
-			ret = xmysqlnd_row_set_field_to_zval( zv, buf, buf_size );
-			break;
-		}
-		case XMYSQLND_TYPE_DECIMAL:{
-			DBG_INF("type    =DECIMAL");
-			ret = xmysqlnd_row_decimal_field_to_zval( zv, buf, buf_size );
-			break;
-		}
-		case XMYSQLND_TYPE_NONE:{
-			DBG_INF("type    =NONE");
-			break;
-		}
+			decoder = xmysqlnd_row_datetime_field_to_zval;
+		} else {
+			DBG_INF("type    =DATETIME handled as DATE");
+			decoder = xmysqlnd_row_date_field_to_zval;
 		}
-		DBG_INF_FMT("TYPE(zv)=%s", ztype2str(zv));
-		DBG_INF("");
+		break;
+	case XMYSQLND_TYPE_SET:
+		DBG_INF("type    =SET");
+		decoder = xmysqlnd_row_set_field_to_zval;
+		break;
+	case XMYSQLND_TYPE_DECIMAL:
+		DBG_INF("type    =DECIMAL");
+		decoder = xmysqlnd_row_decimal_field_to_zval;
+		break;
+	case XMYSQLND_TYPE_NONE:
+		break;
 	}
-	DBG_RETURN(ret);
+	DBG_RETURN(decoder);
 }
 
 static const enum_hnd_func_status
@@ -1627,14 +2073,38 @@ stmt_execute_on_RSET_ROW(const Mysqlx::Resultset::Row& message, void* context)
 	enum_hnd_func_status ret{HND_AGAIN};
 	st_xmysqlnd_result_set_reader_ctx* const ctx = static_cast<st_xmysqlnd_result_set_reader_ctx* >(context);
 	DBG_ENTER("stmt_execute_on_RSET_ROW");
-	DBG_INF_FMT("on_row_field.handler=%p  field_count=%u", ctx->on_row_field.handler, ctx->field_count);
+	DBG_INF_FMT("on_row.handler=%p  field_count=%u", ctx->on_row.handler, ctx->field_count);
 
+	if (stmt_execute_flush_meta(ctx) != HND_AGAIN) {
+		DBG_RETURN(HND_FAIL);
+	}
 	ctx->has_more_results = TRUE;
-	if (ctx->on_row_field.handler) {
-		for (unsigned int i{0}; i < ctx->field_count; ++i) {
-			const util::string_view buffer = message.field(i);
-			ret = ctx->on_row_field.handler(ctx->on_row_field.ctx, buffer, i, xmysqlnd_row_field_to_zval);
-
+	if (ctx->on_row.handler) {
+		zval* const row = ctx->on_row.create_row(ctx->on_row.ctx);
+		if (row) {
+			// timing every row would cost more than decoding the small ones, so only every 16th is timed
+			Perf_statistics* const perf_stats{ xmysqlnd_get_perf_statistics() };
+			const bool timed_row{ perf_stats && ((perf_stats->counters[XMYSQLND_PERF_ROWS_DECODED]++ & 0xF) == 0) };
+			const Perf_clock::time_point decode_started{ timed_row ? Perf_clock::now() : Perf_clock::time_point() };
+			const unsigned int field_count = std::min(static_cast<unsigned int>(ctx->decode_plan.size()),
+													  static_cast<unsigned int>(message.field_size()));
+			const st_xmysqlnd_row_field_decode_step* step = ctx->decode_plan.data();
+			for (unsigned int i{0}; i < field_count; ++i, ++step) {
+				const std::string& buffer = message.field(i);
+				/*
+					  Precaution, as if a decoder misbehaves and doesn't initialize the cell then
+					  it would keep garbage, and string reuse will lead to double-free and a crash.
+				*/
+				ZVAL_NULL(&row[i]);
+				if (!buffer.empty()) {
+					step->decoder(&row[i], reinterpret_cast<const uint8_t*>(buffer.data()), buffer.size(), step->field_meta);
+				}
+			}
+			if (timed_row) {
+				++perf_stats->counters[XMYSQLND_PERF_ROWS_DECODE_SAMPLED];
+				perf_stats->counters[XMYSQLND_PERF_ROWS_DECODE_SAMPLED_NS] += xmysqlnd_perf_elapsed_ns(decode_started);
+			}
+			ret = ctx->on_row.handler(ctx->on_row.ctx, row);
 			if (ret != HND_PASS && ret != HND_AGAIN) {
 				DBG_ERR("Something was wrong");
 				DBG_RETURN(ret);
@@ -1650,6 +2120,9 @@ stmt_execute_on_RSET_FETCH_DONE(const Mysqlx::Resultset::FetchDone& /*message*/,
 {
 	st_xmysqlnd_result_set_reader_ctx* const ctx = static_cast<st_xmysqlnd_result_set_reader_ctx* >(context);
 	DBG_ENTER("stmt_execute_on_RSET_FETCH_DONE");
+	if (stmt_execute_flush_meta(ctx) != HND_AGAIN) {
+		DBG_RETURN(HND_FAIL);
+	}
 	DBG_INF_FMT("on_resultset_end.handler=%p", ctx->on_resultset_end.handler);
 	ctx->has_more_results = FALSE;
 	ctx->has_more_rows_in_set = FALSE;
@@ -1664,6 +2137,9 @@ stmt_execute_on_RSET_FETCH_SUSPENDED(void * context)
 {
 	st_xmysqlnd_result_set_reader_ctx* const ctx = static_cast<st_xmysqlnd_result_set_reader_ctx* >(context);
 	DBG_ENTER("stmt_execute_on_RSET_FETCH_SUSPENDED");
+	if (stmt_execute_flush_meta(ctx) != HND_AGAIN) {
+		DBG_RETURN(HND_FAIL);
+	}
 	ctx->has_more_results = TRUE;
 	DBG_RETURN(HND_PASS);
 }
@@ -1673,6 +2149,9 @@ stmt_execute_on_RSET_FETCH_DONE_MORE_RSETS(const Mysqlx::Resultset::FetchDoneMor
 {
 	st_xmysqlnd_result_set_reader_ctx* const ctx = static_cast<st_xmysqlnd_result_set_reader_ctx* >(context);
 	DBG_ENTER("stmt_execute_on_RSET_FETCH_DONE_MORE_RSETS");
+	if (stmt_execute_flush_meta(ctx) != HND_AGAIN) {
+		DBG_RETURN(HND_FAIL);
+	}
 	DBG_INF_FMT("on_resultset_end.handler=%p", ctx->on_resultset_end.handler);
 	ctx->has_more_results = TRUE;
 	ctx->has_more_rows_in_set = FALSE;
@@ -1688,6 +2167,9 @@ stmt_execute_on_STMT_EXECUTE_OK(const Mysqlx::Sql::StmtExecuteOk& /*message*/, v
 	st_xmysqlnd_result_set_reader_ctx* const ctx = static_cast<st_xmysqlnd_result_set_reader_ctx* >(context);
 	DBG_ENTER("stmt_execute_on_STMT_EXECUTE_OK");
 	DBG_INF_FMT("on_stmt_execute_ok.handler=%p", ctx->on_stmt_execute_ok.handler);
+	if (stmt_execute_flush_meta(ctx) != HND_AGAIN) {
+		DBG_RETURN(HND_FAIL);
+	}
 	ctx->has_more_results = FALSE;
 	if (ctx->on_stmt_execute_ok.handler) {
 		ctx->on_stmt_execute_ok.handler(ctx->on_stmt_execute_ok.ctx);
@@ -1700,6 +2182,9 @@ stmt_execute_on_RSET_FETCH_DONE_MORE_OUT_PARAMS(const Mysqlx::Resultset::FetchDo
 {
 	st_xmysqlnd_result_set_reader_ctx* const ctx = static_cast<st_xmysqlnd_result_set_reader_ctx* >(context);
 	DBG_ENTER("stmt_execute_on_STMT_EXECUTE_OK");
+	if (stmt_execute_flush_meta(ctx) != HND_AGAIN) {
+		DBG_RETURN(HND_FAIL);
+	}
 	ctx->has_more_results = TRUE;
 	DBG_RETURN(HND_PASS);
 }
@@ -1739,7 +2224,8 @@ static st_xmysqlnd_server_messages_handlers stmt_execute_handlers =
 enum_func_status
 xmysqlnd_sql_stmt_execute__init_read(st_xmysqlnd_msg__sql_stmt_execute* const msg,
 									 const st_xmysqlnd_meta_field_create_bind create_meta_field,
-									 const st_xmysqlnd_on_row_field_bind on_row_field,
+									 const st_xmysqlnd_meta_cache_bind meta_cache,
+									 const st_xmysqlnd_on_row_bind on_row,
 									 const st_xmysqlnd_on_meta_field_bind on_meta_field,
 									 const st_xmysqlnd_on_warning_bind on_warning,
 									 const st_xmysqlnd_on_error_bind on_error,
@@ -1751,7 +2237,7 @@ xmysqlnd_sql_stmt_execute__init_read(st_xmysqlnd_msg__sql_stmt_execute* const ms
 									 const st_xmysqlnd_on_resultset_end_bind on_resultset_end)
 {
 	DBG_ENTER("xmysqlnd_sql_stmt_execute__init_read");
-	DBG_INF_FMT("on_row_field.handler  =%p", on_row_field.handler);
+	DBG_INF_FMT("on_row.handler        =%p", on_row.handler);
 	DBG_INF_FMT("on_meta_field.handler =%p", on_meta_field.handler);
 	DBG_INF_FMT("on_warning.handler    =%p", on_warning.handler);
 	DBG_INF_FMT("on_error.handler      =%p", on_error.handler);
@@ -1763,8 +2249,9 @@ xmysqlnd_sql_stmt_execute__init_read(st_xmysqlnd_msg__sql_stmt_execute* const ms
 	DBG_INF_FMT("on_resultset_end.handler         =%p", on_resultset_end.handler);
 
 	msg->reader_ctx.create_meta_field = create_meta_field;
+	msg->reader_ctx.meta_cache = meta_cache;
 
-	msg->reader_ctx.on_row_field = on_row_field;
+	msg->reader_ctx.on_row = on_row;
 	msg->reader_ctx.on_meta_field = on_meta_field;
 	msg->reader_ctx.on_warning = on_warning;
 	msg->reader_ctx.on_error = on_error;
@@ -1775,6 +2262,8 @@ xmysqlnd_sql_stmt_execute__init_read(st_xmysqlnd_msg__sql_stmt_execute* const ms
 	msg->reader_ctx.on_stmt_execute_ok = on_stmt_execute_ok;
 	msg->reader_ctx.on_resultset_end = on_resultset_end;
 
+	msg->reader_ctx.decode_plan.clear();
+	msg->reader_ctx.meta_frames.clear();
 	msg->reader_ctx.field_count = 0;
 	msg->reader_ctx.has_more_results = FALSE;
 	msg->reader_ctx.has_more_rows_in_set = FALSE;
@@ -1826,8 +2315,9 @@ xmysqlnd_get_sql_stmt_execute_message(Message_context& msg_ctx)
 			msg_ctx,
 
 			{ nullptr, nullptr}, /* create meta field */
+			{ nullptr, nullptr, nullptr}, /* meta_cache */
 
-			{ nullptr, nullptr}, /* on_row_field */
+			{ nullptr, nullptr, nullptr}, /* on_row */
 			{ nullptr, nullptr}, /* on_meta_field */
 			{ nullptr, nullptr}, /* on_warning */
 			{ nullptr, nullptr}, /* on_error */
@@ -1838,6 +2328,8 @@ xmysqlnd_get_sql_stmt_execute_message(Message_context& msg_ctx)
 			{ nullptr, nullptr}, /* on_stmt_execute_ok */
 			{ nullptr, nullptr}, /* on_resultset_end */
 
+			{},    /* decode_plan */
+			{},    /* meta_frames */
 			0,     /* field_count*/
 			FALSE, /* has_more_results */
 			FALSE, /* has_more_rows_in_set */
@@ -2345,12 +2837,14 @@ xmysqlnd_collection_add__read_response(st_xmysqlnd_msg__collection_add* msg)
 
 enum_func_status
 xmysqlnd_collection_add__send_request(st_xmysqlnd_msg__collection_add* msg,
-				const st_xmysqlnd_pb_message_shell pb_message_shell)
+				const st_xmysqlnd_pb_message_shell pb_message_shell,
+				std::string& encoded_rows)
 {
 	DBG_ENTER("xmysqlnd_collection_add__send_request");
 	size_t bytes_sent;
 	const enum_func_status ret = xmysqlnd_send_message(COM_CRUD_INSERT,
 								 *(google::protobuf::Message *)(pb_message_shell.message),
+								 encoded_rows,
 								 msg->msg_ctx,
 								 &bytes_sent);
 	DBG_RETURN(ret);
@@ -154,11 +154,33 @@ struct st_xmysqlnd_meta_field_create_bind
 	void * ctx;
 };
 
-typedef enum_func_status (*func_xmysqlnd_wireprotocol__row_field_decoder)(const util::string_view& buffer, const st_xmysqlnd_result_field_meta* const field_meta, const unsigned int idx, zval * out_zv);
+/*
+  The metadata of a result set is looked up by its raw ColumnMetaData frames before
+  anything gets parsed, and a freshly built one is offered for caching.
+*/
+struct st_xmysqlnd_meta_cache_bind
+{
+	const st_xmysqlnd_stmt_result_meta* (*lookup)(void * context, const util::string_view& frames);
+	void (*store)(void * context, const util::string_view& frames);
+	void * ctx;
+};
+
+typedef enum_func_status (*func_xmysqlnd_wireprotocol__row_field_decoder)(zval * out_zv, const uint8_t * buf, const size_t buf_size, const st_xmysqlnd_result_field_meta* const field_meta);
 
-struct st_xmysqlnd_on_row_field_bind
+/*
+  One entry per column, the decoder is picked once when the column metadata arrives,
+  so decoding a row is a plain walk over the plan.
+*/
+struct st_xmysqlnd_row_field_decode_step
+{
+	func_xmysqlnd_wireprotocol__row_field_decoder decoder;
+	const st_xmysqlnd_result_field_meta* field_meta;
+};
+
+struct st_xmysqlnd_on_row_bind
 {
-	const enum_hnd_func_status (*handler)(void * context, const util::string_view& buffer, const unsigned int idx, const func_xmysqlnd_wireprotocol__row_field_decoder decoder);
+	zval* (*create_row)(void * context);
+	const enum_hnd_func_status (*handler)(void * context, zval * row);
 	void * ctx;
 };
 
@@ -206,8 +228,9 @@ struct st_xmysqlnd_result_set_reader_ctx
 	Message_context msg_ctx;
 
 	st_xmysqlnd_meta_field_create_bind create_meta_field;
+	st_xmysqlnd_meta_cache_bind meta_cache;
 
-	st_xmysqlnd_on_row_field_bind on_row_field;
+	st_xmysqlnd_on_row_bind on_row;
 	st_xmysqlnd_on_meta_field_bind on_meta_field;
 	st_xmysqlnd_on_warning_bind on_warning;
 	st_xmysqlnd_on_error_bind on_error;
@@ -218,6 +241,10 @@ struct st_xmysqlnd_result_set_reader_ctx
 	st_xmysqlnd_on_stmt_execute_ok_bind on_stmt_execute_ok;
 	st_xmysqlnd_on_resultset_end_bind on_resultset_end;
 
+	util::vector<st_xmysqlnd_row_field_decode_step> decode_plan;
+	/* size prefixed ColumnMetaData payloads, pending until the first non-metadata message */
+	util::string meta_frames;
+
 	unsigned int field_count:16;
 	zend_bool has_more_results:1;
 	zend_bool has_more_rows_in_set:1;
@@ -233,7 +260,8 @@ struct st_xmysqlnd_msg__sql_stmt_execute
 
 	enum_func_status (*init_read)(st_xmysqlnd_msg__sql_stmt_execute* const msg,
 								  const st_xmysqlnd_meta_field_create_bind create_meta_field,
-								  const st_xmysqlnd_on_row_field_bind on_row_field,
+								  const st_xmysqlnd_meta_cache_bind meta_cache,
+								  const st_xmysqlnd_on_row_bind on_row,
 								  const st_xmysqlnd_on_meta_field_bind on_meta_field,
 								  const st_xmysqlnd_on_warning_bind on_warning,
 								  const st_xmysqlnd_on_error_bind on_error,
@@ -353,8 +381,10 @@ struct st_xmysqlnd_result_ctx
 
 struct st_xmysqlnd_msg__collection_add
 {
+	// encoded_rows - the rows of Insert, already laid out as on the wire
 	enum_func_status(*send_request)(st_xmysqlnd_msg__collection_add* msg,
-						const st_xmysqlnd_pb_message_shell pb_message_shell);
+						const st_xmysqlnd_pb_message_shell pb_message_shell,
+						std::string& encoded_rows);
 
 	enum_func_status(*read_response)(st_xmysqlnd_msg__collection_add* msg);
 
@@ -443,7 +473,8 @@ struct st_xmysqlnd_msg__collection_read
 
 	enum_func_status (*init_read)(st_xmysqlnd_msg__collection_read* const msg,
 								  const st_xmysqlnd_meta_field_create_bind create_meta_field,
-								  const st_xmysqlnd_on_row_field_bind on_row_field,
+								  const st_xmysqlnd_meta_cache_bind meta_cache,
+								  const st_xmysqlnd_on_row_bind on_row,
 								  const st_xmysqlnd_on_meta_field_bind on_meta_field,
 								  const st_xmysqlnd_on_warning_bind on_warning,
 								  const st_xmysqlnd_on_error_bind on_error,
@@ -503,6 +534,8 @@ struct st_xmysqlnd_message_factory
 
 st_xmysqlnd_message_factory get_message_factory(Message_context msg_ctx);
 
+func_xmysqlnd_wireprotocol__row_field_decoder xmysqlnd_row_field_decoder(const st_xmysqlnd_result_field_meta* const field_meta);
+
 void xmysqlnd_shutdown_protobuf_library();
 
 } // namespace drv
@@ -0,0 +1,169 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#include "php_api.h"
+#include "mysqlnd_api.h"
+#include "xmysqlnd.h"
+#include "xmysqlnd_protocol_frame_codec.h"
+#include "xmysqlnd_session.h"
+#include "xmysqlnd_stmt.h"
+#include "xmysqlnd_stmt_result.h"
+#include "xmysqlnd_write_batch.h"
+#include <algorithm>
+
+namespace mysqlx {
+
+namespace drv {
+
+Batched_write::Batched_write(xmysqlnd_stmt* stmt)
+	: stmt(stmt->get_reference(stmt))
+{
+}
+
+Batched_write::~Batched_write()
+{
+	xmysqlnd_stmt_result_free(result, nullptr, nullptr);
+	xmysqlnd_stmt_free(stmt, nullptr, nullptr);
+}
+
+void Batched_write::read()
+{
+	DBG_ENTER("Batched_write::read");
+	if (done) {
+		DBG_VOID_RETURN;
+	}
+	done = true;
+
+	const st_xmysqlnd_stmt_on_warning_bind on_warning{ nullptr, nullptr };
+	const st_xmysqlnd_stmt_on_error_bind on_error{ Batched_write::on_error, this };
+	zend_bool has_more{FALSE};
+	result = stmt->get_buffered_result(stmt, &has_more, on_warning, on_error, nullptr, nullptr);
+	if (!result && !error_code) {
+		// no response at all, the connection is gone
+		const MYSQLND_ERROR_INFO* error_info{ stmt->get_session()->get_data()->get_error_info() };
+		error_code = error_info->error_no ? error_info->error_no : CR_SERVER_GONE_ERROR;
+		sql_state = error_info->sqlstate;
+		error_message = error_info->error_no ? error_info->error : mysqlnd_server_gone;
+	}
+	DBG_INF_FMT("error_code=%u", error_code);
+	DBG_VOID_RETURN;
+}
+
+void Batched_write::wait()
+{
+	if (!done) {
+		stmt->get_session()->get_data()->write_batch.drain();
+	}
+	read();
+}
+
+st_xmysqlnd_stmt_result* Batched_write::release_result()
+{
+	st_xmysqlnd_stmt_result* released{ result };
+	result = nullptr;
+	return released;
+}
+
+const enum_hnd_func_status
+Batched_write::on_error(
+	void* context,
+	xmysqlnd_stmt* const /*stmt*/,
+	const unsigned int code,
+	const util::string_view& sql_state,
+	const util::string_view& message)
+{
+	DBG_ENTER("Batched_write::on_error");
+	Batched_write* write{ static_cast<Batched_write*>(context) };
+	write->error_code = code;
+	write->sql_state = sql_state;
+	write->error_message = message;
+	DBG_RETURN(HND_PASS_RETURN_FAIL);
+}
+
+// ---------
+
+void Write_batch::begin(st_xmysqlnd_protocol_frame_codec* pfc, MYSQLND_VIO* vio)
+{
+	DBG_ENTER("Write_batch::begin");
+	if (is_active()) {
+		DBG_VOID_RETURN;
+	}
+	this->pfc = pfc;
+	this->vio = vio;
+	failed_count = 0;
+	pfc->data->write_batch = this;
+	DBG_VOID_RETURN;
+}
+
+void Write_batch::add(const Batched_write_ptr& write)
+{
+	// the response to START TRANSACTION is to be skipped before the one to this write
+	write->trx_begin_unread = pfc->data->trx_begin_unread;
+	pfc->data->trx_begin_unread = FALSE;
+	pending.push_back(write);
+}
+
+void Write_batch::drain()
+{
+	DBG_ENTER("Write_batch::drain");
+	DBG_INF_FMT("pending=%zu", pending.size());
+	if (draining || pending.empty()) {
+		DBG_VOID_RETURN;
+	}
+	draining = true;
+	// START TRANSACTION sent with a statement after the batched writes
+	const zend_bool trx_begin_unread{ pfc->data->trx_begin_unread };
+	std::vector<Batched_write_ptr> writes;
+	writes.swap(pending);
+	for (auto& write : writes) {
+		pfc->data->trx_begin_unread = write->trx_begin_unread;
+		write->read();
+		if (write->get_error_code()) {
+			++failed_count;
+		}
+	}
+	pfc->data->trx_begin_unread = trx_begin_unread;
+	draining = false;
+	DBG_VOID_RETURN;
+}
+
+std::size_t Write_batch::end(MYSQLND_STATS* stats, MYSQLND_ERROR_INFO* error_info)
+{
+	DBG_ENTER("Write_batch::end");
+	if (!is_active()) {
+		DBG_RETURN(0);
+	}
+	drain();
+	// nothing may be left queued, a message which is never read is sent here
+	if (FAIL == pfc->data->m.flush(pfc, vio, stats, error_info)) {
+		// the queued messages never reached the server, neither did writes still pending
+		failed_count += std::max<std::size_t>(pending.size(), 1);
+		if (error_info && !error_info->error_no) {
+			SET_CLIENT_ERROR(error_info, CR_SERVER_GONE_ERROR, UNKNOWN_SQLSTATE, mysqlnd_server_gone);
+		}
+	}
+	pfc->data->write_batch = nullptr;
+	pfc = nullptr;
+	vio = nullptr;
+	const std::size_t failed{ failed_count };
+	failed_count = 0;
+	DBG_RETURN(failed);
+}
+
+} // namespace drv
+
+} // namespace mysqlx
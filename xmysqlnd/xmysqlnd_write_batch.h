@@ -0,0 +1,123 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#ifndef XMYSQLND_WRITE_BATCH_H
+#define XMYSQLND_WRITE_BATCH_H
+
+#include "xmysqlnd_driver.h"
+#include "util/strings.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mysqlx {
+
+namespace drv {
+
+class xmysqlnd_stmt;
+struct st_xmysqlnd_stmt_result;
+struct st_xmysqlnd_protocol_frame_codec;
+
+/*
+	Write queued in a Write_batch - its response is read when the batch is
+	drained, and then the result, or the error returned by the server, waits here
+	for the devapi result object.
+*/
+class Batched_write
+{
+public:
+	explicit Batched_write(xmysqlnd_stmt* stmt);
+	Batched_write(const Batched_write&) = delete;
+	Batched_write& operator=(const Batched_write&) = delete;
+	~Batched_write();
+
+	// reads the response, unless it was read already
+	void read();
+	// drains the batch of the session if the response wasn't read yet
+	void wait();
+	bool is_done() const { return done; }
+
+	// the caller takes over the result, nullptr if the write failed
+	st_xmysqlnd_stmt_result* release_result();
+	unsigned int get_error_code() const { return error_code; }
+	const std::string& get_sql_state() const { return sql_state; }
+	const std::string& get_error_message() const { return error_message; }
+
+private:
+	friend class Write_batch;
+
+	static const enum_hnd_func_status on_error(
+		void* context,
+		xmysqlnd_stmt* const stmt,
+		const unsigned int code,
+		const util::string_view& sql_state,
+		const util::string_view& message);
+
+	xmysqlnd_stmt* stmt;
+	st_xmysqlnd_stmt_result* result{nullptr};
+	bool done{false};
+	// the deferred START TRANSACTION went out with this write
+	zend_bool trx_begin_unread{FALSE};
+	unsigned int error_code{0};
+	std::string sql_state;
+	std::string error_message;
+};
+
+using Batched_write_ptr = std::shared_ptr<Batched_write>;
+
+/*
+	While a batch is active, the frame codec of the session queues the messages
+	instead of writing them, and the responses to the writes added here are left
+	unread. The queued messages go out with one socket write before anything is
+	read from the session, and the responses to the batched writes are read then,
+	in order, ahead of the response the reader waits for - see
+	xmysqlnd_receive_message. So other statements may be executed in the meantime,
+	they just drain the batch.
+*/
+class Write_batch
+{
+public:
+	Write_batch() = default;
+	Write_batch(const Write_batch&) = delete;
+	Write_batch& operator=(const Write_batch&) = delete;
+
+	void begin(st_xmysqlnd_protocol_frame_codec* pfc, MYSQLND_VIO* vio);
+	bool is_active() const { return pfc != nullptr; }
+	bool is_draining() const { return draining; }
+
+	void add(const Batched_write_ptr& write);
+	// reads the responses to the writes queued so far, the batch stays active
+	void drain();
+	/*
+		sends what is queued, reads all the responses and ends the batch, returns
+		the number of writes which failed
+	*/
+	std::size_t end(MYSQLND_STATS* stats, MYSQLND_ERROR_INFO* error_info);
+
+private:
+	st_xmysqlnd_protocol_frame_codec* pfc{nullptr};
+	MYSQLND_VIO* vio{nullptr};
+	std::vector<Batched_write_ptr> pending;
+	std::size_t failed_count{0};
+	bool draining{false};
+};
+
+} // namespace drv
+
+} // namespace mysqlx
+
+#endif // XMYSQLND_WRITE_BATCH_H
@@ -0,0 +1,144 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#include "php_api.h"
+#include "mysqlnd_api.h"
+#include "xmysqlnd.h"
+#include "xmysqlnd_zval2expr.h"
+
+#include "util/value.h"
+
+#include "proto_gen/mysqlx_datatypes.pb.h"
+#include "proto_gen/mysqlx_expr.pb.h"
+
+namespace mysqlx {
+
+namespace drv {
+
+using namespace Mysqlx::Datatypes;
+
+namespace {
+
+void str2scalar(const util::zvalue& zv, Scalar* scalar)
+{
+	assert(zv.is_string());
+	scalar->set_type(Scalar_Type_V_STRING);
+	// the only copy of the payload, straight from the zend_string
+	scalar->mutable_v_string()->set_value(zv.c_str(), zv.length());
+}
+
+void array2expr(const util::zvalue& zv, Mysqlx::Expr::Expr* expr)
+{
+	assert(zv.is_array());
+	expr->set_type(Mysqlx::Expr::Expr::ARRAY);
+	Mysqlx::Expr::Array* array{ expr->mutable_array() };
+	array->mutable_value()->Reserve(static_cast<int>(zv.size()));
+	for (const auto& value : zv.values()) {
+		zval2expr(value, array->add_value());
+	}
+}
+
+void object2expr(const util::zvalue& zv, Mysqlx::Expr::Expr* expr)
+{
+	assert(zv.is_object());
+	expr->set_type(Mysqlx::Expr::Expr::OBJECT);
+	Mysqlx::Expr::Object* obj{ expr->mutable_object() };
+	for (const auto& [property_name, property_value] : zv) {
+		Mysqlx::Expr::Object_ObjectField* field{ obj->add_fld() };
+
+		assert(property_name.is_string());
+		field->set_key(property_name.c_str(), property_name.length());
+		zval2expr(property_value, field->mutable_value());
+	}
+}
+
+} // anonymous namespace
+
+bool
+zval2scalar(const util::zvalue& zv, Scalar* scalar)
+{
+	DBG_ENTER("zval2scalar");
+	switch (zv.type()) {
+		case util::zvalue::Type::Undefined:
+		case util::zvalue::Type::Null:
+			scalar->set_type(Scalar_Type_V_NULL);
+			break;
+
+		case util::zvalue::Type::False:
+		case util::zvalue::Type::True:
+			scalar->set_type(Scalar_Type_V_BOOL);
+			scalar->set_v_bool(zv.is_true());
+			break;
+
+		case util::zvalue::Type::Long:
+			DBG_INF_FMT("IS_LONG=%lu", zv.to_zlong());
+			scalar->set_type(Scalar_Type_V_SINT);
+			scalar->set_v_signed_int(zv.to_zlong());
+			break;
+
+		case util::zvalue::Type::Double:
+			DBG_INF_FMT("IS_DOUBLE=%f", zv.to_double());
+			scalar->set_type(Scalar_Type_V_DOUBLE);
+			scalar->set_v_double(zv.to_double());
+			break;
+
+		case util::zvalue::Type::String:
+			DBG_INF_FMT("IS_STRING=%s", zv.c_str());
+			str2scalar(zv, scalar);
+			break;
+
+		case util::zvalue::Type::Array:
+		case util::zvalue::Type::Object:
+			DBG_RETURN(false);
+
+		default: {
+			// the same as zval2any does for the rest
+			util::zvalue other = zv.clone();
+			convert_to_string(other.ptr());
+			if (other.is_string()) {
+				str2scalar(other, scalar);
+			}
+			break;
+		}
+	}
+	DBG_RETURN(true);
+}
+
+void
+zval2expr(const util::zvalue& zv, Mysqlx::Expr::Expr* expr)
+{
+	DBG_ENTER("zval2expr");
+	switch (zv.type()) {
+		case util::zvalue::Type::Array:
+			array2expr(zv, expr);
+			break;
+
+		case util::zvalue::Type::Object:
+			object2expr(zv, expr);
+			break;
+
+		default:
+			expr->set_type(Mysqlx::Expr::Expr::LITERAL);
+			zval2scalar(zv, expr->mutable_literal());
+			break;
+	}
+	DBG_VOID_RETURN;
+}
+
+} // namespace drv
+
+} // namespace mysqlx
@@ -0,0 +1,56 @@
+/*
+  +----------------------------------------------------------------------+
+  | PHP Version 7                                                        |
+  +----------------------------------------------------------------------+
+  | Copyright (c) The PHP Group                                          |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+  | Authors: Darek Slusarczyk <marines@php.net>                          |
+  +----------------------------------------------------------------------+
+*/
+#ifndef XMYSQLND_ZVAL2EXPR_H
+#define XMYSQLND_ZVAL2EXPR_H
+
+namespace Mysqlx {
+namespace Datatypes {
+
+	class Scalar;
+
+} // namespace Datatypes
+
+namespace Expr {
+
+	class Expr;
+
+} // namespace Expr
+
+} // namespace Mysqlx
+
+namespace mysqlx {
+
+namespace util { class zvalue; }
+
+namespace drv {
+
+/*
+	single pass encoders of bound values, they write straight into the message
+	instead of building Mysqlx::Datatypes::Any first and copying it with any2expr
+*/
+
+// returns false for arrays and objects, they are not scalars
+bool zval2scalar(const util::zvalue& zv, Mysqlx::Datatypes::Scalar* scalar);
+// scalars become literals, arrays and objects (JSON values) become Expr arrays and objects
+void zval2expr(const util::zvalue& zv, Mysqlx::Expr::Expr* expr);
+
+} // namespace drv
+
+} // namespace mysqlx
+
+#endif /* XMYSQLND_ZVAL2EXPR_H */